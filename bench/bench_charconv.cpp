@@ -0,0 +1,240 @@
+/**
+ * @file bench_charconv.cpp
+ * @brief Benchmarks for std_module.charconv extensions
+ *
+ * Compares a loop of std::from_chars calls (skipping one separator after
+ * each value) against std_module::from_chars_batch on comma-separated
+ * buffers with 10 values per line, for:
+ * - integers: int64 values of 1..18 digits, about half negative
+ * - decimals: doubles printed with 2..6 fractional digits (prices and
+ *   measurements, the common CSV case)
+ * - shortest round-trip doubles: random bit patterns printed by
+ *   std::to_chars (mostly 16-17 significant digits)
+ *
+ * Also compares a std::to_chars loop against std_module::to_chars_batch
+ * for printing the same values back. Results are reported per value and
+ * as input bytes per second.
+ *
+ * Compares std::to_chars against std_module::to_chars (shortest
+ * round-trip) for float and double in every std::chars_format mode
+ * (plain, fixed, scientific, general, hex), on:
+ * - random bits: finite values with uniformly random bit patterns, so
+ *   the whole exponent range (fixed notation then runs to hundreds of
+ *   characters)
+ * - short decimals: values with at most 8 significant digits, such as
+ *   12345.678
+ *
+ * Default is 10^6 values per buffer; pass --full for 10^7.
+ */
+
+import std_module.charconv;
+import std_module.bit;
+import std_module.format;
+import std_module.span;
+import std_module.string;
+import std_module.type_traits;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+template <class T>
+std::string to_csv(const std::vector<T>& values) {
+    std::string out;
+    char buf[64];
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        auto r = std::to_chars(buf, buf + sizeof buf, values[i]);
+        out.append(buf, r.ptr);
+        out.push_back(i % 10 == 9 ? '\n' : ',');
+    }
+    return out;
+}
+
+std::vector<std::int64_t> make_integers(std::size_t n) {
+    bench::rng r(1);
+    std::vector<std::int64_t> out(n);
+    for (auto& v : out) {
+        std::int64_t limit = 1;
+        for (std::uint64_t d = 1 + r.below(18); d > 0; --d) {
+            limit *= 10;
+        }
+        v = static_cast<std::int64_t>(r.below(static_cast<std::uint64_t>(limit)));
+        if (r.below(2)) {
+            v = -v;
+        }
+    }
+    return out;
+}
+
+std::string make_decimals(std::size_t n) {
+    bench::rng r(2);
+    std::string out;
+    char buf[64];
+    for (std::size_t i = 0; i < n; ++i) {
+        double v = static_cast<double>(r.below(100'000'000)) / 1000.0;
+        int precision = 2 + static_cast<int>(r.below(5));
+        auto res = std::to_chars(buf, buf + sizeof buf, v, std::chars_format::fixed, precision);
+        out.append(buf, res.ptr);
+        out.push_back(i % 10 == 9 ? '\n' : ',');
+    }
+    return out;
+}
+
+std::vector<double> make_random_doubles(std::size_t n) {
+    bench::rng r(3);
+    std::vector<double> out;
+    out.reserve(n);
+    while (out.size() < n) {
+        // Uniform exponent in [2^-60, 2^60): a wide but finite spread
+        std::uint64_t bits = (r.next() & 0x800FFFFFFFFFFFFFull) | ((960 + r.below(120)) << 52);
+        out.push_back(std::bit_cast<double>(bits));
+    }
+    return out;
+}
+
+// Finite values with uniformly random bit patterns
+template <class T>
+std::vector<T> make_random_bits(std::size_t n) {
+    using bits_type = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+    bench::rng r(4);
+    std::vector<T> out;
+    out.reserve(n);
+    while (out.size() < n) {
+        T v = std::bit_cast<T>(static_cast<bits_type>(r.next()));
+        if (v - v == 0) {  // skips infinities and NaNs
+            out.push_back(v);
+        }
+    }
+    return out;
+}
+
+template <class T>
+std::vector<T> make_short_decimals(std::size_t n) {
+    bench::rng r(5);
+    std::vector<T> out(n);
+    for (auto& v : out) {
+        v = static_cast<T>(static_cast<double>(r.below(100'000'000)) / 1000.0);
+    }
+    return out;
+}
+
+template <class T>
+void shortest(const char* type, const std::vector<T>& values) {
+    struct mode {
+        const char* name;
+        std::chars_format fmt;
+    };
+    const mode modes[] = {{"plain", std::chars_format{}},
+                          {"fixed", std::chars_format::fixed},
+                          {"scientific", std::chars_format::scientific},
+                          {"general", std::chars_format::general},
+                          {"hex", std::chars_format::hex}};
+    char buf[400];
+    for (const mode& m : modes) {
+        // The plain overload is separate from the chars_format one
+        bool plain = m.fmt == std::chars_format{};
+        bench::run(std::format("std::to_chars {} {}", type, m.name), values.size(), [&] {
+            std::size_t chars = 0;
+            for (T v : values) {
+                auto r = plain ? std::to_chars(buf, buf + sizeof buf, v)
+                               : std::to_chars(buf, buf + sizeof buf, v, m.fmt);
+                chars += static_cast<std::size_t>(r.ptr - buf);
+            }
+            bench::do_not_optimize(chars);
+        });
+        bench::run(std::format("std_module::to_chars {} {}", type, m.name), values.size(), [&] {
+            std::size_t chars = 0;
+            for (T v : values) {
+                auto r = plain ? std_module::to_chars(buf, buf + sizeof buf, v)
+                               : std_module::to_chars(buf, buf + sizeof buf, v, m.fmt);
+                chars += static_cast<std::size_t>(r.ptr - buf);
+            }
+            bench::do_not_optimize(chars);
+        });
+    }
+}
+
+template <class T>
+void parse(const std::string& csv, std::size_t n) {
+    std::vector<T> out(n);
+    double bytes = static_cast<double>(csv.size());
+    const char* first = csv.data();
+    const char* last = csv.data() + csv.size();
+
+    auto loop = bench::run("std::from_chars loop", n, [&] {
+        const char* p = first;
+        std::size_t i = 0;
+        while (p < last && i < n) {
+            auto r = std::from_chars(p, last, out[i++]);
+            p = r.ptr + 1;
+        }
+        bench::do_not_optimize(out.data());
+    });
+    bench::note(std::format("    {:.2f} GB/s", bytes / (loop.ns_per_op * static_cast<double>(n))));
+
+    auto batch = bench::run("from_chars_batch", n, [&] {
+        auto r = std_module::from_chars_batch(first, last, std::span(out));
+        bench::do_not_optimize(r.count);
+    });
+    bench::note(std::format("    {:.2f} GB/s", bytes / (batch.ns_per_op * static_cast<double>(n))));
+}
+
+template <class T>
+void print(const std::vector<T>& values) {
+    std::string buf(values.size() * 32, '\0');
+    char* first = buf.data();
+    char* last = buf.data() + buf.size();
+
+    bench::run("std::to_chars loop", values.size(), [&] {
+        char* p = first;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i != 0) {
+                *p++ = ',';
+            }
+            p = std::to_chars(p, last, values[i]).ptr;
+        }
+        bench::do_not_optimize(p);
+    });
+    bench::run("to_chars_batch", values.size(), [&] {
+        auto r = std_module::to_chars_batch(first, last, std::span(values));
+        bench::do_not_optimize(r.ptr);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.charconv");
+
+    std::size_t n = bench::full_run(argc, argv) ? 10'000'000 : 1'000'000;
+
+    auto integers = make_integers(n);
+    std::string integer_csv = to_csv(integers);
+    bench::section("parse int64 CSV, values", n);
+    parse<std::int64_t>(integer_csv, n);
+
+    std::string decimal_csv = make_decimals(n);
+    bench::section("parse decimal CSV (2-6 fraction digits), values", n);
+    parse<double>(decimal_csv, n);
+
+    auto doubles = make_random_doubles(n);
+    std::string double_csv = to_csv(doubles);
+    bench::section("parse shortest round-trip double CSV, values", n);
+    parse<double>(double_csv, n);
+
+    bench::section("print int64, values", n);
+    print(integers);
+    bench::section("print double (shortest), values", n);
+    print(doubles);
+
+    bench::section("shortest to_chars, random bits, values", n);
+    shortest("double", make_random_bits<double>(n));
+    shortest("float", make_random_bits<float>(n));
+    bench::section("shortest to_chars, short decimals, values", n);
+    shortest("double", make_short_decimals<double>(n));
+    shortest("float", make_short_decimals<float>(n));
+
+    return 0;
+}
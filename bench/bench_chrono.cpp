@@ -0,0 +1,402 @@
+/**
+ * @file bench_chrono.cpp
+ * @brief Benchmarks for std_module.chrono extensions
+ *
+ * Compares the cost of reading the time with steady_clock::now() and
+ * system_clock::now() (clock_gettime through the vDSO) against
+ * std_module::tsc_clock: now(), the raw ticks() and ticks_ordered()
+ * counter reads, and from_ticks() for converting a stored reading later.
+ *
+ * Then measures drift: how far tsc_clock has moved from steady_clock
+ * after a while, as an offset and in parts per million of the elapsed
+ * time, without and with a tsc_clock::recalibrate() halfway through.
+ *
+ * Then compares the coarse clocks, coarse_clock (a cached atomic updated
+ * by a background ticker) and monotonic_coarse_clock
+ * (CLOCK_MONOTONIC_COARSE), against steady_clock and tsc_clock with 1..8
+ * threads all reading at once, and measures how far coarse_clock trails
+ * steady_clock at two resolutions.
+ *
+ * Finally the calendar and time zone helpers: year_month_day <-> sys_days
+ * by the standard conversions and by to_year_month_day()/to_sys_days(),
+ * ISO 8601 timestamps by std::format and by std::from_chars per field
+ * against format_iso8601()/parse_iso8601(), and the UTC offset of increasing
+ * timestamps (one every 31 s, about a year per 10^6) by zoned_time,
+ * time_zone::get_info() and zone_cache.
+ *
+ * Default is 10^7 reads, a 2 s drift run, 10^6 reads per thread and 10^6
+ * conversions; pass --full for 10^8 reads, a 60 s drift run, 10^7 reads
+ * per thread on 1..64 threads and 10^7 conversions. For drift over hours, --drift <seconds> only
+ * runs the drift check, printing the offset every 10 s (every minute
+ * past 10 minutes), for example:
+ *
+ *     bench_chrono --drift 14400
+ */
+
+import std_module.charconv;
+import std_module.chrono;
+import std_module.format;
+import std_module.string_view;
+import std_module.system_error;
+import std_module.thread;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using std_module::coarse_clock;
+using std_module::monotonic_coarse_clock;
+using std_module::tsc_clock;
+
+template <class Clock>
+void read_clock(const char* name, std::size_t n) {
+    bench::run(name, n, [&] {
+        typename Clock::duration sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += Clock::now().time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void read_cost(std::size_t n) {
+    bench::section("time reads", n);
+    read_clock<std::chrono::steady_clock>("std::chrono::steady_clock::now", n);
+    read_clock<std::chrono::system_clock>("std::chrono::system_clock::now", n);
+    read_clock<tsc_clock>("tsc_clock::now", n);
+    read_clock<monotonic_coarse_clock>("monotonic_coarse_clock::now", n);
+    coarse_clock::start();
+    read_clock<coarse_clock>("coarse_clock::now", n);
+    bench::run("tsc_clock::ticks", n, [&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += tsc_clock::ticks();
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("tsc_clock::ticks_ordered", n, [&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += tsc_clock::ticks_ordered();
+        }
+        bench::do_not_optimize(sum);
+    });
+    std::uint64_t base = tsc_clock::ticks();
+    bench::run("tsc_clock::from_ticks", n, [&] {
+        tsc_clock::duration sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += tsc_clock::from_ticks(base + i).time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+    if (tsc_clock::uses_counter()) {
+        bench::note(std::format("    counter at {:.3f} GHz", tsc_clock::ticks_per_second() / 1e9));
+    } else {
+        bench::note("    no invariant counter: tsc_clock forwards to steady_clock");
+    }
+}
+
+// tsc_clock minus steady_clock, averaged over a few back-to-back pairs
+double offset_us() {
+    double sum = 0;
+    for (int i = 0; i < 16; ++i) {
+        auto tsc = tsc_clock::to_steady(tsc_clock::now());
+        auto steady = std::chrono::steady_clock::now();
+        sum += std::chrono::duration<double, std::micro>(tsc - steady).count();
+    }
+    return sum / 16;
+}
+
+void spin_for(std::chrono::steady_clock::duration d) {
+    auto end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+void drift(std::chrono::seconds length) {
+    bench::section("drift against steady_clock, seconds", static_cast<std::size_t>(length.count()));
+    double start = offset_us();
+    spin_for(length);
+    double end = offset_us();
+    double ppm = (end - start) / (static_cast<double>(length.count()) * 1e6) * 1e6;
+    bench::note(std::format("  {:<50} {:>9.2f} us  {:>8.3f} ppm", "without recalibration", end - start, ppm));
+
+    spin_for(length / 2);
+    tsc_clock::recalibrate();
+    start = offset_us();
+    spin_for(length / 2);
+    end = offset_us();
+    ppm = (end - start) / (static_cast<double>(length.count()) / 2 * 1e6) * 1e6;
+    bench::note(std::format("  {:<50} {:>9.2f} us  {:>8.3f} ppm", "after recalibrate()", end - start, ppm));
+}
+
+// Every thread reads the clock per_thread times at once; reports the
+// aggregate cost, so perfect scaling halves it with each doubling
+template <class Clock>
+void contended(const char* name, std::size_t threads, std::size_t per_thread) {
+    bench::run(name, threads * per_thread, [&] {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([per_thread] {
+                typename Clock::duration sum{};
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    sum += Clock::now().time_since_epoch();
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    });
+}
+
+void contention(std::size_t max_threads, std::size_t per_thread) {
+    coarse_clock::start();
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("now() from all threads at once, threads", threads);
+        contended<std::chrono::steady_clock>("std::chrono::steady_clock::now", threads, per_thread);
+        contended<tsc_clock>("tsc_clock::now", threads, per_thread);
+        contended<monotonic_coarse_clock>("monotonic_coarse_clock::now", threads, per_thread);
+        contended<coarse_clock>("coarse_clock::now", threads, per_thread);
+    }
+    bench::note(std::format("    {} hardware threads", std::thread::hardware_concurrency()));
+}
+
+// steady_clock minus coarse_clock over back-to-back reads
+void staleness(std::chrono::nanoseconds resolution, std::size_t samples) {
+    coarse_clock::set_resolution(resolution);
+    coarse_clock::start();
+    std::vector<double> lag;
+    lag.reserve(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        auto coarse = coarse_clock::to_steady(coarse_clock::now());
+        lag.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - coarse).count());
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(resolution).count();
+    bench::report_percentiles(std::format("coarse_clock lag, resolution {} us", us), lag);
+}
+
+void calendar(std::size_t n) {
+    bench::section("calendar conversions", n);
+    bench::run("std::chrono::year_month_day(sys_days)", n, [&] {
+        unsigned sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::chrono::year_month_day ymd{std::chrono::sys_days(std::chrono::days(static_cast<int>(i)))};
+            sum += static_cast<unsigned>(ymd.day());
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("to_year_month_day", n, [&] {
+        unsigned sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto ymd = std_module::to_year_month_day(std::chrono::sys_days(std::chrono::days(static_cast<int>(i))));
+            sum += static_cast<unsigned>(ymd.day());
+        }
+        bench::do_not_optimize(sum);
+    });
+    std::vector<std::chrono::year_month_day> dates;
+    dates.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        dates.push_back(std_module::to_year_month_day(std::chrono::sys_days(std::chrono::days(static_cast<int>(i)))));
+    }
+    bench::run("std::chrono::sys_days(year_month_day)", n, [&] {
+        std::chrono::days sum{};
+        for (const auto& ymd : dates) {
+            sum += std::chrono::sys_days(ymd).time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("to_sys_days", n, [&] {
+        std::chrono::days sum{};
+        for (const auto& ymd : dates) {
+            sum += std_module::to_sys_days(ymd).time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+// The straightforward parse: std::from_chars for each field, sys_days(year_month_day) for the date
+template <class Duration>
+bool from_chars_fields(const char* p, const char* last, std::chrono::sys_time<Duration>& out) {
+    int y = 0;
+    unsigned mo = 0, d = 0, h = 0, mi = 0, s = 0;
+    unsigned* fields[] = {&mo, &d, &h, &mi, &s};
+    auto r = std::from_chars(p, last, y);
+    for (unsigned* f : fields) {
+        if (r.ec != std::errc{} || r.ptr == last) {
+            return false;
+        }
+        r = std::from_chars(r.ptr + 1, last, *f);
+    }
+    std::chrono::year_month_day ymd{std::chrono::year(y), std::chrono::month(mo), std::chrono::day(d)};
+    if (r.ec != std::errc{} || !ymd.ok()) {
+        return false;
+    }
+    auto t = std::chrono::sys_days(ymd) + std::chrono::hours(h) + std::chrono::minutes(mi) + std::chrono::seconds(s);
+    std::chrono::nanoseconds fraction{};
+    if (r.ptr != last && *r.ptr == '.') {
+        unsigned long long digits = 0;
+        auto f = std::from_chars(r.ptr + 1, last, digits);
+        for (auto n = f.ptr - (r.ptr + 1); n < 9; ++n) {
+            digits *= 10;
+        }
+        fraction = std::chrono::nanoseconds(static_cast<long long>(digits));
+    }
+    out = std::chrono::floor<Duration>(t + fraction);
+    return true;
+}
+
+template <class Duration>
+void iso8601(const char* suffix, std::size_t n, Duration step) {
+    using time = std::chrono::sys_time<Duration>;
+    time base = std::chrono::sys_days(std::chrono::year(2024) / 1 / 1);
+    char buf[std_module::iso8601_buffer_size];
+    bench::run(std::format("std::format_to_n {{:%FT%TZ}} {}", suffix), n, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            time t = base + step * static_cast<long long>(i);
+            sum += static_cast<std::size_t>(std::format_to_n(buf, sizeof buf, "{:%FT%TZ}", t).size);
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run(std::format("format_iso8601 {}", suffix), n, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            time t = base + step * static_cast<long long>(i);
+            sum += static_cast<std::size_t>(std_module::format_iso8601(buf, buf + sizeof buf, t).ptr - buf);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    std::vector<char> text;
+    std::vector<std::size_t> offsets;
+    for (std::size_t i = 0; i < n; ++i) {
+        offsets.push_back(text.size());
+        char* end = std_module::format_iso8601(buf, buf + sizeof buf, base + step * static_cast<long long>(i)).ptr;
+        text.insert(text.end(), buf, end);
+    }
+    offsets.push_back(text.size());
+    auto field = [&](std::size_t i) {
+        return std::string_view(text.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    };
+    bench::run(std::format("std::from_chars fields {}", suffix), n, [&] {
+        Duration sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            std::string_view s = field(i);
+            time t;
+            if (from_chars_fields(s.data(), s.data() + s.size(), t)) {
+                sum += t.time_since_epoch();
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run(std::format("parse_iso8601 {}", suffix), n, [&] {
+        Duration sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            time t;
+            std::string_view s = field(i);
+            std_module::parse_iso8601(s.data(), s.data() + s.size(), t);
+            sum += t.time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void zone_offsets(std::size_t n) {
+    bench::section("UTC offset of increasing timestamps, America/New_York", n);
+    const std::chrono::time_zone* zone = nullptr;
+    try {
+        zone = std::chrono::locate_zone("America/New_York");
+    } catch (...) {
+        bench::note("  tzdb unavailable");
+        return;
+    }
+    std::chrono::sys_seconds base = std::chrono::sys_days(std::chrono::year(2024) / 1 / 1);
+    bench::run("zoned_time::get_local_time", n, [&] {
+        std::chrono::seconds sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            std::chrono::sys_seconds t = base + std::chrono::seconds(31 * static_cast<long long>(i));
+            sum += std::chrono::zoned_time(zone, t).get_local_time().time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("time_zone::get_info", n, [&] {
+        std::chrono::seconds sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            std::chrono::sys_seconds t = base + std::chrono::seconds(31 * static_cast<long long>(i));
+            sum += zone->get_info(t).offset;
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("zone_cache::to_local", n, [&] {
+        std_module::zone_cache cache(zone);
+        std::chrono::seconds sum{};
+        for (std::size_t i = 0; i < n; ++i) {
+            std::chrono::sys_seconds t = base + std::chrono::seconds(31 * static_cast<long long>(i));
+            sum += cache.to_local(t).time_since_epoch();
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("zone_cache::offset + format_iso8601", n, [&] {
+        std_module::zone_cache cache(zone);
+        char buf[std_module::iso8601_buffer_size];
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::chrono::sys_seconds t = base + std::chrono::seconds(31 * static_cast<long long>(i));
+            sum += static_cast<std::size_t>(
+                std_module::format_iso8601(buf, buf + sizeof buf, t, cache.offset(t)).ptr - buf);
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+int long_drift(long long seconds) {
+    bench::header("std_module.chrono drift");
+    double start = offset_us();
+    auto begin = std::chrono::steady_clock::now();
+    for (long long elapsed = 0; elapsed < seconds;) {
+        long long step = elapsed < 600 ? 10 : 60;
+        elapsed += step;
+        spin_for(begin + std::chrono::seconds(elapsed) - std::chrono::steady_clock::now());
+        double off = offset_us() - start;
+        bench::note(std::format("  {:>8} s  offset {:>10.2f} us  {:>8.3f} ppm", elapsed, off,
+                                off / (static_cast<double>(elapsed) * 1e6) * 1e6));
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string_view(argv[1]) == "--drift") {
+        long long seconds = 0;
+        for (const char* p = argv[2]; *p >= '0' && *p <= '9'; ++p) {
+            seconds = seconds * 10 + (*p - '0');
+        }
+        return long_drift(seconds);
+    }
+
+    bench::header("std_module.chrono");
+
+    bool full = bench::full_run(argc, argv);
+    read_cost(full ? 100'000'000 : 10'000'000);
+    drift(full ? std::chrono::seconds(60) : std::chrono::seconds(2));
+    contention(full ? 64 : 8, full ? 10'000'000 : 1'000'000);
+
+    bench::section("coarse_clock behind steady_clock");
+    staleness(std::chrono::milliseconds(1), 1'000'000);
+    staleness(std::chrono::microseconds(100), 1'000'000);
+
+    std::size_t conversions = full ? 10'000'000 : 1'000'000;
+    calendar(conversions);
+    bench::section("ISO 8601 timestamps", conversions);
+    iso8601("(seconds)", conversions, std::chrono::seconds(31));
+    iso8601("(milliseconds)", conversions, std::chrono::milliseconds(31'001));
+    iso8601("(nanoseconds)", conversions, std::chrono::nanoseconds(31'000'000'001));
+    zone_offsets(conversions);
+
+    return 0;
+}
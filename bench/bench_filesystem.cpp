@@ -0,0 +1,150 @@
+/**
+ * @file bench_filesystem.cpp
+ * @brief Benchmarks for std_module.filesystem extensions
+ *
+ * Scans a generated tree (100 files per directory, 100 directories per
+ * level) and counts its regular files, with:
+ * - recursive_directory_iterator, taking types from the entry (no stat
+ *   where the platform reports types with names)
+ * - recursive_directory_iterator calling status() per entry, as code that
+ *   asks for more than the type does: one stat per entry
+ * - std_module::parallel_walk on 1, 2, 4, ... threads, up to
+ *   hardware_concurrency (at least 4)
+ *
+ * Then asks for the type, size and modification time of every regular
+ * file, with:
+ * - status(), file_size() and last_write_time(): three stats per file
+ * - std_module::query_file_info for the three fields: one statx per file
+ * - the batch std_module::query_file_info on 1, 2, 4, ... threads
+ *
+ * Results are per entry, with the page cache warm (the tree was just
+ * created, and every case runs three times). Scans of a cold tree on a
+ * real disk are bound by I/O latency and gain more from threads.
+ *
+ * Default is 10^5 files; pass --full for 10^6 (creating them takes a
+ * while). --tree <path> scans an existing directory instead of
+ * generating one.
+ */
+
+import std_module.filesystem;
+import std_module.atomic;
+import std_module.format;
+import std_module.fstream;
+import std_module.string;
+import std_module.string_view;
+import std_module.thread;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+fs::path generate(std::size_t files) {
+    fs::path root = fs::temp_directory_path() / "std_module_bench_walk";
+    fs::remove_all(root);
+    std::size_t directories = (files + 99) / 100;
+    for (std::size_t d = 0; d < directories; ++d) {
+        fs::path dir = root / std::format("d{:03}", d / 100) / std::format("d{:03}", d % 100);
+        fs::create_directories(dir);
+        for (std::size_t f = 0; f < 100 && d * 100 + f < files; ++f) {
+            std::ofstream(dir / std::format("file_{:05}.dat", f));
+        }
+    }
+    return root;
+}
+
+void scan(const fs::path& root, std::size_t max_threads) {
+    std::size_t entries = 0;
+    for (auto it = fs::recursive_directory_iterator(root); it != fs::recursive_directory_iterator(); ++it) {
+        ++entries;
+    }
+    bench::section("entries", entries);
+
+    bench::run("recursive_directory_iterator", entries, [&] {
+        std::size_t regular = 0;
+        for (const auto& e : fs::recursive_directory_iterator(root)) {
+            regular += e.is_regular_file();
+        }
+        bench::do_not_optimize(regular);
+    });
+    bench::run("recursive_directory_iterator + status()", entries, [&] {
+        std::size_t regular = 0;
+        for (const auto& e : fs::recursive_directory_iterator(root)) {
+            regular += fs::is_regular_file(e.status());
+        }
+        bench::do_not_optimize(regular);
+    });
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        bench::run(std::format("parallel_walk, threads = {}", threads), entries, [&] {
+            std::atomic<std::size_t> regular{0};
+            std_module::walk_options options;
+            options.threads = threads;
+            std_module::parallel_walk(root, [&](const std_module::walk_batch& batch) {
+                std::size_t n = 0;
+                for (const auto& e : batch.entries) {
+                    n += e.type == fs::file_type::regular;
+                }
+                regular.fetch_add(n, std::memory_order_relaxed);
+            }, options);
+            bench::do_not_optimize(regular);
+        });
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& e : fs::recursive_directory_iterator(root)) {
+        if (e.is_regular_file()) {
+            files.push_back(e.path());
+        }
+    }
+    bench::section("metadata of regular files", files.size());
+    bench::run("status() + file_size() + last_write_time()", files.size(), [&] {
+        std::uintmax_t bytes = 0;
+        for (const auto& file : files) {
+            bytes += fs::is_regular_file(fs::status(file)) ? fs::file_size(file) : 0;
+            bench::do_not_optimize(fs::last_write_time(file));
+        }
+        bench::do_not_optimize(bytes);
+    });
+    auto fields = std_module::file_info_fields::type | std_module::file_info_fields::size |
+                  std_module::file_info_fields::last_write_time;
+    bench::run("query_file_info", files.size(), [&] {
+        std::uintmax_t bytes = 0;
+        for (const auto& file : files) {
+            auto info = std_module::query_file_info(file, fields);
+            bytes += info.type == fs::file_type::regular ? info.size : 0;
+            bench::do_not_optimize(info.last_write_time);
+        }
+        bench::do_not_optimize(bytes);
+    });
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        bench::run(std::format("batch query_file_info, threads = {}", threads), files.size(), [&] {
+            std_module::file_info_options options;
+            options.fields = fields;
+            options.threads = threads;
+            bench::do_not_optimize(std_module::query_file_info(files, options));
+        });
+    }
+    bench::note(std::format("    {} hardware threads", std::thread::hardware_concurrency()));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.filesystem");
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    std::size_t max_threads = hardware > 4 ? hardware : 4;
+    if (argc == 3 && std::string_view(argv[1]) == "--tree") {
+        scan(argv[2], max_threads);
+        return 0;
+    }
+
+    fs::path root = generate(bench::full_run(argc, argv) ? 1'000'000 : 100'000);
+    scan(root, max_threads);
+    fs::remove_all(root);
+
+    return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file bench_format.cpp
+ * @brief Benchmarks for std_module.format extensions
+ *
+ * Formats log-line-like records, per call, with:
+ * - std::format, std::format_to into a reused std::string and into a
+ *   char buffer (runtime parsing of the format string on every call)
+ * - std_module::format<F>, std_module::format_to<F> into a std::span<char>
+ *   and into a char* (format string compiled at build time)
+ *
+ * Two format strings are measured: plain "{}" fields only, which use the
+ * compiled fast paths, and fields with specs, which fall back to
+ * std::vformat_to per field.
+ *
+ * Output targets: std::format's returned std::string, a reused std::string
+ * via back_inserter, and std_module::memory_buffer (fresh per call and
+ * reused), for a short log line and one whose message outgrows the
+ * buffer's inline storage. Heap allocations per call are counted by
+ * replacing the global operator new.
+ *
+ * Default is 10^6 calls per case; pass --full for 10^7.
+ */
+
+import std_module.format;
+import std_module.iterator;
+import std_module.span;
+import std_module.string;
+import std_module.string_view;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>  // For malloc/free in the counting operator new
+#include <new>
+
+// Counts every heap allocation made by the benchmarked code
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++allocation_count;
+    std::size_t a = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+struct record {
+    std::int64_t timestamp;
+    std::string_view level;
+    std::string component;
+    std::uint32_t request;
+    double latency_ms;
+};
+
+std::vector<record> make_records(std::size_t n) {
+    static constexpr std::string_view levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+    bench::rng r(11);
+    std::vector<record> out;
+    for (std::size_t i = 0; i < n; ++i) {
+        out.push_back({static_cast<std::int64_t>(1'700'000'000'000 + r.below(1'000'000'000)), levels[r.below(4)],
+                       "svc.http.handler" + std::to_string(r.below(16)), static_cast<std::uint32_t>(r.below(1u << 31)),
+                       static_cast<double>(r.below(1'000'000)) / 997.0});
+    }
+    return out;
+}
+
+void plain(const std::vector<record>& records, std::size_t calls) {
+    bench::section("plain fields: \"{} {} {}: request {} took {} ms\"");
+    std::size_t mask = records.size() - 1;
+
+    bench::run("std::format", calls, [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            total += std::format("{} {} {}: request {} took {} ms", r.timestamp, r.level, r.component, r.request,
+                                 r.latency_ms).size();
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("std::format_to (reused std::string)", calls, [&] {
+        std::string line;
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            line.clear();
+            std::format_to(std::back_inserter(line), "{} {} {}: request {} took {} ms", r.timestamp, r.level,
+                           r.component, r.request, r.latency_ms);
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("std::format_to (char*)", calls, [&] {
+        char buf[256];
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            char* end = std::format_to(buf, "{} {} {}: request {} took {} ms", r.timestamp, r.level, r.component,
+                                       r.request, r.latency_ms);
+            total += static_cast<std::size_t>(end - buf);
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("std_module::format<F>", calls, [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            total += std_module::format<"{} {} {}: request {} took {} ms">(r.timestamp, r.level, r.component,
+                                                                            r.request, r.latency_ms).size();
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("std_module::format_to<F> (span<char>)", calls, [&] {
+        char buf[256];
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            total += static_cast<std::size_t>(std_module::format_to<"{} {} {}: request {} took {} ms">(
+                std::span<char>(buf), r.timestamp, r.level, r.component, r.request, r.latency_ms).size);
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("std_module::format_to<F> (char*)", calls, [&] {
+        char buf[256];
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            char* end = std_module::format_to<"{} {} {}: request {} took {} ms">(buf, r.timestamp, r.level,
+                                                                                  r.component, r.request,
+                                                                                  r.latency_ms);
+            total += static_cast<std::size_t>(end - buf);
+        }
+        bench::do_not_optimize(total);
+    });
+}
+
+void with_specs(const std::vector<record>& records, std::size_t calls) {
+    bench::section("fields with specs: \"{} {:<5} {:>24} {:08x} {:.3f}\"");
+    std::size_t mask = records.size() - 1;
+
+    bench::run("std::format_to (char*)", calls, [&] {
+        char buf[256];
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            char* end = std::format_to(buf, "{} {:<5} {:>24} {:08x} {:.3f}", r.timestamp, r.level, r.component,
+                                       r.request, r.latency_ms);
+            total += static_cast<std::size_t>(end - buf);
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("std_module::format_to<F> (char*)", calls, [&] {
+        char buf[256];
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            char* end = std_module::format_to<"{} {:<5} {:>24} {:08x} {:.3f}">(buf, r.timestamp, r.level,
+                                                                                 r.component, r.request,
+                                                                                 r.latency_ms);
+            total += static_cast<std::size_t>(end - buf);
+        }
+        bench::do_not_optimize(total);
+    });
+}
+
+// Reports ns/call, then reruns once to count allocations per call
+template <class F>
+void run_counted(const char* name, std::size_t calls, F&& fn) {
+    bench::run(name, calls, fn);
+    std::size_t before = allocation_count;
+    fn();
+    double per_call = static_cast<double>(allocation_count - before) / static_cast<double>(calls);
+    std::string text = std::format("    {:.2f} allocations/call", per_call);
+    bench::note(text);
+}
+
+void sinks(const std::vector<record>& records, std::size_t calls, std::size_t message_size) {
+    bench::section("sink targets: \"{} [{}] {}: {}\", message bytes", message_size);
+    std::size_t mask = records.size() - 1;
+    std::string message(message_size, 'm');
+
+    run_counted("std::format", calls, [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            total += std::format("{} [{}] {}: {}", r.timestamp, r.level, r.component, message).size();
+        }
+        bench::do_not_optimize(total);
+    });
+    run_counted("std::format_to (reused std::string)", calls, [&] {
+        std::string line;
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            line.clear();
+            std::format_to(std::back_inserter(line), "{} [{}] {}: {}", r.timestamp, r.level, r.component, message);
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    });
+    run_counted("std_module::format<F>", calls, [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            total += std_module::format<"{} [{}] {}: {}">(r.timestamp, r.level, r.component, message).size();
+        }
+        bench::do_not_optimize(total);
+    });
+    run_counted("std_module::format_to<F> (new memory_buffer)", calls, [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            std_module::memory_buffer line;
+            std_module::format_to<"{} [{}] {}: {}">(line, r.timestamp, r.level, r.component, message);
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    });
+    run_counted("std_module::format_to<F> (reused buffer)", calls, [&] {
+        std_module::memory_buffer line;
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            line.clear();
+            std_module::format_to<"{} [{}] {}: {}">(line, r.timestamp, r.level, r.component, message);
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    });
+    run_counted("std_module::format_to (runtime, reused)", calls, [&] {
+        std_module::memory_buffer line;
+        std::string_view fmt = "{} [{}] {}: {}";
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            const record& r = records[i & mask];
+            line.clear();
+            std_module::format_to(line, fmt, r.timestamp, r.level, r.component, message);
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.format");
+
+    std::size_t calls = bench::full_run(argc, argv) ? 10'000'000 : 1'000'000;
+    auto records = make_records(1024);
+
+    plain(records, calls);
+    with_specs(records, calls);
+    sinks(records, calls, 40);
+    sinks(records, calls, 1000);
+
+    return 0;
+}
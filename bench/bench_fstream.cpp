@@ -0,0 +1,228 @@
+/**
+ * @file bench_fstream.cpp
+ * @brief Benchmarks for std_module.fstream extensions
+ *
+ * Reads a file of random bytes and checksums it, with:
+ * - std::ifstream::read into a 64 KiB buffer, chunk by chunk
+ * - std::ifstream::read of the whole file into one buffer (up to 1 GB)
+ * - std_module::mapped_file, summing bytes() in place (sequential advice),
+ *   faulting pages in as it goes or all at once (populate)
+ * - std_module::mapped_streambuf under an std::istream, read in 64 KiB
+ *   chunks as the ifstream case is (the same istream code, no file reads)
+ *
+ * Results are per 4 KiB page and in GB/s, with the page cache warm (the
+ * file was just written, and every case runs three times): this is the
+ * copying and system call overhead of each way in, not disk speed.
+ *
+ * Then writes a checkpoint-like file as 64-byte and as 64 KiB records,
+ * with:
+ * - std::ofstream::write with its default buffer
+ * - std::ofstream::write after pubsetbuf() of 1 MiB
+ * - std_module::fast_ofstream (1 MiB aligned buffer)
+ * - std_module::fast_ofstream with O_DIRECT, where the file system
+ *   allows it (these numbers are the device's, not the page cache's)
+ *
+ * Results are per record and in GB/s; the file is closed inside the
+ * measurement, but not fsync()ed. Writing to the page cache costs about
+ * as much as the stream layer does, so the stream layer alone is also
+ * measured, writing 64-byte records to /dev/null through ostream::write
+ * and through the streambuf's sputn().
+ *
+ * Default is 1 MB, 16 MB and 256 MB files to read and a 256 MB file to
+ * write; pass --full to add 1 GB and 10 GB reads and write 4 GB (files
+ * go to temp_directory_path()).
+ */
+
+import std_module.fstream;
+import std_module.filesystem;
+import std_module.format;
+import std_module.ios;
+import std_module.istream;
+import std_module.ostream;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr std::size_t chunk = 64 * 1024;
+
+/// Sum of the data as 64-bit words, so every byte is touched at close to memory speed
+std::uint64_t checksum(const void* data, std::size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    std::uint64_t sum = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        sum += word;
+    }
+    for (; i < size; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+void generate(const fs::path& file, std::size_t size) {
+    std::vector<std::uint64_t> block(chunk / 8);
+    bench::rng rng;
+    std::ofstream out(file, std::ios_base::binary);
+    for (std::size_t written = 0; written < size; written += chunk) {
+        for (auto& word : block) {
+            word = rng.next();
+        }
+        std::size_t n = size - written < chunk ? size - written : chunk;
+        out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(n));
+    }
+}
+
+void read(const fs::path& file, std::size_t size) {
+    std::size_t pages = (size + 4095) / 4096;
+    double bytes = static_cast<double>(size);
+    auto report = [&](const bench::result& r) {
+        bench::note(std::format("    {:.2f} GB/s", bytes / (r.ns_per_op * static_cast<double>(pages))));
+    };
+
+    std::vector<char> buffer(chunk);
+    report(bench::run("ifstream::read, 64 KiB chunks", pages, [&] {
+        std::ifstream in(file, std::ios_base::binary);
+        std::uint64_t sum = 0;
+        while (in.read(buffer.data(), chunk) || in.gcount() != 0) {
+            sum += checksum(buffer.data(), static_cast<std::size_t>(in.gcount()));
+        }
+        bench::do_not_optimize(sum);
+    }));
+
+    if (size <= (std::size_t{1} << 30)) {
+        report(bench::run("ifstream::read, whole file", pages, [&] {
+            std::ifstream in(file, std::ios_base::binary);
+            std::vector<char> all(size);
+            in.read(all.data(), static_cast<std::streamsize>(size));
+            bench::do_not_optimize(checksum(all.data(), all.size()));
+        }));
+    }
+
+    report(bench::run("mapped_file", pages, [&] {
+        std_module::mapped_file map(file, {.advice = std_module::map_advice::sequential});
+        bench::do_not_optimize(checksum(map.bytes().data(), map.size()));
+    }));
+
+    report(bench::run("mapped_file, populate", pages, [&] {
+        std_module::mapped_file map(file, {.advice = std_module::map_advice::sequential, .populate = true});
+        bench::do_not_optimize(checksum(map.bytes().data(), map.size()));
+    }));
+
+    report(bench::run("mapped_streambuf + istream::read, 64 KiB", pages, [&] {
+        std_module::mapped_streambuf buf(file);
+        std::istream in(&buf);
+        std::uint64_t sum = 0;
+        while (in.read(buffer.data(), chunk) || in.gcount() != 0) {
+            sum += checksum(buffer.data(), static_cast<std::size_t>(in.gcount()));
+        }
+        bench::do_not_optimize(sum);
+    }));
+}
+
+void write(const fs::path& file, std::size_t size, std::size_t record) {
+    std::vector<char> data(record, 'x');
+    std::size_t records = size / record;
+    bench::section("record bytes", record);
+    auto report = [&](const bench::result& r) {
+        bench::note(std::format("    {:.2f} GB/s", static_cast<double>(record) / r.ns_per_op));
+    };
+    auto fill = [&](std::ostream& out) {
+        for (std::size_t i = 0; i < records; ++i) {
+            out.write(data.data(), static_cast<std::streamsize>(record));
+        }
+    };
+
+    report(bench::run("ofstream::write", records, [&] {
+        std::ofstream out(file, std::ios_base::binary);
+        fill(out);
+    }));
+    std::vector<char> buffer(1 << 20);
+    report(bench::run("ofstream::write, 1 MiB pubsetbuf", records, [&] {
+        std::ofstream out;
+        out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.open(file, std::ios_base::binary);
+        fill(out);
+    }));
+    report(bench::run("fast_ofstream", records, [&] {
+        std_module::fast_ofstream out(file);
+        fill(out);
+    }));
+    bool direct = false;
+    report(bench::run("fast_ofstream, direct", records, [&] {
+        std_module::fast_ofstream out(file, std::ios_base::out, {.direct = true});
+        direct = out.rdbuf()->direct();
+        fill(out);
+    }));
+    if (!direct) {
+        bench::note("    (O_DIRECT refused by the file system: ordinary writes)");
+    }
+}
+
+void stream_layer(std::size_t records) {
+    fs::path null = "/dev/null";
+    if (!fs::exists(null)) {
+        return;
+    }
+    char record[64] = {};
+    bench::section("stream layer only (/dev/null), 64-byte records", records);
+    bench::run("ofstream::write", records, [&] {
+        std::ofstream out(null, std::ios_base::binary);
+        for (std::size_t i = 0; i < records; ++i) {
+            out.write(record, sizeof record);
+        }
+    });
+    bench::run("fast_ofstream::write", records, [&] {
+        std_module::fast_ofstream out(null);
+        for (std::size_t i = 0; i < records; ++i) {
+            out.write(record, sizeof record);
+        }
+    });
+    bench::run("filebuf::sputn", records, [&] {
+        std::ofstream out(null, std::ios_base::binary);
+        for (std::size_t i = 0; i < records; ++i) {
+            out.rdbuf()->sputn(record, sizeof record);
+        }
+    });
+    bench::run("fast_filebuf::sputn", records, [&] {
+        std_module::fast_ofstream out(null);
+        for (std::size_t i = 0; i < records; ++i) {
+            out.rdbuf()->sputn(record, sizeof record);
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.fstream");
+
+    std::vector<std::size_t> sizes = {std::size_t{1} << 20, std::size_t{16} << 20, std::size_t{256} << 20};
+    if (bench::full_run(argc, argv)) {
+        sizes.push_back(std::size_t{1} << 30);
+        sizes.push_back(std::size_t{10} << 30);
+    }
+
+    fs::path file = fs::temp_directory_path() / "std_module_bench_fstream.bin";
+    for (std::size_t size : sizes) {
+        generate(file, size);
+        bench::section("bytes", size);
+        read(file, size);
+    }
+
+    std::size_t output = bench::full_run(argc, argv) ? std::size_t{4} << 30 : std::size_t{256} << 20;
+    bench::section("bytes written", output);
+    write(file, output, 64);
+    write(file, output, 64 * 1024);
+    stream_layer(output / 64);
+    fs::remove(file);
+
+    return 0;
+}
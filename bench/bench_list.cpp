@@ -0,0 +1,158 @@
+/**
+ * @file bench_list.cpp
+ * @brief Benchmarks for std_module.list / std_module.forward_list extensions
+ *
+ * An LRU cache (lookup; on hit move to front, on miss insert and evict the
+ * least recently used entry) built three ways:
+ * - std::list + std::unordered_map with the default allocator
+ * - the same containers on std_module::node_pool_allocator
+ * - std_module::intrusive_list for recency plus std_module::intrusive_slist
+ *   hash chains, over entries preallocated in one array (no allocation
+ *   after construction)
+ *
+ * Keys are drawn from twice the capacity with a hot set, giving a mix of
+ * hits and misses. Default capacity is 10^5; pass --full for 10^6.
+ */
+
+import std_module.list;
+import std_module.forward_list;
+import std_module.memory;
+import std_module.bit;
+import std_module.functional;
+import std_module.unordered_map;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using key_type = std::uint64_t;
+using value_type = std::uint64_t;
+
+template <template <class> class Alloc>
+class std_lru {
+    struct entry {
+        key_type key;
+        value_type value;
+    };
+
+    using list_type = std::list<entry, Alloc<entry>>;
+    using map_value = typename std::unordered_map<key_type, typename list_type::iterator>::value_type;
+    using map_type = std::unordered_map<key_type, typename list_type::iterator, std::hash<key_type>,
+                                        std::equal_to<key_type>, Alloc<map_value>>;
+
+public:
+    explicit std_lru(std::size_t capacity) : capacity_(capacity) { map_.reserve(capacity); }
+
+    value_type get_or_put(key_type key) {
+        auto it = map_.find(key);
+        if (it != map_.end()) {
+            list_.splice(list_.begin(), list_, it->second);
+            return it->second->value;
+        }
+        if (map_.size() == capacity_) {
+            map_.erase(list_.back().key);
+            list_.pop_back();
+        }
+        list_.push_front(entry{key, key * 3});
+        map_.emplace(key, list_.begin());
+        return key * 3;
+    }
+
+private:
+    std::size_t capacity_;
+    list_type list_;
+    map_type map_;
+};
+
+template <class T>
+using default_alloc = std::allocator<T>;
+
+template <class T>
+using pool_alloc = std_module::node_pool_allocator<T>;
+
+class intrusive_lru {
+    struct entry : std_module::list_hook<>, std_module::slist_hook<> {
+        key_type key = 0;
+        value_type value = 0;
+    };
+
+    using bucket = std_module::intrusive_slist<entry>;
+
+public:
+    explicit intrusive_lru(std::size_t capacity)
+        : entries_(capacity), buckets_(std::bit_ceil(capacity)), mask_(buckets_.size() - 1) {}
+
+    value_type get_or_put(key_type key) {
+        bucket& b = buckets_[slot(key)];
+        for (entry& e : b) {
+            if (e.key == key) {
+                recency_.splice(recency_.begin(), recency_, recency_.iterator_to(e));
+                return e.value;
+            }
+        }
+        entry* e;
+        if (used_ < entries_.size()) {
+            e = &entries_[used_++];
+        } else {
+            e = &recency_.back();
+            recency_.pop_back();
+            buckets_[slot(e->key)].remove(*e);
+        }
+        e->key = key;
+        e->value = key * 3;
+        recency_.push_front(*e);
+        b.push_front(*e);
+        return e->value;
+    }
+
+private:
+    std::size_t slot(key_type key) const {
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 20) & mask_;
+    }
+
+    std::vector<entry> entries_;
+    std::vector<bucket> buckets_;
+    std::size_t mask_;
+    std::size_t used_ = 0;
+    std_module::intrusive_list<entry> recency_;
+};
+
+std::vector<key_type> workload(std::size_t capacity, std::size_t ops) {
+    // 80% of lookups go to a hot set of half the capacity
+    bench::rng r(7);
+    std::vector<key_type> keys(ops);
+    for (auto& k : keys) {
+        k = r.below(10) < 8 ? r.below(capacity / 2) : r.below(capacity * 2);
+    }
+    return keys;
+}
+
+template <class Cache>
+void run_lru(const char* name, std::size_t capacity, const std::vector<key_type>& keys) {
+    bench::run(name, keys.size(), [&] {
+        Cache cache(capacity);
+        value_type sum = 0;
+        for (key_type k : keys) {
+            sum += cache.get_or_put(k);
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.list / std_module.forward_list");
+
+    std::size_t capacity = bench::full_run(argc, argv) ? 1'000'000 : 100'000;
+    auto keys = workload(capacity, capacity * 4);
+
+    bench::section("LRU cache, capacity", capacity);
+    run_lru<std_lru<default_alloc>>("std::list + unordered_map", capacity, keys);
+    run_lru<std_lru<pool_alloc>>("std::list + unordered_map (node_pool)", capacity, keys);
+    run_lru<intrusive_lru>("intrusive_list + intrusive_slist", capacity, keys);
+
+    return 0;
+}
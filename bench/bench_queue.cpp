@@ -0,0 +1,309 @@
+/**
+ * @file bench_queue.cpp
+ * @brief Benchmarks for std_module.queue extensions
+ *
+ * Compares std::priority_queue against std_module::dary_heap (several
+ * arities), std_module::mutable_dary_heap, std_module::indexed_priority_queue
+ * and std_module::radix_heap on:
+ * - fill/drain: push n random keys, then pop them all
+ * - hold: steady-state queue of n timers, each op pops the earliest deadline
+ *   and re-arms it a random delay later (timer wheel / event simulation)
+ *
+ * Compares a mutex-protected std::queue against std_module::spsc_queue and
+ * std_module::mpmc_queue (try_ and blocking operations) on:
+ * - throughput: t producers and t consumers moving a fixed number of items
+ * - latency: paced producers stamp each item, consumers record the
+ *   enqueue-to-dequeue delay
+ *
+ * Default sizes are 10^4..10^6 elements and 1..8 threads per side; pass
+ * --full for 10^7 elements and 1..64 threads.
+ */
+
+import std_module.queue;
+import std_module.atomic;
+import std_module.chrono;
+import std_module.functional;
+import std_module.mutex;
+import std_module.thread;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using key = std::uint64_t;
+using min_order = std::greater<key>;
+
+std::vector<key> random_keys(std::size_t n, std::uint64_t seed) {
+    bench::rng r(seed);
+    std::vector<key> keys(n);
+    for (auto& k : keys) {
+        k = r.below(1ull << 40);
+    }
+    return keys;
+}
+
+template <class Queue>
+void fill_drain(const char* name, const std::vector<key>& keys) {
+    bench::run(name, keys.size() * 2, [&] {
+        Queue q;
+        for (key k : keys) {
+            q.push(k);
+        }
+        key sum = 0;
+        while (!q.empty()) {
+            sum += q.top();
+            q.pop();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+template <class Queue>
+void hold(const char* name, const std::vector<key>& keys, std::size_t ops) {
+    Queue q;
+    for (key k : keys) {
+        q.push(k);
+    }
+    bench::rng r(42);
+    bench::run(name, ops, [&] {
+        for (std::size_t i = 0; i < ops; ++i) {
+            key now = q.top();
+            q.pop();
+            q.push(now + 1 + r.below(1u << 20));
+        }
+        bench::do_not_optimize(q.top());
+    }, 1);
+}
+
+void hold_indexed(const char* name, const std::vector<key>& keys, std::size_t ops) {
+    // Re-arming in place via update() instead of pop + push
+    std_module::indexed_priority_queue<key, 4, min_order> q;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        q.push(i, keys[i]);
+    }
+    bench::rng r(42);
+    bench::run(name, ops, [&] {
+        for (std::size_t i = 0; i < ops; ++i) {
+            q.update(q.top_index(), q.top() + 1 + r.below(1u << 20));
+        }
+        bench::do_not_optimize(q.top());
+    }, 1);
+}
+
+// ---- Concurrent queues ----
+
+constexpr std::size_t queue_capacity = 1024;
+
+// Unbounded std::queue behind a mutex, with the try_ interface of the
+// lock-free queues so the same drivers can run it.
+template <class T>
+class locked_queue {
+public:
+    explicit locked_queue(std::size_t) {}
+
+    bool try_push(const T& v) {
+        std::lock_guard<std::mutex> lock(m_);
+        q_.push(v);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        std::lock_guard<std::mutex> lock(m_);
+        if (q_.empty()) {
+            return false;
+        }
+        out = q_.front();
+        q_.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_;
+    std::queue<T> q_;
+};
+
+// Spin on try_ operations, yielding between failed attempts.
+struct try_ops {
+    template <class Q, class T>
+    static void push(Q& q, const T& v) {
+        while (!q.try_push(v)) {
+            std::this_thread::yield();
+        }
+    }
+
+    template <class Q, class T>
+    static void pop(Q& q, T& out) {
+        while (!q.try_pop(out)) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+// Sleep in std::atomic::wait when full/empty.
+struct blocking_ops {
+    template <class Q, class T>
+    static void push(Q& q, const T& v) { q.push(v); }
+
+    template <class Q, class T>
+    static void pop(Q& q, T& out) { out = q.pop(); }
+};
+
+// Items are split evenly between producers and between consumers.
+template <class Queue, class Ops>
+void throughput(const char* name, std::size_t threads, std::size_t items) {
+    std::size_t per_thread = items / threads;
+    bench::run(name, per_thread * threads, [&] {
+        Queue q(queue_capacity);
+        std::atomic<std::uint64_t> total{0};
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    Ops::push(q, static_cast<std::uint64_t>(i));
+                }
+            });
+            workers.emplace_back([&] {
+                std::uint64_t sum = 0;
+                std::uint64_t v = 0;
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    Ops::pop(q, v);
+                    sum += v;
+                }
+                total += sum;
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        bench::do_not_optimize(total.load());
+    }, 1);
+}
+
+void spsc_bulk_throughput(std::size_t items) {
+    bench::run("spsc_queue (bulk 32)", items, [&] {
+        std_module::spsc_queue<std::uint64_t> q(queue_capacity);
+        std::thread producer([&] {
+            std::uint64_t buf[32];
+            for (std::size_t i = 0; i < items;) {
+                std::size_t n = items - i < 32 ? items - i : 32;
+                for (std::size_t k = 0; k < n; ++k) {
+                    buf[k] = i + k;
+                }
+                q.push_bulk(buf, n);
+                i += n;
+            }
+        });
+        std::uint64_t buf[32];
+        std::uint64_t sum = 0;
+        for (std::size_t got = 0; got < items;) {
+            std::size_t n = q.pop_bulk(buf, 32);
+            for (std::size_t k = 0; k < n; ++k) {
+                sum += buf[k];
+            }
+            got += n;
+        }
+        producer.join();
+        bench::do_not_optimize(sum);
+    }, 1);
+}
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               bench::clock::now().time_since_epoch()).count();
+}
+
+// Each producer sends @p samples timestamps, one every @p gap_ns.
+template <class Queue, class Ops>
+void latency(const char* name, std::size_t threads, std::size_t samples, std::int64_t gap_ns) {
+    Queue q(queue_capacity);
+    std::vector<std::vector<double>> per_consumer(threads);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            std::int64_t next = now_ns();
+            for (std::size_t i = 0; i < samples; ++i) {
+                while (now_ns() < next) {
+                }
+                Ops::push(q, now_ns());
+                next += gap_ns;
+            }
+        });
+        workers.emplace_back([&, t] {
+            auto& out = per_consumer[t];
+            out.reserve(samples);
+            std::int64_t stamp = 0;
+            for (std::size_t i = 0; i < samples; ++i) {
+                Ops::pop(q, stamp);
+                out.push_back(static_cast<double>(now_ns() - stamp));
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    std::vector<double> all;
+    for (auto& v : per_consumer) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    bench::report_percentiles(name, all);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.queue");
+
+    std::size_t max_n = bench::full_run(argc, argv) ? 10'000'000 : 1'000'000;
+
+    for (std::size_t n = 10'000; n <= max_n; n *= 10) {
+        auto keys = random_keys(n, n);
+
+        bench::section("fill/drain, n", n);
+        fill_drain<std::priority_queue<key, std::vector<key>, min_order>>("std::priority_queue", keys);
+        fill_drain<std_module::dary_heap<key, 2, std::vector<key>, min_order>>("dary_heap<2>", keys);
+        fill_drain<std_module::dary_heap<key, 4, std::vector<key>, min_order>>("dary_heap<4>", keys);
+        fill_drain<std_module::dary_heap<key, 8, std::vector<key>, min_order>>("dary_heap<8>", keys);
+        fill_drain<std_module::radix_heap<key>>("radix_heap", keys);
+
+        std::size_t ops = n < 1'000'000 ? 1'000'000 : n;
+        bench::section("hold (pop + re-arm), n", n);
+        hold<std::priority_queue<key, std::vector<key>, min_order>>("std::priority_queue", keys, ops);
+        hold<std_module::dary_heap<key, 2, std::vector<key>, min_order>>("dary_heap<2>", keys, ops);
+        hold<std_module::dary_heap<key, 4, std::vector<key>, min_order>>("dary_heap<4>", keys, ops);
+        hold<std_module::dary_heap<key, 8, std::vector<key>, min_order>>("dary_heap<8>", keys, ops);
+        hold<std_module::mutable_dary_heap<key, 4, min_order>>("mutable_dary_heap<4>", keys, ops);
+        hold_indexed("indexed_priority_queue<4> (update)", keys, ops);
+        hold<std_module::radix_heap<key>>("radix_heap", keys, ops);
+    }
+
+    std::size_t max_threads = bench::full_run(argc, argv) ? 64 : 8;
+    std::size_t items = 1u << 20;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("throughput, producers = consumers", threads);
+        throughput<locked_queue<std::uint64_t>, try_ops>("mutex + std::queue", threads, items);
+        throughput<std_module::mpmc_queue<std::uint64_t>, try_ops>("mpmc_queue (try_)", threads, items);
+        throughput<std_module::mpmc_queue<std::uint64_t>, blocking_ops>("mpmc_queue (blocking)", threads, items);
+        if (threads == 1) {
+            throughput<std_module::spsc_queue<std::uint64_t>, try_ops>("spsc_queue (try_)", 1, items);
+            throughput<std_module::spsc_queue<std::uint64_t>, blocking_ops>("spsc_queue (blocking)", 1, items);
+            spsc_bulk_throughput(items);
+        }
+    }
+
+    std::size_t samples = 20'000;
+    std::int64_t gap_ns = 2'000;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("latency (1 item / 2 us per producer), producers = consumers", threads);
+        latency<locked_queue<std::int64_t>, try_ops>("mutex + std::queue", threads, samples, gap_ns);
+        latency<std_module::mpmc_queue<std::int64_t>, try_ops>("mpmc_queue (try_)", threads, samples, gap_ns);
+        latency<std_module::mpmc_queue<std::int64_t>, blocking_ops>("mpmc_queue (blocking)", threads, samples, gap_ns);
+        if (threads == 1) {
+            latency<std_module::spsc_queue<std::int64_t>, try_ops>("spsc_queue (try_)", 1, samples, gap_ns);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file bench_random.cpp
+ * @brief Benchmarks for std_module.random extensions
+ *
+ * Compares the std engines (mt19937_64 above all, plus mt19937 and
+ * minstd_rand) against std_module's xoshiro256starstar, xoshiro128plus,
+ * pcg32, pcg64, wyrand and the counter-based philox4x32, philox4x64 and
+ * threefry4x64:
+ * - raw draws: the engine alone, reported per draw and as output bytes
+ *   per second
+ * - through the std distributions: uniform_real_distribution<double>,
+ *   uniform_int_distribution<int>(0, 999) and normal_distribution<double>
+ *
+ * Then compares filling a 4096-value buffer one std distribution call at a
+ * time against the batch generate() of fast_uniform_real_distribution
+ * (double and float), fast_uniform_int_distribution,
+ * ziggurat_normal_distribution and ziggurat_exponential_distribution, fed
+ * by std::mt19937_64, xoshiro256starstar and the 8-lane
+ * xoshiro256starstar_x8 (raw draws included).
+ *
+ * For parallel streams, measures per-task stream setup (seeding
+ * mt19937_64 from std::random_device against positioning a counter
+ * engine with stream_partition::item_engine) and the scaling of a
+ * stream_partition fill over 1, 2, 4 and 8 threads, checking that every
+ * thread count produces the same checksum.
+ *
+ * Default is 10^7 draws per case; pass --full for 10^8.
+ *
+ * For full statistical testing, --stdout <engine> writes the raw output of
+ * one engine (xoshiro256, xoshiro128, pcg32, pcg64, wyrand, philox4x32,
+ * philox4x64, threefry4x64 or mt19937_64) to stdout without end, for
+ * example:
+ *
+ *     bench_random --stdout pcg64 | RNG_test stdin64
+ */
+
+import std_module.random;
+import std_module.format;
+import std_module.iostream;
+import std_module.span;
+import std_module.string_view;
+import std_module.thread;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+template <class Engine>
+void raw(const char* name, std::size_t n) {
+    Engine engine;
+    auto r = bench::run(name, n, [&] {
+        typename Engine::result_type sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum ^= engine();
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::note(std::format("    {:.2f} GB/s", static_cast<double>(sizeof(typename Engine::result_type)) / r.ns_per_op));
+}
+
+template <class Engine, class Distribution>
+void distributed(const char* name, std::size_t n, Distribution d) {
+    Engine engine;
+    bench::run(name, n, [&] {
+        typename Distribution::result_type sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += d(engine);
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+template <class Distribution>
+void all_engines(const char* title, std::size_t n, Distribution d) {
+    bench::section(std::format("{}, draws", title), n);
+    distributed<std::mt19937_64>("std::mt19937_64", n, d);
+    distributed<std::mt19937>("std::mt19937", n, d);
+    distributed<std_module::xoshiro256starstar>("xoshiro256starstar", n, d);
+    distributed<std_module::xoshiro128plus>("xoshiro128plus", n, d);
+    distributed<std_module::pcg32>("pcg32", n, d);
+    distributed<std_module::pcg64>("pcg64", n, d);
+    distributed<std_module::wyrand>("wyrand", n, d);
+    distributed<std_module::philox4x64>("philox4x64", n, d);
+}
+
+// Buffer filled per generate() call: fits in L1, like a simulation's work block
+constexpr std::size_t block = 4096;
+
+template <class Engine, class Distribution>
+void looped(const char* name, std::size_t n, Distribution d) {
+    Engine engine;
+    std::vector<typename Distribution::result_type> buf(block);
+    bench::run(name, n, [&] {
+        for (std::size_t i = 0; i < n; i += block) {
+            for (auto& v : buf) {
+                v = d(engine);
+            }
+            bench::do_not_optimize(buf.data());
+        }
+    });
+}
+
+template <class Engine, class Distribution>
+void batched(const char* name, std::size_t n, Distribution d) {
+    Engine engine;
+    std::vector<typename Distribution::result_type> buf(block);
+    bench::run(name, n, [&] {
+        for (std::size_t i = 0; i < n; i += block) {
+            d.generate(engine, std::span(buf));
+            bench::do_not_optimize(buf.data());
+        }
+    });
+}
+
+template <class StdDistribution, class Distribution>
+void batch_case(const char* title, std::size_t n, StdDistribution std_d, Distribution d) {
+    bench::section(std::format("{}, values", title), n);
+    looped<std::mt19937_64>("std:: loop, std::mt19937_64", n, std_d);
+    looped<std_module::xoshiro256starstar>("std:: loop, xoshiro256starstar", n, std_d);
+    batched<std::mt19937_64>("generate, std::mt19937_64", n, d);
+    batched<std_module::xoshiro256starstar>("generate, xoshiro256starstar", n, d);
+    batched<std_module::xoshiro256starstar_x8>("generate, xoshiro256starstar_x8", n, d);
+}
+
+void raw_batch(std::size_t n) {
+    bench::section("raw draws into a buffer, draws", n);
+    std::vector<std::uint64_t> buf(block);
+    std_module::xoshiro256starstar scalar;
+    bench::run("xoshiro256starstar loop", n, [&] {
+        for (std::size_t i = 0; i < n; i += block) {
+            for (auto& v : buf) {
+                v = scalar();
+            }
+            bench::do_not_optimize(buf.data());
+        }
+    });
+    std_module::xoshiro256starstar_x8 lanes;
+    auto r = bench::run("xoshiro256starstar_x8 generate", n, [&] {
+        for (std::size_t i = 0; i < n; i += block) {
+            lanes.generate(std::span(buf));
+            bench::do_not_optimize(buf.data());
+        }
+    });
+    bench::note(std::format("    {:.2f} GB/s", 8.0 / r.ns_per_op));
+}
+
+template <class Setup>
+void setup(const char* name, std::size_t tasks, Setup make) {
+    bench::run(name, tasks, [&] {
+        unsigned long long sum = 0;
+        for (std::size_t task = 0; task < tasks; ++task) {
+            auto engine = make(task);
+            sum += engine();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void stream_setup(std::size_t tasks) {
+    bench::section("per-task stream setup and first draw, tasks", tasks);
+    std::random_device device;
+    setup("std::mt19937_64(random_device())", tasks, [&](std::size_t) { return std::mt19937_64(device()); });
+    setup("std::mt19937_64(seed_seq of 8 random_device words)", tasks, [&](std::size_t) {
+        std::seed_seq seq{device(), device(), device(), device(), device(), device(), device(), device()};
+        return std::mt19937_64(seq);
+    });
+    std_module::stream_partition<std_module::philox4x64> philox({}, tasks, 1, 1'000'000);
+    setup("philox4x64 item_engine", tasks, [&](std::size_t task) { return philox.item_engine(task); });
+    std_module::stream_partition<std_module::threefry4x64> threefry({}, tasks, 1, 1'000'000);
+    setup("threefry4x64 item_engine", tasks, [&](std::size_t task) { return threefry.item_engine(task); });
+}
+
+template <class Engine>
+void parallel(const char* name, std::size_t n) {
+    bench::section(std::format("{} stream_partition fill, draws", name), n);
+    unsigned long long reference = 0;
+    bool same = true;
+    for (std::size_t threads : {1, 2, 4, 8}) {
+        // One item per 4096 draws, so the work splits evenly
+        std_module::stream_partition<Engine> partition({}, n / block, threads, block);
+        std::vector<unsigned long long> sums(threads);
+        bench::run(std::format("{} thread(s)", threads), n, [&] {
+            std::vector<std::thread> workers;
+            for (std::size_t part = 0; part < threads; ++part) {
+                workers.emplace_back([&, part] {
+                    Engine engine = partition.engine(part);
+                    std::vector<typename Engine::result_type> buf(block);
+                    unsigned long long sum = 0;
+                    for (std::size_t item = 0; item < partition.range(part).size(); ++item) {
+                        engine.generate(std::span(buf));
+                        for (auto v : buf) {
+                            sum += v;
+                        }
+                    }
+                    sums[part] = sum;
+                });
+            }
+            for (std::thread& w : workers) {
+                w.join();
+            }
+        });
+        unsigned long long total = 0;
+        for (unsigned long long s : sums) {
+            total += s;
+        }
+        if (threads == 1) {
+            reference = total;
+        }
+        same = same && total == reference;
+    }
+    bench::note(same ? "    same checksum on every thread count" : "    CHECKSUM MISMATCH between thread counts");
+}
+
+template <class Engine>
+int stream() {
+    Engine engine;
+    typename Engine::result_type block[4096];
+    for (;;) {
+        for (auto& v : block) {
+            v = engine();
+        }
+        if (!std::cout.write(reinterpret_cast<const char*>(block), sizeof block)) {
+            return 0;  // reader went away
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string_view(argv[1]) == "--stdout") {
+        std::string_view engine = argv[2];
+        if (engine == "xoshiro256") {
+            return stream<std_module::xoshiro256starstar>();
+        }
+        if (engine == "xoshiro128") {
+            return stream<std_module::xoshiro128plus>();
+        }
+        if (engine == "pcg32") {
+            return stream<std_module::pcg32>();
+        }
+        if (engine == "pcg64") {
+            return stream<std_module::pcg64>();
+        }
+        if (engine == "wyrand") {
+            return stream<std_module::wyrand>();
+        }
+        if (engine == "philox4x32") {
+            return stream<std_module::philox4x32>();
+        }
+        if (engine == "philox4x64") {
+            return stream<std_module::philox4x64>();
+        }
+        if (engine == "threefry4x64") {
+            return stream<std_module::threefry4x64>();
+        }
+        if (engine == "mt19937_64") {
+            return stream<std::mt19937_64>();
+        }
+        std::cerr << "unknown engine " << engine << "\n";
+        return 1;
+    }
+
+    bench::header("std_module.random");
+
+    std::size_t n = bench::full_run(argc, argv) ? 100'000'000 : 10'000'000;
+
+    bench::section("raw draws", n);
+    raw<std::mt19937_64>("std::mt19937_64", n);
+    raw<std::mt19937>("std::mt19937", n);
+    raw<std::minstd_rand>("std::minstd_rand", n);
+    raw<std_module::xoshiro256starstar>("xoshiro256starstar", n);
+    raw<std_module::xoshiro128plus>("xoshiro128plus", n);
+    raw<std_module::pcg32>("pcg32", n);
+    raw<std_module::pcg64>("pcg64", n);
+    raw<std_module::wyrand>("wyrand", n);
+    raw<std_module::philox4x32>("philox4x32", n);
+    raw<std_module::philox4x64>("philox4x64", n);
+    raw<std_module::threefry4x64>("threefry4x64", n);
+
+    all_engines("uniform_real_distribution<double>(0, 1)", n, std::uniform_real_distribution<double>(0.0, 1.0));
+    all_engines("uniform_int_distribution<int>(0, 999)", n, std::uniform_int_distribution<int>(0, 999));
+    all_engines("normal_distribution<double>(0, 1)", n, std::normal_distribution<double>(0.0, 1.0));
+
+    raw_batch(n);
+    batch_case("uniform real double [0, 1)", n, std::uniform_real_distribution<double>(0.0, 1.0),
+               std_module::fast_uniform_real_distribution<double>(0.0, 1.0));
+    batch_case("uniform real float [0, 1)", n, std::uniform_real_distribution<float>(0.0f, 1.0f),
+               std_module::fast_uniform_real_distribution<float>(0.0f, 1.0f));
+    batch_case("uniform int [0, 999]", n, std::uniform_int_distribution<int>(0, 999),
+               std_module::fast_uniform_int_distribution<int>(0, 999));
+    batch_case("normal double (0, 1)", n, std::normal_distribution<double>(0.0, 1.0),
+               std_module::ziggurat_normal_distribution<double>(0.0, 1.0));
+    batch_case("exponential double (1)", n, std::exponential_distribution<double>(1.0),
+               std_module::ziggurat_exponential_distribution<double>(1.0));
+
+    stream_setup(n / 100);
+    parallel<std_module::philox4x64>("philox4x64", n * 10);
+    parallel<std_module::threefry4x64>("threefry4x64", n * 10);
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file bench_regex.cpp
+ * @brief Benchmarks for std_module.regex extensions
+ *
+ * Compares std::regex against std_module::dfa_regex on generated access
+ * logs (about 110 bytes per line: timestamp, level, worker, request,
+ * status, latency, user, client address), for typical filters:
+ * - literal: ERROR
+ * - digits: timeout after \d+ms
+ * - alternation: (GET|POST) /api/v\d+/users/\d+ 5\d\d
+ * - anchored, with a capture: ^\S+ (WARN|ERROR) +\[worker-(\d+)\]
+ * - address: \b10\.0\.\d{1,3}\.\d{1,3}\b
+ *
+ * Each filter runs regex_search on every line and counts the matching
+ * ones (the grep use case); results are per line and as input bytes per
+ * second. A second group extracts every latency with ([0-9]+)ms from the
+ * whole buffer, std::cregex_iterator against dfa_regex_iterator.
+ *
+ * Each filter also runs as a compile-time pattern (std_module::search
+ * with the pattern as a template argument), and the extraction as a
+ * std_module::captures loop. The cost of constructing the five filter
+ * patterns, which std::regex and dfa_regex pay at every startup and the
+ * compile-time patterns do not, is measured first.
+ *
+ * Last, the per-request latency of a service that receives a filter with
+ * every request and runs it over one log line: constructing std::regex
+ * each time, against std_module::regex_cache, at 50%, 90% and 99% of
+ * requests reusing one of 64 common filters (the others are one-off).
+ *
+ * Default is 8 MB of log text and 20000 requests; pass --full for 1 GB
+ * (std::regex then needs minutes per filter, so every case runs once) and
+ * 200000 requests.
+ */
+
+import std_module.regex;
+import std_module.chrono;
+import std_module.format;
+import std_module.string;
+import std_module.string_view;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+std::string make_log(std::size_t bytes) {
+    static const char* const users[] = {"alice", "bob", "carol", "dave", "erin", "frank"};
+    static const char* const paths[] = {"/api/v1/users/", "/api/v2/users/", "/api/v2/orders/", "/static/app.js?v=",
+                                        "/health?probe="};
+    bench::rng r(1);
+    std::string out;
+    out.reserve(bytes + 256);
+    std::uint64_t ms = 0;
+    while (out.size() < bytes) {
+        ms += r.below(50);
+        std::uint64_t roll = r.below(1000);
+        const char* level = roll < 30 ? "ERROR" : roll < 100 ? "WARN " : "INFO ";
+        const char* method = r.below(4) == 0 ? "POST" : r.below(8) == 0 ? "DELETE" : "GET";
+        std::uint64_t status = roll < 30 ? 500 + r.below(4) : r.below(20) == 0 ? 404 : 200;
+        out += std::format("2024-05-17T{:02}:{:02}:{:02}.{:03}Z {} [worker-{}] {} {}{} {} {}ms user={} ip={}.{}.{}.{}",
+                           ms / 3'600'000 % 24, ms / 60'000 % 60, ms / 1000 % 60, ms % 1000, level, r.below(32),
+                           method, paths[r.below(5)], r.below(100000), status, 1 + r.below(300),
+                           users[r.below(6)], r.below(4) == 0 ? 10 : 172, r.below(4) == 0 ? 0 : 16, r.below(256),
+                           r.below(256));
+        if (roll < 15) {
+            out += std::format(" upstream timeout after {}ms", 1000 * (1 + r.below(30)));
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+std::vector<std::string_view> split_lines(const std::string& text) {
+    std::vector<std::string_view> lines;
+    std::size_t start = 0;
+    for (std::size_t nl = text.find('\n'); nl != std::string::npos; nl = text.find('\n', start)) {
+        lines.emplace_back(text.data() + start, nl - start);
+        start = nl + 1;
+    }
+    return lines;
+}
+
+template <std_module::regex_string P>
+void filter(const std::vector<std::string_view>& lines, double bytes, int reps) {
+    const char* pattern = P.data;
+    bench::section(std::format("filter /{}/, lines", pattern), lines.size());
+    std::regex re(pattern);
+    std_module::dfa_regex dre(pattern);
+    std::size_t std_count = 0;
+    std::size_t dfa_count = 0;
+    std::size_t static_count = 0;
+
+    auto base = bench::run("std::regex_search per line", lines.size(), [&] {
+        std_count = 0;
+        for (std::string_view line : lines) {
+            std_count += std::regex_search(line.begin(), line.end(), re) ? 1 : 0;
+        }
+        bench::do_not_optimize(std_count);
+    }, reps);
+    bench::note(std::format("    {:.1f} MB/s", bytes / (base.ns_per_op * static_cast<double>(lines.size())) * 1e3));
+
+    auto fast = bench::run("std_module::regex_search per line", lines.size(), [&] {
+        dfa_count = 0;
+        for (std::string_view line : lines) {
+            dfa_count += std_module::regex_search(line, dre) ? 1 : 0;
+        }
+        bench::do_not_optimize(dfa_count);
+    }, reps);
+    bench::note(std::format("    {:.1f} MB/s, {} matching lines{}", bytes / (fast.ns_per_op * static_cast<double>(lines.size())) * 1e3,
+                            dfa_count, dfa_count == std_count ? "" : " (MISMATCH with std::regex)"));
+
+    auto fixed = bench::run("std_module::search<pattern> per line", lines.size(), [&] {
+        static_count = 0;
+        for (std::string_view line : lines) {
+            static_count += std_module::search<P>(line) ? 1 : 0;
+        }
+        bench::do_not_optimize(static_count);
+    }, reps);
+    bench::note(std::format("    {:.1f} MB/s{}", bytes / (fixed.ns_per_op * static_cast<double>(lines.size())) * 1e3,
+                            static_count == std_count ? "" : " (MISMATCH with std::regex)"));
+}
+
+// Construction cost, paid at every program start for std::regex; the
+// compile-time patterns have none
+void startup() {
+    const char* patterns[] = {"ERROR", R"(timeout after \d+ms)", R"((GET|POST) /api/v\d+/users/\d+ 5\d\d)",
+                              R"(^\S+ (WARN|ERROR) +\[worker-(\d+)\])", R"(\b10\.0\.\d{1,3}\.\d{1,3}\b)"};
+    const std::size_t rounds = 200;
+    bench::section("construct the five filter patterns, patterns", 5 * rounds);
+    bench::run("std::regex", 5 * rounds, [&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            for (const char* p : patterns) {
+                std::regex re(p);
+                bench::do_not_optimize(re.mark_count());
+            }
+        }
+    });
+    bench::run("std_module::dfa_regex", 5 * rounds, [&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            for (const char* p : patterns) {
+                std_module::dfa_regex re(p);
+                bench::do_not_optimize(re.mark_count());
+            }
+        }
+    });
+    bench::note("    std_module::search<pattern>: none, parsed while compiling");
+}
+
+void extract(const std::string& text, int reps) {
+    const char* pattern = "([0-9]+)ms";
+    std::regex re(pattern);
+    std_module::dfa_regex dre(pattern);
+    std::uint64_t std_sum = 0;
+    std::uint64_t dfa_sum = 0;
+    std::size_t matches = 0;
+    std_module::dfa_regex_iterator end;
+    for (std_module::dfa_regex_iterator it(text, dre); it != end; ++it) {
+        ++matches;
+    }
+    bench::section(std::format("extract /{}/ from the whole buffer, matches", pattern), matches);
+
+    auto base = bench::run("std::cregex_iterator", matches, [&] {
+        std_sum = 0;
+        for (std::cregex_iterator it(text.data(), text.data() + text.size(), re), last; it != last; ++it) {
+            std_sum += static_cast<std::uint64_t>((*it)[1].length());
+        }
+        bench::do_not_optimize(std_sum);
+    }, reps);
+    bench::note(std::format("    {:.1f} MB/s", static_cast<double>(text.size()) / (base.ns_per_op * static_cast<double>(matches)) * 1e3));
+
+    auto fast = bench::run("std_module::dfa_regex_iterator", matches, [&] {
+        dfa_sum = 0;
+        for (std_module::dfa_regex_iterator it(text, dre); it != end; ++it) {
+            dfa_sum += static_cast<std::uint64_t>((*it)[1].length());
+        }
+        bench::do_not_optimize(dfa_sum);
+    }, reps);
+    bench::note(std::format("    {:.1f} MB/s{}", static_cast<double>(text.size()) / (fast.ns_per_op * static_cast<double>(matches)) * 1e3,
+                            dfa_sum == std_sum ? "" : " (MISMATCH with std::regex)"));
+
+    std::uint64_t static_sum = 0;
+    auto fixed = bench::run("std_module::captures<pattern> loop", matches, [&] {
+        static_sum = 0;
+        std::string_view rest = text;
+        while (auto m = std_module::captures<"([0-9]+)ms">(rest)) {
+            static_sum += m.length(1);
+            rest.remove_prefix(m.position() + m.length());
+        }
+        bench::do_not_optimize(static_sum);
+    }, reps);
+    bench::note(std::format("    {:.1f} MB/s{}", static_cast<double>(text.size()) / (fixed.ns_per_op * static_cast<double>(matches)) * 1e3,
+                            static_sum == std_sum ? "" : " (MISMATCH with std::regex)"));
+}
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(bench::clock::now().time_since_epoch()).count();
+}
+
+// A service that receives a user filter with every request: get the regex
+// (construct it, or look it up in a regex_cache) and run it over a line
+void requests(const std::vector<std::string_view>& lines, std::size_t count) {
+    static const char* const users[] = {"alice", "bob", "carol", "dave", "erin", "frank"};
+    std::vector<std::string> hot;
+    for (std::size_t i = 0; i < 64; ++i) {
+        hot.push_back(std::format(R"(user={} .*\b5\d\d\b|\[worker-{}\].*timeout)", users[i % 6], i % 32));
+    }
+    for (std::uint64_t percent : {50, 90, 99}) {
+        bench::rng r(percent);
+        std::vector<std::string> filters(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            // Filters seen once, like ad-hoc searches, miss every time
+            filters[i] = r.below(100) < percent ? hot[r.below(hot.size())] : std::format(R"(session={}\b)", i);
+        }
+        bench::section(std::format("per-request latency, {}% repeated filters, requests", percent), count);
+
+        std::vector<double> samples;
+        samples.reserve(count);
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string_view line = lines[i % lines.size()];
+            std::int64_t start = now_ns();
+            std::regex re(filters[i]);
+            found += std::regex_search(line.begin(), line.end(), re) ? 1 : 0;
+            samples.push_back(static_cast<double>(now_ns() - start));
+        }
+        bench::report_percentiles("construct std::regex", samples);
+
+        std_module::regex_cache cache(256);
+        for (const std::string& f : hot) {
+            cache.get(f);
+        }
+        auto warm = cache.stats();
+        samples.clear();
+        std::size_t cached_found = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string_view line = lines[i % lines.size()];
+            std::int64_t start = now_ns();
+            auto re = cache.get(filters[i]);
+            cached_found += std::regex_search(line.begin(), line.end(), *re) ? 1 : 0;
+            samples.push_back(static_cast<double>(now_ns() - start));
+        }
+        bench::report_percentiles("regex_cache (capacity 256)", samples);
+        auto after = cache.stats();
+        bench::note(std::format("    hit ratio {:.1f}%, {} evictions{}",
+                                100.0 * static_cast<double>(after.hits - warm.hits) / static_cast<double>(count),
+                                after.evictions, found == cached_found ? "" : " (MISMATCH)"));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.regex");
+
+    bool full = bench::full_run(argc, argv);
+    std::size_t bytes = full ? std::size_t{1} << 30 : std::size_t{8} << 20;
+    int reps = full ? 1 : 3;
+
+    std::string text = make_log(bytes);
+    std::vector<std::string_view> lines = split_lines(text);
+    double line_bytes = static_cast<double>(text.size());
+
+    startup();
+
+    filter<"ERROR">(lines, line_bytes, reps);
+    filter<R"(timeout after \d+ms)">(lines, line_bytes, reps);
+    filter<R"((GET|POST) /api/v\d+/users/\d+ 5\d\d)">(lines, line_bytes, reps);
+    filter<R"(^\S+ (WARN|ERROR) +\[worker-(\d+)\])">(lines, line_bytes, reps);
+    filter<R"(\b10\.0\.\d{1,3}\.\d{1,3}\b)">(lines, line_bytes, reps);
+
+    extract(text, reps);
+
+    requests(lines, full ? 200'000 : 20'000);
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file bench_stack.cpp
+ * @brief Benchmarks for std_module.stack extensions
+ *
+ * Compares std::stack (over std::deque and std::vector) against
+ * std_module::small_stack (heap-only and with inline capacity) on:
+ * - fill/drain: push n values, then pop them all from one long-lived stack
+ * - short-lived: construct a stack, run a depth-first traversal of a small
+ *   tree with it, destroy it (the typical scratch-stack pattern)
+ *
+ * Compares a mutex-protected std::stack against std_module::treiber_stack
+ * used as a freelist: each thread repeatedly takes a few slots and returns
+ * them.
+ *
+ * Default sizes are 10^3..10^6 elements and 1..8 threads; pass --full for
+ * 10^7 elements and 1..64 threads.
+ */
+
+import std_module.stack;
+import std_module.deque;
+import std_module.mutex;
+import std_module.thread;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using value = std::uint64_t;
+
+template <class Stack>
+void fill_drain(const char* name, std::size_t n) {
+    bench::run(name, n * 2, [&] {
+        Stack s;
+        for (std::size_t i = 0; i < n; ++i) {
+            s.push(i);
+        }
+        value sum = 0;
+        while (!s.empty()) {
+            sum += s.top();
+            s.pop();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+// Depth-first traversal of a complete binary tree of the given height,
+// with a fresh stack per traversal; the stack never holds more than
+// height + 1 entries.
+template <class Stack>
+void short_lived(const char* name, std::size_t height, std::size_t traversals) {
+    std::size_t nodes = (std::size_t{2} << height) - 1;
+    bench::run(name, traversals * nodes * 2, [&] {
+        value sum = 0;
+        for (std::size_t t = 0; t < traversals; ++t) {
+            Stack s;
+            s.push(0);
+            while (!s.empty()) {
+                value depth = s.top();
+                s.pop();
+                sum += depth;
+                if (depth < height) {
+                    s.push(depth + 1);
+                    s.push(depth + 1);
+                }
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+// ---- Concurrent freelist ----
+
+constexpr std::size_t pool_slots = 1024;
+constexpr std::size_t take_per_round = 4;
+
+// std::stack behind a mutex, with the try_ interface of treiber_stack.
+class locked_stack {
+public:
+    explicit locked_stack(std::size_t) {}
+
+    bool try_push(value v) {
+        std::lock_guard<std::mutex> lock(m_);
+        s_.push(v);
+        return true;
+    }
+
+    bool try_pop(value& out) {
+        std::lock_guard<std::mutex> lock(m_);
+        if (s_.empty()) {
+            return false;
+        }
+        out = s_.top();
+        s_.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_;
+    std::stack<value, std::vector<value>> s_;
+};
+
+template <class Stack>
+void freelist(const char* name, std::size_t threads, std::size_t rounds) {
+    Stack pool(pool_slots);
+    for (std::size_t i = 0; i < pool_slots; ++i) {
+        pool.try_push(i);
+    }
+    bench::run(name, threads * rounds * take_per_round * 2, [&] {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                value taken[take_per_round];
+                value sum = 0;
+                for (std::size_t r = 0; r < rounds; ++r) {
+                    std::size_t n = 0;
+                    while (n < take_per_round && pool.try_pop(taken[n])) {
+                        sum += taken[n++];
+                    }
+                    while (n > 0) {
+                        pool.try_push(taken[--n]);
+                    }
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }, 1);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.stack");
+
+    std::size_t max_n = bench::full_run(argc, argv) ? 10'000'000 : 1'000'000;
+
+    for (std::size_t n = 1'000; n <= max_n; n *= 10) {
+        bench::section("fill/drain, n", n);
+        fill_drain<std::stack<value>>("std::stack<deque>", n);
+        fill_drain<std::stack<value, std::vector<value>>>("std::stack<vector>", n);
+        fill_drain<std_module::small_stack<value>>("small_stack<0>", n);
+        fill_drain<std_module::small_stack<value, 64>>("small_stack<64>", n);
+    }
+
+    for (std::size_t height : {3u, 5u, 10u}) {
+        std::size_t traversals = (std::size_t{1} << 22) >> height;
+        bench::section("short-lived (DFS of a binary tree), height", height);
+        short_lived<std::stack<value>>("std::stack<deque>", height, traversals);
+        short_lived<std::stack<value, std::vector<value>>>("std::stack<vector>", height, traversals);
+        short_lived<std_module::small_stack<value>>("small_stack<0>", height, traversals);
+        short_lived<std_module::small_stack<value, 16>>("small_stack<16>", height, traversals);
+    }
+
+    std::size_t max_threads = bench::full_run(argc, argv) ? 64 : 8;
+    std::size_t rounds = 200'000;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("freelist take/return, threads", threads);
+        freelist<locked_stack>("mutex + std::stack<vector>", threads, rounds);
+        freelist<std_module::treiber_stack<value>>("treiber_stack", threads, rounds);
+    }
+
+    return 0;
+}
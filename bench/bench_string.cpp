@@ -0,0 +1,320 @@
+/**
+ * @file bench_string.cpp
+ * @brief Benchmarks for std_module.string extensions
+ *
+ * Uses a dataset of n metric-name-like strings (8..48 bytes) in which 1%
+ * are distinct, and compares:
+ * - memory: one std::string per record against one std::string_view into
+ *   std_module::string_pool, and one 32-bit id into
+ *   std_module::string_interner
+ * - lookup: interning every record through std::unordered_map<std::string,
+ *   std::uint32_t>, string_pool and string_interner (single thread)
+ * - concurrent interning: t threads over disjoint slices of the dataset,
+ *   against the unordered_map behind a std::mutex
+ *
+ * Compares std::string against std_module::rope on documents of 1..100 MB:
+ * - random-position insertion and erasure of 16 bytes
+ * - moving a 64 KiB block to a random position (cut and paste)
+ * - flattening to std::string and streaming to a std::streambuf
+ *
+ * Default sizes are 10^5..10^6 records, 1..8 threads and 1..10 MB
+ * documents; pass --full for 10^7 records, 1..64 threads and 100 MB.
+ */
+
+import std_module.string;
+import std_module.string_view;
+import std_module.streambuf;
+import std_module.mutex;
+import std_module.thread;
+import std_module.unordered_map;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+std::vector<std::string> make_dataset(std::size_t n) {
+    static const char* const parts[] = {"http", "server", "requests", "latency", "bucket",
+                                        "cpu", "user", "system", "disk", "io", "bytes", "sent"};
+    bench::rng r(n);
+    std::size_t unique = n / 100;
+    std::vector<std::string> names;
+    names.reserve(unique);
+    for (std::size_t i = 0; i < unique; ++i) {
+        std::string s = "svc" + std::to_string(i % 97);
+        std::size_t target = 8 + r.below(41);
+        while (s.size() < target) {
+            s += '.';
+            s += parts[r.below(12)];
+        }
+        s.resize(target);
+        s += std::to_string(i);  // keeps names distinct
+        names.push_back(std::move(s));
+    }
+    std::vector<std::string> records;
+    records.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        records.push_back(names[r.below(unique)]);
+    }
+    return records;
+}
+
+void report_memory(const char* name, std::size_t bytes, std::size_t records) {
+    bench::note(std::string(name) + ": " + std::to_string(bytes / 1024) + " KiB, " +
+                std::to_string(static_cast<double>(bytes) / static_cast<double>(records)).substr(0, 5) +
+                " bytes/record");
+}
+
+void memory(const std::vector<std::string>& records) {
+    std::size_t copies = records.size() * sizeof(std::string);
+    std::string empty;
+    for (const auto& s : records) {
+        if (s.capacity() > empty.capacity()) {
+            copies += s.capacity() + 1;  // heap block beyond the SSO buffer
+        }
+    }
+    report_memory("std::string per record", copies, records.size());
+
+    std_module::string_pool pool;
+    for (const auto& s : records) {
+        pool.intern(s);
+    }
+    report_memory("string_view into string_pool", pool.memory_usage() +
+                  records.size() * sizeof(std::string_view), records.size());
+
+    std_module::string_interner interner;
+    for (const auto& s : records) {
+        interner.intern(s);
+    }
+    report_memory("id into string_interner", interner.memory_usage() +
+                  records.size() * sizeof(std::uint32_t), records.size());
+}
+
+void lookup(const std::vector<std::string>& records) {
+    bench::run("std::unordered_map<std::string, id>", records.size(), [&] {
+        std::unordered_map<std::string, std::uint32_t> ids;
+        std::uint64_t sum = 0;
+        for (const auto& s : records) {
+            sum += ids.try_emplace(s, static_cast<std::uint32_t>(ids.size())).first->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("string_pool::intern", records.size(), [&] {
+        std_module::string_pool pool;
+        std::uint64_t sum = 0;
+        for (const auto& s : records) {
+            sum += pool.intern(s).size();
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("string_interner::intern", records.size(), [&] {
+        std_module::string_interner interner;
+        std::uint64_t sum = 0;
+        for (const auto& s : records) {
+            sum += interner.intern(s);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    std_module::string_interner warm;
+    for (const auto& s : records) {
+        warm.intern(s);
+    }
+    bench::run("string_interner::find (all present)", records.size(), [&] {
+        std::uint64_t sum = 0;
+        for (const auto& s : records) {
+            sum += *warm.find(s);
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("string_interner::view", records.size(), [&] {
+        std::uint64_t sum = 0;
+        for (std::uint32_t id = 0, n = static_cast<std::uint32_t>(warm.size()), i = 0;
+             i < records.size(); ++i, id = id + 1 == n ? 0 : id + 1) {
+            sum += warm.view(id).size();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+// std::unordered_map behind a mutex, with the interner's interface.
+class locked_interner {
+public:
+    std::uint32_t intern(const std::string& s) {
+        std::lock_guard<std::mutex> lock(m_);
+        return ids_.try_emplace(s, static_cast<std::uint32_t>(ids_.size())).first->second;
+    }
+
+private:
+    std::mutex m_;
+    std::unordered_map<std::string, std::uint32_t> ids_;
+};
+
+template <class Interner>
+void concurrent(const char* name, const std::vector<std::string>& records, std::size_t threads) {
+    std::size_t per_thread = records.size() / threads;
+    bench::run(name, per_thread * threads, [&] {
+        Interner interner;
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::uint64_t sum = 0;
+                for (std::size_t i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+                    sum += interner.intern(records[i]);
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }, 1);
+}
+
+// ---- Rope ----
+
+// Discards output, counting bytes
+class null_buf : public std::streambuf {
+public:
+    std::size_t bytes = 0;
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        bytes += static_cast<std::size_t>(n);
+        return n;
+    }
+
+    int_type overflow(int_type c) override {
+        ++bytes;
+        return c;
+    }
+};
+
+template <class Doc>
+void edits(const char* name, Doc doc, std::size_t count, std::uint64_t seed, bool erase) {
+    bench::rng r(seed);
+    std::string_view snippet = "<span>{{x}}</sp>";
+    bench::run(name, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t pos = r.below(doc.size() - 16);
+            if (erase) {
+                doc.erase(pos, 16);
+            } else {
+                doc.insert(pos, snippet);
+            }
+        }
+        bench::do_not_optimize(doc.size());
+    }, 1);
+}
+
+void move_block_string(std::string doc, std::size_t count) {
+    bench::rng r(9);
+    constexpr std::size_t block = 64 * 1024;
+    bench::run("std::string", count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t from = r.below(doc.size() - block);
+            std::string cut = doc.substr(from, block);
+            doc.erase(from, block);
+            doc.insert(r.below(doc.size()), cut);
+        }
+        bench::do_not_optimize(doc.size());
+    }, 1);
+}
+
+void move_block_rope(std_module::rope doc, std::size_t count) {
+    bench::rng r(9);
+    constexpr std::size_t block = 64 * 1024;
+    bench::run("rope", count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t from = r.below(doc.size() - block);
+            std_module::rope cut = doc.substr(from, block);
+            doc.erase(from, block);
+            doc.insert(r.below(doc.size()), cut);
+        }
+        bench::do_not_optimize(doc.size());
+    }, 1);
+}
+
+void documents(std::size_t size) {
+    bench::rng r(size);
+    std::string text(size, ' ');
+    for (auto& c : text) {
+        c = static_cast<char>('a' + r.below(26));
+    }
+    std_module::rope doc(text);
+
+    // std::string edits move half the document on average, so fewer of them
+    std::size_t string_edits = 200;
+    std::size_t rope_edits = 100'000;
+
+    bench::section("random insert (16 bytes), document bytes", size);
+    edits("std::string", text, string_edits, 1, false);
+    edits("rope", doc, rope_edits, 1, false);
+
+    bench::section("random erase (16 bytes), document bytes", size);
+    edits("std::string", text, string_edits, 2, true);
+    edits("rope", doc, rope_edits / 10, 2, true);  // keeps 1 MB documents mostly intact
+
+    bench::section("move 64 KiB block, document bytes", size);
+    move_block_string(text, string_edits);
+    move_block_rope(doc, rope_edits / 10);
+
+    // Fragment the rope the way an editing session would before flattening
+    bench::rng er(3);
+    for (std::size_t i = 0; i < rope_edits; ++i) {
+        doc.insert(er.below(doc.size()), "<b>");
+    }
+    bench::section("flatten / stream, per byte, document bytes", size);
+    bench::run("std::string copy", text.size(), [&] {
+        std::string copy = text;
+        bench::do_not_optimize(copy.data());
+    });
+    bench::run("rope::str", doc.size(), [&] {
+        std::string flat = doc.str();
+        bench::do_not_optimize(flat.data());
+    });
+    bench::run("std::streambuf::sputn (std::string)", text.size(), [&] {
+        null_buf out;
+        out.sputn(text.data(), static_cast<std::streamsize>(text.size()));
+        bench::do_not_optimize(out.bytes);
+    });
+    bench::run("rope::write_to", doc.size(), [&] {
+        null_buf out;
+        doc.write_to(out);
+        bench::do_not_optimize(out.bytes);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.string");
+
+    std::size_t max_n = bench::full_run(argc, argv) ? 10'000'000 : 1'000'000;
+
+    for (std::size_t n = 100'000; n <= max_n; n *= 10) {
+        auto records = make_dataset(n);
+
+        bench::section("memory (1% unique), records", n);
+        memory(records);
+
+        bench::section("lookup (1% unique), records", n);
+        lookup(records);
+    }
+
+    std::size_t max_threads = bench::full_run(argc, argv) ? 64 : 8;
+    auto records = make_dataset(max_n);
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("concurrent intern (1% unique), threads", threads);
+        concurrent<locked_interner>("mutex + std::unordered_map", records, threads);
+        concurrent<std_module::string_interner>("string_interner", records, threads);
+    }
+
+    std::size_t max_doc = bench::full_run(argc, argv) ? (100u << 20) : (10u << 20);
+    for (std::size_t size = 1u << 20; size <= max_doc; size *= 10) {
+        documents(size);
+    }
+
+    return 0;
+}
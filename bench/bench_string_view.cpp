@@ -0,0 +1,214 @@
+/**
+ * @file bench_string_view.cpp
+ * @brief Benchmarks for std_module.string_view extensions
+ *
+ * Compares, per input byte:
+ * - std::string_view::find_first_of against std_module::find_any_of when
+ *   scanning a buffer for delimiters at various densities (average field
+ *   length 8, 64 and 1024 bytes)
+ * - a find/substr loop against std_module::split (char and byte_set
+ *   delimiters) when splitting CSV rows into fields
+ * and, per call, std::equal/std::hash based case-insensitive header name
+ * lookup, comparison and hashing against std_module::iequals and
+ * std_module::ihash.
+ *
+ * Default buffer size is 1 MiB; pass --full for 64 MiB.
+ */
+
+import std_module.string_view;
+import std_module.string;
+import std_module.algorithm;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+// Printable ASCII text with a delimiter from @p delims roughly every
+// @p field_length bytes.
+std::string make_text(std::size_t size, std::size_t field_length, std::string_view delims) {
+    bench::rng r(field_length);
+    std::string s(size, 'x');
+    for (auto& c : s) {
+        c = r.below(field_length) == 0 ? delims[r.below(delims.size())]
+                                       : static_cast<char>('a' + r.below(26));
+    }
+    return s;
+}
+
+void find_any(const std::string& text, std::size_t field_length) {
+    std::string_view s = text;
+    constexpr std::string_view chars = ",\"\r\n";
+    const std_module::byte_set set(chars);
+
+    bench::section("find delimiters, average field length", field_length);
+    bench::run("std::string_view::find_first_of", s.size(), [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = s.find_first_of(chars); i != std::string_view::npos;
+             i = s.find_first_of(chars, i + 1)) {
+            ++hits;
+        }
+        bench::do_not_optimize(hits);
+    });
+    bench::run("find_any_of", s.size(), [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = std_module::find_any_of(s, set); i != std::string_view::npos;
+             i = std_module::find_any_of(s, set, i + 1)) {
+            ++hits;
+        }
+        bench::do_not_optimize(hits);
+    });
+}
+
+void split_fields(const std::string& text) {
+    std::string_view s = text;
+    bench::section("split CSV fields");
+    bench::run("find + substr loop", s.size(), [&] {
+        std::size_t total = 0;
+        std::size_t start = 0;
+        for (;;) {
+            std::size_t end = s.find(',', start);
+            std::string_view field = s.substr(start, end - start);
+            total += field.size();
+            if (end == std::string_view::npos) {
+                break;
+            }
+            start = end + 1;
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::run("split (char)", s.size(), [&] {
+        std::size_t total = 0;
+        for (std::string_view field : std_module::split(s, ',')) {
+            total += field.size();
+        }
+        bench::do_not_optimize(total);
+    });
+    const std_module::byte_set delims(",\n");
+    bench::run("split (byte_set \",\\n\")", s.size(), [&] {
+        std::size_t total = 0;
+        for (std::string_view field : std_module::split(s, delims)) {
+            total += field.size();
+        }
+        bench::do_not_optimize(total);
+    });
+}
+
+char ascii_lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c;
+}
+
+bool std_iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return ascii_lower(x) == ascii_lower(y); });
+}
+
+std::size_t std_ihash(std::string_view s) {
+    std::string lower(s);
+    for (auto& c : lower) {
+        c = ascii_lower(c);
+    }
+    return std::hash<std::string>{}(lower);
+}
+
+void header_names(std::size_t calls) {
+    static constexpr std::string_view known[] = {"Accept", "Accept-Encoding", "Accept-Language", "Authorization",
+                                        "Cache-Control", "Connection", "Content-Length", "Content-Type",
+                                        "Cookie", "Host", "If-None-Match", "User-Agent"};
+    std::vector<std::string> incoming;
+    bench::rng r(3);
+    for (std::size_t i = 0; i < 1024; ++i) {
+        std::string name(known[r.below(12)]);
+        for (auto& c : name) {
+            if (r.below(2)) {
+                c = c >= 'a' && c <= 'z' ? static_cast<char>(c - 32) : c;
+            }
+        }
+        incoming.push_back(name);
+    }
+
+    bench::section("case-insensitive header name lookup (linear over 12 names)");
+    bench::run("std::equal + ascii_lower", calls, [&] {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            std::string_view name = incoming[i & 1023];
+            for (std::string_view k : known) {
+                if (std_iequals(name, k)) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        bench::do_not_optimize(found);
+    });
+    bench::run("iequals", calls, [&] {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            std::string_view name = incoming[i & 1023];
+            for (std::string_view k : known) {
+                if (std_module::iequals(name, k)) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        bench::do_not_optimize(found);
+    });
+
+    std::vector<std::string> upper;
+    for (const auto& name : incoming) {
+        std::string u = name;
+        for (auto& c : u) {
+            c = c >= 'a' && c <= 'z' ? static_cast<char>(c - 32) : c;
+        }
+        upper.push_back(std::move(u));
+    }
+    bench::section("case-insensitive equality of matching names");
+    bench::run("std::equal + ascii_lower", calls, [&] {
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            equal += std_iequals(incoming[i & 1023], upper[i & 1023]);
+        }
+        bench::do_not_optimize(equal);
+    });
+    bench::run("iequals", calls, [&] {
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            equal += std_module::iequals(incoming[i & 1023], upper[i & 1023]);
+        }
+        bench::do_not_optimize(equal);
+    });
+
+    bench::section("case-insensitive hash of a header name");
+    bench::run("lowercase copy + std::hash<std::string>", calls, [&] {
+        std::size_t h = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            h += std_ihash(incoming[i & 1023]);
+        }
+        bench::do_not_optimize(h);
+    });
+    bench::run("ihash", calls, [&] {
+        std::size_t h = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            h += std_module::ihash(incoming[i & 1023]);
+        }
+        bench::do_not_optimize(h);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.string_view");
+
+    std::size_t size = bench::full_run(argc, argv) ? (64u << 20) : (1u << 20);
+
+    for (std::size_t field_length : {8u, 64u, 1024u}) {
+        find_any(make_text(size, field_length, ",\"\r\n"), field_length);
+    }
+    split_fields(make_text(size, 12, ",,,,,,,\n"));
+    header_names(1'000'000);
+
+    return 0;
+}
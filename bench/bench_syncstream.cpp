@@ -0,0 +1,146 @@
+/**
+ * @file bench_syncstream.cpp
+ * @brief Benchmarks for std_module.syncstream extensions
+ *
+ * Compares logging a line with std::osyncstream(out) << std::format(...)
+ * (formatting and a locked emit on the calling thread) against
+ * std_module::async_logger (capture on the calling thread, formatting and
+ * writing on a background thread), both writing to a discarding stream:
+ * - caller latency: t threads each log one line every 2 us and time every
+ *   call; reported as percentiles of the per-call time
+ * - throughput: t threads log as fast as they can, including the time to
+ *   flush everything out at the end
+ *
+ * Default is 1..4 threads and 20000 lines per thread; pass --full for
+ * 1..16 threads and 200000 lines per thread.
+ */
+
+import std_module.syncstream;
+import std_module.chrono;
+import std_module.format;
+import std_module.ostream;
+import std_module.streambuf;
+import std_module.string;
+import std_module.thread;
+import std_module.vector;
+import std_module.bench_framework;
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+// Stream buffer that accepts and discards everything
+class null_buffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               bench::clock::now().time_since_epoch()).count();
+}
+
+struct sync_stream_logger {
+    explicit sync_stream_logger(std::ostream& out) : out(out) {}
+
+    void line(int thread, std::size_t i, const std::string& user, double ms) {
+        std::osyncstream(out) << std::format("request {} from {} on t{} took {:.3f} ms\n", i, user, thread, ms);
+    }
+
+    void flush() {}
+
+    std::ostream& out;
+};
+
+struct async_stream_logger {
+    explicit async_stream_logger(std::ostream& out) : log(out) {}
+
+    void line(int thread, std::size_t i, const std::string& user, double ms) {
+        log.info("request {} from {} on t{} took {:.3f} ms", i, user, thread, ms);
+    }
+
+    void flush() { log.flush(); }
+
+    std_module::async_logger log;
+};
+
+template <class Logger>
+void latency(const char* name, std::size_t threads, std::size_t lines) {
+    null_buffer sink;
+    std::ostream out(&sink);
+    Logger logger(out);
+    std::vector<std::vector<double>> per_thread(threads);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::string user = "user" + std::to_string(t);
+            auto& samples = per_thread[t];
+            samples.reserve(lines);
+            std::int64_t next = now_ns();
+            for (std::size_t i = 0; i < lines; ++i) {
+                while (now_ns() < next) {
+                }
+                std::int64_t start = now_ns();
+                logger.line(static_cast<int>(t), i, user, static_cast<double>(i) * 0.001);
+                samples.push_back(static_cast<double>(now_ns() - start));
+                next += 2'000;
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    logger.flush();
+    std::vector<double> all;
+    for (auto& v : per_thread) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    bench::report_percentiles(name, all);
+}
+
+template <class Logger>
+void throughput(const char* name, std::size_t threads, std::size_t lines) {
+    bench::run(name, threads * lines, [&] {
+        null_buffer sink;
+        std::ostream out(&sink);
+        Logger logger(out);
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::string user = "user" + std::to_string(t);
+                for (std::size_t i = 0; i < lines; ++i) {
+                    logger.line(static_cast<int>(t), i, user, static_cast<double>(i) * 0.001);
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        logger.flush();
+    }, 1);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::header("std_module.syncstream");
+
+    bool full = bench::full_run(argc, argv);
+    std::size_t max_threads = full ? 16 : 4;
+    std::size_t lines = full ? 200'000 : 20'000;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("caller latency (1 line / 2 us per thread), threads", threads);
+        latency<sync_stream_logger>("osyncstream << std::format", threads, lines);
+        latency<async_stream_logger>("async_logger", threads, lines);
+    }
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench::section("throughput (unpaced, incl. final flush), threads", threads);
+        throughput<sync_stream_logger>("osyncstream << std::format", threads, lines);
+        throughput<async_stream_logger>("async_logger", threads, lines);
+    }
+
+    return 0;
+}
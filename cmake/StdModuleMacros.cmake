@@ -171,3 +171,51 @@ macro(std_module_link_test_framework MODULE_NAME)
         target_link_libraries(test_${MODULE_NAME} PRIVATE std_module::test_framework)
     endif()
 endmacro()
+
+# ------------------------------------------------------------------------------
+# std_module_add_benchmark
+# ------------------------------------------------------------------------------
+# Creates a benchmark executable for a standard library module wrapper.
+#
+# Usage:
+#   std_module_add_benchmark(queue)
+#
+# This macro will:
+#   - Check if STD_MODULE_BUILD_ALL_MODULES or STD_MODULE_BUILD_<NAME> is ON
+#   - Create benchmark executable bench_<name> from bench_<name>.cpp
+#   - Link against std_module::<name>, std_module::bench_framework and
+#     std_module::all (benchmarks import helper modules such as vector)
+#   - Link Threads::Threads (multi-threaded benchmarks)
+#   - Set C++20 requirement
+#   - Print status message
+#
+# Benchmarks are not registered with CTest; run them directly from the
+# build's bin/ directory.
+#
+# Parameters:
+#   MODULE_NAME - The name of the module (e.g., "queue", "string")
+#
+macro(std_module_add_benchmark MODULE_NAME)
+    # Convert module name to uppercase for option checking
+    string(TOUPPER ${MODULE_NAME} MODULE_NAME_UPPER)
+
+    # Check if this module should be built
+    if(STD_MODULE_BUILD_ALL_MODULES OR STD_MODULE_BUILD_${MODULE_NAME_UPPER})
+        # Create benchmark executable
+        add_executable(bench_${MODULE_NAME} bench_${MODULE_NAME}.cpp)
+
+        # Link against the module, the benchmark utilities and helper modules
+        target_link_libraries(bench_${MODULE_NAME}
+            PRIVATE
+                std_module::${MODULE_NAME}
+                std_module::bench_framework
+                std_module::all
+                Threads::Threads
+        )
+
+        # Require C++20
+        target_compile_features(bench_${MODULE_NAME} PRIVATE cxx_std_20)
+
+        message(STATUS "Configured benchmark: bench_${MODULE_NAME}")
+    endif()
+endmacro()
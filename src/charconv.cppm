@@ -6,6 +6,23 @@
 module;
 
 #include <charconv>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define STD_MODULE_CHARCONV_SSE2 1
+#else
+#define STD_MODULE_CHARCONV_SSE2 0
+#endif
 
 export module std_module.charconv;
 
@@ -22,3 +39,1239 @@ using std::from_chars_result;
 // Floating-point format specification
 using std::chars_format;
 }  // namespace std
+
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module
+{
+/**
+ * @brief Result of from_chars_batch(): @c count values were stored; on
+ * error @c ptr is the first character that could not be consumed (the
+ * start of a malformed or out-of-range field, or a bad separator).
+ */
+struct from_chars_batch_result
+{
+    const char* ptr;
+    std::errc ec;
+    std::size_t count;
+};
+
+/**
+ * @brief Result of to_chars_batch(): @c count values were written and
+ * @c ptr is one past the last character of the last complete value.
+ */
+struct to_chars_batch_result
+{
+    char* ptr;
+    std::errc ec;
+    std::size_t count;
+};
+
+/// Element types supported by the batch conversions
+template <class T>
+concept batch_number = (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>;
+}  // namespace std_module
+
+namespace std_module::detail
+{
+inline constexpr std::uint64_t digit_pow10[] = {1ull,
+                                                10ull,
+                                                100ull,
+                                                1000ull,
+                                                10000ull,
+                                                100000ull,
+                                                1000000ull,
+                                                10000000ull,
+                                                100000000ull,
+                                                1000000000ull,
+                                                10000000000ull,
+                                                100000000000ull,
+                                                1000000000000ull,
+                                                10000000000000ull,
+                                                100000000000000ull,
+                                                1000000000000000ull,
+                                                10000000000000000ull,
+                                                100000000000000000ull,
+                                                1000000000000000000ull,
+                                                10000000000000000000ull};
+
+// Up to 8 bytes at p, first character in the lowest byte. Missing bytes
+// read as 0, which is not a digit.
+inline std::uint64_t load_digit_word(const char* p, const char* last) noexcept
+{
+    std::uint64_t x = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        if (last - p >= 8) {
+            std::memcpy(&x, p, 8);
+            return x;
+        }
+    }
+    std::size_t n = last - p < 8 ? static_cast<std::size_t>(last - p) : 8;
+    for (std::size_t i = 0; i < n; ++i) {
+        x |= std::uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+    }
+    return x;
+}
+
+// Value of 8 digits (0..9 per byte, most significant in the lowest byte)
+inline std::uint64_t eight_digits(std::uint64_t x) noexcept
+{
+    x = (x * 10 + (x >> 8)) & 0x00FF00FF00FF00FFull;
+    x = (x * 100 + (x >> 16)) & 0x0000FFFF0000FFFFull;
+    return (x * 10000 + (x >> 32)) & 0xFFFFFFFFull;
+}
+
+// Number of leading digit bytes in x (already XORed with '0'): a byte is
+// a digit iff it is at most 9 now. 8 when all are digits.
+inline std::size_t leading_digits(std::uint64_t x) noexcept
+{
+    std::uint64_t non_digit = (((x & 0x7F7F7F7F7F7F7F7Full) + 0x7676767676767676ull) | x) & 0x8080808080808080ull;
+    return static_cast<std::size_t>(std::countr_zero(non_digit)) / 8;
+}
+
+// Value of the first n digit bytes of x. Shifting them to the top makes
+// the unused low bytes leading zeros.
+inline std::uint64_t digits_value(std::uint64_t x, std::size_t n) noexcept
+{
+    // Branch-free for n == 0 too: shift by 0 and mask everything off
+    std::uint64_t keep = 0 - std::uint64_t{n != 0};
+    return eight_digits((x << ((8 * (8 - n)) & 63)) & keep);
+}
+
+/**
+ * Appends the run of decimal digits at p to value. Each 8-byte load is
+ * validated as a whole and its digit bytes are combined with three
+ * multiplies; with 16 bytes of input left, runs of up to 16 digits take
+ * no data-dependent branches. Returns the end of the run, or nullptr once
+ * more than 19 significant positions were seen and value can no longer be
+ * exact.
+ */
+inline const char* accumulate_digits(const char* p, const char* last, std::uint64_t& value,
+                                     std::size_t& digits) noexcept
+{
+    if (last - p >= 16) {
+        std::uint64_t x0 = load_digit_word(p, last) ^ 0x3030303030303030ull;
+        std::uint64_t x1 = load_digit_word(p + 8, last) ^ 0x3030303030303030ull;
+        std::size_t n0 = leading_digits(x0);
+        std::size_t n1 = n0 == 8 ? leading_digits(x1) : 0;
+        std::size_t n = n0 + n1;
+        if (n1 < 8 && digits + n <= 19) {
+            std::uint64_t run = digits_value(x0, n0) * digit_pow10[n1] + digits_value(x1, n1);
+            value = value * digit_pow10[n] + run;
+            digits += n;
+            return p + n;
+        }
+    }
+    for (;;) {
+        std::uint64_t x = load_digit_word(p, last) ^ 0x3030303030303030ull;
+        std::size_t n = leading_digits(x);
+        if (n == 0) {
+            return p;
+        }
+        digits += n;
+        if (digits > 19) {
+            return nullptr;
+        }
+        value = value * digit_pow10[n] + digits_value(x, n);
+        p += n;
+        if (n < 8) {
+            return p;
+        }
+    }
+}
+
+template <class T>
+std::from_chars_result parse_integer(const char* first, const char* last, T& out) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    const char* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        negative = p != last && *p == '-';
+        p += negative;
+    }
+    std::uint64_t magnitude = 0;
+    std::size_t digits = 0;
+    const char* end = accumulate_digits(p, last, magnitude, digits);
+    if (end == nullptr) {
+        // Very long (possibly zero-padded) field: exact std semantics
+        return std::from_chars(first, last, out);
+    }
+    if (end == p) {
+        return {first, std::errc::invalid_argument};
+    }
+    std::uint64_t limit = static_cast<U>(std::numeric_limits<T>::max());
+    if (negative ? magnitude > limit + 1 : magnitude > limit) {
+        return {end, std::errc::result_out_of_range};
+    }
+    out = negative ? static_cast<T>(U(0) - static_cast<U>(magnitude)) : static_cast<T>(magnitude);
+    return {end, std::errc{}};
+}
+
+template <class T>
+struct clinger_limits;
+
+template <>
+struct clinger_limits<double>
+{
+    static constexpr std::uint64_t max_mantissa = std::uint64_t(1) << 53;
+    static constexpr int max_exponent = 22;
+    static constexpr double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template <>
+struct clinger_limits<float>
+{
+    static constexpr std::uint64_t max_mantissa = std::uint64_t(1) << 24;
+    static constexpr int max_exponent = 10;
+    static constexpr float pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+/**
+ * Decimal floating point in std::chars_format::general syntax. Digits are
+ * read 8 at a time; when the significand fits the type's mantissa and the
+ * power of ten is exactly representable, one multiply or divide gives the
+ * correctly rounded result (Clinger's fast path). Everything else (long
+ * significands, large exponents, inf/nan, malformed input) is handed to
+ * std::from_chars, which is exact and reports errors the standard way.
+ */
+template <class T>
+std::from_chars_result parse_floating(const char* first, const char* last, T& out) noexcept
+{
+    if constexpr (!std::is_same_v<T, double> && !std::is_same_v<T, float>) {
+        return std::from_chars(first, last, out);
+    } else {
+        using limits = clinger_limits<T>;
+        const char* p = first;
+        bool negative = p != last && *p == '-';
+        p += negative;
+        std::uint64_t mantissa = 0;
+        std::size_t digits = 0;
+        const char* int_end = accumulate_digits(p, last, mantissa, digits);
+        if (int_end == nullptr) {
+            return std::from_chars(first, last, out);
+        }
+        p = int_end;
+        int exponent = 0;
+        if (p != last && *p == '.') {
+            const char* frac_end = accumulate_digits(p + 1, last, mantissa, digits);
+            if (frac_end == nullptr) {
+                return std::from_chars(first, last, out);
+            }
+            exponent = -static_cast<int>(frac_end - (p + 1));
+            p = frac_end;
+        }
+        if (digits == 0) {
+            return std::from_chars(first, last, out);
+        }
+        if (p != last && (*p == 'e' || *p == 'E')) {
+            const char* e = p + 1;
+            bool negative_exp = e != last && *e == '-';
+            e += e != last && (*e == '-' || *e == '+');
+            int value = 0;
+            const char* e_digits = e;
+            while (e != last && *e >= '0' && *e <= '9' && e - e_digits < 5) {
+                value = value * 10 + (*e++ - '0');
+            }
+            if (e == e_digits || (e != last && *e >= '0' && *e <= '9')) {
+                return std::from_chars(first, last, out);
+            }
+            exponent += negative_exp ? -value : value;
+            p = e;
+        }
+        if (mantissa > limits::max_mantissa || exponent < -limits::max_exponent ||
+            exponent > limits::max_exponent) {
+            return std::from_chars(first, last, out);
+        }
+        T value = static_cast<T>(mantissa);
+        value = exponent < 0 ? value / limits::pow10[-exponent] : value * limits::pow10[exponent];
+        out = negative ? -value : value;
+        return {p, std::errc{}};
+    }
+}
+
+#if STD_MODULE_CHARCONV_SSE2
+// Value of 16 digit bytes (0..9, most significant first): pairs, quads
+// and octets of digits are combined with pmaddwd
+inline std::uint64_t digits16_value(__m128i digits) noexcept
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i tens = _mm_setr_epi16(10, 1, 10, 1, 10, 1, 10, 1);
+    __m128i pairs = _mm_packs_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(digits, zero), tens),
+                                    _mm_madd_epi16(_mm_unpackhi_epi8(digits, zero), tens));
+    __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    quads = _mm_packs_epi32(quads, quads);
+    __m128i octets = _mm_madd_epi16(quads, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+    std::uint64_t halves = static_cast<std::uint64_t>(_mm_cvtsi128_si64(octets));
+    return (halves & 0xFFFFFFFFull) * 100000000ull + (halves >> 32);
+}
+
+// The 16 bytes ending at end minus '0', with the n - 1 < 16 bytes before
+// end kept and everything earlier zeroed (= leading zeros)
+inline __m128i tail_digits(const char* end, std::size_t n) noexcept
+{
+    static constexpr signed char window[32] = {0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+                                               -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(end - 16));
+    __m128i keep = _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + n));
+    return _mm_and_si128(_mm_sub_epi8(v, _mm_set1_epi8('0')), keep);
+}
+
+// All bytes are digit values
+inline bool all_digits(__m128i digits) noexcept
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits)) == 0xFFFF;
+}
+#endif
+
+/**
+ * Integer field [first, end) whose end is already known (from the
+ * separator scan): validates and converts it with no data-dependent
+ * branches. Returns false when the field is not a plain run of 1..16
+ * digits, is out of range, or lies too close to the ends of the buffer
+ * [buffer_first, buffer_last) for the wide loads; parse_integer then
+ * produces the exact result or error.
+ */
+template <class T>
+[[gnu::always_inline]] inline bool parse_short_integer(const char* first, const char* end, T& out,
+                                                       const char* buffer_first,
+                                                       [[maybe_unused]] const char* buffer_last) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    bool negative = std::is_signed_v<T> && *first == '-';
+    std::size_t n = static_cast<std::size_t>(end - first) - negative;
+    std::uint64_t limit = static_cast<U>(std::numeric_limits<T>::max()) + std::uint64_t{negative};
+#if STD_MODULE_CHARCONV_SSE2
+    if (n - 1 >= 16 || end - buffer_first < 16) {
+        return false;
+    }
+    __m128i digits = tail_digits(end, n);
+    std::uint64_t magnitude = digits16_value(digits);
+    bool ok = all_digits(digits) & (magnitude <= limit);
+#else
+    // Two 8-byte words from the first digit; the digit count must match
+    // the field length
+    const char* p = first + negative;
+    if (buffer_last - p < 16) {
+        return false;
+    }
+    std::uint64_t x0 = load_digit_word(p, p + 8) ^ 0x3030303030303030ull;
+    std::uint64_t x1 = load_digit_word(p + 8, p + 16) ^ 0x3030303030303030ull;
+    std::size_t n0 = leading_digits(x0);
+    std::size_t n1 = leading_digits(x1) & (0 - std::size_t{n0 == 8});
+    std::uint64_t magnitude = digits_value(x0, n0) * digit_pow10[n1] + digits_value(x1, n1);
+    bool ok = (n != 0) & (n1 != 8) & (n0 + n1 == n) & (magnitude <= limit);
+#endif
+    out = negative ? static_cast<T>(U(0) - static_cast<U>(magnitude)) : static_cast<T>(magnitude);
+    return ok;
+}
+
+#if STD_MODULE_CHARCONV_SSE2
+/**
+ * Decimal field [first, end) of at most 16 characters after the sign,
+ * digits with at most one '.', and no exponent: the digits before and
+ * after the point are converted separately with the same SIMD steps and
+ * combined, then finished with Clinger's fast path. Returns false for
+ * anything else (std::from_chars then parses the field).
+ */
+template <class T>
+[[gnu::always_inline]] inline bool parse_short_decimal(const char* first, const char* end, T& out,
+                                                       const char* buffer_first) noexcept
+{
+    if constexpr (!std::is_same_v<T, double> && !std::is_same_v<T, float>) {
+        return false;
+    } else {
+        using limits = clinger_limits<T>;
+        bool negative = *first == '-';
+        std::size_t n = static_cast<std::size_t>(end - first) - negative;
+        if (n - 1 >= 16 || end - buffer_first < 16) {
+            return false;
+        }
+        __m128i digits = tail_digits(end, n);
+        // '.' - '0' is 0xFE; clear it so the point reads as a zero digit
+        __m128i point = _mm_cmpeq_epi8(digits, _mm_set1_epi8(static_cast<char>('.' - '0')));
+        unsigned point_mask = static_cast<unsigned>(_mm_movemask_epi8(point));
+        digits = _mm_andnot_si128(point, digits);
+        unsigned point_pos = static_cast<unsigned>(std::countr_zero(point_mask | 0x10000u));
+        // Digits before the point are followed by zeros for the point and
+        // the fraction; those after it are the fraction itself
+        __m128i before = _mm_cmplt_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                        _mm_set1_epi8(static_cast<char>(point_pos)));
+        std::uint64_t whole = digits16_value(_mm_and_si128(digits, before));
+        std::uint64_t fraction = digits16_value(_mm_andnot_si128(before, digits));
+        bool has_point = point_mask != 0;
+        std::size_t fraction_digits = has_point ? 15 - point_pos : 0;
+        std::uint64_t mantissa = has_point ? whole / 10 + fraction : whole;
+        bool ok = all_digits(digits) & ((point_mask & (point_mask - 1)) == 0) & (n > std::size_t{has_point}) &
+                  (mantissa <= limits::max_mantissa) & (fraction_digits <= std::size_t(limits::max_exponent));
+        if (!ok) {
+            return false;
+        }
+        T value = static_cast<T>(mantissa) / limits::pow10[fraction_digits];
+        out = negative ? -value : value;
+        return true;
+    }
+}
+#endif
+
+#if STD_MODULE_CHARCONV_SSE2
+// Bit i set iff block[i] is a field separator, for the 64 bytes at block
+inline std::uint64_t separator_mask(const char* block, char delimiter) noexcept
+{
+    __m128i delim = _mm_set1_epi8(delimiter);
+    __m128i newline = _mm_set1_epi8('\n');
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, delim), _mm_cmpeq_epi8(v, newline));
+        mask |= std::uint64_t{static_cast<unsigned>(_mm_movemask_epi8(hit))} << (16 * i);
+    }
+    return mask;
+}
+#else
+// One bit per byte of x equal to the byte in pattern (broadcast), in
+// the low 8 bits, first byte lowest
+inline std::uint64_t byte_eq_mask(std::uint64_t x, std::uint64_t pattern) noexcept
+{
+    std::uint64_t t = x ^ pattern;
+    std::uint64_t zero = ~(((t & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | t) & 0x8080808080808080ull;
+    return (zero * 0x0002040810204081ull) >> 56;
+}
+
+// Bit i set iff block[i] is a field separator, for the 64 bytes at block
+inline std::uint64_t separator_mask(const char* block, char delimiter) noexcept
+{
+    std::uint64_t delim = 0x0101010101010101ull * static_cast<unsigned char>(delimiter);
+    std::uint64_t newline = 0x0101010101010101ull * '\n';
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        std::uint64_t x = load_digit_word(block + 8 * i, block + 64);
+        mask |= (byte_eq_mask(x, delim) | byte_eq_mask(x, newline)) << (8 * i);
+    }
+    return mask;
+}
+#endif
+
+template <class T>
+std::from_chars_result parse_number(const char* first, const char* last, T& out) noexcept
+{
+    if constexpr (std::is_integral_v<T>) {
+        return parse_integer(first, last, out);
+    } else {
+        return parse_floating(first, last, out);
+    }
+}
+
+// A batch field the branch-free paths declined
+template <class T>
+std::from_chars_result parse_long_field(const char* first, const char* last, T& out) noexcept
+{
+#if STD_MODULE_CHARCONV_SSE2
+    if constexpr (std::is_floating_point_v<T>) {
+        // Short decimals were already tried, and longer ones rarely fit
+        // Clinger's fast path: skip straight to the exact parser
+        return std::from_chars(first, last, out);
+    }
+#endif
+    return parse_number(first, last, out);
+}
+}  // namespace std_module::detail
+
+// ==============================================================================
+// Shortest round-trip floating-point output
+// ==============================================================================
+
+// Schubfach (R. Giulietti, "The Schubfach way to render doubles"): the
+// rounding interval of the value is scaled by a 128-bit (double) or
+// 64-bit (float) approximation of a power of ten, and the shortest
+// decimal in it is picked with a couple of comparisons - no loops over
+// digits and no big integers. Output is then laid out exactly like
+// libstdc++/MSVC std::to_chars.
+
+namespace std_module::detail
+{
+template <class T>
+struct ieee_layout;
+
+template <>
+struct ieee_layout<double>
+{
+    using carrier = std::uint64_t;
+    static constexpr int significand_bits = 52;
+    static constexpr int exponent_bits = 11;
+    static constexpr int exponent_bias = 1023;
+    static constexpr int min_k = -292;          // power-of-ten table range
+    static constexpr int max_k = 324;
+    static constexpr int max_exact_pow10 = 22;  // 10^22 is the largest exact power of ten
+};
+
+template <>
+struct ieee_layout<float>
+{
+    using carrier = std::uint32_t;
+    static constexpr int significand_bits = 23;
+    static constexpr int exponent_bits = 8;
+    static constexpr int exponent_bias = 127;
+    static constexpr int min_k = -31;
+    static constexpr int max_k = 45;
+    static constexpr int max_exact_pow10 = 10;
+};
+
+struct uint128_parts
+{
+    std::uint64_t hi;
+    std::uint64_t lo;
+};
+
+inline uint128_parts umul128(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<std::uint64_t>(p >> 64), static_cast<std::uint64_t>(p)};
+#else
+    std::uint64_t ll = (a & 0xFFFFFFFFull) * (b & 0xFFFFFFFFull);
+    std::uint64_t lh = (a & 0xFFFFFFFFull) * (b >> 32);
+    std::uint64_t hl = (a >> 32) * (b & 0xFFFFFFFFull);
+    std::uint64_t hh = (a >> 32) * (b >> 32);
+    std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+    return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & 0xFFFFFFFFull)};
+#endif
+}
+
+// Wide enough for 5^324 and for 2^895 / 5^292 to keep 128 significant bits
+struct pow10_bignum
+{
+    static constexpr int limbs = 28;
+    std::uint32_t limb[limbs] = {};
+
+    constexpr int bit_length() const
+    {
+        for (int i = limbs - 1; i >= 0; --i) {
+            if (limb[i] != 0) {
+                return 32 * i + std::bit_width(limb[i]);
+            }
+        }
+        return 0;
+    }
+
+    // 64 bits starting at bit lo; bits below 0 read as zero
+    constexpr std::uint64_t bits_at(int lo) const
+    {
+        std::uint64_t r = 0;
+        for (int i = 0; i < 64; ++i) {
+            int b = lo + i;
+            if (b >= 0 && b < 32 * limbs && ((limb[b / 32] >> (b % 32)) & 1) != 0) {
+                r |= std::uint64_t(1) << i;
+            }
+        }
+        return r;
+    }
+
+    constexpr void mul5()
+    {
+        std::uint64_t carry = 0;
+        for (auto& w : limb) {
+            std::uint64_t t = std::uint64_t{w} * 5 + carry;
+            w = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+
+    constexpr void div5()
+    {
+        std::uint64_t rem = 0;
+        for (int i = limbs - 1; i >= 0; --i) {
+            std::uint64_t cur = (rem << 32) | limb[i];
+            limb[i] = static_cast<std::uint32_t>(cur / 5);
+            rem = cur % 5;
+        }
+    }
+};
+
+/**
+ * @brief Leading 128 bits of 10^e (truncated) for e in [MinK, MaxK].
+ *
+ * The binary exponent is implied (the table is normalized to
+ * [2^127, 2^128)), so only the powers of five matter. Negative powers use
+ * floor(floor(x) / 5) == floor(x / 5) to stay exact while dividing a
+ * fixed 2^895 down.
+ */
+template <int MinK, int MaxK>
+consteval std::array<uint128_parts, MaxK - MinK + 1> make_pow10_significands()
+{
+    std::array<uint128_parts, MaxK - MinK + 1> table{};
+    auto leading = [](const pow10_bignum& x) {
+        int length = x.bit_length();
+        return uint128_parts{x.bits_at(length - 64), x.bits_at(length - 128)};
+    };
+    pow10_bignum pos;
+    pos.limb[0] = 1;
+    for (int e = 0; e <= MaxK; ++e) {
+        table[e - MinK] = leading(pos);
+        pos.mul5();
+    }
+    pow10_bignum neg;
+    neg.limb[pow10_bignum::limbs - 1] = std::uint32_t(1) << 31;
+    for (int e = -1; e >= MinK; --e) {
+        neg.div5();
+        table[e - MinK] = leading(neg);
+    }
+    return table;
+}
+
+// Schubfach's g: the truncated significand plus one, so the scaled
+// interval bounds are never underestimated
+inline constexpr auto pow10_significands_double = [] {
+    auto table = make_pow10_significands<ieee_layout<double>::min_k, ieee_layout<double>::max_k>();
+    for (auto& g : table) {
+        g.lo += 1;
+        g.hi += g.lo == 0;
+    }
+    return table;
+}();
+
+inline constexpr auto pow10_significands_float = [] {
+    auto wide = make_pow10_significands<ieee_layout<float>::min_k, ieee_layout<float>::max_k>();
+    std::array<std::uint64_t, wide.size()> table{};
+    for (std::size_t i = 0; i < wide.size(); ++i) {
+        table[i] = wide[i].hi + 1;
+    }
+    return table;
+}();
+
+inline int floor_log10_pow2(int e) noexcept
+{
+    return (e * 315653) >> 20;
+}
+
+inline int floor_log10_three_quarters_pow2(int e) noexcept
+{
+    return (e * 315653 - 131237) >> 20;
+}
+
+inline int floor_log2_pow10(int e) noexcept
+{
+    return (e * 1741647) >> 19;
+}
+
+// Top word of g * cp, rounded to odd (the sticky bit keeps "exactly on a
+// boundary" distinguishable from "just above it")
+inline std::uint64_t round_to_odd(uint128_parts g, std::uint64_t cp) noexcept
+{
+    uint128_parts x = umul128(g.lo, cp);
+    uint128_parts y = umul128(g.hi, cp);
+    std::uint64_t mid = y.lo + x.hi;
+    std::uint64_t top = y.hi + (mid < y.lo);
+    return top | (mid > 1);
+}
+
+inline std::uint32_t round_to_odd(std::uint64_t g, std::uint32_t cp) noexcept
+{
+    uint128_parts p = umul128(g, cp);
+    return static_cast<std::uint32_t>(p.hi) | (static_cast<std::uint32_t>(p.lo >> 32) > 1);
+}
+
+/// value == significand * 10^exponent
+struct shortest_decimal
+{
+    std::uint64_t significand;
+    int exponent;
+};
+
+// Strips Digits trailing zeros if there are that many (a select, no
+// branch; the divisor must be a constant to become a multiplication)
+template <int Digits>
+inline void strip_zeros(shortest_decimal& r) noexcept
+{
+    constexpr std::uint64_t divisor = digit_pow10[Digits];
+    std::uint64_t quotient = r.significand / divisor;
+    bool zeros = quotient * divisor == r.significand;
+    r.significand = zeros ? quotient : r.significand;
+    r.exponent += zeros ? Digits : 0;
+}
+
+// Short decimals such as 0.3 come out as 17 digits with many trailing
+// zeros: strip 8, 4, 2 and 1 of them rather than one per iteration
+inline shortest_decimal remove_trailing_zeros(shortest_decimal r) noexcept
+{
+    if (r.significand % 10000000000000000ull == 0) {
+        r.significand /= 10000000000000000ull;
+        r.exponent += 16;
+    }
+    strip_zeros<8>(r);
+    strip_zeros<4>(r);
+    strip_zeros<2>(r);
+    strip_zeros<1>(r);
+    return r;
+}
+
+/**
+ * @brief Shortest decimal that rounds back to the finite, nonzero value
+ * with the given IEEE fields; among equally short ones the closest, ties
+ * to even. Trailing zeros are removed.
+ */
+template <class T>
+shortest_decimal to_shortest_decimal(typename ieee_layout<T>::carrier field, int biased_exponent) noexcept
+{
+    using layout = ieee_layout<T>;
+    using U = typename layout::carrier;
+    constexpr int shift = layout::exponent_bias + layout::significand_bits;
+
+    U c = field;
+    int q = 1 - shift;
+    if (biased_exponent != 0) {
+        c = field | (U(1) << layout::significand_bits);
+        q = biased_exponent - shift;
+        // Small integers are their own shortest representation
+        if (q <= 0 && -q <= layout::significand_bits && (c & ((U(1) << -q) - 1)) == 0) {
+            return remove_trailing_zeros({static_cast<std::uint64_t>(c >> -q), 0});
+        }
+    }
+
+    bool is_even = (c & 1) == 0;
+    bool lower_closer = field == 0 && biased_exponent > 1;
+    U cbl = 4 * c - 2 + lower_closer;
+    U cb = 4 * c;
+    U cbr = 4 * c + 2;
+
+    int k = lower_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+    int h = q + floor_log2_pow10(-k) + 1;
+    U vbl, vb, vbr;
+    if constexpr (std::is_same_v<T, double>) {
+        uint128_parts g = pow10_significands_double[-k - layout::min_k];
+        vbl = round_to_odd(g, cbl << h);
+        vb = round_to_odd(g, cb << h);
+        vbr = round_to_odd(g, cbr << h);
+    } else {
+        std::uint64_t g = pow10_significands_float[-k - layout::min_k];
+        vbl = round_to_odd(g, static_cast<std::uint32_t>(cbl << h));
+        vb = round_to_odd(g, static_cast<std::uint32_t>(cb << h));
+        vbr = round_to_odd(g, static_cast<std::uint32_t>(cbr << h));
+    }
+    U lower = vbl + !is_even;
+    U upper = vbr - !is_even;
+
+    // The candidates one digit shorter (at most one of them is inside the
+    // interval) and at full length (the closer one, ties to even when both
+    // are inside). All of it is computed and then selected, because with
+    // real data the outcome is close to random and branches mispredict.
+    U s = vb / 4;
+    U sp = s / 10;
+    bool up_inside = lower <= 40 * sp;
+    bool wp_inside = 40 * sp + 40 <= upper;
+    bool shorter = s >= 10 && up_inside != wp_inside;
+
+    bool u_inside = lower <= 4 * s;
+    bool w_inside = 4 * s + 4 <= upper;
+    U mid = 4 * s + 2;
+    bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+    U full = s + (u_inside != w_inside ? w_inside : round_up);
+
+    return remove_trailing_zeros({static_cast<std::uint64_t>(shorter ? sp + wp_inside : full), k + shorter});
+}
+
+inline constexpr char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+inline int decimal_length(std::uint64_t v) noexcept
+{
+    // v | 1 makes zero one digit long
+    v |= 1;
+    int guess = (std::bit_width(v) * 1233) >> 12;
+    return guess + (v >= digit_pow10[guess]);
+}
+
+// Writes the decimal digits of v so that they end just before end
+inline void write_digits(char* end, std::uint64_t v) noexcept
+{
+    if (v >= 100000000) {
+        // Low 8 digits in 32-bit arithmetic, two at a time
+        std::uint64_t high = v / 100000000;
+        auto low = static_cast<std::uint32_t>(v - high * 100000000);
+        for (int i = 0; i < 4; ++i) {
+            end -= 2;
+            std::memcpy(end, digit_pairs + 2 * (low % 100), 2);
+            low /= 100;
+        }
+        v = high;
+    }
+    auto rest = static_cast<std::uint32_t>(v);
+    while (rest >= 100) {
+        end -= 2;
+        std::memcpy(end, digit_pairs + 2 * (rest % 100), 2);
+        rest /= 100;
+    }
+    if (rest >= 10) {
+        std::memcpy(end - 2, digit_pairs + 2 * rest, 2);
+    } else {
+        end[-1] = static_cast<char>('0' + rest);
+    }
+}
+
+/**
+ * @brief Writes the integer c * 2^q exactly (q > 0) and returns the end.
+ * Fixed notation of a value whose shortest digits are not its exact
+ * value (1e23 prints as 99999999999999991611392) needs every digit.
+ */
+inline char* write_exact_integer(char* first, std::uint64_t c, int q) noexcept
+{
+    std::uint32_t limb[35] = {};  // 53 + 971 bits
+    int word = q / 32;
+    int bit = q % 32;
+    std::uint64_t low = (c & 0xFFFFFFFFull) << bit;
+    std::uint64_t high = ((c >> 32) << bit) + (low >> 32);
+    limb[word] = static_cast<std::uint32_t>(low);
+    limb[word + 1] = static_cast<std::uint32_t>(high);
+    limb[word + 2] = static_cast<std::uint32_t>(high >> 32);
+
+    // Base 10^9 digits, least significant first. Each pass divides by
+    // 10^9 four times in a cascade: every stage has its own remainder
+    // chain, so the four long divisions overlap instead of running one
+    // after another.
+    std::uint32_t chunk[40];
+    int chunks = 0;
+    for (int size = word + 3; size > 0;) {
+        std::uint64_t rem[4] = {};
+        for (int i = size - 1; i >= 0; --i) {
+            std::uint64_t x = limb[i];
+            for (auto& r : rem) {
+                std::uint64_t cur = (r << 32) | x;
+                x = cur / 1000000000;
+                r = cur - x * 1000000000;
+            }
+            limb[i] = static_cast<std::uint32_t>(x);
+        }
+        for (std::uint64_t r : rem) {
+            chunk[chunks++] = static_cast<std::uint32_t>(r);
+        }
+        while (size > 0 && limb[size - 1] == 0) {
+            --size;
+        }
+    }
+    while (chunks > 1 && chunk[chunks - 1] == 0) {
+        --chunks;
+    }
+
+    char* p = first + decimal_length(chunk[chunks - 1]);
+    write_digits(p, chunk[chunks - 1]);
+    for (int i = chunks - 2; i >= 0; --i) {
+        std::memset(p, '0', 9);
+        write_digits(p + 9, chunk[i]);
+        p += 9;
+    }
+    return p;
+}
+
+/**
+ * @brief Shortest hex form as libstdc++ prints it: "1.8p+1", subnormals
+ * with a leading 0 ("0.0000000000001p-1022"), zero as "0p+0".
+ */
+template <class T>
+std::to_chars_result write_shortest_hex(char* first, char* last, typename ieee_layout<T>::carrier field,
+                                        int biased_exponent) noexcept
+{
+    using layout = ieee_layout<T>;
+    // float's 23 fraction bits are padded to 6 whole hex digits
+    constexpr int fraction_digits = (layout::significand_bits + 3) / 4;
+    std::uint64_t fraction = std::uint64_t{field} << (4 * fraction_digits - layout::significand_bits);
+    int digits = fraction == 0 ? 0 : fraction_digits - std::countr_zero(fraction) / 4;
+    fraction >>= 4 * (fraction_digits - digits);
+
+    int exponent = biased_exponent - layout::exponent_bias;
+    if (biased_exponent == 0) {
+        exponent = field == 0 ? 0 : 1 - layout::exponent_bias;
+    }
+    unsigned magnitude = static_cast<unsigned>(exponent < 0 ? -exponent : exponent);
+    int exponent_length = magnitude >= 1000 ? 4 : magnitude >= 100 ? 3 : magnitude >= 10 ? 2 : 1;
+
+    if (last - first < 1 + (digits != 0 ? digits + 1 : 0) + 2 + exponent_length) {
+        return {last, std::errc::value_too_large};
+    }
+    char* p = first;
+    *p++ = biased_exponent != 0 ? '1' : '0';
+    if (digits != 0) {
+        *p++ = '.';
+        for (int i = digits - 1; i >= 0; --i) {
+            p[i] = "0123456789abcdef"[fraction & 15];
+            fraction >>= 4;
+        }
+        p += digits;
+    }
+    *p++ = 'p';
+    *p++ = exponent < 0 ? '-' : '+';
+    write_digits(p + exponent_length, magnitude);
+    return {p + exponent_length, std::errc{}};
+}
+
+// Eight ASCII digits of v < 10^8: both halves of the number are split
+// into digit pairs and then digits in parallel, one SWAR lane each
+inline void write_eight_digits(char* p, std::uint32_t v) noexcept
+{
+    std::uint64_t x = (v / 10000) | (std::uint64_t{v % 10000} << 32);
+    std::uint64_t hundreds = ((x * 10486) >> 20) & 0x0000007F0000007Full;
+    x = hundreds | ((x - hundreds * 100) << 16);
+    std::uint64_t tens = ((x * 103) >> 10) & 0x000F000F000F000Full;
+    x = (tens | ((x - tens * 10) << 8)) | 0x3030303030303030ull;
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(p, &x, 8);
+    } else {
+        for (int i = 0; i < 8; ++i) {
+            p[i] = static_cast<char>(x >> (8 * i));
+        }
+    }
+}
+
+/// Most digits a shortest float/double significand can have
+template <class T>
+inline constexpr int max_shortest_digits = std::is_same_v<T, double> ? 17 : 9;
+
+// Writes exactly max_shortest_digits<T> digits of v
+template <class T>
+inline void write_normalized_digits(char* p, std::uint64_t v) noexcept
+{
+    if constexpr (std::is_same_v<T, double>) {
+        std::uint64_t top = v / 10000000000000000ull;
+        std::uint64_t rest = v - top * 10000000000000000ull;
+        std::uint64_t high = rest / 100000000;
+        p[0] = static_cast<char>('0' + top);
+        write_eight_digits(p + 1, static_cast<std::uint32_t>(high));
+        write_eight_digits(p + 9, static_cast<std::uint32_t>(rest - high * 100000000));
+    } else {
+        auto w = static_cast<std::uint32_t>(v);
+        std::uint32_t top = w / 100000000;
+        p[0] = static_cast<char>('0' + top);
+        write_eight_digits(p + 1, w - top * 100000000);
+    }
+}
+
+// Room write_decimal_unchecked may use beyond the output itself
+inline constexpr int decimal_slack = 32;
+
+/**
+ * @brief Lays out significand * 10^exponent (after the sign) in the
+ * notation chosen by write_shortest_decimal() and returns the end.
+ *
+ * The significand is scaled to a fixed digit count first, so digits are
+ * written with fixed-size stores whatever their number; the caller
+ * guarantees decimal_slack bytes of room past the output.
+ */
+template <class T>
+char* write_decimal_unchecked(char* first, shortest_decimal d, int n, bool fixed, std::uint64_t c, int q) noexcept
+{
+    constexpr int width = max_shortest_digits<T>;
+    int k = d.exponent;
+    std::uint64_t normalized = d.significand * digit_pow10[width - n];
+
+    if (!fixed) {
+        // Digits go one to the right, then the first moves in front of the point
+        write_normalized_digits<T>(first + 1, normalized);
+        first[0] = first[1];
+        first[1] = '.';
+        char* p = first + n + (n > 1);
+        int scientific_exponent = k + n - 1;
+        unsigned magnitude = static_cast<unsigned>(scientific_exponent < 0 ? -scientific_exponent : scientific_exponent);
+        // At least two exponent digits; a third one is written and then
+        // kept or overwritten, without a branch
+        bool three = magnitude >= 100;
+        p[0] = 'e';
+        p[1] = scientific_exponent < 0 ? '-' : '+';
+        p[2] = static_cast<char>('0' + magnitude / 100);
+        std::memcpy(p + 2 + three, digit_pairs + 2 * (magnitude % 100), 2);
+        return p + 4 + three;
+    }
+
+    if (k >= 0) {
+        if (k > 0) {
+            // Zero-filling is only right if the digits are the exact value
+            using layout = ieee_layout<T>;
+            bool exact = k <= layout::max_exact_pow10;
+            if (exact) {
+                std::uint64_t pow5 = 1;
+                for (int i = 0; i < k; ++i) {
+                    pow5 *= 5;
+                }
+                constexpr std::uint64_t max_exact = std::uint64_t(1) << (layout::significand_bits + 1);
+                exact = (d.significand >> std::countr_zero(d.significand)) <= max_exact / pow5;
+            }
+            if (!exact) {
+                return write_exact_integer(first, c, q);
+            }
+        }
+        // The normalized digits already end in zeros
+        write_normalized_digits<T>(first, normalized);
+        if (n + k > width) {
+            std::memset(first + width, '0', static_cast<std::size_t>(n + k - width));
+        }
+        return first + n + k;
+    }
+    int whole = n + k;
+    if (whole > 0) {
+        char digits[width + 24] = {};
+        write_normalized_digits<T>(digits, normalized);
+        std::memcpy(first, digits, 24);
+        std::memcpy(first + whole + 1, digits + whole, 24);
+        first[whole] = '.';
+        return first + n + 1;
+    }
+    first[0] = '0';
+    first[1] = '.';
+    std::memset(first + 2, '0', static_cast<std::size_t>(-whole));
+    write_normalized_digits<T>(first + 2 - whole, normalized);
+    return first + 2 - k;
+}
+
+/**
+ * @brief Writes significand * 10^exponent (after the sign) in the
+ * notation std::to_chars picks for @p fmt. @p c and @p q describe the
+ * binary value for the rare exact-integer case of fixed notation.
+ */
+template <class T>
+std::to_chars_result write_shortest_decimal(char* first, char* last, shortest_decimal d, std::chars_format fmt,
+                                            std::uint64_t c, int q) noexcept
+{
+    int n = decimal_length(d.significand);
+    int k = d.exponent;
+
+    bool fixed;
+    if (fmt == std::chars_format{}) {
+        // Plain: whichever is shorter, fixed on a tie (1e4 -> "10000",
+        // 1e5 -> "1e+05", 1234e5 -> "123400000", 1234e6 -> "1.234e+09")
+        fixed = n == 1 ? -3 <= k && k <= 4 : -(n + 3) <= k && k <= 5;
+    } else if (fmt == std::chars_format::general) {
+        // printf %g with the default precision 6
+        fixed = -4 <= k + n - 1 && k + n - 1 < 6;
+    } else {
+        fixed = fmt == std::chars_format::fixed;
+    }
+
+    // Upper bound of the output length (an exact integer never has more
+    // digits than n + k)
+    int bound = max_shortest_digits<T> + 6;
+    if (fixed) {
+        bound = k >= 0 ? n + k : n + k > 0 ? n + 1 : 2 - k;
+    }
+    if (last - first >= bound + decimal_slack) {
+        return {write_decimal_unchecked<T>(first, d, n, fixed, c, q), std::errc{}};
+    }
+    // Short buffer: lay out in a scratch buffer, then copy what fits
+    char scratch[2 + 330 + decimal_slack];
+    std::size_t length = static_cast<std::size_t>(write_decimal_unchecked<T>(scratch, d, n, fixed, c, q) - scratch);
+    if (static_cast<std::size_t>(last - first) < length) {
+        return {last, std::errc::value_too_large};
+    }
+    std::memcpy(first, scratch, length);
+    return {first + length, std::errc{}};
+}
+
+template <class T>
+std::to_chars_result shortest_to_chars(char* first, char* last, T value, std::chars_format fmt) noexcept
+{
+    using layout = ieee_layout<T>;
+    using U = typename layout::carrier;
+    constexpr int exponent_mask = (1 << layout::exponent_bits) - 1;
+
+    U bits = std::bit_cast<U>(value);
+    U field = bits & ((U(1) << layout::significand_bits) - 1);
+    int biased_exponent = static_cast<int>(bits >> layout::significand_bits) & exponent_mask;
+    // Every result has at least one character, so the sign can be stored
+    // unconditionally
+    if (first == last) {
+        return {last, std::errc::value_too_large};
+    }
+    *first = '-';
+    first += bits >> (layout::significand_bits + layout::exponent_bits);
+
+    if (biased_exponent == exponent_mask) {
+        if (last - first < 3) {
+            return {last, std::errc::value_too_large};
+        }
+        std::memcpy(first, field == 0 ? "inf" : "nan", 3);
+        return {first + 3, std::errc{}};
+    }
+    if (fmt == std::chars_format::hex) {
+        return write_shortest_hex<T>(first, last, field, biased_exponent);
+    }
+    shortest_decimal d{0, 0};
+    if (field != 0 || biased_exponent != 0) {
+        d = to_shortest_decimal<T>(field, biased_exponent);
+    }
+    return write_shortest_decimal<T>(first, last, d, fmt, field | (U(1) << layout::significand_bits),
+                                     biased_exponent - layout::exponent_bias - layout::significand_bits);
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Shortest round-trip conversion, character for character what
+ * std::to_chars(first, last, value) produces with libstdc++ (and MSVC),
+ * without depending on the standard library's floating-point <charconv>
+ * support and faster than its Ryu-based implementations.
+ *
+ * On std::errc::value_too_large, ptr is @p last and the contents of
+ * [first, last) are unspecified, as for std::to_chars. long double is not
+ * covered; use std::to_chars for it.
+ */
+inline std::to_chars_result to_chars(char* first, char* last, double value) noexcept
+{
+    return detail::shortest_to_chars(first, last, value, std::chars_format{});
+}
+
+/// @copydoc to_chars(char*, char*, double)
+inline std::to_chars_result to_chars(char* first, char* last, float value) noexcept
+{
+    return detail::shortest_to_chars(first, last, value, std::chars_format{});
+}
+
+/**
+ * @brief Shortest round-trip conversion in the notation @p fmt selects
+ * (fixed, scientific, general or hex), matching
+ * std::to_chars(first, last, value, fmt).
+ */
+inline std::to_chars_result to_chars(char* first, char* last, double value, std::chars_format fmt) noexcept
+{
+    return detail::shortest_to_chars(first, last, value, fmt);
+}
+
+/// @copydoc to_chars(char*, char*, double, std::chars_format)
+inline std::to_chars_result to_chars(char* first, char* last, float value, std::chars_format fmt) noexcept
+{
+    return detail::shortest_to_chars(first, last, value, fmt);
+}
+}  // namespace std_module
+
+export namespace std_module
+{
+/**
+ * @brief Parses delimited numbers from [first, last) into @p out.
+ *
+ * Fields are separated by @p delimiter or a line break ("\n" or "\r\n"),
+ * so a numeric CSV/TSV file can be parsed in one call; a trailing
+ * separator is allowed. Each field follows std::from_chars syntax (no
+ * whitespace or '+'); integers and common decimals take a branch-light
+ * 8-digits-per-step path, anything unusual is delegated to
+ * std::from_chars, so results always match it exactly. The delimiter
+ * must not be a character that can appear in a number.
+ *
+ * Stops when @p out is full (ptr is then the start of the next field, so
+ * parsing can resume from there), at @p last, or at the first error.
+ *
+ *     std::vector<double> v(rows * cols);
+ *     auto r = std_module::from_chars_batch(csv.data(), csv.data() + csv.size(), std::span(v));
+ *     if (r.ec != std::errc{}) report(r.ptr - csv.data());
+ */
+template <batch_number T, std::size_t Extent>
+from_chars_batch_result from_chars_batch(const char* first, const char* last, std::span<T, Extent> out,
+                                         char delimiter = ',') noexcept
+{
+    from_chars_batch_result result{first, std::errc{}, 0};
+
+    // Parses the field from result.ptr up to the separator at end (or
+    // last); false stops the batch
+    auto field = [&](const char* end) {
+        if (result.count == out.size()) {
+            return false;
+        }
+        const char* stop = end != last && end != result.ptr && end[-1] == '\r' && *end == '\n' ? end - 1 : end;
+        bool parsed = false;
+        if constexpr (std::is_integral_v<T>) {
+            parsed = detail::parse_short_integer(result.ptr, stop, out[result.count], first, last);
+        }
+#if STD_MODULE_CHARCONV_SSE2
+        if constexpr (std::is_floating_point_v<T>) {
+            parsed = detail::parse_short_decimal(result.ptr, stop, out[result.count], first);
+        }
+#endif
+        if (parsed) {
+            ++result.count;
+            result.ptr = end == last ? last : end + 1;
+            return true;
+        }
+        auto r = detail::parse_long_field(result.ptr, stop, out[result.count]);
+        if (r.ec != std::errc{}) {
+            result.ec = r.ec;
+            return false;
+        }
+        if (r.ptr != stop) {
+            result.ptr = r.ptr;
+            result.ec = std::errc::invalid_argument;
+            return false;
+        }
+        ++result.count;
+        result.ptr = end == last ? last : end + 1;
+        return true;
+    };
+
+    // Separators are located 64 bytes at a time first, so each field's
+    // start is known without waiting for the previous field to be parsed
+    // and consecutive fields are converted in parallel by the CPU.
+    const char* p = first;
+    while (last - p >= 64) {
+        for (std::uint64_t mask = detail::separator_mask(p, delimiter); mask != 0; mask &= mask - 1) {
+            if (!field(p + std::countr_zero(mask))) {
+                return result;
+            }
+        }
+        p += 64;
+    }
+    for (; p != last; ++p) {
+        if ((*p == delimiter || *p == '\n') && !field(p)) {
+            return result;
+        }
+    }
+    if (result.ptr != last) {
+        field(last);
+    }
+    return result;
+}
+
+/**
+ * @brief Writes @p values into [first, last) separated by @p separator
+ * (no trailing separator). Integers in base 10, floating point in the
+ * shortest round-trip form, as std::to_chars does.
+ *
+ * If the buffer runs out, stops with std::errc::value_too_large after the
+ * last value that fit completely; ptr then points past that value and
+ * count says how many were written.
+ */
+template <class T, std::size_t Extent>
+    requires batch_number<std::remove_cv_t<T>>
+to_chars_batch_result to_chars_batch(char* first, char* last, std::span<T, Extent> values,
+                                     char separator = ',') noexcept
+{
+    char* p = first;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        char* start = p;
+        if (i != 0) {
+            if (p == last) {
+                return {start, std::errc::value_too_large, i};
+            }
+            *p++ = separator;
+        }
+        std::to_chars_result r;
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, double> || std::is_same_v<std::remove_cv_t<T>, float>) {
+            r = std_module::to_chars(p, last, values[i]);
+        } else {
+            r = std::to_chars(p, last, values[i]);
+        }
+        if (r.ec != std::errc{}) {
+            return {start, r.ec, i};
+        }
+        p = r.ptr;
+    }
+    return {p, std::errc{}, values.size()};
+}
+}  // namespace std_module
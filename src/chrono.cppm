@@ -6,6 +6,45 @@
 module;
 
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ratio>
+#include <stop_token>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define STD_MODULE_CHRONO_X86 1
+#else
+#define STD_MODULE_CHRONO_X86 0
+#endif
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define STD_MODULE_CHRONO_ARM64 1
+#else
+#define STD_MODULE_CHRONO_ARM64 0
+#endif
+
+#if defined(__linux__)
+#include <time.h>
+#define STD_MODULE_CHRONO_LINUX 1
+#else
+#define STD_MODULE_CHRONO_LINUX 0
+#endif
 
 export module std_module.chrono;
 
@@ -193,3 +232,987 @@ using std::chrono_literals::operator""d;
 using std::chrono_literals::operator""y;
 }
 }
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+namespace std_module::detail
+{
+/// Nanoseconds on steady_clock, as a plain integer
+inline std::int64_t chrono_steady_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// True when the hardware counter runs at a constant rate through power states (invariant TSC)
+inline bool chrono_invariant_tsc() noexcept
+{
+#if STD_MODULE_CHRONO_X86
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    if (__get_cpuid(0x80000007u, &a, &b, &c, &d) == 0) {
+        return false;
+    }
+    return (d >> 8 & 1) != 0;
+#elif STD_MODULE_CHRONO_ARM64
+    return true;  // the generic timer counts at the fixed CNTFRQ rate by definition
+#else
+    return false;
+#endif
+}
+
+/// The hardware counter: rdtsc on x86, CNTVCT_EL0 on AArch64
+inline std::uint64_t chrono_read_counter() noexcept
+{
+#if STD_MODULE_CHRONO_X86
+    return __rdtsc();
+#elif STD_MODULE_CHRONO_ARM64
+    std::uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return static_cast<std::uint64_t>(chrono_steady_ns());
+#endif
+}
+
+/// The counter, read only after all earlier instructions have executed (rdtscp; isb on AArch64)
+inline std::uint64_t chrono_read_counter_ordered() noexcept
+{
+#if STD_MODULE_CHRONO_X86
+    unsigned aux;
+    return __rdtscp(&aux);
+#elif STD_MODULE_CHRONO_ARM64
+    std::uint64_t v;
+    asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(v) : : "memory");
+    return v;
+#else
+    return static_cast<std::uint64_t>(chrono_steady_ns());
+#endif
+}
+
+/// (a * b) >> 32 without overflow: a tick count times a 32.32 fixed-point nanoseconds-per-tick factor
+inline std::uint64_t chrono_mul_shift32(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 32);
+#else
+    std::uint64_t lo = (a & 0xFFFFFFFFull) * b;
+    return (a >> 32) * b + (lo >> 32);
+#endif
+}
+
+/// A counter reading paired with the steady_clock time it was taken, from the tightest of a few brackets
+struct chrono_anchor
+{
+    std::uint64_t ticks = 0;
+    std::int64_t ns = 0;
+};
+
+inline chrono_anchor chrono_take_anchor() noexcept
+{
+    chrono_anchor best;
+    std::int64_t best_width = std::numeric_limits<std::int64_t>::max();
+    for (int i = 0; i < 8; ++i) {
+        std::int64_t before = chrono_steady_ns();
+        std::uint64_t ticks = chrono_read_counter_ordered();
+        std::int64_t after = chrono_steady_ns();
+        if (after - before < best_width) {
+            best_width = after - before;
+            best = {ticks, before + (after - before) / 2};
+        }
+    }
+    return best;
+}
+
+/**
+ * Calibration of the counter against steady_clock, behind a sequence
+ * lock so tsc_clock::recalibrate() can replace it while other threads
+ * read: readers retry if the sequence is odd or moved during their
+ * reads. The mapping before the last recalibration is kept for readings
+ * taken before it, so a reading converts to the same time whether it is
+ * converted before or after a recalibration, and later readings never
+ * convert to earlier times.
+ */
+struct chrono_tsc_state
+{
+    static constexpr std::int64_t window_ns = 10'000'000;
+
+    bool counter = false;  // false: the counter is unusable and tsc_clock reads steady_clock
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint64_t> base_ticks{0};
+    std::atomic<std::int64_t> base_ns{0};
+    std::atomic<std::uint64_t> mult{std::uint64_t{1} << 32};  // nanoseconds per tick, 32.32 fixed point
+    std::atomic<std::uint64_t> prev_ticks{0};                 // the mapping before the last recalibration
+    std::atomic<std::int64_t> prev_ns{0};
+    std::atomic<std::uint64_t> prev_mult{std::uint64_t{1} << 32};
+    chrono_anchor first;                                     // the startup anchor, for recalibration
+    std::mutex writer;
+
+    chrono_tsc_state()
+    {
+        counter = chrono_invariant_tsc();
+        if (!counter) {
+            return;
+        }
+        first = chrono_take_anchor();
+        while (chrono_steady_ns() - first.ns < window_ns) {
+        }
+        chrono_anchor last = chrono_take_anchor();
+        base_ticks.store(last.ticks, std::memory_order_relaxed);
+        base_ns.store(last.ns, std::memory_order_relaxed);
+        mult.store(slope(first, last), std::memory_order_relaxed);
+        prev_ticks.store(last.ticks, std::memory_order_relaxed);
+        prev_ns.store(last.ns, std::memory_order_relaxed);
+        prev_mult.store(mult.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    static std::uint64_t slope(const chrono_anchor& a, const chrono_anchor& b) noexcept
+    {
+        double ns_per_tick = static_cast<double>(b.ns - a.ns) / static_cast<double>(b.ticks - a.ticks);
+        return static_cast<std::uint64_t>(ns_per_tick * 4294967296.0 + 0.5);
+    }
+
+    static std::int64_t map(std::uint64_t ticks, std::uint64_t bt, std::int64_t bn, std::uint64_t m) noexcept
+    {
+        return ticks >= bt ? bn + static_cast<std::int64_t>(chrono_mul_shift32(ticks - bt, m))
+                           : bn - static_cast<std::int64_t>(chrono_mul_shift32(bt - ticks, m));
+    }
+
+    std::int64_t to_ns(std::uint64_t ticks) const noexcept
+    {
+        for (;;) {
+            // Acquire loads keep the second sequence read after the fields
+            std::uint32_t seq = sequence.load(std::memory_order_acquire);
+            std::uint64_t bt = base_ticks.load(std::memory_order_acquire);
+            std::int64_t ns;
+            if (ticks >= bt) {
+                ns = map(ticks, bt, base_ns.load(std::memory_order_acquire), mult.load(std::memory_order_acquire));
+            } else {
+                // Taken before the last recalibration: convert as it was converted then
+                ns = map(ticks, prev_ticks.load(std::memory_order_acquire), prev_ns.load(std::memory_order_acquire),
+                         prev_mult.load(std::memory_order_acquire));
+            }
+            if ((seq & 1) == 0 && sequence.load(std::memory_order_relaxed) == seq) {
+                return ns;
+            }
+        }
+    }
+
+    void recalibrate() noexcept
+    {
+        if (!counter) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(writer);
+        chrono_anchor now = chrono_take_anchor();
+        std::uint64_t m = slope(first, now);
+        std::uint64_t old_ticks = base_ticks.load(std::memory_order_relaxed);
+        std::int64_t old_ns = base_ns.load(std::memory_order_relaxed);
+        std::uint64_t old_mult = mult.load(std::memory_order_relaxed);
+        sequence.fetch_add(1, std::memory_order_acq_rel);
+        // Switch mappings at a reading taken inside the write, so readings
+        // already converted with the old mapping all precede it, and keep
+        // the old mapping for those before it. At the switch, continue
+        // from the old mapping, or catch up to steady_clock if behind it:
+        // never step backwards.
+        std::uint64_t at = chrono_read_counter_ordered();
+        std::int64_t current = map(at, old_ticks, old_ns, old_mult);
+        std::int64_t steady = map(at, now.ticks, now.ns, m);
+        prev_ticks.store(old_ticks, std::memory_order_release);
+        prev_ns.store(old_ns, std::memory_order_release);
+        prev_mult.store(old_mult, std::memory_order_release);
+        base_ticks.store(at, std::memory_order_release);
+        base_ns.store(current > steady ? current : steady, std::memory_order_release);
+        mult.store(m, std::memory_order_release);
+        sequence.fetch_add(1, std::memory_order_release);
+    }
+};
+
+inline chrono_tsc_state& chrono_tsc() noexcept
+{
+    static chrono_tsc_state state;
+    return state;
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Clock on the CPU timestamp counter: rdtsc on x86, CNTVCT_EL0 on
+ * AArch64.
+ *
+ * now() is one counter read plus a fixed-point multiply, with none of
+ * clock_gettime's vDSO sequence lock and conversion. The counter is
+ * calibrated against steady_clock once, on first use, over a 10 ms
+ * window, and time points share steady_clock's epoch, so the two can be
+ * compared directly. The x86 counter is used only when CPUID reports an
+ * invariant TSC (constant rate through frequency and sleep states);
+ * otherwise, and on other architectures, every call forwards to
+ * steady_clock and uses_counter() is false. For tracing, store ticks()
+ * on the hot path and convert with from_ticks() later. A 10 ms
+ * calibration is good to a few parts per million; recalibrate() re-fits
+ * the rate over the whole time since startup, so calling it now and then
+ * (say, every few minutes) keeps long runs in step with steady_clock.
+ */
+class tsc_clock
+{
+public:
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<tsc_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept { return from_ticks(ticks()); }
+
+    /// Raw counter value (steady_clock nanoseconds when the counter is unused)
+    static std::uint64_t ticks() noexcept
+    {
+        return detail::chrono_tsc().counter ? detail::chrono_read_counter()
+                                            : static_cast<std::uint64_t>(detail::chrono_steady_ns());
+    }
+
+    /// Like ticks(), but not read before earlier instructions finish (rdtscp), for timing a code region's end
+    static std::uint64_t ticks_ordered() noexcept
+    {
+        return detail::chrono_tsc().counter ? detail::chrono_read_counter_ordered()
+                                            : static_cast<std::uint64_t>(detail::chrono_steady_ns());
+    }
+
+    /// The time point at which ticks() returned @p ticks
+    static time_point from_ticks(std::uint64_t ticks) noexcept
+    {
+        const detail::chrono_tsc_state& state = detail::chrono_tsc();
+        if (!state.counter) {
+            return time_point(duration(static_cast<rep>(ticks)));
+        }
+        return time_point(duration(state.to_ns(ticks)));
+    }
+
+    /// The length of @p ticks counter ticks
+    static duration to_duration(std::uint64_t ticks) noexcept
+    {
+        const detail::chrono_tsc_state& state = detail::chrono_tsc();
+        if (!state.counter) {
+            return duration(static_cast<rep>(ticks));
+        }
+        return duration(static_cast<rep>(
+            detail::chrono_mul_shift32(ticks, state.mult.load(std::memory_order_relaxed))));
+    }
+
+    /// Calibrated counter frequency
+    static double ticks_per_second() noexcept
+    {
+        const detail::chrono_tsc_state& state = detail::chrono_tsc();
+        return 1e9 * 4294967296.0 / static_cast<double>(state.mult.load(std::memory_order_relaxed));
+    }
+
+    /// Whether now() reads the counter (false: it forwards to steady_clock)
+    static bool uses_counter() noexcept { return detail::chrono_tsc().counter; }
+
+    /// Whether the CPU reports an invariant TSC (always true on AArch64, false elsewhere)
+    static bool invariant_tsc() noexcept { return detail::chrono_invariant_tsc(); }
+
+    /// Re-fits the counter rate against steady_clock over all the time since calibration; thread-safe
+    static void recalibrate() noexcept { detail::chrono_tsc().recalibrate(); }
+
+    /// The same instant on steady_clock (the epochs coincide)
+    static std::chrono::steady_clock::time_point to_steady(time_point t) noexcept
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(t.time_since_epoch()));
+    }
+};
+}  // namespace std_module
+
+// ------------------------------------------------------------------------------
+// Coarse clocks
+// ------------------------------------------------------------------------------
+
+namespace std_module::detail
+{
+/// The time coarse_clock::now() returns, on a cache line of its own so writes next to it never evict it from readers
+struct alignas(64) chrono_coarse_cell
+{
+    std::atomic<std::int64_t> ns{0};  // steady_clock nanoseconds; 0 while the ticker is stopped
+};
+
+inline constinit chrono_coarse_cell chrono_coarse_now;
+
+/**
+ * The background ticker behind coarse_clock: a jthread storing
+ * steady_clock's time into chrono_coarse_now once per resolution. Only
+ * the slow paths (first use, stop(), set_resolution()) come here.
+ */
+struct chrono_coarse_ticker
+{
+    static constexpr std::int64_t min_resolution_ns = 10'000;
+
+    std::mutex mutex;
+    std::condition_variable_any wake;
+    std::int64_t resolution_ns = 1'000'000;
+    bool changed = false;
+    std::unique_ptr<std::jthread> thread;
+
+    ~chrono_coarse_ticker() { stop(); }
+
+    // Called with mutex held: reading and storing under one lock keeps the stored times increasing
+    void tick() noexcept { chrono_coarse_now.ns.store(chrono_steady_ns(), std::memory_order_relaxed); }
+
+    void run(std::stop_token stop)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stop.stop_requested()) {
+            tick();
+            wake.wait_for(lock, stop, std::chrono::nanoseconds(resolution_ns), [&] { return changed; });
+            changed = false;
+        }
+    }
+
+    /// Starts the ticker if it is not running; returns the current coarse time
+    std::int64_t start() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!thread) {
+            try {
+                thread = std::make_unique<std::jthread>([this](std::stop_token stop) { run(stop); });
+            } catch (...) {
+                return chrono_steady_ns();  // no thread to be had: read steady_clock and try again next call
+            }
+            tick();
+        }
+        return chrono_coarse_now.ns.load(std::memory_order_relaxed);
+    }
+
+    void stop() noexcept
+    {
+        std::unique_ptr<std::jthread> old;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!thread) {
+                return;
+            }
+            thread->request_stop();
+            old = std::move(thread);
+            chrono_coarse_now.ns.store(0, std::memory_order_relaxed);
+        }
+        old.reset();  // joins outside the lock, which the ticker needs to wake up and leave
+    }
+
+    void set_resolution(std::int64_t ns) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        resolution_ns = ns < min_resolution_ns ? min_resolution_ns : ns;
+        changed = true;
+        wake.notify_all();
+    }
+};
+
+inline chrono_coarse_ticker& chrono_coarse() noexcept
+{
+    static chrono_coarse_ticker ticker;
+    return ticker;
+}
+
+/// CLOCK_MONOTONIC_COARSE (steady_clock where it does not exist), in nanoseconds
+inline std::int64_t chrono_monotonic_coarse_ns() noexcept
+{
+#if STD_MODULE_CHRONO_LINUX && defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+#else
+    return chrono_steady_ns();
+#endif
+}
+
+inline std::int64_t chrono_monotonic_coarse_resolution_ns() noexcept
+{
+#if STD_MODULE_CHRONO_LINUX && defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts;
+    if (clock_getres(CLOCK_MONOTONIC_COARSE, &ts) == 0) {
+        return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+    }
+#endif
+    return 1;
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Clock whose now() is one relaxed atomic load, for code that
+ * needs "the time to the millisecond" millions of times a second (cache
+ * TTLs, rate limiters, timeouts).
+ *
+ * A background std::jthread stores steady_clock's time into a single
+ * cache line once per resolution (1 ms by default), and now() reads it:
+ * no system call, no counter read, and no writes, so any number of
+ * threads read it without contending. The price is accuracy: now()
+ * trails steady_clock by up to one resolution plus the ticker's wake-up
+ * latency. Time points share steady_clock's epoch and never go backwards.
+ *
+ * The ticker starts on the first now() (or start()) and runs until
+ * stop() or program exit; a now() after stop() starts it again.
+ * set_resolution() takes effect at once, down to 10 us; each tick costs
+ * the ticker thread a wake-up, so keep it as coarse as callers allow.
+ */
+class coarse_clock
+{
+public:
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<coarse_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+        std::int64_t ns = detail::chrono_coarse_now.ns.load(std::memory_order_relaxed);
+        if (ns == 0) [[unlikely]] {
+            ns = detail::chrono_coarse().start();
+        }
+        return time_point(duration(ns));
+    }
+
+    /// Starts the ticker ahead of the first now(), so that call does not pay for creating the thread
+    static void start() noexcept { detail::chrono_coarse().start(); }
+
+    /// Stops and joins the ticker
+    static void stop() noexcept { detail::chrono_coarse().stop(); }
+
+    /// Whether the ticker is running
+    static bool running() noexcept { return detail::chrono_coarse_now.ns.load(std::memory_order_relaxed) != 0; }
+
+    /// How often the ticker updates the time
+    static duration resolution() noexcept
+    {
+        detail::chrono_coarse_ticker& ticker = detail::chrono_coarse();
+        std::lock_guard<std::mutex> lock(ticker.mutex);
+        return duration(ticker.resolution_ns);
+    }
+
+    /// Sets how often the ticker updates the time; values below 10 us are raised to 10 us
+    static void set_resolution(duration d) noexcept { detail::chrono_coarse().set_resolution(d.count()); }
+
+    /// The same instant on steady_clock (the epochs coincide)
+    static std::chrono::steady_clock::time_point to_steady(time_point t) noexcept
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(t.time_since_epoch()));
+    }
+};
+
+/**
+ * @brief The kernel's coarse monotonic clock, CLOCK_MONOTONIC_COARSE.
+ *
+ * Served from the vDSO like steady_clock, but returns the time of the
+ * last timer interrupt instead of reading the hardware counter, so it is
+ * cheaper and as coarse as the kernel tick (resolution(), commonly 1 to
+ * 4 ms). Needs no background thread, unlike coarse_clock, but still
+ * costs a call and a sequence-lock read per now(). Time points share
+ * steady_clock's epoch. Where CLOCK_MONOTONIC_COARSE does not exist,
+ * this is steady_clock.
+ */
+class monotonic_coarse_clock
+{
+public:
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<monotonic_coarse_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept { return time_point(duration(detail::chrono_monotonic_coarse_ns())); }
+
+    /// The clock's granularity, as reported by clock_getres
+    static duration resolution() noexcept { return duration(detail::chrono_monotonic_coarse_resolution_ns()); }
+
+    /// The same instant on steady_clock (the epochs coincide)
+    static std::chrono::steady_clock::time_point to_steady(time_point t) noexcept
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(t.time_since_epoch()));
+    }
+};
+}  // namespace std_module
+
+// ------------------------------------------------------------------------------
+// Calendar and time zone conversion
+// ------------------------------------------------------------------------------
+
+namespace std_module::detail
+{
+// Calendar arithmetic on days counted from 0000-03-01, so leap days fall at
+// the end of the year (Howard Hinnant's days_from_civil/civil_from_days).
+// The fast paths are Neri and Schneider's refinement of the same algorithm
+// ("Euclidean affine functions and their application to calendar
+// algorithms", 2022): shifted far enough that everything is unsigned
+// 32-bit, with each division by a calendar constant a multiply and shift.
+// They cover far more than the range of std::chrono::year; the signed
+// 64-bit forms handle the rest.
+inline constexpr std::uint32_t chrono_shift_years = 1'468'000;  // 3670 400-year eras
+inline constexpr std::uint32_t chrono_shift_days = 536'895'458;  // 3670 eras plus 0000-03-01 to 1970-01-01, in days
+
+/// Days from 1970-01-01 to a proleptic Gregorian date
+constexpr std::int64_t chrono_days_from_civil(std::int64_t y, unsigned m, unsigned d) noexcept
+{
+    if (y > -static_cast<std::int64_t>(chrono_shift_years) && y < 1'400'000) {
+        auto y1 = static_cast<std::uint32_t>(y + chrono_shift_years);
+        std::uint32_t before_march = m < 3;
+        std::uint32_t y0 = y1 - before_march;
+        std::uint32_t m0 = before_march ? m + 12 : m;  // [3, 14]
+        std::uint32_t century = y0 / 100;
+        std::uint32_t year_days = 1461 * y0 / 4 - century + century / 4;
+        std::uint32_t month_days = (979 * m0 - 2919) / 32;
+        // Modulo 2^32, so day 0 (and other out-of-range days) still count linearly
+        return static_cast<std::int32_t>(year_days + month_days + d - 1 - chrono_shift_days);
+    }
+    y -= m <= 2;
+    std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    std::int64_t yoe = y - era * 400;                                                 // [0, 399]
+    std::int64_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + std::int64_t{d} - 1;  // [0, 365], from March 1
+    return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+}
+
+struct chrono_civil
+{
+    std::int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+/// The proleptic Gregorian date @p z days after 1970-01-01
+constexpr chrono_civil chrono_civil_from_days(std::int64_t z) noexcept
+{
+    if (z >= -static_cast<std::int64_t>(chrono_shift_days) && z < 536'846'366) {
+        std::uint32_t r0 = static_cast<std::uint32_t>(z) + chrono_shift_days;
+        std::uint32_t n1 = 4 * r0 + 3;
+        std::uint32_t centuries = n1 / 146097;
+        std::uint32_t day_of_century = n1 % 146097 / 4;
+        std::uint64_t u2 = std::uint64_t{2939745} * (4 * day_of_century + 3);
+        auto year_of_century = static_cast<std::uint32_t>(u2 >> 32);
+        std::uint32_t day_of_year = static_cast<std::uint32_t>(u2) / 2939745 / 4;  // [0, 365], from March 1
+        std::uint32_t n3 = 2141 * day_of_year + 197913;
+        std::uint32_t month = n3 >> 16;                                          // [3, 14]
+        std::uint32_t day = (n3 & 0xFFFF) / 2141 + 1;
+        std::uint32_t january = day_of_year >= 306;
+        std::uint32_t y = 100 * centuries + year_of_century + january;
+        return {static_cast<std::int64_t>(y) - chrono_shift_years, january ? month - 12 : month, day};
+    }
+    z += 719468;
+    std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    auto doe = static_cast<unsigned>(z - era * 146097);                      // [0, 146096]
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                // [0, 365], from March 1
+    unsigned mp = (5 * doy + 2) / 153;                                     // [0, 11], March = 0
+    unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    return {static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2), m, d};
+}
+
+constexpr unsigned chrono_last_day(std::int64_t y, unsigned m) noexcept
+{
+    if (m != 2) {
+        return m == 4 || m == 6 || m == 9 || m == 11 ? 30 : 31;
+    }
+    return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0) ? 29 : 28;
+}
+
+inline constexpr char chrono_digit_pairs[] = "0001020304050607080910111213141516171819"
+                                             "2021222324252627282930313233343536373839"
+                                             "4041424344454647484950515253545556575859"
+                                             "6061626364656667686970717273747576777879"
+                                             "8081828384858687888990919293949596979899";
+
+inline constexpr std::int64_t chrono_pow10[] = {1,
+                                                10,
+                                                100,
+                                                1'000,
+                                                10'000,
+                                                100'000,
+                                                1'000'000,
+                                                10'000'000,
+                                                100'000'000,
+                                                1'000'000'000,
+                                                10'000'000'000,
+                                                100'000'000'000,
+                                                1'000'000'000'000,
+                                                10'000'000'000'000,
+                                                100'000'000'000'000,
+                                                1'000'000'000'000'000,
+                                                10'000'000'000'000'000,
+                                                100'000'000'000'000'000,
+                                                1'000'000'000'000'000'000};
+
+inline void chrono_write2(char* p, unsigned v) noexcept
+{
+    p[0] = chrono_digit_pairs[2 * v];
+    p[1] = chrono_digit_pairs[2 * v + 1];
+}
+
+/// Writes @p v as exactly @p n digits, zero-padded, ending just before @p end
+inline void chrono_write_digits(char* end, std::uint64_t v, int n) noexcept
+{
+    for (; n >= 2; n -= 2) {
+        end -= 2;
+        chrono_write2(end, static_cast<unsigned>(v % 100));
+        v /= 100;
+    }
+    if (n != 0) {
+        *--end = static_cast<char>('0' + v % 10);
+    }
+}
+
+inline int chrono_digit_count(std::uint64_t v) noexcept
+{
+    int n = 1;
+    for (; v >= 10; v /= 10) {
+        ++n;
+    }
+    return n;
+}
+
+/// Reads the two digits at @p p; false if either is not a digit
+inline bool chrono_read2(const char* p, unsigned& v) noexcept
+{
+    auto hi = static_cast<unsigned>(p[0] - '0');
+    auto lo = static_cast<unsigned>(p[1] - '0');
+    v = hi * 10 + lo;
+    return hi < 10 && lo < 10;
+}
+
+/// Digits after the decimal point for @p Duration: the std::format rule (hh_mm_ss::fractional_width)
+template <class Duration>
+inline constexpr int chrono_fraction_digits = std::chrono::hh_mm_ss<Duration>::fractional_width;
+
+template <class Duration>
+std::to_chars_result chrono_format_iso8601(char* first, char* last, std::chrono::sys_time<Duration> t,
+                                           std::int64_t offset, bool zulu) noexcept
+{
+    static_assert(!std::chrono::treat_as_floating_point_v<typename Duration::rep>,
+                  "ISO 8601 formatting needs an integral duration");
+    constexpr int fraction_digits = chrono_fraction_digits<Duration>;
+    auto whole = std::chrono::floor<std::chrono::seconds>(t);
+    std::uint64_t fraction = 0;
+    if constexpr (fraction_digits > 0) {
+        using precision = typename std::chrono::hh_mm_ss<Duration>::precision;
+        fraction = static_cast<std::uint64_t>(std::chrono::duration_cast<precision>(t - whole).count());
+    }
+
+    std::int64_t s = whole.time_since_epoch().count() + offset;
+    std::int64_t days = s / 86400 - (s % 86400 < 0);
+    auto second_of_day = static_cast<unsigned>(s - days * 86400);
+    chrono_civil date = chrono_civil_from_days(days);
+
+    // Years outside [0, 9999] get a sign if negative and as many digits as they need, as with %Y
+    bool plain_year = date.year >= 0 && date.year <= 9999;
+    std::uint64_t year_abs =
+        date.year < 0 ? 0 - static_cast<std::uint64_t>(date.year) : static_cast<std::uint64_t>(date.year);
+    int year_digits = plain_year ? 4 : std::max(4, chrono_digit_count(year_abs));
+    std::ptrdiff_t size = (date.year < 0) + year_digits + 15 + (fraction_digits > 0 ? fraction_digits + 1 : 0) +
+                          (zulu ? 1 : 6);
+    if (last - first < size) {
+        return {last, std::errc::value_too_large};
+    }
+
+    char* p = first;
+    if (date.year < 0) {
+        *p++ = '-';
+    }
+    chrono_write_digits(p + year_digits, year_abs, year_digits);
+    p += year_digits;
+    p[0] = '-';
+    chrono_write2(p + 1, date.month);
+    p[3] = '-';
+    chrono_write2(p + 4, date.day);
+    p[6] = 'T';
+    chrono_write2(p + 7, second_of_day / 3600);
+    p[9] = ':';
+    chrono_write2(p + 10, second_of_day / 60 % 60);
+    p[12] = ':';
+    chrono_write2(p + 13, second_of_day % 60);
+    p += 15;
+    if constexpr (fraction_digits > 0) {
+        *p++ = '.';
+        chrono_write_digits(p + fraction_digits, fraction, fraction_digits);
+        p += fraction_digits;
+    }
+    if (zulu) {
+        *p++ = 'Z';
+    } else {
+        // ISO 8601 offsets stop at minutes; the seconds of historical offsets are dropped
+        std::int64_t minutes = (offset < 0 ? -offset : offset) / 60;
+        p[0] = offset < 0 ? '-' : '+';
+        chrono_write2(p + 1, static_cast<unsigned>(minutes / 60 % 100));
+        p[3] = ':';
+        chrono_write2(p + 4, static_cast<unsigned>(minutes % 60));
+        p += 6;
+    }
+    return {p, std::errc{}};
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief year_month_day of a sys_days, by Howard Hinnant's civil_from_days
+ * in Neri and Schneider's unsigned 32-bit form.
+ *
+ * A dozen integer operations with no table, branch or loop; constexpr,
+ * and valid over the whole range of year.
+ */
+constexpr std::chrono::year_month_day to_year_month_day(std::chrono::sys_days d) noexcept
+{
+    detail::chrono_civil c = detail::chrono_civil_from_days(d.time_since_epoch().count());
+    return {std::chrono::year(static_cast<int>(c.year)), std::chrono::month(c.month), std::chrono::day(c.day)};
+}
+
+/**
+ * @brief sys_days of a year_month_day, by Howard Hinnant's days_from_civil
+ * in Neri and Schneider's unsigned 32-bit form.
+ *
+ * Like sys_days's conversion, a day past the end of the month carries
+ * into the next (2023-02-30 is 2023-03-02); the month must be valid.
+ */
+constexpr std::chrono::sys_days to_sys_days(const std::chrono::year_month_day& ymd) noexcept
+{
+    return std::chrono::sys_days(std::chrono::days(detail::chrono_days_from_civil(
+        static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()))));
+}
+
+/// Buffer size that fits format_iso8601 of any sys_time
+inline constexpr std::size_t iso8601_buffer_size = 64;
+
+/**
+ * @brief Writes @p t as ISO 8601 UTC into [first, last):
+ * "2024-02-29T13:05:07.123Z".
+ *
+ * Seconds get as many decimals as Duration needs, by the std::format
+ * rule (none for seconds, 3 for milliseconds, 9 for nanoseconds). Like
+ * std::to_chars, returns {end, errc()} or, if the buffer is too small,
+ * {last, errc::value_too_large}; iso8601_buffer_size always suffices.
+ * No locale, no streams, no allocation.
+ */
+template <class Duration>
+std::to_chars_result format_iso8601(char* first, char* last, std::chrono::sys_time<Duration> t) noexcept
+{
+    return detail::chrono_format_iso8601(first, last, t, 0, true);
+}
+
+/**
+ * @brief Writes @p t as ISO 8601 local time at UTC offset @p offset:
+ * "2024-02-29T08:05:07.123-05:00".
+ *
+ * Pair with zone_cache::offset() for time zones. Offsets are written to
+ * the minute.
+ */
+template <class Duration>
+std::to_chars_result format_iso8601(char* first, char* last, std::chrono::sys_time<Duration> t,
+                                    std::chrono::seconds offset) noexcept
+{
+    return detail::chrono_format_iso8601(first, last, t, offset.count(), false);
+}
+
+/**
+ * @brief Parses an ISO 8601 date and time from [first, last) into @p out.
+ *
+ * Accepts "YYYY-MM-DDTHH:MM:SS" ('t' or a space also separate date and
+ * time), then optionally a fraction after '.' or ',' of any length (cut
+ * to Duration's resolution, rounding down), then optionally 'Z' or an
+ * offset "+HH:MM", "+HHMM" or "+HH"; without one the time is taken as
+ * UTC. Years are four digits. Like std::from_chars, returns the end of
+ * the parsed text and errc(), {first, errc::invalid_argument} for text
+ * that is not such a timestamp or names an invalid date or time, or
+ * errc::result_out_of_range when the instant does not fit Duration.
+ */
+template <class Duration>
+std::from_chars_result parse_iso8601(const char* first, const char* last,
+                                     std::chrono::sys_time<Duration>& out) noexcept
+{
+    using detail::chrono_read2;
+    const char* p = first;
+    unsigned century, year, month, day, hour, minute, second;
+    if (last - p < 19 || !chrono_read2(p, century) || !chrono_read2(p + 2, year) || p[4] != '-' ||
+        !chrono_read2(p + 5, month) || p[7] != '-' || !chrono_read2(p + 8, day) ||
+        (p[10] != 'T' && p[10] != 't' && p[10] != ' ') || !chrono_read2(p + 11, hour) || p[13] != ':' ||
+        !chrono_read2(p + 14, minute) || p[16] != ':' || !chrono_read2(p + 17, second)) {
+        return {first, std::errc::invalid_argument};
+    }
+    std::int64_t y = century * 100 + year;
+    if (month - 1 > 11 || day - 1 >= detail::chrono_last_day(y, month) || hour > 23 || minute > 59 || second > 59) {
+        return {first, std::errc::invalid_argument};
+    }
+    p += 19;
+
+    std::int64_t fraction = 0;
+    int fraction_digits = 0;
+    if (p != last && (*p == '.' || *p == ',')) {
+        const char* q = p + 1;
+        for (; q != last && static_cast<unsigned>(*q - '0') < 10; ++q) {
+            if (fraction_digits < 18) {
+                fraction = fraction * 10 + (*q - '0');
+                ++fraction_digits;
+            }
+        }
+        if (q == p + 1) {
+            return {first, std::errc::invalid_argument};
+        }
+        p = q;
+    }
+
+    std::int64_t offset = 0;
+    if (p != last && (*p == 'Z' || *p == 'z')) {
+        ++p;
+    } else if (p != last && (*p == '+' || *p == '-')) {
+        unsigned offset_hours, offset_minutes = 0;
+        if (last - p < 3 || !chrono_read2(p + 1, offset_hours)) {
+            return {first, std::errc::invalid_argument};
+        }
+        const char* q = p + 3;
+        if (q != last && *q == ':') {
+            if (last - q < 3 || !chrono_read2(q + 1, offset_minutes)) {
+                return {first, std::errc::invalid_argument};
+            }
+            q += 3;
+        } else if (last - q >= 2 && chrono_read2(q, offset_minutes)) {
+            q += 2;
+        }
+        if (offset_hours > 23 || offset_minutes > 59) {
+            return {first, std::errc::invalid_argument};
+        }
+        offset = static_cast<std::int64_t>(offset_hours * 3600 + offset_minutes * 60) * (*p == '-' ? -1 : 1);
+        p = q;
+    }
+
+    std::int64_t s =
+        detail::chrono_days_from_civil(y, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset;
+    using precision = typename std::chrono::hh_mm_ss<Duration>::precision;
+    constexpr int digits = detail::chrono_fraction_digits<Duration>;
+    if constexpr (std::ratio_less_equal_v<typename Duration::period, std::ratio<1>>) {
+        constexpr std::int64_t limit =
+            std::min<std::int64_t>(std::chrono::duration_cast<std::chrono::seconds>(Duration::max()).count(),
+                                   std::chrono::duration_cast<std::chrono::seconds>(precision::max()).count());
+        if (s >= limit || s <= -limit) {
+            return {p, std::errc::result_out_of_range};
+        }
+    }
+    std::int64_t scaled = 0;
+    if constexpr (digits > 0) {
+        scaled = fraction_digits >= digits ? fraction / detail::chrono_pow10[fraction_digits - digits]
+                                           : fraction * detail::chrono_pow10[digits - fraction_digits];
+    }
+    out = std::chrono::floor<Duration>(std::chrono::sys_seconds(std::chrono::seconds(s)) + precision(scaled));
+    return {p, std::errc{}};
+}
+
+/**
+ * @brief Per-zone cache of UTC offset periods, for converting many
+ * timestamps in one time zone.
+ *
+ * time_zone::get_info() and zoned_time search the zone's rules on every
+ * call. zone_cache keeps each sys_info it has looked up in a sorted
+ * table and remembers the last one used, so a timestamp in the same
+ * period as the previous one, or in the next period, costs two
+ * comparisons: O(1) for increasing timestamps, as in a log. Other
+ * timestamps binary-search the table and only ask the zone on a miss;
+ * preload() fills the table for a range up front.
+ *
+ * TimeZonePtr is as for zoned_time: anything with ->get_info(sys_seconds).
+ * A cache is not thread-safe; give each thread its own. References it
+ * returns are valid until its next call.
+ *
+ *     std_module::zone_cache ny("America/New_York");
+ *     for (auto t : timestamps) {
+ *         auto end = std_module::format_iso8601(buf, buf + sizeof buf, t, ny.offset(t)).ptr;
+ *     }
+ */
+template <class TimeZonePtr = const std::chrono::time_zone*>
+class zone_cache
+{
+public:
+    explicit zone_cache(TimeZonePtr zone) : zone_(std::move(zone)) {}
+
+    /// The zone named @p name, found through zoned_traits like zoned_time does
+    explicit zone_cache(std::string_view name) : zone_(std::chrono::zoned_traits<TimeZonePtr>::locate_zone(name)) {}
+
+    TimeZonePtr get_time_zone() const { return zone_; }
+
+    /// The period in effect at @p t: its UTC range, offset, DST save and abbreviation
+    template <class Duration>
+    const std::chrono::sys_info& info(std::chrono::sys_time<Duration> t)
+    {
+        auto s = std::chrono::floor<std::chrono::seconds>(t);
+        if (cursor_ < periods_.size()) {
+            const std::chrono::sys_info& current = periods_[cursor_];
+            if (current.begin <= s && s < current.end) {
+                return current;
+            }
+        }
+        return lookup(s);
+    }
+
+    /// UTC offset at @p t
+    template <class Duration>
+    std::chrono::seconds offset(std::chrono::sys_time<Duration> t)
+    {
+        return info(t).offset;
+    }
+
+    /// Local time at @p t, as zoned_time::get_local_time() would give
+    template <class Duration>
+    std::chrono::local_time<std::common_type_t<Duration, std::chrono::seconds>> to_local(
+        std::chrono::sys_time<Duration> t)
+    {
+        return std::chrono::local_time<std::common_type_t<Duration, std::chrono::seconds>>(
+            (t + info(t).offset).time_since_epoch());
+    }
+
+    /// Looks up every period overlapping [begin, end), so later lookups in that range never reach the zone
+    void preload(std::chrono::sys_seconds begin, std::chrono::sys_seconds end)
+    {
+        for (std::chrono::sys_seconds s = begin; s < end;) {
+            s = info(s).end;
+        }
+        cursor_ = 0;
+    }
+
+    /// Number of cached periods
+    std::size_t size() const noexcept { return periods_.size(); }
+
+    void clear() noexcept
+    {
+        periods_.clear();
+        cursor_ = 0;
+    }
+
+private:
+    const std::chrono::sys_info& lookup(std::chrono::sys_seconds s)
+    {
+        auto contains = [s](const std::chrono::sys_info& i) { return i.begin <= s && s < i.end; };
+        if (cursor_ + 1 < periods_.size() && contains(periods_[cursor_ + 1])) {
+            return periods_[++cursor_];
+        }
+        auto before = [](std::chrono::sys_seconds v, const std::chrono::sys_info& i) { return v < i.begin; };
+        auto it = std::upper_bound(periods_.begin(), periods_.end(), s, before);
+        if (it != periods_.begin() && contains(*std::prev(it))) {
+            cursor_ = static_cast<std::size_t>(std::prev(it) - periods_.begin());
+            return periods_[cursor_];
+        }
+        it = periods_.insert(it, zone_->get_info(s));
+        cursor_ = static_cast<std::size_t>(it - periods_.begin());
+        return *it;
+    }
+
+    TimeZonePtr zone_;
+    std::vector<std::chrono::sys_info> periods_;
+    std::size_t cursor_ = 0;
+};
+
+/// A zone name deduces the default TimeZonePtr, as for zoned_time
+template <class TimeZonePtrOrName>
+zone_cache(TimeZonePtrOrName&&)
+    -> zone_cache<std::conditional_t<std::is_convertible_v<TimeZonePtrOrName, std::string_view>,
+                                     const std::chrono::time_zone*, std::remove_cvref_t<TimeZonePtrOrName>>>;
+}  // namespace std_module
@@ -6,6 +6,33 @@
 module;
 
 #include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define STD_MODULE_FILESYSTEM_LINUX 1
+#else
+#define STD_MODULE_FILESYSTEM_LINUX 0
+#endif
 
 export module std_module.filesystem;
 
@@ -89,3 +116,689 @@ using std::filesystem::end;
 }  // namespace filesystem
 
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module
+{
+/// One directory entry seen by parallel_walk
+struct walk_entry
+{
+    std::string_view name;           ///< File name within its directory; valid during the callback only
+    std::filesystem::file_type type; ///< The entry's own type: symlinks are reported as symlinks, not followed
+    std::uint64_t inode;             ///< Inode number (0 where the platform does not report one)
+};
+
+/// A batch of entries from one directory, as handed to parallel_walk's callback
+struct walk_batch
+{
+    const std::filesystem::path& directory; ///< The directory holding the entries
+    int depth;                              ///< Depth of the entries: 0 for the root's children
+    std::span<const walk_entry> entries;
+};
+
+struct walk_options
+{
+    unsigned threads = 0;                ///< Threads walking, the caller included; 0: hardware_concurrency()
+    int max_depth = -1;                  ///< Deepest entries reported (the root's children are 0); -1: no limit
+    std::size_t read_buffer = 64 * 1024; ///< Bytes of directory entries read per system call, and so per batch
+};
+
+struct walk_stats
+{
+    std::uint64_t entries = 0;     ///< Entries seen, filtered or not
+    std::uint64_t directories = 0; ///< Directories read, the root included
+    std::uint64_t errors = 0;      ///< Directories that could not be opened or read, and skipped
+};
+}  // namespace std_module
+
+namespace std_module::detail
+{
+struct walk_all
+{
+    bool operator()(const std::filesystem::path&, const walk_entry&) const noexcept { return true; }
+};
+
+struct walk_no_prune
+{
+    bool operator()(const std::filesystem::path&, const walk_entry&) const noexcept { return false; }
+};
+
+struct walk_task
+{
+    std::filesystem::path directory;
+    int depth;  // of the directory's entries
+};
+
+/**
+ * One thread's share of the directories still to read. The owner pushes
+ * and pops at the back, so each thread goes depth first and keeps its
+ * queue short; thieves take from the front, where the directories
+ * nearest the root (the biggest subtrees) are. Tasks are whole
+ * directories, so a plain mutex per queue is nowhere near contended.
+ */
+struct alignas(64) walk_queue
+{
+    std::mutex mutex;
+    std::deque<walk_task> tasks;
+
+    void push(walk_task&& task)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+
+    bool pop(walk_task& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        out = std::move(tasks.back());
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(walk_task& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        out = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+    }
+};
+
+#if STD_MODULE_FILESYSTEM_LINUX
+inline std::filesystem::file_type filesystem_type_from_mode(mode_t mode) noexcept
+{
+    using std::filesystem::file_type;
+    switch (mode & S_IFMT) {
+    case S_IFREG: return file_type::regular;
+    case S_IFDIR: return file_type::directory;
+    case S_IFLNK: return file_type::symlink;
+    case S_IFBLK: return file_type::block;
+    case S_IFCHR: return file_type::character;
+    case S_IFIFO: return file_type::fifo;
+    case S_IFSOCK: return file_type::socket;
+    default: return file_type::unknown;
+    }
+}
+
+/// The type from getdents64's d_type, which has S_IFMT's bits shifted down by 12; DT_UNKNOWN is 0
+inline std::filesystem::file_type filesystem_type_from_dtype(unsigned char type) noexcept
+{
+    return type == 0 ? std::filesystem::file_type::unknown
+                     : filesystem_type_from_mode(static_cast<mode_t>(type) << 12);
+}
+#endif
+
+template <class OnBatch, class Filter, class Prune>
+class walker
+{
+public:
+    walker(OnBatch& on_batch, Filter& filter, Prune& prune, const walk_options& options, unsigned threads)
+        : on_batch_(on_batch), filter_(filter), prune_(prune), options_(options), threads_(threads),
+          queues_(std::make_unique<walk_queue[]>(threads))
+    {
+    }
+
+    walk_stats run(const std::filesystem::path& root)
+    {
+        schedule(0, walk_task{root, 0});
+        {
+            std::vector<std::jthread> helpers;
+            helpers.reserve(threads_ - 1);
+            for (unsigned i = 1; i < threads_; ++i) {
+                helpers.emplace_back([this, i] { work(i); });
+            }
+            work(0);
+        }
+        if (failure_) {
+            std::rethrow_exception(failure_);
+        }
+        return stats_;
+    }
+
+private:
+    struct local
+    {
+        walk_stats stats;
+        std::vector<walk_entry> entries;
+        std::vector<char> buffer;
+    };
+
+    void schedule(unsigned self, walk_task&& task)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        queues_[self].push(std::move(task));
+    }
+
+    bool next(unsigned self, walk_task& out, std::uint64_t& seed)
+    {
+        if (queues_[self].pop(out)) {
+            return true;
+        }
+        // Start from a random victim so idle threads spread over the busy ones
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        for (unsigned i = 0, start = static_cast<unsigned>(seed % threads_); i < threads_; ++i) {
+            unsigned victim = (start + i) % threads_;
+            if (victim != self && queues_[victim].steal(out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(unsigned self)
+    {
+        local state;
+        state.buffer.resize(options_.read_buffer < 4096 ? 4096 : options_.read_buffer);
+        std::uint64_t seed = 0x9E3779B97F4A7C15ull * (self + 1);
+        walk_task task;
+        unsigned idle = 0;
+        while (!stopped_.load(std::memory_order_relaxed)) {
+            if (next(self, task, seed)) {
+                try {
+                    read(self, task, state);
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+                idle = 0;
+            } else if (pending_.load(std::memory_order_acquire) == 0) {
+                break;
+            } else if (++idle < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.entries += state.stats.entries;
+        stats_.directories += state.stats.directories;
+        stats_.errors += state.stats.errors;
+    }
+
+    void fail(std::exception_ptr e)
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (!failure_) {
+            failure_ = std::move(e);
+        }
+        stopped_.store(true, std::memory_order_relaxed);
+    }
+
+    /// Counts, filters and maybe descends into one entry; true to report it
+    bool visit(unsigned self, const walk_task& task, const walk_entry& entry, local& state)
+    {
+        ++state.stats.entries;
+        if (entry.type == std::filesystem::file_type::directory &&
+            (options_.max_depth < 0 || task.depth < options_.max_depth) && !prune_(task.directory, entry)) {
+            schedule(self, walk_task{task.directory / entry.name, task.depth + 1});
+        }
+        return filter_(task.directory, entry);
+    }
+
+    void deliver(const walk_task& task, local& state)
+    {
+        if (!state.entries.empty()) {
+            on_batch_(walk_batch{task.directory, task.depth, std::span<const walk_entry>(state.entries)});
+            state.entries.clear();
+        }
+    }
+
+#if STD_MODULE_FILESYSTEM_LINUX
+    // getdents64 fills the buffer with linux_dirent64 records: d_ino (8
+    // bytes), d_off (8), d_reclen (2), d_type (1), then the NUL-terminated
+    // name. d_type saves a stat per entry on every common file system;
+    // only DT_UNKNOWN entries are stat'ed.
+    void read(unsigned self, const walk_task& task, local& state)
+    {
+        int fd = ::open(task.directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            ++state.stats.errors;
+            return;
+        }
+        struct closer
+        {
+            int fd;
+            ~closer() { ::close(fd); }
+        } guard{fd};
+        ++state.stats.directories;
+        for (;;) {
+            long n = ::syscall(SYS_getdents64, fd, state.buffer.data(), state.buffer.size());
+            if (n <= 0) {
+                state.stats.errors += n < 0;
+                return;
+            }
+            for (long offset = 0; offset < n;) {
+                const char* record = state.buffer.data() + offset;
+                std::uint64_t inode;
+                unsigned short length;
+                std::memcpy(&inode, record, sizeof inode);
+                std::memcpy(&length, record + 16, sizeof length);
+                offset += length;
+                std::string_view name(record + 19);
+                if (name == "." || name == "..") {
+                    continue;
+                }
+                std::filesystem::file_type type = filesystem_type_from_dtype(static_cast<unsigned char>(record[18]));
+                if (type == std::filesystem::file_type::unknown) {
+                    struct stat st;
+                    if (::fstatat(fd, name.data(), &st, AT_SYMLINK_NOFOLLOW) == 0) {
+                        type = filesystem_type_from_mode(st.st_mode);
+                    }
+                }
+                walk_entry entry{name, type, inode};
+                if (visit(self, task, entry, state)) {
+                    state.entries.push_back(entry);
+                }
+            }
+            deliver(task, state);
+        }
+    }
+#else
+    // Elsewhere, directory_iterator; its entries cache the type where the
+    // platform reports it with the name (Windows, and POSIX d_type).
+    void read(unsigned self, const walk_task& task, local& state)
+    {
+        std::error_code ec;
+        std::filesystem::directory_iterator it(task.directory, ec);
+        if (ec) {
+            ++state.stats.errors;
+            return;
+        }
+        ++state.stats.directories;
+        std::size_t per_batch = state.buffer.size() / 64;
+        std::vector<std::string> names;
+        std::vector<std::filesystem::file_type> types;
+        for (std::filesystem::directory_iterator end; it != end;) {
+            names.push_back(it->path().filename().string());
+            types.push_back(it->symlink_status(ec).type());
+            it.increment(ec);
+            if (ec) {
+                ++state.stats.errors;
+                break;
+            }
+            if (names.size() == per_batch || it == end) {
+                for (std::size_t i = 0; i < names.size(); ++i) {
+                    walk_entry entry{names[i], types[i], 0};
+                    if (visit(self, task, entry, state)) {
+                        state.entries.push_back(entry);
+                    }
+                }
+                deliver(task, state);
+                names.clear();
+                types.clear();
+            }
+        }
+    }
+#endif
+
+    OnBatch& on_batch_;
+    Filter& filter_;
+    Prune& prune_;
+    const walk_options& options_;
+    unsigned threads_;
+    std::unique_ptr<walk_queue[]> queues_;
+    std::atomic<std::size_t> pending_{0};  // directories scheduled but not yet read
+    std::atomic<bool> stopped_{false};
+    std::mutex stats_mutex_;
+    walk_stats stats_;
+    std::exception_ptr failure_;
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Walks the tree under @p root on several threads, handing
+ * entries to @p on_batch a directory read at a time.
+ *
+ * Directories are spread over a work-stealing pool: each thread reads
+ * the directories it finds depth first and idle threads steal the ones
+ * nearest the root. On Linux each read is one getdents64 call into a
+ * read_buffer-sized buffer, and entry types come from d_type, so unlike
+ * recursive_directory_iterator plus status() nothing is stat'ed except
+ * on file systems that leave d_type unknown. Elsewhere it reads with
+ * directory_iterator.
+ *
+ * For each entry, @p filter(directory, entry) decides whether it goes
+ * into the batch, and for each subdirectory @p prune(directory, entry)
+ * returning true skips its contents; both default to accepting
+ * everything. Symlinks are reported, never followed. All three callbacks
+ * run on the walking threads at once, so they must be thread-safe; the
+ * entries' names are valid only during the call. Entries come in no
+ * particular order.
+ *
+ * Throws filesystem_error if @p root is not a directory. Subdirectories
+ * that cannot be read (permissions, removed meanwhile) are skipped and
+ * counted in walk_stats::errors. An exception from a callback stops the
+ * walk and is rethrown here.
+ *
+ *     std::atomic<std::size_t> files{0};
+ *     auto regular = [](const auto&, const std_module::walk_entry& e) { return e.type == file_type::regular; };
+ *     auto skip_git = [](const auto&, const std_module::walk_entry& e) { return e.name == ".git"; };
+ *     std_module::parallel_walk(root, [&](const std_module::walk_batch& b) { files += b.entries.size(); },
+ *                               {}, regular, skip_git);
+ */
+template <class OnBatch, class Filter = detail::walk_all, class Prune = detail::walk_no_prune>
+walk_stats parallel_walk(const std::filesystem::path& root, OnBatch on_batch, const walk_options& options = {},
+                         Filter filter = {}, Prune prune = {})
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec)) {
+        throw std::filesystem::filesystem_error(
+            "parallel_walk", root, ec ? ec : std::make_error_code(std::errc::not_a_directory));
+    }
+    unsigned threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    detail::walker<OnBatch, Filter, Prune> walker(on_batch, filter, prune, options, threads == 0 ? 1 : threads);
+    return walker.run(root);
+}
+}  // namespace std_module
+
+// ------------------------------------------------------------------------------
+// File metadata
+// ------------------------------------------------------------------------------
+
+export namespace std_module
+{
+/// Bitmask of the attributes a file_info query asks for
+enum class file_info_fields : unsigned
+{
+    none = 0,
+    type = 1u << 0,
+    permissions = 1u << 1,
+    size = 1u << 2,
+    last_write_time = 1u << 3,
+    last_access_time = 1u << 4,
+    status_change_time = 1u << 5,
+    creation_time = 1u << 6,  ///< Only where the file system records it
+    hard_link_count = 1u << 7,
+    inode = 1u << 8,
+    all = (1u << 9) - 1
+};
+
+constexpr file_info_fields operator|(file_info_fields a, file_info_fields b) noexcept
+{
+    return static_cast<file_info_fields>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+}
+
+constexpr file_info_fields operator&(file_info_fields a, file_info_fields b) noexcept
+{
+    return static_cast<file_info_fields>(static_cast<unsigned>(a) & static_cast<unsigned>(b));
+}
+
+constexpr file_info_fields operator~(file_info_fields a) noexcept
+{
+    return static_cast<file_info_fields>(~static_cast<unsigned>(a) & static_cast<unsigned>(file_info_fields::all));
+}
+
+constexpr file_info_fields& operator|=(file_info_fields& a, file_info_fields b) noexcept { return a = a | b; }
+
+constexpr file_info_fields& operator&=(file_info_fields& a, file_info_fields b) noexcept { return a = a & b; }
+
+/// A file's attributes, as many as were asked for and the file system reports
+struct file_info
+{
+    file_info_fields fields = file_info_fields::none;  ///< Which of the members below are filled in
+    std::filesystem::file_type type = std::filesystem::file_type::none;
+    std::filesystem::perms permissions = std::filesystem::perms::unknown;
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type last_write_time{};
+    std::filesystem::file_time_type last_access_time{};
+    std::filesystem::file_time_type status_change_time{};
+    std::filesystem::file_time_type creation_time{};
+    std::uintmax_t hard_link_count = 0;
+    std::uint64_t inode = 0;
+    std::error_code error;  ///< Why a batch query failed for this path; fields is then none
+
+    /// Whether all of @p f are filled in
+    bool has(file_info_fields f) const noexcept { return (fields & f) == f; }
+};
+
+/// Options for the batch query_file_info
+struct file_info_options
+{
+    file_info_fields fields = file_info_fields::all; ///< Attributes to fetch
+    bool follow_symlinks = true;                     ///< As query_file_info (true) or query_symlink_info (false)
+    unsigned threads = 0; ///< Threads querying, the caller included; 0: hardware_concurrency()
+};
+}  // namespace std_module
+
+namespace std_module::detail
+{
+inline bool filesystem_wants(file_info_fields wanted, file_info_fields f) noexcept
+{
+    return (wanted & f) != file_info_fields::none;
+}
+
+inline std::filesystem::file_time_type filesystem_file_time(std::int64_t seconds, std::int64_t nanoseconds) noexcept
+{
+    auto sys = std::chrono::sys_seconds(std::chrono::seconds(seconds)) + std::chrono::nanoseconds(nanoseconds);
+    return std::chrono::time_point_cast<std::filesystem::file_time_type::duration>(
+        std::chrono::file_clock::from_sys(sys));
+}
+
+#if STD_MODULE_FILESYSTEM_LINUX
+#if defined(STATX_TYPE)
+/// Set once statx turns out to be unavailable (kernels before 4.11, some seccomp sandboxes)
+inline std::atomic<bool> filesystem_no_statx{false};
+#endif
+
+/// One statx call for the wanted fields, or one fstatat where statx is unavailable
+inline void filesystem_query(const char* path, bool follow, file_info_fields wanted, file_info& out,
+                             std::error_code& ec) noexcept
+{
+    using F = file_info_fields;
+    int flags = follow ? 0 : AT_SYMLINK_NOFOLLOW;
+#if defined(STATX_TYPE)
+    if (!filesystem_no_statx.load(std::memory_order_relaxed)) {
+        struct field_bit
+        {
+            F field;
+            unsigned bit;
+        };
+        static constexpr field_bit bits[] = {
+            {F::type, STATX_TYPE},
+            {F::permissions, STATX_MODE},
+            {F::size, STATX_SIZE},
+            {F::last_write_time, STATX_MTIME},
+            {F::last_access_time, STATX_ATIME},
+            {F::status_change_time, STATX_CTIME},
+            {F::creation_time, STATX_BTIME},
+            {F::hard_link_count, STATX_NLINK},
+            {F::inode, STATX_INO},
+        };
+        unsigned mask = 0;
+        for (const field_bit& b : bits) {
+            mask |= filesystem_wants(wanted, b.field) ? b.bit : 0;
+        }
+        struct statx sx;
+        if (::statx(AT_FDCWD, path, flags, mask, &sx) == 0) {
+            // Only what was both asked for and reported (creation time often is not)
+            for (const field_bit& b : bits) {
+                if (filesystem_wants(wanted, b.field) && (sx.stx_mask & b.bit) != 0) {
+                    out.fields |= b.field;
+                }
+            }
+            out.type = filesystem_type_from_mode(sx.stx_mode);
+            out.permissions = static_cast<std::filesystem::perms>(sx.stx_mode & 07777);
+            out.size = sx.stx_size;
+            out.last_write_time = filesystem_file_time(sx.stx_mtime.tv_sec, sx.stx_mtime.tv_nsec);
+            out.last_access_time = filesystem_file_time(sx.stx_atime.tv_sec, sx.stx_atime.tv_nsec);
+            out.status_change_time = filesystem_file_time(sx.stx_ctime.tv_sec, sx.stx_ctime.tv_nsec);
+            out.creation_time = filesystem_file_time(sx.stx_btime.tv_sec, sx.stx_btime.tv_nsec);
+            out.hard_link_count = sx.stx_nlink;
+            out.inode = sx.stx_ino;
+            return;
+        }
+        if (errno != ENOSYS && errno != EPERM) {
+            ec.assign(errno, std::generic_category());
+            return;
+        }
+        filesystem_no_statx.store(true, std::memory_order_relaxed);
+    }
+#endif
+    struct stat st;
+    if (::fstatat(AT_FDCWD, path, &st, flags) != 0) {
+        ec.assign(errno, std::generic_category());
+        return;
+    }
+    out.fields = wanted & ~F::creation_time;
+    out.type = filesystem_type_from_mode(st.st_mode);
+    out.permissions = static_cast<std::filesystem::perms>(st.st_mode & 07777);
+    out.size = static_cast<std::uintmax_t>(st.st_size);
+    out.last_write_time = filesystem_file_time(st.st_mtim.tv_sec, st.st_mtim.tv_nsec);
+    out.last_access_time = filesystem_file_time(st.st_atim.tv_sec, st.st_atim.tv_nsec);
+    out.status_change_time = filesystem_file_time(st.st_ctim.tv_sec, st.st_ctim.tv_nsec);
+    out.hard_link_count = st.st_nlink;
+    out.inode = st.st_ino;
+}
+#endif
+
+/// A missing path is not an error, as for status(): it has type not_found and nothing else
+inline file_info filesystem_info(const std::filesystem::path& p, bool follow, file_info_fields wanted,
+                                 std::error_code& ec) noexcept
+{
+    using F = file_info_fields;
+    file_info out;
+    ec.clear();
+#if STD_MODULE_FILESYSTEM_LINUX
+    filesystem_query(p.c_str(), follow, wanted, out, ec);
+#else
+    // One std::filesystem call per group of attributes
+    std::filesystem::file_status st = follow ? std::filesystem::status(p, ec) : std::filesystem::symlink_status(p, ec);
+    if (!ec) {
+        out.type = st.type();
+        out.permissions = st.permissions();
+        out.fields = wanted & (F::type | F::permissions);
+        if (filesystem_wants(wanted, F::size) && out.type == std::filesystem::file_type::regular) {
+            out.size = std::filesystem::file_size(p, ec);
+            out.fields |= ec ? F::none : F::size;
+        }
+        if (filesystem_wants(wanted, F::last_write_time)) {
+            out.last_write_time = std::filesystem::last_write_time(p, ec);
+            out.fields |= ec ? F::none : F::last_write_time;
+        }
+        if (filesystem_wants(wanted, F::hard_link_count)) {
+            out.hard_link_count = std::filesystem::hard_link_count(p, ec);
+            out.fields |= ec ? F::none : F::hard_link_count;
+        }
+        ec.clear();
+    }
+#endif
+    if (ec == std::errc::no_such_file_or_directory || ec == std::errc::not_a_directory) {
+        ec.clear();
+        out = file_info{};
+        out.fields = F::type;
+        out.type = std::filesystem::file_type::not_found;
+    } else if (ec) {
+        out = file_info{};
+    }
+    return out;
+}
+
+inline file_info filesystem_info_or_throw(const char* what, const std::filesystem::path& p, bool follow,
+                                          file_info_fields wanted)
+{
+    std::error_code ec;
+    file_info out = filesystem_info(p, follow, wanted, ec);
+    if (ec) {
+        throw std::filesystem::filesystem_error(what, p, ec);
+    }
+    return out;
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Fetches the attributes in @p fields of the file at @p p (symlinks
+ * followed) with one system call.
+ *
+ * std::filesystem needs a stat per question: status(), file_size() and
+ * last_write_time() together are three. On Linux this is one statx()
+ * asking only for @p fields, so the kernel (and network file systems in
+ * particular) can skip the rest; without statx, one stat. Elsewhere it
+ * falls back to the std::filesystem calls. file_info::fields says which
+ * attributes came back: those asked for that the file system reports
+ * (creation_time is often missing).
+ *
+ * As with status(), a missing path is not an error: the result has type
+ * not_found and nothing else. Other failures throw filesystem_error.
+ */
+inline file_info query_file_info(const std::filesystem::path& p, file_info_fields fields = file_info_fields::all)
+{
+    return detail::filesystem_info_or_throw("query_file_info", p, true, fields);
+}
+
+/// As query_file_info, reporting failures through @p ec
+inline file_info query_file_info(const std::filesystem::path& p, file_info_fields fields,
+                                 std::error_code& ec) noexcept
+{
+    return detail::filesystem_info(p, true, fields, ec);
+}
+
+/// As query_file_info, but about a symlink itself rather than its target, like symlink_status()
+inline file_info query_symlink_info(const std::filesystem::path& p, file_info_fields fields = file_info_fields::all)
+{
+    return detail::filesystem_info_or_throw("query_symlink_info", p, false, fields);
+}
+
+/// As query_symlink_info, reporting failures through @p ec
+inline file_info query_symlink_info(const std::filesystem::path& p, file_info_fields fields,
+                                    std::error_code& ec) noexcept
+{
+    return detail::filesystem_info(p, false, fields, ec);
+}
+
+/**
+ * @brief query_file_info for every path in @p paths, on several threads.
+ *
+ * Threads take the paths 256 at a time from a shared cursor, so slow
+ * paths (cold inodes, network mounts) do not hold up a fixed share.
+ * Result i is about paths[i]. Never throws for a path: missing paths have
+ * type not_found, and paths that fail otherwise have fields == none and
+ * file_info::error set.
+ */
+inline std::vector<file_info> query_file_info(std::span<const std::filesystem::path> paths,
+                                              const file_info_options& options = {})
+{
+    std::vector<file_info> out(paths.size());
+    constexpr std::size_t chunk = 256;
+    std::atomic<std::size_t> cursor{0};
+    auto work = [&] {
+        for (;;) {
+            std::size_t begin = cursor.fetch_add(chunk, std::memory_order_relaxed);
+            if (begin >= paths.size()) {
+                return;
+            }
+            std::size_t end = paths.size() - begin < chunk ? paths.size() : begin + chunk;
+            for (std::size_t i = begin; i < end; ++i) {
+                std::error_code ec;
+                out[i] = detail::filesystem_info(paths[i], options.follow_symlinks, options.fields, ec);
+                out[i].error = ec;
+            }
+        }
+    };
+    unsigned threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    std::size_t useful = (paths.size() + chunk - 1) / chunk;
+    threads = static_cast<unsigned>(threads < useful ? threads : useful);
+    {
+        std::vector<std::jthread> helpers;
+        for (unsigned i = 1; i < threads; ++i) {
+            helpers.emplace_back(work);
+        }
+        work();
+    }
+    return out;
+}
+}  // namespace std_module
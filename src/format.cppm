@@ -6,6 +6,20 @@
 module;
 
 #include <format>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 export module std_module.format;
 
@@ -45,3 +59,616 @@ using std::make_wformat_args;
 using std::visit_format_arg;
 }  // namespace std
 
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module
+{
+/**
+ * @brief String literal usable as a template argument, e.g. in
+ * std_module::format<"{} = {}">(key, value).
+ */
+template <std::size_t N>
+struct fixed_string
+{
+    char data[N] = {};
+
+    constexpr fixed_string(const char (&s)[N]) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            data[i] = s[i];
+        }
+    }
+
+    constexpr std::string_view view() const noexcept { return {data, N - 1}; }
+};
+
+/**
+ * @brief Contiguous character buffer with N characters of inline storage
+ * that grows through a std::pmr::memory_resource.
+ *
+ * Intended as a reusable formatting target: short output never leaves the
+ * inline storage (typically on the stack), and clear() keeps whatever
+ * capacity was acquired, so a buffer reused across calls stops allocating
+ * once it has seen the longest line. Satisfies format_sink, and
+ * push_back/value_type make std::back_inserter work too.
+ */
+template <class Char, std::size_t N = 500>
+class basic_memory_buffer
+{
+    static_assert(N > 0, "basic_memory_buffer needs inline storage");
+    static_assert(std::is_trivially_copyable_v<Char>);
+
+public:
+    using value_type = Char;
+    using size_type = std::size_t;
+    using iterator = Char*;
+    using const_iterator = const Char*;
+
+    basic_memory_buffer() noexcept : basic_memory_buffer(std::pmr::get_default_resource()) {}
+
+    explicit basic_memory_buffer(std::pmr::memory_resource* resource) noexcept
+        : data_(inline_), resource_(resource)
+    {
+    }
+
+    basic_memory_buffer(basic_memory_buffer&& other) noexcept
+        : data_(inline_), resource_(other.resource_)
+    {
+        take(other);
+    }
+
+    basic_memory_buffer& operator=(basic_memory_buffer&& other) noexcept
+    {
+        if (this != &other) {
+            if (*resource_ == *other.resource_) {
+                deallocate();
+                data_ = inline_;
+                cap_ = N;
+                take(other);
+            } else {
+                // Storage from another resource cannot be adopted; copy it
+                size_ = 0;
+                append(other.view());
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    basic_memory_buffer(const basic_memory_buffer&) = delete;
+    basic_memory_buffer& operator=(const basic_memory_buffer&) = delete;
+
+    ~basic_memory_buffer() { deallocate(); }
+
+    Char* data() noexcept { return data_; }
+    const Char* data() const noexcept { return data_; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return cap_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    Char& operator[](size_type i) noexcept { return data_[i]; }
+    const Char& operator[](size_type i) const noexcept { return data_[i]; }
+
+    std::basic_string_view<Char> view() const noexcept { return {data_, size_}; }
+    std::basic_string<Char> str() const { return std::basic_string<Char>(data_, size_); }
+
+    /// Drops the contents; capacity is kept for reuse
+    void clear() noexcept { size_ = 0; }
+
+    void reserve(size_type n)
+    {
+        if (n > cap_) {
+            grow(n);
+        }
+    }
+
+    /// New characters are left uninitialized
+    void resize(size_type n)
+    {
+        reserve(n);
+        size_ = n;
+    }
+
+    void push_back(Char c)
+    {
+        if (size_ == cap_) {
+            grow(size_ + 1);
+        }
+        data_[size_++] = c;
+    }
+
+    void append(std::basic_string_view<Char> s)
+    {
+        if (s.size() > cap_ - size_) {
+            grow(size_ + s.size());
+        }
+        if (!s.empty()) {
+            std::memcpy(data_ + size_, s.data(), s.size() * sizeof(Char));
+        }
+        size_ += s.size();
+    }
+
+    void append(const Char* first, const Char* last) { append(std::basic_string_view<Char>(first, last)); }
+
+private:
+    // At least doubles, so appends are amortized O(1)
+    [[gnu::noinline]] void grow(size_type min_cap)
+    {
+        size_type cap = cap_ * 2 > min_cap ? cap_ * 2 : min_cap;
+        Char* p = static_cast<Char*>(resource_->allocate(cap * sizeof(Char), alignof(Char)));
+        std::memcpy(p, data_, size_ * sizeof(Char));
+        deallocate();
+        data_ = p;
+        cap_ = cap;
+    }
+
+    void deallocate() noexcept
+    {
+        if (data_ != inline_) {
+            resource_->deallocate(data_, cap_ * sizeof(Char), alignof(Char));
+        }
+    }
+
+    // Requires *this to be empty and inline, with other's resource
+    void take(basic_memory_buffer& other) noexcept
+    {
+        if (other.data_ == other.inline_) {
+            std::memcpy(inline_, other.inline_, other.size_ * sizeof(Char));
+        } else {
+            data_ = other.data_;
+            cap_ = other.cap_;
+            other.data_ = other.inline_;
+            other.cap_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    Char* data_;
+    size_type size_ = 0;
+    size_type cap_ = N;
+    std::pmr::memory_resource* resource_;
+    Char inline_[N];
+};
+
+using memory_buffer = basic_memory_buffer<char>;
+
+/**
+ * @brief Anything formatted output can be appended to in chunks: a
+ * memory_buffer, a std::string, or a user type wrapping a socket buffer
+ * or a mapped file. A field with a format spec reaches a sink without
+ * push_back in pieces of up to 256 characters.
+ */
+template <class S>
+concept format_sink = requires(S& sink, std::string_view chunk) { sink.append(chunk); };
+}  // namespace std_module
+
+namespace std_module::detail
+{
+/**
+ * One piece of a compiled format string: either literal text (with "{{"
+ * and "}}" already collapsed) or a replacement field with its argument
+ * index and the spec after ':'. Offsets are into the format string.
+ */
+struct format_segment
+{
+    bool field = false;
+    std::size_t begin = 0;
+    std::size_t size = 0;
+    std::size_t arg = 0;
+};
+
+// Calls on_literal(begin, size) and on_field(arg, spec_begin, spec_size)
+// in order. Errors throw, which makes them compile errors when parsing
+// happens in a constant expression.
+template <class Literal, class Field>
+constexpr void parse_format(std::string_view fmt, Literal on_literal, Field on_field)
+{
+    std::size_t next_arg = 0;
+    bool manual = false;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < fmt.size(); ++i) {
+        char c = fmt[i];
+        if (c != '{' && c != '}') {
+            continue;
+        }
+        if (i + 1 < fmt.size() && fmt[i + 1] == c) {
+            // Escaped brace: keep one, skip the other
+            on_literal(start, i + 1 - start);
+            start = ++i + 1;
+            continue;
+        }
+        if (c == '}') {
+            throw std::format_error("unmatched '}' in format string");
+        }
+        if (i > start) {
+            on_literal(start, i - start);
+        }
+        std::size_t close = i + 1;
+        while (close < fmt.size() && fmt[close] != '}') {
+            if (fmt[close] == '{') {
+                // Nested width/precision ("{:>{}}") would need a second
+                // argument in the field's vformat_to call.
+                throw std::format_error("nested replacement fields are not supported by std_module::format");
+            }
+            ++close;
+        }
+        if (close == fmt.size()) {
+            throw std::format_error("unmatched '{' in format string");
+        }
+        std::size_t j = i + 1;
+        std::size_t arg = 0;
+        if (j < close && fmt[j] >= '0' && fmt[j] <= '9') {
+            while (j < close && fmt[j] >= '0' && fmt[j] <= '9') {
+                arg = arg * 10 + static_cast<std::size_t>(fmt[j++] - '0');
+            }
+            if (next_arg > 0) {
+                throw std::format_error("cannot switch from automatic to manual argument indexing");
+            }
+            manual = true;
+        } else {
+            if (manual) {
+                throw std::format_error("cannot switch from manual to automatic argument indexing");
+            }
+            arg = next_arg++;
+        }
+        if (j < close && fmt[j] != ':') {
+            throw std::format_error("invalid replacement field in format string");
+        }
+        std::size_t spec_begin = j < close ? j + 1 : close;
+        on_field(arg, spec_begin, close - spec_begin);
+        start = close + 1;
+        i = close;
+    }
+    if (start < fmt.size()) {
+        on_literal(start, fmt.size() - start);
+    }
+}
+
+template <fixed_string F>
+struct compiled_format
+{
+    static constexpr std::size_t count = [] {
+        std::size_t n = 0;
+        parse_format(F.view(), [&](std::size_t, std::size_t) { ++n; },
+                     [&](std::size_t, std::size_t, std::size_t) { ++n; });
+        return n;
+    }();
+
+    static constexpr std::array<format_segment, count> segments = [] {
+        std::array<format_segment, count> out{};
+        std::size_t n = 0;
+        parse_format(
+            F.view(), [&](std::size_t begin, std::size_t size) { out[n++] = {false, begin, size, 0}; },
+            [&](std::size_t arg, std::size_t begin, std::size_t size) { out[n++] = {true, begin, size, arg}; });
+        return out;
+    }();
+
+    static constexpr std::size_t arg_count = [] {
+        std::size_t n = 0;
+        for (const auto& s : segments) {
+            if (s.field && s.arg + 1 > n) {
+                n = s.arg + 1;
+            }
+        }
+        return n;
+    }();
+
+    // "{:spec}" for fields that go through std::vformat_to
+    template <std::size_t I>
+    static constexpr auto field_format = [] {
+        constexpr format_segment s = segments[I];
+        std::array<char, s.size + 3> out{};
+        out[0] = '{';
+        out[1] = ':';
+        for (std::size_t i = 0; i < s.size; ++i) {
+            out[2 + i] = F.data[s.begin + i];
+        }
+        out[s.size + 2] = '}';
+        return out;
+    }();
+};
+
+template <class T>
+concept fast_string_arg = std::is_array_v<T> || std::same_as<T, const char*> || std::same_as<T, char*> ||
+                          std::same_as<T, std::string_view> || std::same_as<T, std::string>;
+
+template <class T>
+concept fast_arg = std::is_arithmetic_v<T> || fast_string_arg<T>;
+
+/**
+ * Writes into an output iterator. char* targets get memcpy-speed appends
+ * through std::copy.
+ */
+template <class OutputIt>
+struct iterator_writer
+{
+    OutputIt out;
+
+    void append(std::string_view s) { out = std::copy(s.begin(), s.end(), out); }
+
+    template <class T>
+    void field(std::string_view fmt, const T& value)
+    {
+        out = std::vformat_to(std::move(out), fmt, std::make_format_args(value));
+    }
+};
+
+/// Output iterator that writes while there is room and counts everything
+struct bounded_iterator
+{
+    using difference_type = std::ptrdiff_t;
+
+    char* pos;
+    char* end;
+    std::size_t* total;
+
+    bounded_iterator& operator*() noexcept { return *this; }
+    bounded_iterator& operator++() noexcept { return *this; }
+    bounded_iterator& operator++(int) noexcept { return *this; }
+
+    bounded_iterator& operator=(char c) noexcept
+    {
+        if (pos != end) {
+            *pos++ = c;
+        }
+        ++*total;
+        return *this;
+    }
+};
+
+/// Writes into a fixed buffer, truncating, while counting the full size
+struct span_writer
+{
+    char* pos;
+    char* end;
+    std::size_t total = 0;
+
+    void append(std::string_view s) noexcept
+    {
+        std::size_t room = static_cast<std::size_t>(end - pos);
+        std::size_t n = s.size() < room ? s.size() : room;
+        if (n != 0) {
+            std::memcpy(pos, s.data(), n);
+            pos += n;
+        }
+        total += s.size();
+    }
+
+    template <class T>
+    void field(std::string_view fmt, const T& value)
+    {
+        pos = std::vformat_to(bounded_iterator{pos, end, &total}, fmt, std::make_format_args(value)).pos;
+    }
+};
+
+/// Output iterator that collects characters in a scratch buffer and hands each full buffer to a sink
+template <class Sink>
+struct chunk_iterator
+{
+    using difference_type = std::ptrdiff_t;
+
+    Sink* sink;
+    char* buf;
+    char* pos;
+    char* end;
+
+    chunk_iterator& operator*() noexcept { return *this; }
+    chunk_iterator& operator++() noexcept { return *this; }
+    chunk_iterator& operator++(int) noexcept { return *this; }
+
+    chunk_iterator& operator=(char c)
+    {
+        if (pos == end) {
+            sink->append(std::string_view(buf, static_cast<std::size_t>(pos - buf)));
+            pos = buf;
+        }
+        *pos++ = c;
+        return *this;
+    }
+};
+
+// Sinks with push_back (memory_buffer, std::string) are formatted into
+// directly. Other sinks get the output through a stack buffer: one
+// append() for up to 256 characters, and 256-character pieces beyond
+// that. Neither way allocates outside the sink.
+template <class Sink>
+void vformat_into(Sink& sink, std::string_view fmt, std::format_args args)
+{
+    if constexpr (requires(Sink& s, char c) {
+                      typename Sink::value_type;
+                      s.push_back(c);
+                  }) {
+        std::vformat_to(std::back_inserter(sink), fmt, args);
+    } else {
+        char buf[256];
+        chunk_iterator<Sink> first{&sink, buf, buf, buf + sizeof buf};
+        chunk_iterator<Sink> last = std::vformat_to(first, fmt, args);
+        if (last.pos != buf) {
+            sink.append(std::string_view(buf, static_cast<std::size_t>(last.pos - buf)));
+        }
+    }
+}
+
+/// Appends to a format_sink
+template <class Sink>
+struct sink_writer
+{
+    Sink& sink;
+
+    void append(std::string_view s) { sink.append(s); }
+
+    template <class T>
+    void field(std::string_view fmt, const T& value)
+    {
+        vformat_into(sink, fmt, std::make_format_args(value));
+    }
+};
+
+// Fast paths for "{}" of common types; must match std::format output
+template <class Writer, class T>
+void write_plain(Writer& w, const T& value)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        w.append(value ? std::string_view("true") : std::string_view("false"));
+    } else if constexpr (std::is_same_v<T, char>) {
+        w.append(std::string_view(&value, 1));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        char buf[64];
+        auto r = std::to_chars(buf, buf + sizeof buf, value);
+        w.append(std::string_view(buf, static_cast<std::size_t>(r.ptr - buf)));
+    } else if constexpr (std::is_array_v<T> || std::is_pointer_v<T>) {
+        w.append(std::string_view(value));
+    } else {
+        w.append(std::string_view(value.data(), value.size()));
+    }
+}
+
+template <fixed_string F, std::size_t I, class Writer, class Tuple>
+void write_segment(Writer& w, const Tuple& args)
+{
+    using program = compiled_format<F>;
+    constexpr format_segment s = program::segments[I];
+    if constexpr (!s.field) {
+        w.append(F.view().substr(s.begin, s.size));
+    } else {
+        const auto& value = std::get<s.arg>(args);
+        using T = std::remove_cvref_t<decltype(value)>;
+        if constexpr (s.size == 0 && fast_arg<T>) {
+            write_plain(w, value);
+        } else {
+            constexpr auto& fmt = program::template field_format<I>;
+            w.field(std::string_view(fmt.data(), fmt.size()), value);
+        }
+    }
+}
+
+template <fixed_string F, class Writer, class... Args>
+void write_format(Writer& w, const Args&... args)
+{
+    using program = compiled_format<F>;
+    static_assert(program::arg_count <= sizeof...(Args), "format string refers to a missing argument");
+    // Full standard validation of the specs against the argument types
+    [[maybe_unused]] constexpr std::format_string<const Args&...> check(F.view());
+    auto tuple = std::forward_as_tuple(args...);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (write_segment<F, I>(w, tuple), ...);
+    }(std::make_index_sequence<program::count>{});
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief std::format with the format string parsed at compile time.
+ *
+ * F is split into literal chunks and typed replacement fields when the
+ * call is compiled; at run time literals are copied and "{}" fields of
+ * arithmetic and string types are written with std::to_chars/memcpy,
+ * with no parsing at all. Fields with a format spec go through
+ * std::vformat_to for that field only, so they format as std::format
+ * would, and the whole string is still validated against the argument
+ * types at compile time. Nested width and precision fields ("{:>{}}")
+ * are not supported and fail to compile; use std::format for those.
+ *
+ *     auto line = std_module::format<"{}: {} ({:.2f} ms)">(host, status, ms);
+ */
+template <fixed_string F, class... Args>
+std::string format(const Args&... args)
+{
+    // Format into a stack buffer first, so typical lines need one pass
+    // and one allocation.
+    char buf[256];
+    detail::span_writer w{buf, buf + sizeof buf};
+    detail::write_format<F>(w, args...);
+    if (w.total <= sizeof buf) {
+        return std::string(buf, w.total);
+    }
+    std::string out(w.total, '\0');
+    detail::span_writer again{out.data(), out.data() + out.size()};
+    detail::write_format<F>(again, args...);
+    return out;
+}
+
+/// Compiled-format counterpart of std::format_to
+template <fixed_string F, class OutputIt, class... Args>
+    requires std::output_iterator<OutputIt, const char&>
+OutputIt format_to(OutputIt out, const Args&... args)
+{
+    detail::iterator_writer<OutputIt> w{std::move(out)};
+    detail::write_format<F>(w, args...);
+    return std::move(w.out);
+}
+
+/**
+ * @brief Formats into a caller-provided buffer, truncating if it is too
+ * small. Like std::format_to_n, .size is the untruncated length.
+ */
+template <fixed_string F, class... Args>
+std::format_to_n_result<char*> format_to(std::span<char> buf, const Args&... args)
+{
+    detail::span_writer w{buf.data(), buf.data() + buf.size()};
+    detail::write_format<F>(w, args...);
+    return {w.pos, static_cast<std::ptrdiff_t>(w.total)};
+}
+
+/**
+ * @brief Appends the formatted output to a sink, e.g. a reused
+ * memory_buffer, without building an intermediate std::string.
+ *
+ *     std_module::memory_buffer line;
+ *     std_module::format_to<"{} {}\n">(line, level, message);
+ *     socket.write(line.view());
+ */
+template <fixed_string F, class Sink, class... Args>
+    requires format_sink<Sink>
+void format_to(Sink& sink, const Args&... args)
+{
+    detail::sink_writer<Sink> w{sink};
+    detail::write_format<F>(w, args...);
+}
+
+/// Compiled-format counterpart of std::formatted_size
+template <fixed_string F, class... Args>
+std::size_t formatted_size(const Args&... args)
+{
+    char buf[256];
+    detail::span_writer w{buf, buf + sizeof buf};
+    detail::write_format<F>(w, args...);
+    return w.total;
+}
+
+/// Runtime format string fallback: std::vformat
+template <class... Args>
+std::string format(std::string_view fmt, const Args&... args)
+{
+    return std::vformat(fmt, std::make_format_args(args...));
+}
+
+/// Runtime format string fallback into a buffer, truncating like the compiled overload
+template <class... Args>
+std::format_to_n_result<char*> format_to(std::span<char> buf, std::string_view fmt, const Args&... args)
+{
+    std::size_t total = 0;
+    char* end = std::vformat_to(detail::bounded_iterator{buf.data(), buf.data() + buf.size(), &total}, fmt,
+                                std::make_format_args(args...))
+                    .pos;
+    return {end, static_cast<std::ptrdiff_t>(total)};
+}
+
+/// Runtime format string fallback into a sink
+template <format_sink Sink, class... Args>
+void format_to(Sink& sink, std::string_view fmt, const Args&... args)
+{
+    detail::vformat_into(sink, fmt, std::make_format_args(args...));
+}
+}  // namespace std_module
@@ -5,6 +5,9 @@
 
 module;
 #include <forward_list>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 export module std_module.forward_list;
 
 export namespace std {
@@ -27,3 +30,215 @@ export namespace std {
     using std::erase;
     using std::erase_if;
 }
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module {
+    template <class T, class Tag>
+    class intrusive_slist;
+
+    /**
+     * @brief Link that makes a type storable in an intrusive_slist.
+     *
+     * Derive the element type from slist_hook<Tag>; use distinct tags to put
+     * one element into several lists at once. Copying an element does not
+     * copy its link.
+     */
+    template <class Tag = void>
+    class slist_hook {
+    public:
+        slist_hook() noexcept = default;
+        slist_hook(const slist_hook&) noexcept {}
+        slist_hook& operator=(const slist_hook&) noexcept { return *this; }
+
+        /// True while the element is in a list.
+        bool is_linked() const noexcept { return next_ != nullptr; }
+
+    private:
+        template <class, class>
+        friend class intrusive_slist;
+
+        // Shared terminator: the last element links here rather than to
+        // nullptr, so is_linked() holds for it and moving a list is O(1).
+        static slist_hook* end_marker() noexcept {
+            static slist_hook marker;
+            return &marker;
+        }
+
+        slist_hook* next_ = nullptr;
+    };
+
+    /**
+     * @brief Singly-linked list threading through hooks embedded in elements.
+     *
+     * The intrusive counterpart of std::forward_list: push/insert link the
+     * caller's object and erase unlinks it, with no allocation. size() is
+     * O(1). Destroying or clearing the list unlinks all elements.
+     */
+    template <class T, class Tag = void>
+    class intrusive_slist {
+        using hook = slist_hook<Tag>;
+
+        template <bool Const>
+        class basic_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            basic_iterator() noexcept = default;
+            basic_iterator(const basic_iterator<false>& other) noexcept requires Const
+                : node_(other.node_) {}
+
+            reference operator*() const noexcept { return static_cast<reference>(*node_); }
+            pointer operator->() const noexcept { return &**this; }
+
+            basic_iterator& operator++() noexcept {
+                node_ = node_->next_;
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept {
+                basic_iterator tmp = *this;
+                node_ = node_->next_;
+                return tmp;
+            }
+
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return a.node_ == b.node_;
+            }
+
+        private:
+            friend class intrusive_slist;
+            friend class basic_iterator<!Const>;
+
+            explicit basic_iterator(hook* node) noexcept : node_(node) {}
+
+            hook* node_ = nullptr;
+        };
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        intrusive_slist() noexcept { head_.next_ = hook::end_marker(); }
+
+        intrusive_slist(const intrusive_slist&) = delete;
+        intrusive_slist& operator=(const intrusive_slist&) = delete;
+
+        intrusive_slist(intrusive_slist&& other) noexcept : size_(other.size_) {
+            head_.next_ = other.head_.next_;
+            other.head_.next_ = hook::end_marker();
+            other.size_ = 0;
+        }
+
+        intrusive_slist& operator=(intrusive_slist&& other) noexcept {
+            if (this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~intrusive_slist() { clear(); }
+
+        // ---- Iterators ----
+
+        iterator before_begin() noexcept { return iterator(&head_); }
+        const_iterator before_begin() const noexcept { return const_iterator(const_cast<hook*>(&head_)); }
+        const_iterator cbefore_begin() const noexcept { return before_begin(); }
+        iterator begin() noexcept { return iterator(head_.next_); }
+        const_iterator begin() const noexcept { return const_iterator(head_.next_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        iterator end() noexcept { return iterator(hook::end_marker()); }
+        const_iterator end() const noexcept { return const_iterator(hook::end_marker()); }
+        const_iterator cend() const noexcept { return end(); }
+
+        /// Iterator to @p value, which must be in this list.
+        iterator iterator_to(T& value) noexcept { return iterator(as_hook(value)); }
+
+        // ---- Capacity and access ----
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        size_type size() const noexcept { return size_; }
+
+        reference front() noexcept { return *begin(); }
+        const_reference front() const noexcept { return *begin(); }
+
+        // ---- Modifiers ----
+
+        void push_front(T& value) noexcept { insert_after(before_begin(), value); }
+        void pop_front() noexcept { erase_after(before_begin()); }
+
+        /// Link @p value after @p pos; @p value must not be linked.
+        iterator insert_after(const_iterator pos, T& value) noexcept {
+            hook* h = as_hook(value);
+            h->next_ = pos.node_->next_;
+            pos.node_->next_ = h;
+            ++size_;
+            return iterator(h);
+        }
+
+        /// Unlink the element following @p pos; returns the position after it.
+        iterator erase_after(const_iterator pos) noexcept {
+            hook* h = pos.node_->next_;
+            pos.node_->next_ = h->next_;
+            h->next_ = nullptr;
+            --size_;
+            return iterator(pos.node_->next_);
+        }
+
+        /// Unlink @p value if it is in this list. O(n): walks to its predecessor.
+        bool remove(T& value) noexcept {
+            hook* target = as_hook(value);
+            for (hook* prev = &head_; prev->next_ != hook::end_marker(); prev = prev->next_) {
+                if (prev->next_ == target) {
+                    erase_after(const_iterator(prev));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Unlink every element.
+        void clear() noexcept {
+            hook* h = head_.next_;
+            while (h != hook::end_marker()) {
+                hook* next = h->next_;
+                h->next_ = nullptr;
+                h = next;
+            }
+            head_.next_ = hook::end_marker();
+            size_ = 0;
+        }
+
+        void swap(intrusive_slist& other) noexcept {
+            hook* first = head_.next_;
+            head_.next_ = other.head_.next_;
+            other.head_.next_ = first;
+            size_type n = size_;
+            size_ = other.size_;
+            other.size_ = n;
+        }
+
+    private:
+        static hook* as_hook(T& value) noexcept { return static_cast<hook*>(&value); }
+
+        hook head_;
+        size_type size_ = 0;
+    };
+
+    template <class T, class Tag>
+    void swap(intrusive_slist<T, Tag>& a, intrusive_slist<T, Tag>& b) noexcept {
+        a.swap(b);
+    }
+}
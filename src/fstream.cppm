@@ -6,6 +6,32 @@
 module;
 
 #include <fstream>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <span>
+#include <streambuf>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STD_MODULE_FSTREAM_POSIX 1
+#else
+#define STD_MODULE_FSTREAM_POSIX 0
+#endif
 
 export module std_module.fstream;
 
@@ -31,3 +57,888 @@ using std::basic_fstream;
 using std::fstream;
 using std::wfstream;
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+// Memory-mapped files
+// ------------------------------------------------------------------------------
+
+export namespace std_module
+{
+/// Access a mapped_file is opened for
+enum class map_mode
+{
+    read_only,  ///< Pages are read-only; the file must exist
+    read_write  ///< Stores reach the file (shared mapping)
+};
+
+/// Expected access pattern, passed on to madvise()
+enum class map_advice
+{
+    normal,
+    sequential,  ///< Aggressive read-ahead; pages behind may be dropped early
+    random,      ///< No read-ahead
+    will_need,   ///< Start reading the range in now
+    dont_need    ///< The range will not be used again soon
+};
+
+/// How mapped_file opens and maps a file
+struct map_options
+{
+    map_mode mode = map_mode::read_only;
+    map_advice advice = map_advice::normal; ///< Applied to the whole mapping once mapped
+    bool huge_pages = false; ///< Ask for transparent huge pages (Linux, where the file system supports them)
+    bool populate = false;   ///< Fault every page in before returning (Linux MAP_POPULATE)
+    std::size_t size = 0;    ///< read_write: create the file if missing and resize it to this; 0: keep the size
+};
+}  // namespace std_module
+
+namespace std_module::detail
+{
+#if STD_MODULE_FSTREAM_POSIX
+inline int fstream_madvice(map_advice advice) noexcept
+{
+    switch (advice) {
+    case map_advice::sequential: return MADV_SEQUENTIAL;
+    case map_advice::random: return MADV_RANDOM;
+    case map_advice::will_need: return MADV_WILLNEED;
+    case map_advice::dont_need: return MADV_DONTNEED;
+    default: return MADV_NORMAL;
+    }
+}
+#endif
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief RAII view of a whole file mapped into memory.
+ *
+ * Reading through ifstream copies every byte from the page cache into the
+ * stream buffer and again into the caller's; a mapping hands out the page
+ * cache itself, so parsers can work on bytes() in place. Empty files are
+ * open with an empty view (there is nothing to map).
+ *
+ * Elsewhere than POSIX systems the file is read into memory instead, and
+ * read_write contents are written back by flush() and close().
+ *
+ * Move-only. Throwing members throw filesystem_error; each has an
+ * std::error_code overload.
+ */
+class mapped_file
+{
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    mapped_file() noexcept = default;
+
+    explicit mapped_file(const std::filesystem::path& p, const map_options& options = {}) { open(p, options); }
+
+    mapped_file(const std::filesystem::path& p, const map_options& options, std::error_code& ec) noexcept
+    {
+        open(p, options, ec);
+    }
+
+    mapped_file(mapped_file&& other) noexcept { swap(other); }
+
+    mapped_file& operator=(mapped_file&& other) noexcept
+    {
+        mapped_file(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~mapped_file() { close(); }
+
+    void swap(mapped_file& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(mode_, other.mode_);
+        std::swap(open_, other.open_);
+#if !STD_MODULE_FSTREAM_POSIX
+        std::swap(copy_, other.copy_);
+        std::swap(path_, other.path_);
+#endif
+    }
+
+    /// Maps @p p, closing what was mapped before
+    void open(const std::filesystem::path& p, const map_options& options = {})
+    {
+        std::error_code ec;
+        open(p, options, ec);
+        if (ec) {
+            throw std::filesystem::filesystem_error("mapped_file", p, ec);
+        }
+    }
+
+    void open(const std::filesystem::path& p, const map_options& options, std::error_code& ec) noexcept
+    {
+        close();
+        ec.clear();
+        bool writable = options.mode == map_mode::read_write;
+#if STD_MODULE_FSTREAM_POSIX
+        int flags = (writable ? O_RDWR : O_RDONLY) | (writable && options.size != 0 ? O_CREAT : 0) | O_CLOEXEC;
+        int fd = ::open(p.c_str(), flags, 0666);
+        if (fd < 0) {
+            ec.assign(errno, std::generic_category());
+            return;
+        }
+        struct stat st;
+        if (writable && options.size != 0 && ::ftruncate(fd, static_cast<off_t>(options.size)) != 0) {
+            ec.assign(errno, std::generic_category());
+        } else if (::fstat(fd, &st) != 0) {
+            ec.assign(errno, std::generic_category());
+        } else if (!S_ISREG(st.st_mode)) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+        } else if (static_cast<std::uintmax_t>(st.st_size) > static_cast<std::uintmax_t>(npos / 2)) {
+            ec = std::make_error_code(std::errc::file_too_large);
+        } else if (st.st_size != 0) {
+            int map_flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+            map_flags |= options.populate ? MAP_POPULATE : 0;
+#endif
+            int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* address = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), protection, map_flags, fd, 0);
+            if (address == MAP_FAILED) {
+                ec.assign(errno, std::generic_category());
+            } else {
+                data_ = static_cast<std::byte*>(address);
+                size_ = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);  // The mapping keeps its own reference to the file
+        if (ec) {
+            return;
+        }
+#if defined(MADV_HUGEPAGE)
+        if (options.huge_pages && size_ != 0) {
+            ::madvise(data_, size_, MADV_HUGEPAGE);  // A hint: file systems without huge page support refuse it
+        }
+#endif
+#else
+        if (writable && options.size != 0) {
+            if (!std::filesystem::exists(p, ec)) {
+                std::ofstream(p, std::ios_base::binary);
+            }
+            std::filesystem::resize_file(p, options.size, ec);
+        }
+        std::uintmax_t size = ec ? 0 : std::filesystem::file_size(p, ec);
+        if (ec) {
+            return;
+        }
+        std::ifstream in(p, std::ios_base::binary);
+        copy_ = std::make_unique_for_overwrite<std::byte[]>(static_cast<std::size_t>(size));
+        if (!in.read(reinterpret_cast<char*>(copy_.get()), static_cast<std::streamsize>(size))) {
+            copy_.reset();
+            ec = std::make_error_code(std::errc::io_error);
+            return;
+        }
+        data_ = copy_.get();
+        size_ = static_cast<std::size_t>(size);
+        path_ = p;
+#endif
+        mode_ = options.mode;
+        open_ = true;
+        if (options.advice != map_advice::normal) {
+            advise(options.advice);
+        }
+    }
+
+    /// Unmaps the file; read_write changes reach the file eventually (flush() first to wait for them)
+    void close() noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        if (size_ != 0) {
+            ::munmap(data_, size_);
+        }
+#else
+        std::error_code ec;
+        flush(ec);
+        copy_.reset();
+        path_.clear();
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    bool is_open() const noexcept { return open_; }
+    map_mode mode() const noexcept { return mode_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// The file's contents; valid until close()
+    std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+
+    /// The file's contents for writing; empty unless open read_write
+    std::span<std::byte> writable_bytes() noexcept
+    {
+        return mode_ == map_mode::read_write ? std::span<std::byte>(data_, size_) : std::span<std::byte>();
+    }
+
+    /// The file's contents as characters, for text parsers
+    std::string_view chars() const noexcept { return {reinterpret_cast<const char*>(data_), size_}; }
+
+    /**
+     * @brief Tells the kernel how [offset, offset + length) will be used.
+     *
+     * A hint: failures are ignored. The range is widened to whole pages.
+     */
+    void advise(map_advice advice, std::size_t offset = 0, std::size_t length = npos) noexcept
+    {
+        if (offset >= size_) {
+            return;
+        }
+        length = length < size_ - offset ? length : size_ - offset;
+#if STD_MODULE_FSTREAM_POSIX
+        std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t start = offset / page * page;
+        ::madvise(data_ + start, length + (offset - start), detail::fstream_madvice(advice));
+#else
+        (void)advice;
+#endif
+    }
+
+    /// Writes read_write changes back to the file and waits for them; nothing to do for read_only
+    void flush()
+    {
+        std::error_code ec;
+        flush(ec);
+        if (ec) {
+#if STD_MODULE_FSTREAM_POSIX
+            throw std::filesystem::filesystem_error("mapped_file::flush", ec);
+#else
+            throw std::filesystem::filesystem_error("mapped_file::flush", path_, ec);
+#endif
+        }
+    }
+
+    void flush(std::error_code& ec) noexcept
+    {
+        ec.clear();
+        if (mode_ != map_mode::read_write || size_ == 0) {
+            return;
+        }
+#if STD_MODULE_FSTREAM_POSIX
+        if (::msync(data_, size_, MS_SYNC) != 0) {
+            ec.assign(errno, std::generic_category());
+        }
+#else
+        std::ofstream out(path_, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+        if (!out.write(reinterpret_cast<const char*>(data_), static_cast<std::streamsize>(size_)) || !out.flush()) {
+            ec = std::make_error_code(std::errc::io_error);
+        }
+#endif
+    }
+
+private:
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    map_mode mode_ = map_mode::read_only;
+    bool open_ = false;
+#if !STD_MODULE_FSTREAM_POSIX
+    std::unique_ptr<std::byte[]> copy_;
+    std::filesystem::path path_;
+#endif
+};
+
+inline void swap(mapped_file& a, mapped_file& b) noexcept { a.swap(b); }
+
+/**
+ * @brief A read-only streambuf over mapped bytes, for std::istream code.
+ *
+ * The whole mapping is the get area, so reads are memcpy from the page
+ * cache (or no copy at all for getline-style scans of the buffer) with
+ * no underflow() calls and no file reads. Seeking is pointer arithmetic.
+ * Either owns a mapped_file or views bytes that outlive it.
+ *
+ * @code
+ * std_module::mapped_streambuf buf("input.csv");
+ * std::istream in(&buf);
+ * @endcode
+ */
+class mapped_streambuf : public std::streambuf
+{
+public:
+    mapped_streambuf() = default;
+
+    /// Views @p bytes, which must outlive the buffer
+    explicit mapped_streambuf(std::span<const std::byte> bytes) { view(bytes); }
+
+    /// Takes ownership of @p file
+    explicit mapped_streambuf(mapped_file file) : file_(std::move(file)) { view(file_.bytes()); }
+
+    /// Maps @p p, by default with sequential read-ahead; throws filesystem_error
+    explicit mapped_streambuf(const std::filesystem::path& p,
+                              const map_options& options = {.advice = map_advice::sequential})
+        : mapped_streambuf(mapped_file(p, options))
+    {
+    }
+
+    mapped_streambuf(const mapped_streambuf&) = delete;
+    mapped_streambuf& operator=(const mapped_streambuf&) = delete;
+
+    /// The owned mapping; not open when viewing bytes
+    const mapped_file& file() const noexcept { return file_; }
+
+protected:
+    std::streamsize showmanyc() override { return gptr() == egptr() ? -1 : egptr() - gptr(); }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if ((which & std::ios_base::in) == 0) {
+            return pos_type(off_type(-1));
+        }
+        off_type base = dir == std::ios_base::beg   ? 0
+                        : dir == std::ios_base::cur ? gptr() - eback()
+                                                    : egptr() - eback();
+        off_type target = base + off;
+        if (target < 0 || target > egptr() - eback()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + target, egptr());
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    void view(std::span<const std::byte> bytes) noexcept
+    {
+        // The get area is never written through: pbackfail() is not overridden, so putting back a
+        // different character fails instead of storing it
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(bytes.data()));
+        setg(begin, begin, begin + bytes.size());
+    }
+
+    mapped_file file_;
+};
+}  // namespace std_module
+
+// ------------------------------------------------------------------------------
+// Buffered binary output
+// ------------------------------------------------------------------------------
+
+export namespace std_module
+{
+/// How fast_filebuf buffers and writes
+struct fast_filebuf_options
+{
+    std::size_t buffer_size = 1 << 20; ///< Bytes per write() call; rounded up to alignment, capped at INT_MAX
+    std::size_t alignment = 4096;      ///< Of the buffer, and of O_DIRECT writes; a power of two
+    bool direct = false; ///< Write with O_DIRECT (Linux), bypassing the page cache where the file system allows
+};
+}  // namespace std_module
+
+namespace std_module::detail
+{
+/// The file under a fast_filebuf: every write names its offset, so no shared file position
+class fstream_file
+{
+public:
+    fstream_file() = default;
+    fstream_file(const fstream_file&) = delete;
+    fstream_file& operator=(const fstream_file&) = delete;
+    ~fstream_file()
+    {
+        std::error_code ec;
+        close(ec);
+    }
+
+    /// Opens for writing, creating the file; @p direct is cleared when O_DIRECT is unavailable
+    bool open(const std::filesystem::path& p, bool truncate, bool& direct, std::error_code& ec) noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+#if defined(O_DIRECT)
+        if (direct) {
+            fd_ = ::open(p.c_str(), flags | O_DIRECT, 0666);
+            if (fd_ >= 0) {
+                return true;
+            }
+        }
+#endif
+        direct = false;  // Not supported here, or refused by the file system (tmpfs)
+        fd_ = ::open(p.c_str(), flags, 0666);
+        if (fd_ < 0) {
+            ec.assign(errno, std::generic_category());
+            return false;
+        }
+        return true;
+#else
+        direct = false;
+        std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+        if (!truncate) {
+            std::filebuf create;
+            if (!create.open(p, std::ios_base::in | std::ios_base::binary)) {
+                create.open(p, mode);
+            }
+            mode |= std::ios_base::in;
+        }
+        if (!file_.open(p, mode)) {
+            ec = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    bool is_open() const noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        return fd_ >= 0;
+#else
+        return file_.is_open();
+#endif
+    }
+
+    /// Writes all of [data, data + size) at @p offset; safe from several threads on disjoint ranges
+    bool write(const char* data, std::size_t size, std::uint64_t offset, std::error_code& ec) noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        while (size != 0) {
+            ssize_t n = ::pwrite(fd_, data, size, static_cast<off_t>(offset));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ec.assign(errno, std::generic_category());
+                return false;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+        return true;
+#else
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto at = std::streampos(static_cast<std::streamoff>(offset));
+        if (file_.pubseekpos(at, std::ios_base::out) != at ||
+            file_.sputn(data, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size) ||
+            file_.pubsync() != 0) {
+            ec = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    bool size(std::uint64_t& out, std::error_code& ec) noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            ec.assign(errno, std::generic_category());
+            return false;
+        }
+        out = static_cast<std::uint64_t>(st.st_size);
+        return true;
+#else
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::streamoff end = file_.pubseekoff(0, std::ios_base::end, std::ios_base::out);
+        if (end < 0) {
+            ec = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        out = static_cast<std::uint64_t>(end);
+        return true;
+#endif
+    }
+
+    /// Cuts off the padding of an O_DIRECT write; only called while direct
+    bool truncate(std::uint64_t size, std::error_code& ec) noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            ec.assign(errno, std::generic_category());
+            return false;
+        }
+#else
+        (void)size;
+        (void)ec;
+#endif
+        return true;
+    }
+
+    /// Turns O_DIRECT off, for writes that cannot be aligned
+    void drop_direct() noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX && defined(O_DIRECT)
+        ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+#endif
+    }
+
+    bool close(std::error_code& ec) noexcept
+    {
+#if STD_MODULE_FSTREAM_POSIX
+        if (fd_ < 0) {
+            return true;
+        }
+        bool ok = ::close(fd_) == 0;
+        if (!ok) {
+            ec.assign(errno, std::generic_category());
+        }
+        fd_ = -1;
+        return ok;
+#else
+        if (!file_.is_open()) {
+            return true;
+        }
+        if (!file_.close()) {
+            ec = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        return true;
+#endif
+    }
+
+private:
+#if STD_MODULE_FSTREAM_POSIX
+    int fd_ = -1;
+#else
+    std::filebuf file_;
+    std::mutex mutex_;
+#endif
+};
+
+struct fstream_aligned_delete
+{
+    std::size_t alignment;
+
+    void operator()(char* p) const noexcept { ::operator delete[](p, std::align_val_t(alignment)); }
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief A write-only, char-only file buffer for bulk binary output.
+ *
+ * std::filebuf writes through a small buffer (BUFSIZ in libstdc++) and
+ * asks its codecvt facet about every overflow, even for char with no
+ * conversion. fast_filebuf gathers output in one large aligned buffer
+ * (1 MiB by default) and hands it straight to pwrite(); writes of 64 KiB
+ * or more skip the copy and go to the kernel directly (except O_DIRECT).
+ * There is no locale involvement at this level: bytes in are bytes out.
+ *
+ * With fast_filebuf_options::direct the file is opened O_DIRECT: output
+ * bypasses the page cache (no cache pollution, no writeback stalls for
+ * multi-GB checkpoints). Every write is then a whole number of aligned
+ * blocks; the last, partial block is written zero-padded, the file cut
+ * back to size, and the block rewritten once it fills. Seeking to a
+ * position, or appending to a file whose size is not aligned, turns
+ * O_DIRECT off for the rest of the file. File systems that refuse
+ * O_DIRECT (tmpfs) get ordinary writes.
+ *
+ * The stream position is kept here, not in the file: every write is a
+ * pwrite() at an explicit offset. ios_base::app therefore starts at the
+ * end of the file rather than seeking there before each write.
+ *
+ * Failures make the stream operations fail (overflow() returns eof,
+ * sync() -1, open() and close() nullptr) as with std::filebuf; error()
+ * says why.
+ */
+class fast_filebuf : public std::streambuf
+{
+public:
+    fast_filebuf() = default;
+    fast_filebuf(const fast_filebuf&) = delete;
+    fast_filebuf& operator=(const fast_filebuf&) = delete;
+    ~fast_filebuf() override { close(); }
+
+    /**
+     * @brief Opens @p p for writing, creating it.
+     *
+     * @p mode is as for std::filebuf: truncated unless it has in or app;
+     * app and ate start at the end of the file.
+     * @return this, or nullptr if already open or the file cannot be opened
+     */
+    fast_filebuf* open(const std::filesystem::path& p,
+                       std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc,
+                       const fast_filebuf_options& options = {})
+    {
+        if (is_open()) {
+            return nullptr;
+        }
+        error_.clear();
+        std::size_t alignment = options.alignment < alignof(std::max_align_t) ? alignof(std::max_align_t)
+                                                                               : options.alignment;
+        std::size_t capacity = options.buffer_size < alignment ? alignment : options.buffer_size;
+        capacity = (capacity + alignment - 1) / alignment * alignment;
+        // The put area is advanced with pbump(int)
+        std::size_t max_capacity = static_cast<std::size_t>(std::numeric_limits<int>::max()) / alignment * alignment;
+        if (capacity > max_capacity && max_capacity != 0) {
+            capacity = max_capacity;
+        }
+        if (!buffer_ || capacity != capacity_ || alignment != buffer_.get_deleter().alignment) {
+            buffer_.reset();
+            buffer_ = buffer(new (std::align_val_t(alignment)) char[capacity],
+                             detail::fstream_aligned_delete{alignment});
+            capacity_ = capacity;
+        }
+        bool truncate = (mode & (std::ios_base::in | std::ios_base::app)) == 0 || (mode & std::ios_base::trunc) != 0;
+        direct_ = options.direct;
+        if (!file_.open(p, truncate, direct_, error_)) {
+            return nullptr;
+        }
+        std::uint64_t end = 0;
+        if (!file_.size(end, error_)) {
+            file_.close(error_);
+            return nullptr;
+        }
+        position_ = (mode & (std::ios_base::app | std::ios_base::ate)) != 0 ? end : 0;
+        if (direct_ && (position_ % alignment != 0 || position_ != end)) {
+            drop_direct();  // Padded writes would land on data past the position
+        }
+        setp(buffer_.get(), buffer_.get() + capacity_);
+        return this;
+    }
+
+    bool is_open() const noexcept { return file_.is_open(); }
+
+    /// Whether writes are going out O_DIRECT
+    bool direct() const noexcept { return direct_; }
+
+    /// Writes what is buffered and closes; @return this, or nullptr if not open or anything failed
+    fast_filebuf* close() noexcept
+    {
+        if (!is_open()) {
+            return nullptr;
+        }
+        bool ok = flush_buffer();
+        ok = file_.close(error_) && ok;
+        setp(nullptr, nullptr);
+        return ok ? this : nullptr;
+    }
+
+    /**
+     * @brief Writes [data, data + size) at byte @p offset, around the buffer.
+     *
+     * For patching headers and for writers that lay out a file from
+     * several threads: calls on disjoint ranges may run concurrently with
+     * each other and with streaming to other ranges. Buffered output is
+     * not flushed first, so overlapping it is unspecified. While direct(),
+     * data, size and offset must be aligned and the range must lie before
+     * the stream position.
+     */
+    std::error_code write_at(std::uint64_t offset, const void* data, std::size_t size) noexcept
+    {
+        std::error_code ec;
+        if (!file_.is_open()) {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+        } else {
+            file_.write(static_cast<const char*>(data), size, offset, ec);
+        }
+        return ec;
+    }
+
+    /// Why the last failed operation failed
+    std::error_code error() const noexcept { return error_; }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!is_open() || !flush_buffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type* s, std::streamsize n) override
+    {
+        std::streamsize room = epptr() - pptr();
+        if (n <= room) {
+            traits_type::copy(pptr(), s, static_cast<std::size_t>(n));
+            pbump(static_cast<int>(n));
+            return n;
+        }
+        if (!is_open()) {
+            return 0;
+        }
+        std::streamsize done = 0;
+        if (!direct_ && static_cast<std::size_t>(n) >= (capacity_ < bypass_size ? capacity_ : bypass_size)) {
+            // Large writes go straight to the kernel, after what is buffered
+            if (!flush_buffer() || !file_.write(s, static_cast<std::size_t>(n), position_, error_)) {
+                return 0;
+            }
+            position_ += static_cast<std::uint64_t>(n);
+            return n;
+        }
+        while (done < n) {
+            room = epptr() - pptr();
+            if (room == 0) {
+                if (!flush_buffer()) {
+                    return done;
+                }
+                continue;
+            }
+            std::streamsize step = n - done < room ? n - done : room;
+            traits_type::copy(pptr(), s + done, static_cast<std::size_t>(step));
+            pbump(static_cast<int>(step));
+            done += step;
+        }
+        return n;
+    }
+
+    int sync() override { return is_open() && flush_buffer() ? 0 : -1; }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        auto fail = pos_type(off_type(-1));
+        if (!is_open() || (which & std::ios_base::out) == 0) {
+            return fail;
+        }
+        std::uint64_t here = position_ + static_cast<std::uint64_t>(pptr() - pbase());
+        if (dir == std::ios_base::cur && off == 0) {
+            return pos_type(static_cast<off_type>(here));  // tellp() without flushing
+        }
+        if (!flush_buffer()) {
+            return fail;
+        }
+        if (direct_) {
+            // A direct flush keeps the partial last block buffered; write it plainly at its unaligned end
+            drop_direct();
+            if (!flush_buffer()) {
+                return fail;
+            }
+        }
+        std::uint64_t end = 0;
+        if (dir == std::ios_base::end && !file_.size(end, error_)) {
+            return fail;
+        }
+        off_type base = dir == std::ios_base::beg   ? 0
+                        : dir == std::ios_base::cur ? static_cast<off_type>(here)
+                                                    : static_cast<off_type>(end);
+        if (off < -base) {
+            return fail;
+        }
+        position_ = static_cast<std::uint64_t>(base + off);
+        return pos_type(static_cast<off_type>(position_));
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    using buffer = std::unique_ptr<char[], detail::fstream_aligned_delete>;
+
+    /// Writes this large skip the buffer: the kernel copies them from cache-hot memory instead
+    static constexpr std::size_t bypass_size = 64 * 1024;
+
+    /// Writes out the buffer and empties it; while direct, the partial last block is written padded and kept
+    bool flush_buffer() noexcept
+    {
+        auto n = static_cast<std::size_t>(pptr() - pbase());
+        if (n == 0) {
+            return true;
+        }
+        if (!direct_) {
+            if (!file_.write(pbase(), n, position_, error_)) {
+                return false;
+            }
+            position_ += n;
+            setp(pbase(), epptr());
+            return true;
+        }
+        std::size_t alignment = buffer_.get_deleter().alignment;
+        std::size_t whole = n / alignment * alignment;
+        std::size_t padded = (n + alignment - 1) / alignment * alignment;
+        std::memset(pbase() + n, 0, padded - n);
+        if (!file_.write(pbase(), padded, position_, error_)) {
+            return false;
+        }
+        if (padded != whole && !file_.truncate(position_ + n, error_)) {
+            return false;
+        }
+        // Keep the partial block: it is written again, in full, once it fills
+        std::memmove(pbase(), pbase() + whole, n - whole);
+        position_ += whole;
+        setp(pbase(), epptr());
+        pbump(static_cast<int>(n - whole));
+        return true;
+    }
+
+    /// Back to ordinary writes, for positions that are not aligned
+    void drop_direct() noexcept
+    {
+        file_.drop_direct();
+        direct_ = false;
+    }
+
+    detail::fstream_file file_;
+    buffer buffer_{nullptr, detail::fstream_aligned_delete{alignof(std::max_align_t)}};
+    std::size_t capacity_ = 0;
+    std::uint64_t position_ = 0;  ///< File offset of pbase()
+    bool direct_ = false;
+    std::error_code error_;
+};
+
+/**
+ * @brief An std::ostream writing through a fast_filebuf.
+ *
+ * A drop-in for binary std::ofstream output: write() and put() go to the
+ * large buffer; formatted output (operator<<) still formats through the
+ * stream's locale, as it would with any streambuf.
+ */
+class fast_ofstream : public std::ostream
+{
+public:
+    fast_ofstream() : std::ostream(nullptr) { this->init(&buf_); }
+
+    explicit fast_ofstream(const std::filesystem::path& p,
+                           std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc,
+                           const fast_filebuf_options& options = {})
+        : fast_ofstream()
+    {
+        open(p, mode, options);
+    }
+
+    fast_ofstream(const fast_ofstream&) = delete;
+    fast_ofstream& operator=(const fast_ofstream&) = delete;
+
+    /// Sets failbit if the file cannot be opened, clears the state otherwise
+    void open(const std::filesystem::path& p,
+              std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc,
+              const fast_filebuf_options& options = {})
+    {
+        if (buf_.open(p, mode | std::ios_base::out, options)) {
+            this->clear();
+        } else {
+            this->setstate(std::ios_base::failbit);
+        }
+    }
+
+    /// Sets failbit if anything buffered could not be written
+    void close()
+    {
+        if (!buf_.close()) {
+            this->setstate(std::ios_base::failbit);
+        }
+    }
+
+    bool is_open() const noexcept { return buf_.is_open(); }
+
+    fast_filebuf* rdbuf() const noexcept { return const_cast<fast_filebuf*>(&buf_); }
+
+    /// As fast_filebuf::write_at
+    std::error_code write_at(std::uint64_t offset, const void* data, std::size_t size) noexcept
+    {
+        return buf_.write_at(offset, data, size);
+    }
+
+private:
+    fast_filebuf buf_;
+};
+}  // namespace std_module
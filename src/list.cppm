@@ -6,6 +6,10 @@
 module;
 
 #include <list>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 
 export module std_module.list;
 
@@ -30,3 +34,259 @@ using std::operator<=>;
 using std::erase;
 using std::erase_if;
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module
+{
+template <class T, class Tag>
+class intrusive_list;
+
+/**
+ * @brief Links that make a type storable in an intrusive_list.
+ *
+ * Derive the element type from list_hook<Tag>; use distinct tags to put
+ * one element into several lists at once. Copying an element does not
+ * copy its links. An element must outlive its membership in a list.
+ */
+template <class Tag = void>
+class list_hook {
+public:
+    list_hook() noexcept = default;
+    list_hook(const list_hook&) noexcept {}
+    list_hook& operator=(const list_hook&) noexcept { return *this; }
+
+    /// True while the element is in a list.
+    bool is_linked() const noexcept { return next_ != nullptr; }
+
+private:
+    template <class, class>
+    friend class intrusive_list;
+
+    list_hook* prev_ = nullptr;
+    list_hook* next_ = nullptr;
+};
+
+/**
+ * @brief Doubly-linked list threading through hooks embedded in elements.
+ *
+ * The list never allocates or copies: push/insert link the caller's
+ * object, erase unlinks it (O(1) given only the element, via erase(T&)),
+ * and the caller keeps ownership. Interface follows std::list where it
+ * makes sense; size() is O(1). Destroying or clearing the list unlinks all
+ * elements.
+ */
+template <class T, class Tag = void>
+class intrusive_list {
+    using hook = list_hook<Tag>;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() noexcept = default;
+        basic_iterator(const basic_iterator<false>& other) noexcept requires Const
+            : node_(other.node_) {}
+
+        reference operator*() const noexcept { return static_cast<reference>(*node_); }
+        pointer operator->() const noexcept { return &**this; }
+
+        basic_iterator& operator++() noexcept {
+            node_ = node_->next_;
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            basic_iterator tmp = *this;
+            node_ = node_->next_;
+            return tmp;
+        }
+
+        basic_iterator& operator--() noexcept {
+            node_ = node_->prev_;
+            return *this;
+        }
+
+        basic_iterator operator--(int) noexcept {
+            basic_iterator tmp = *this;
+            node_ = node_->prev_;
+            return tmp;
+        }
+
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept {
+            return a.node_ == b.node_;
+        }
+
+    private:
+        friend class intrusive_list;
+        friend class basic_iterator<!Const>;
+
+        explicit basic_iterator(hook* node) noexcept : node_(node) {}
+
+        hook* node_ = nullptr;
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    intrusive_list() noexcept { reset(); }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    intrusive_list(intrusive_list&& other) noexcept {
+        reset();
+        splice(end(), other);
+    }
+
+    intrusive_list& operator=(intrusive_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            splice(end(), other);
+        }
+        return *this;
+    }
+
+    ~intrusive_list() { clear(); }
+
+    // ---- Iterators ----
+
+    iterator begin() noexcept { return iterator(root_.next_); }
+    const_iterator begin() const noexcept { return const_iterator(root_.next_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(&root_); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<hook*>(&root_)); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /// Iterator to @p value, which must be in this list.
+    iterator iterator_to(T& value) noexcept { return iterator(as_hook(value)); }
+    const_iterator iterator_to(const T& value) const noexcept {
+        return const_iterator(as_hook(const_cast<T&>(value)));
+    }
+
+    // ---- Capacity and access ----
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    reference front() noexcept { return *begin(); }
+    const_reference front() const noexcept { return *begin(); }
+    reference back() noexcept { return *iterator(root_.prev_); }
+    const_reference back() const noexcept { return *const_iterator(root_.prev_); }
+
+    // ---- Modifiers ----
+
+    void push_front(T& value) noexcept { insert(begin(), value); }
+    void push_back(T& value) noexcept { insert(end(), value); }
+    void pop_front() noexcept { erase(begin()); }
+    void pop_back() noexcept { erase(iterator(root_.prev_)); }
+
+    /// Link @p value before @p pos; @p value must not be linked.
+    iterator insert(const_iterator pos, T& value) noexcept {
+        hook* h = as_hook(value);
+        hook* next = pos.node_;
+        h->next_ = next;
+        h->prev_ = next->prev_;
+        next->prev_->next_ = h;
+        next->prev_ = h;
+        ++size_;
+        return iterator(h);
+    }
+
+    /// Unlink the element at @p pos; returns the following position.
+    iterator erase(const_iterator pos) noexcept {
+        hook* h = pos.node_;
+        hook* next = h->next_;
+        unlink(h);
+        --size_;
+        return iterator(next);
+    }
+
+    /// Unlink @p value, which must be in this list. O(1).
+    void erase(T& value) noexcept { erase(const_iterator(as_hook(value))); }
+
+    /// Move every element of @p other before @p pos.
+    void splice(const_iterator pos, intrusive_list& other) noexcept {
+        if (other.empty()) {
+            return;
+        }
+        hook* first = other.root_.next_;
+        hook* last = other.root_.prev_;
+        hook* next = pos.node_;
+        first->prev_ = next->prev_;
+        next->prev_->next_ = first;
+        last->next_ = next;
+        next->prev_ = last;
+        size_ += other.size_;
+        other.reset();
+    }
+
+    /// Move the element at @p it from @p other before @p pos.
+    void splice(const_iterator pos, intrusive_list& other, const_iterator it) noexcept {
+        if (pos == it || pos.node_ == it.node_->next_) {
+            return;
+        }
+        T& value = const_cast<T&>(*it);
+        other.erase(it);
+        insert(pos, value);
+    }
+
+    /// Unlink every element.
+    void clear() noexcept {
+        hook* h = root_.next_;
+        while (h != &root_) {
+            hook* next = h->next_;
+            h->prev_ = h->next_ = nullptr;
+            h = next;
+        }
+        reset();
+    }
+
+    void swap(intrusive_list& other) noexcept {
+        intrusive_list tmp(std::move(other));
+        other.splice(other.end(), *this);
+        splice(end(), tmp);
+    }
+
+private:
+    static hook* as_hook(T& value) noexcept { return static_cast<hook*>(&value); }
+
+    static void unlink(hook* h) noexcept {
+        h->prev_->next_ = h->next_;
+        h->next_->prev_ = h->prev_;
+        h->prev_ = h->next_ = nullptr;
+    }
+
+    void reset() noexcept {
+        root_.prev_ = root_.next_ = &root_;
+        size_ = 0;
+    }
+
+    hook root_;
+    size_type size_ = 0;
+};
+
+template <class T, class Tag>
+void swap(intrusive_list<T, Tag>& a, intrusive_list<T, Tag>& b) noexcept {
+    a.swap(b);
+}
+}  // namespace std_module
@@ -6,6 +6,10 @@
 module;
 
 #include <memory>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 export module std_module.memory;
 
@@ -96,3 +100,214 @@ using std::operator<<;
 // Hash support
 using std::hash;
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+namespace std_module::detail
+{
+/**
+ * Pool of fixed-size blocks carved out of large slabs.
+ *
+ * Blocks are handed out by bumping through the newest slab and recycled
+ * through an intrusive free list; slabs are only returned to the system
+ * when the pool is destroyed. Not thread-safe.
+ */
+class fixed_pool {
+public:
+    fixed_pool(std::size_t size, std::size_t align, std::size_t blocks_per_slab)
+        : block_align_(block_align_for(align)),
+          block_size_(block_size_for(size, align)),
+          blocks_per_slab_(blocks_per_slab ? blocks_per_slab : 1) {}
+
+    // Blocks must be able to hold a free-list link.
+    static constexpr std::size_t block_align_for(std::size_t align) noexcept {
+        return align < alignof(void*) ? alignof(void*) : align;
+    }
+
+    static constexpr std::size_t block_size_for(std::size_t size, std::size_t align) noexcept {
+        std::size_t a = block_align_for(align);
+        std::size_t n = size < sizeof(void*) ? sizeof(void*) : size;
+        return (n + a - 1) / a * a;
+    }
+
+    fixed_pool(const fixed_pool&) = delete;
+    fixed_pool& operator=(const fixed_pool&) = delete;
+
+    ~fixed_pool() {
+        for (void* slab : slabs_) {
+            ::operator delete(slab, std::align_val_t(block_align_));
+        }
+    }
+
+    std::size_t block_size() const noexcept { return block_size_; }
+    std::size_t block_align() const noexcept { return block_align_; }
+
+    void* allocate() {
+        if (free_) {
+            free_block* b = free_;
+            free_ = b->next;
+            return b;
+        }
+        if (cursor_ == slab_end_) {
+            grow();
+        }
+        void* p = cursor_;
+        cursor_ += block_size_;
+        return p;
+    }
+
+    void deallocate(void* p) noexcept {
+        auto* b = static_cast<free_block*>(p);
+        b->next = free_;
+        free_ = b;
+    }
+
+private:
+    struct free_block {
+        free_block* next;
+    };
+
+    void grow() {
+        std::size_t bytes = block_size_ * blocks_per_slab_;
+        slabs_.reserve(slabs_.size() + 1);
+        void* slab = ::operator new(bytes, std::align_val_t(block_align_));
+        slabs_.push_back(slab);
+        cursor_ = static_cast<unsigned char*>(slab);
+        slab_end_ = cursor_ + bytes;
+    }
+
+    std::size_t block_align_;
+    std::size_t block_size_;
+    std::size_t blocks_per_slab_;
+    free_block* free_ = nullptr;
+    unsigned char* cursor_ = nullptr;
+    unsigned char* slab_end_ = nullptr;
+    std::vector<void*> slabs_;
+};
+
+/**
+ * The pools shared by one node_pool_allocator and all of its rebound
+ * copies, one pool per (size, alignment).
+ */
+class fixed_pool_set {
+public:
+    explicit fixed_pool_set(std::size_t blocks_per_slab) : blocks_per_slab_(blocks_per_slab) {}
+
+    fixed_pool& get(std::size_t size, std::size_t align) {
+        std::size_t block_size = fixed_pool::block_size_for(size, align);
+        std::size_t block_align = fixed_pool::block_align_for(align);
+        for (auto& pool : pools_) {
+            if (pool->block_size() == block_size && pool->block_align() == block_align) {
+                return *pool;
+            }
+        }
+        pools_.push_back(std::make_unique<fixed_pool>(size, align, blocks_per_slab_));
+        return *pools_.back();
+    }
+
+private:
+    std::size_t blocks_per_slab_;
+    std::vector<std::unique_ptr<fixed_pool>> pools_;
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Allocator serving single-object allocations from contiguous slabs.
+ *
+ * Node-based containers (std::list, std::forward_list, std::map,
+ * std::unordered_map nodes) allocate one element at a time; this allocator
+ * serves those requests from slabs of @p NodesPerSlab blocks, so nodes are
+ * packed together in memory and allocation is a free-list pop instead of a
+ * call to operator new. Requests for more than one object (vectors, hash
+ * bucket arrays) go to std::allocator.
+ *
+ * A default-constructed allocator owns a fresh set of pools; copies and
+ * rebound copies share it, and compare equal exactly when they do. Copying
+ * a container gives the copy its own pools. Memory returns to the pools
+ * when elements are freed and to the system when the last allocator
+ * sharing the pools is destroyed. Not thread-safe: a container and the
+ * pools behind it must be used from one thread at a time.
+ */
+template <class T, std::size_t NodesPerSlab = 4096>
+class node_pool_allocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <class U>
+    struct rebind {
+        using other = node_pool_allocator<U, NodesPerSlab>;
+    };
+
+    node_pool_allocator()
+        : pools_(std::make_shared<detail::fixed_pool_set>(NodesPerSlab)),
+          pool_(&pools_->get(sizeof(T), alignof(T))) {}
+
+    // Moves copy: a moved-from allocator must still free what it allocated
+    // and compare equal to its move target.
+    node_pool_allocator(const node_pool_allocator&) noexcept = default;
+    node_pool_allocator(node_pool_allocator&& other) noexcept : node_pool_allocator(other) {}
+    node_pool_allocator& operator=(const node_pool_allocator&) noexcept = default;
+    node_pool_allocator& operator=(node_pool_allocator&& other) noexcept { return *this = other; }
+
+    // Must not throw, so the pool for T is looked up (and maybe created) on
+    // first use unless other already uses blocks of the same shape.
+    template <class U>
+    node_pool_allocator(const node_pool_allocator<U, NodesPerSlab>& other) noexcept
+        : pools_(other.pools_), pool_(other.pool_ && same_blocks<U>() ? other.pool_ : nullptr) {}
+
+    T* allocate(size_type n) {
+        if (n == 1) {
+            return static_cast<T*>(pool().allocate());
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_type n) noexcept {
+        if (n == 1) {
+            // The pool exists (p came from it), so pool() finds it without allocating
+            pool().deallocate(p);
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    node_pool_allocator select_on_container_copy_construction() const {
+        return node_pool_allocator();
+    }
+
+    template <class U>
+    bool operator==(const node_pool_allocator<U, NodesPerSlab>& other) const noexcept {
+        return pools_ == other.pools_;
+    }
+
+private:
+    template <class, std::size_t>
+    friend class node_pool_allocator;
+
+    template <class U>
+    static constexpr bool same_blocks() noexcept {
+        return detail::fixed_pool::block_size_for(sizeof(U), alignof(U)) ==
+                   detail::fixed_pool::block_size_for(sizeof(T), alignof(T)) &&
+               detail::fixed_pool::block_align_for(alignof(U)) == detail::fixed_pool::block_align_for(alignof(T));
+    }
+
+    detail::fixed_pool& pool() {
+        if (!pool_) {
+            pool_ = &pools_->get(sizeof(T), alignof(T));
+        }
+        return *pool_;
+    }
+
+    std::shared_ptr<detail::fixed_pool_set> pools_;
+    detail::fixed_pool* pool_;
+};
+}  // namespace std_module
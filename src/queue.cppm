@@ -6,6 +6,17 @@
 module;
 
 #include <queue>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 export module std_module.queue;
 
@@ -22,3 +33,1129 @@ using std::swap;
 // are defined as hidden friends inside the class templates, so they
 // should be available through ADL when using the exported types.
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+namespace std_module::detail
+{
+/**
+ * d-ary heap over (value, id) entries with an id -> position table.
+ *
+ * Shared by mutable_dary_heap (ids are handed out internally) and
+ * indexed_priority_queue (ids are chosen by the caller). Values live next
+ * to their id in one contiguous array so sifting never chases pointers;
+ * the position table is only written, never read, on the hot path.
+ */
+template <class T, std::size_t D, class Compare>
+class indexed_dary_heap {
+    static_assert(D >= 2, "heap arity must be at least 2");
+
+public:
+    using size_type = std::size_t;
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    struct entry {
+        T value;
+        size_type id;
+    };
+
+    indexed_dary_heap() = default;
+    explicit indexed_dary_heap(const Compare& comp) : comp_(comp) {}
+
+    bool empty() const noexcept { return heap_.empty(); }
+    size_type size() const noexcept { return heap_.size(); }
+    const entry& front() const { return heap_.front(); }
+
+    bool contains(size_type id) const noexcept {
+        return id < pos_.size() && pos_[id] != npos;
+    }
+
+    const T& value(size_type id) const { return heap_[pos_[id]].value; }
+
+    void reserve(size_type n) {
+        heap_.reserve(n);
+        pos_.reserve(n);
+    }
+
+    template <class... Args>
+    void emplace(size_type id, Args&&... args) {
+        if (id >= pos_.size()) {
+            pos_.resize(id + 1, npos);
+        }
+        heap_.push_back(entry{T(std::forward<Args>(args)...), id});
+        sift_up(heap_.size() - 1);
+    }
+
+    void pop() { erase_at(0); }
+
+    void erase(size_type id) { erase_at(pos_[id]); }
+
+    template <class U>
+    void update(size_type id, U&& v) {
+        size_type i = pos_[id];
+        heap_[i].value = std::forward<U>(v);
+        if (i > 0 && comp_(heap_[parent(i)].value, heap_[i].value)) {
+            sift_up(i);
+        } else {
+            sift_down(i);
+        }
+    }
+
+    void clear() noexcept {
+        heap_.clear();
+        pos_.clear();
+    }
+
+    void swap(indexed_dary_heap& other) noexcept(std::is_nothrow_swappable_v<Compare>) {
+        using std::swap;
+        swap(heap_, other.heap_);
+        swap(pos_, other.pos_);
+        swap(comp_, other.comp_);
+    }
+
+    const Compare& comp() const noexcept { return comp_; }
+
+private:
+    static constexpr size_type parent(size_type i) noexcept { return (i - 1) / D; }
+    static constexpr size_type first_child(size_type i) noexcept { return i * D + 1; }
+
+    void erase_at(size_type i) {
+        pos_[heap_[i].id] = npos;
+        size_type last = heap_.size() - 1;
+        if (i != last) {
+            heap_[i] = std::move(heap_[last]);
+            heap_.pop_back();
+            if (i > 0 && comp_(heap_[parent(i)].value, heap_[i].value)) {
+                sift_up(i);
+            } else {
+                sift_down(i);
+            }
+        } else {
+            heap_.pop_back();
+        }
+    }
+
+    // Hole-based sifting: the moving entry is held aside and written once.
+    void sift_up(size_type i) {
+        entry moving = std::move(heap_[i]);
+        while (i > 0) {
+            size_type p = parent(i);
+            if (!comp_(heap_[p].value, moving.value)) {
+                break;
+            }
+            heap_[i] = std::move(heap_[p]);
+            pos_[heap_[i].id] = i;
+            i = p;
+        }
+        pos_[moving.id] = i;
+        heap_[i] = std::move(moving);
+    }
+
+    void sift_down(size_type i) {
+        const size_type n = heap_.size();
+        entry moving = std::move(heap_[i]);
+        for (;;) {
+            size_type c = first_child(i);
+            if (c >= n) {
+                break;
+            }
+            size_type end = c + D < n ? c + D : n;
+            size_type best = c;
+            for (size_type k = c + 1; k < end; ++k) {
+                if (comp_(heap_[best].value, heap_[k].value)) {
+                    best = k;
+                }
+            }
+            if (!comp_(moving.value, heap_[best].value)) {
+                break;
+            }
+            heap_[i] = std::move(heap_[best]);
+            pos_[heap_[i].id] = i;
+            i = best;
+        }
+        pos_[moving.id] = i;
+        heap_[i] = std::move(moving);
+    }
+
+    std::vector<entry> heap_;
+    std::vector<size_type> pos_;
+    [[no_unique_address]] Compare comp_{};
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Priority queue backed by a d-ary heap.
+ *
+ * Drop-in for std::priority_queue (same template parameter order, same
+ * top/push/emplace/pop/size/empty/swap interface, max-heap under the
+ * default std::less) with a configurable arity as second parameter. A wider
+ * node (D = 4 by default) halves the tree height and keeps all children of
+ * a node in one or two cache lines, which is what makes it faster than a
+ * binary heap once the queue no longer fits in cache.
+ *
+ * Elements cannot be re-prioritized; use mutable_dary_heap or
+ * indexed_priority_queue for decrease-key.
+ */
+template <class T, std::size_t D = 4, class Container = std::vector<T>,
+          class Compare = std::less<typename Container::value_type>>
+class dary_heap {
+    static_assert(D >= 2, "heap arity must be at least 2");
+
+public:
+    using container_type = Container;
+    using value_compare = Compare;
+    using value_type = typename Container::value_type;
+    using size_type = typename Container::size_type;
+    using reference = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+    static constexpr std::size_t arity = D;
+
+    dary_heap() = default;
+    explicit dary_heap(const Compare& comp) : comp(comp) {}
+
+    dary_heap(const Compare& comp, Container cont) : c(std::move(cont)), comp(comp) {
+        make_heap();
+    }
+
+    [[nodiscard]] bool empty() const { return c.empty(); }
+    size_type size() const { return c.size(); }
+    const_reference top() const { return c.front(); }
+
+    void push(const value_type& v) {
+        c.push_back(v);
+        sift_up(c.size() - 1);
+    }
+
+    void push(value_type&& v) {
+        c.push_back(std::move(v));
+        sift_up(c.size() - 1);
+    }
+
+    template <class... Args>
+    void emplace(Args&&... args) {
+        c.emplace_back(std::forward<Args>(args)...);
+        sift_up(c.size() - 1);
+    }
+
+    void pop() {
+        size_type last = c.size() - 1;
+        if (last > 0) {
+            value_type moving = std::move(c[last]);
+            c.pop_back();
+            sift_hole_to_leaf_then_up(std::move(moving));
+        } else {
+            c.pop_back();
+        }
+    }
+
+    void swap(dary_heap& other) noexcept(std::is_nothrow_swappable_v<Container> &&
+                                         std::is_nothrow_swappable_v<Compare>) {
+        using std::swap;
+        swap(c, other.c);
+        swap(comp, other.comp);
+    }
+
+protected:
+    Container c;
+    Compare comp;
+
+private:
+    static constexpr size_type parent(size_type i) noexcept { return (i - 1) / D; }
+    static constexpr size_type first_child(size_type i) noexcept { return i * D + 1; }
+
+    void make_heap() {
+        if (c.size() < 2) {
+            return;
+        }
+        for (size_type i = parent(c.size() - 1) + 1; i-- > 0;) {
+            value_type moving = std::move(c[i]);
+            size_type hole = i;
+            for (;;) {
+                size_type best = best_child(hole);
+                if (best == hole || !comp(moving, c[best])) {
+                    break;
+                }
+                c[hole] = std::move(c[best]);
+                hole = best;
+            }
+            c[hole] = std::move(moving);
+        }
+    }
+
+    // Largest child of @p i, or @p i itself when it is a leaf.
+    size_type best_child(size_type i) const {
+        const size_type n = c.size();
+        size_type first = first_child(i);
+        if (first >= n) {
+            return i;
+        }
+        size_type end = first + D < n ? first + D : n;
+        size_type best = first;
+        for (size_type k = first + 1; k < end; ++k) {
+            if (comp(c[best], c[k])) {
+                best = k;
+            }
+        }
+        return best;
+    }
+
+    void sift_up(size_type hole) {
+        value_type moving = std::move(c[hole]);
+        while (hole > 0) {
+            size_type p = parent(hole);
+            if (!comp(c[p], moving)) {
+                break;
+            }
+            c[hole] = std::move(c[p]);
+            hole = p;
+        }
+        c[hole] = std::move(moving);
+    }
+
+    // Floyd's pop: walk the root hole down along the best children without
+    // comparing against the replacement (which almost always belongs near
+    // the bottom), then sift the replacement up from the leaf.
+    void sift_hole_to_leaf_then_up(value_type&& moving) {
+        size_type hole = 0;
+        for (;;) {
+            size_type best = best_child(hole);
+            if (best == hole) {
+                break;
+            }
+            c[hole] = std::move(c[best]);
+            hole = best;
+        }
+        while (hole > 0) {
+            size_type p = parent(hole);
+            if (!comp(c[p], moving)) {
+                break;
+            }
+            c[hole] = std::move(c[p]);
+            hole = p;
+        }
+        c[hole] = std::move(moving);
+    }
+};
+
+template <class T, std::size_t D, class Container, class Compare>
+void swap(dary_heap<T, D, Container, Compare>& a,
+          dary_heap<T, D, Container, Compare>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+/**
+ * @brief d-ary heap whose elements can be re-prioritized through handles.
+ *
+ * Same interface as dary_heap, except that push() and emplace() return a
+ * handle that stays valid until the element is popped or erased. update()
+ * re-prioritizes the element in O(log_D n), which covers decrease-key for
+ * Dijkstra-style schedulers; erase() removes it. Tracking positions costs
+ * an extra index per element and a table write per move, so prefer
+ * dary_heap when no element is ever updated.
+ */
+template <class T, std::size_t D = 4, class Compare = std::less<T>>
+class mutable_dary_heap {
+    using heap_type = detail::indexed_dary_heap<T, D, Compare>;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using value_compare = Compare;
+    using handle_type = std::size_t;
+
+    static constexpr std::size_t arity = D;
+
+    mutable_dary_heap() = default;
+    explicit mutable_dary_heap(const Compare& comp) : heap_(comp) {}
+
+    [[nodiscard]] bool empty() const noexcept { return heap_.empty(); }
+    size_type size() const noexcept { return heap_.size(); }
+    const_reference top() const { return heap_.front().value; }
+    handle_type top_handle() const { return heap_.front().id; }
+
+    handle_type push(const value_type& v) { return emplace(v); }
+    handle_type push(value_type&& v) { return emplace(std::move(v)); }
+
+    template <class... Args>
+    handle_type emplace(Args&&... args) {
+        handle_type h = acquire_handle();
+        heap_.emplace(h, std::forward<Args>(args)...);
+        return h;
+    }
+
+    void pop() {
+        free_.push_back(heap_.front().id);
+        heap_.pop();
+    }
+
+    /// True while @p h refers to an element still in the heap.
+    bool contains(handle_type h) const noexcept { return heap_.contains(h); }
+
+    /// Value of the element referred to by @p h.
+    const_reference value(handle_type h) const { return heap_.value(h); }
+
+    /// Replace the value of @p h and restore heap order (either direction).
+    template <class U>
+    void update(handle_type h, U&& v) { heap_.update(h, std::forward<U>(v)); }
+
+    /// Remove the element referred to by @p h.
+    void erase(handle_type h) {
+        heap_.erase(h);
+        free_.push_back(h);
+    }
+
+    void reserve(size_type n) { heap_.reserve(n); }
+
+    void clear() noexcept {
+        heap_.clear();
+        free_.clear();
+    }
+
+    void swap(mutable_dary_heap& other) noexcept(std::is_nothrow_swappable_v<Compare>) {
+        heap_.swap(other.heap_);
+        free_.swap(other.free_);
+    }
+
+    value_compare value_comp() const { return heap_.comp(); }
+
+private:
+    handle_type acquire_handle() {
+        if (!free_.empty()) {
+            handle_type h = free_.back();
+            free_.pop_back();
+            return h;
+        }
+        return heap_.size();
+    }
+
+    heap_type heap_;
+    std::vector<handle_type> free_;
+};
+
+template <class T, std::size_t D, class Compare>
+void swap(mutable_dary_heap<T, D, Compare>& a,
+          mutable_dary_heap<T, D, Compare>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+/**
+ * @brief d-ary heap keyed by caller-supplied dense indices.
+ *
+ * Each element is identified by an index in [0, n) chosen by the caller
+ * (a vertex id, a timer slot), so no handle needs to be stored on the
+ * outside. Same top/pop/size/empty interface as std::priority_queue, plus
+ * contains(), update() and erase() by index.
+ */
+template <class T, std::size_t D = 4, class Compare = std::less<T>>
+class indexed_priority_queue {
+    using heap_type = detail::indexed_dary_heap<T, D, Compare>;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using value_compare = Compare;
+    using index_type = std::size_t;
+
+    static constexpr std::size_t arity = D;
+
+    indexed_priority_queue() = default;
+    explicit indexed_priority_queue(const Compare& comp) : heap_(comp) {}
+
+    [[nodiscard]] bool empty() const noexcept { return heap_.empty(); }
+    size_type size() const noexcept { return heap_.size(); }
+    const_reference top() const { return heap_.front().value; }
+    index_type top_index() const { return heap_.front().id; }
+
+    /// Insert @p v under index @p i; @p i must not already be present.
+    void push(index_type i, const value_type& v) { heap_.emplace(i, v); }
+    void push(index_type i, value_type&& v) { heap_.emplace(i, std::move(v)); }
+
+    template <class... Args>
+    void emplace(index_type i, Args&&... args) {
+        heap_.emplace(i, std::forward<Args>(args)...);
+    }
+
+    void pop() { heap_.pop(); }
+
+    bool contains(index_type i) const noexcept { return heap_.contains(i); }
+    const_reference value(index_type i) const { return heap_.value(i); }
+
+    template <class U>
+    void update(index_type i, U&& v) { heap_.update(i, std::forward<U>(v)); }
+
+    /// Insert @p v under @p i, or update it if @p i is already present.
+    template <class U>
+    void push_or_update(index_type i, U&& v) {
+        if (heap_.contains(i)) {
+            heap_.update(i, std::forward<U>(v));
+        } else {
+            heap_.emplace(i, std::forward<U>(v));
+        }
+    }
+
+    void erase(index_type i) { heap_.erase(i); }
+
+    void reserve(size_type n) { heap_.reserve(n); }
+    void clear() noexcept { heap_.clear(); }
+
+    void swap(indexed_priority_queue& other) noexcept(std::is_nothrow_swappable_v<Compare>) {
+        heap_.swap(other.heap_);
+    }
+
+    value_compare value_comp() const { return heap_.comp(); }
+
+private:
+    heap_type heap_;
+};
+
+template <class T, std::size_t D, class Compare>
+void swap(indexed_priority_queue<T, D, Compare>& a,
+          indexed_priority_queue<T, D, Compare>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+/**
+ * @brief Monotone min-priority queue for unsigned integer keys.
+ *
+ * Valid when keys are never pushed below the last popped key (timer
+ * deadlines, Dijkstra with non-negative weights). Elements are bucketed by
+ * the highest bit in which their key differs from the last popped key, so
+ * push is O(1) and pop is amortized O(bits) with no comparisons on the
+ * push path.
+ *
+ * With T = void the queue stores bare keys; otherwise value_type is
+ * std::pair<Key, T> and emplace(key, args...) constructs the payload.
+ */
+template <class Key, class T = void>
+class radix_heap {
+    static_assert(std::is_unsigned_v<Key>, "radix_heap requires an unsigned integer key");
+
+public:
+    using key_type = Key;
+    using value_type = std::conditional_t<std::is_void_v<T>, Key, std::pair<Key, T>>;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    radix_heap() = default;
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /// Smallest element. Precondition: !empty().
+    const_reference top() const {
+        refill();
+        return buckets_[0].back();
+    }
+
+    /// Smallest key. Precondition: !empty().
+    key_type top_key() const { return key_of(top()); }
+
+    /// Precondition: key_of(v) >= the last popped key.
+    void push(const value_type& v) { place(value_type(v)); }
+    void push(value_type&& v) { place(std::move(v)); }
+
+    template <class... Args>
+    void emplace(Args&&... args) {
+        place(value_type(std::forward<Args>(args)...));
+    }
+
+    void pop() {
+        refill();
+        buckets_[0].pop_back();
+        --size_;
+    }
+
+    void clear() noexcept {
+        for (auto& b : buckets_) {
+            b.clear();
+        }
+        size_ = 0;
+        last_ = 0;
+    }
+
+    void swap(radix_heap& other) noexcept {
+        using std::swap;
+        swap(buckets_, other.buckets_);
+        swap(size_, other.size_);
+        swap(last_, other.last_);
+    }
+
+private:
+    static constexpr std::size_t bucket_count = std::numeric_limits<Key>::digits + 1;
+
+    static key_type key_of(const value_type& v) noexcept {
+        if constexpr (std::is_void_v<T>) {
+            return v;
+        } else {
+            return v.first;
+        }
+    }
+
+    static std::size_t bucket_of(key_type key, key_type last) noexcept {
+        return static_cast<std::size_t>(std::bit_width(static_cast<key_type>(key ^ last)));
+    }
+
+    void place(value_type&& v) {
+        buckets_[bucket_of(key_of(v), last_)].push_back(std::move(v));
+        ++size_;
+    }
+
+    // Move the bucket holding the new minimum down so that bucket 0 is
+    // non-empty; every element in bucket 0 carries key == last_.
+    void refill() const {
+        if (!buckets_[0].empty()) {
+            return;
+        }
+        std::size_t i = 1;
+        while (buckets_[i].empty()) {
+            ++i;
+        }
+        auto& src = buckets_[i];
+        key_type min = key_of(src.front());
+        for (const auto& v : src) {
+            if (key_of(v) < min) {
+                min = key_of(v);
+            }
+        }
+        last_ = min;
+        for (auto& v : src) {
+            buckets_[bucket_of(key_of(v), last_)].push_back(std::move(v));
+        }
+        src.clear();
+    }
+
+    mutable std::vector<value_type> buckets_[bucket_count];
+    size_type size_ = 0;
+    mutable key_type last_ = 0;
+};
+
+template <class Key, class T>
+void swap(radix_heap<Key, T>& a, radix_heap<Key, T>& b) noexcept {
+    a.swap(b);
+}
+}  // namespace std_module
+
+// ==============================================================================
+// Concurrent bounded queues
+// ==============================================================================
+
+namespace std_module::detail
+{
+// Fixed rather than std::hardware_destructive_interference_size, whose value
+// may differ between translation units and triggers -Winterference-size.
+inline constexpr std::size_t cache_line_size = 64;
+
+inline std::size_t ring_capacity(std::size_t requested) {
+    return std::bit_ceil(requested < 2 ? std::size_t{2} : requested);
+}
+
+// Uninitialized ring storage; element lifetime is managed by the queues.
+template <class T>
+class ring_storage {
+public:
+    explicit ring_storage(std::size_t n) : data_(std::allocator<T>().allocate(n)), size_(n) {}
+    ~ring_storage() { std::allocator<T>().deallocate(data_, size_); }
+
+    ring_storage(const ring_storage&) = delete;
+    ring_storage& operator=(const ring_storage&) = delete;
+
+    T* operator+(std::size_t i) const noexcept { return data_ + i; }
+    T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+private:
+    T* data_;
+    std::size_t size_;
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Bounded single-producer/single-consumer ring queue.
+ *
+ * try_push()/try_pop() are wait-free: one relaxed load of the own index,
+ * one acquire load of the other side's index (usually skipped thanks to a
+ * locally cached copy) and one release store. The two indices live on
+ * separate cache lines.
+ *
+ * push()/pop() block with std::atomic::wait when the queue is full/empty
+ * and notify the other side after every operation. The try_ operations
+ * never notify, so a thread blocked in push() or pop() is only woken by
+ * the other side's blocking operations.
+ *
+ * Capacity is rounded up to a power of two.
+ */
+template <class T>
+class spsc_queue {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit spsc_queue(size_type capacity)
+        : mask_(detail::ring_capacity(capacity) - 1), slots_(mask_ + 1) {}
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        size_type h = head_.load(std::memory_order_relaxed);
+        size_type t = tail_.load(std::memory_order_relaxed);
+        for (; h != t; ++h) {
+            std::destroy_at(slots_ + (h & mask_));
+        }
+    }
+
+    size_type capacity() const noexcept { return mask_ + 1; }
+
+    /// Approximate when called concurrently with push/pop.
+    size_type size() const noexcept {
+        size_type h = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - h;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    // ---- Producer side ----
+
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        size_type t = tail_.load(std::memory_order_relaxed);
+        if (t - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (t - head_cache_ > mask_) {
+                return false;
+            }
+        }
+        std::construct_at(slots_ + (t & mask_), std::forward<Args>(args)...);
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& v) { return try_emplace(v); }
+    bool try_push(T&& v) { return try_emplace(std::move(v)); }
+
+    /// Push as many of [first, first + n) as fit; returns the number pushed.
+    template <class InputIt>
+    size_type try_push_bulk(InputIt first, size_type n) {
+        size_type t = tail_.load(std::memory_order_relaxed);
+        size_type room = capacity() - (t - head_cache_);
+        if (room < n) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            room = capacity() - (t - head_cache_);
+        }
+        size_type k = n < room ? n : room;
+        for (size_type i = 0; i < k; ++i, ++first) {
+            std::construct_at(slots_ + ((t + i) & mask_), *first);
+        }
+        if (k) {
+            tail_.store(t + k, std::memory_order_release);
+        }
+        return k;
+    }
+
+    /// Blocking push: waits while the queue is full.
+    template <class... Args>
+    void emplace(Args&&... args) {
+        size_type t = tail_.load(std::memory_order_relaxed);
+        while (t - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (t - head_cache_ > mask_) {
+                head_.wait(head_cache_, std::memory_order_acquire);
+            }
+        }
+        std::construct_at(slots_ + (t & mask_), std::forward<Args>(args)...);
+        tail_.store(t + 1, std::memory_order_release);
+        tail_.notify_one();
+    }
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    /// Blocking bulk push of [first, first + n).
+    template <class InputIt>
+    void push_bulk(InputIt first, size_type n) {
+        while (n > 0) {
+            size_type k = try_push_bulk(first, n);
+            if (k == 0) {
+                head_.wait(head_cache_, std::memory_order_acquire);
+                continue;
+            }
+            tail_.notify_one();
+            std::advance(first, k);
+            n -= k;
+        }
+    }
+
+    // ---- Consumer side ----
+
+    bool try_pop(T& out) {
+        size_type h = head_.load(std::memory_order_relaxed);
+        if (h == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (h == tail_cache_) {
+                return false;
+            }
+        }
+        take(h, out);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        std::optional<T> out;
+        size_type h = head_.load(std::memory_order_relaxed);
+        if (h == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (h == tail_cache_) {
+                return out;
+            }
+        }
+        T* slot = slots_ + (h & mask_);
+        out.emplace(std::move(*slot));
+        std::destroy_at(slot);
+        head_.store(h + 1, std::memory_order_release);
+        return out;
+    }
+
+    /// Pop up to @p max elements into @p out; returns the number popped.
+    template <class OutputIt>
+    size_type try_pop_bulk(OutputIt out, size_type max) {
+        size_type h = head_.load(std::memory_order_relaxed);
+        size_type avail = tail_cache_ - h;
+        if (avail < max) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            avail = tail_cache_ - h;
+        }
+        size_type k = max < avail ? max : avail;
+        for (size_type i = 0; i < k; ++i, ++out) {
+            T* slot = slots_ + ((h + i) & mask_);
+            *out = std::move(*slot);
+            std::destroy_at(slot);
+        }
+        if (k) {
+            head_.store(h + k, std::memory_order_release);
+        }
+        return k;
+    }
+
+    /// Blocking pop: waits while the queue is empty.
+    T pop() {
+        size_type h = head_.load(std::memory_order_relaxed);
+        while (h == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (h == tail_cache_) {
+                tail_.wait(h, std::memory_order_acquire);
+            }
+        }
+        T* slot = slots_ + (h & mask_);
+        T out(std::move(*slot));
+        std::destroy_at(slot);
+        head_.store(h + 1, std::memory_order_release);
+        head_.notify_one();
+        return out;
+    }
+
+    /// Blocking bulk pop: waits until at least one element is available,
+    /// then pops up to @p max; returns the number popped.
+    template <class OutputIt>
+    size_type pop_bulk(OutputIt out, size_type max) {
+        size_type k;
+        while ((k = try_pop_bulk(out, max)) == 0 && max > 0) {
+            tail_.wait(head_.load(std::memory_order_relaxed), std::memory_order_acquire);
+        }
+        head_.notify_one();
+        return k;
+    }
+
+private:
+    void take(size_type h, T& out) {
+        T* slot = slots_ + (h & mask_);
+        out = std::move(*slot);
+        std::destroy_at(slot);
+    }
+
+    const size_type mask_;
+    detail::ring_storage<T> slots_;
+
+    // Consumer-owned line: its index and its view of the producer's index
+    alignas(detail::cache_line_size) std::atomic<size_type> head_{0};
+    size_type tail_cache_ = 0;
+
+    // Producer-owned line
+    alignas(detail::cache_line_size) std::atomic<size_type> tail_{0};
+    size_type head_cache_ = 0;
+};
+
+/**
+ * @brief Bounded multi-producer/multi-consumer queue (Vyukov).
+ *
+ * Each slot carries a sequence counter on its own cache line that says
+ * whose turn it is: a producer holding ticket p may write slot p when its
+ * sequence equals p, a consumer holding ticket p may read it when it equals
+ * p + 1. try_push()/try_pop() claim a ticket with a CAS only once the slot
+ * is ready, so they never block; push()/pop() take a ticket
+ * unconditionally with fetch_add and std::atomic::wait on the slot's
+ * sequence until their turn comes, then notify its waiters. As with
+ * spsc_queue, the try_ operations never notify.
+ *
+ * Bulk operations claim a run of consecutive tickets with a single atomic
+ * operation on the shared index.
+ *
+ * Capacity is rounded up to a power of two.
+ */
+template <class T>
+class mpmc_queue {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit mpmc_queue(size_type capacity)
+        : mask_(detail::ring_capacity(capacity) - 1), cells_(mask_ + 1) {
+        for (size_type i = 0; i <= mask_; ++i) {
+            std::construct_at(cells_ + i, i);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() {
+        for (size_type i = 0; i <= mask_; ++i) {
+            cell& c = cells_[i];
+            if ((c.seq.load(std::memory_order_relaxed) & mask_) == ((i + 1) & mask_)) {
+                std::destroy_at(c.value());
+            }
+            std::destroy_at(&c);
+        }
+    }
+
+    size_type capacity() const noexcept { return mask_ + 1; }
+
+    /// Approximate when called concurrently with push/pop.
+    size_type size() const noexcept {
+        size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+        size_type head = dequeue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    // ---- Producers ----
+
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells_[pos & mask_];
+            size_type seq = c.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::construct_at(c.value(), std::forward<Args>(args)...);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_push(const T& v) { return try_emplace(v); }
+    bool try_push(T&& v) { return try_emplace(std::move(v)); }
+
+    /// Push as many of [first, first + n) as there are ready slots; returns
+    /// the number pushed.
+    template <class InputIt>
+    size_type try_push_bulk(InputIt first, size_type n) {
+        size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            size_type k = 0;
+            while (k < n && k <= mask_ &&
+                   cells_[(pos + k) & mask_].seq.load(std::memory_order_acquire) == pos + k) {
+                ++k;
+            }
+            if (k == 0) {
+                size_type seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(seq - pos) < 0) {
+                    return 0;
+                }
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+                for (size_type i = 0; i < k; ++i, ++first) {
+                    cell& c = cells_[(pos + i) & mask_];
+                    std::construct_at(c.value(), *first);
+                    c.seq.store(pos + i + 1, std::memory_order_release);
+                }
+                return k;
+            }
+        }
+    }
+
+    /// Blocking push: takes a ticket and waits for its slot to be free.
+    template <class... Args>
+    void emplace(Args&&... args) {
+        size_type pos = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+        put(pos, std::forward<Args>(args)...);
+    }
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    /// Blocking bulk push: claims n consecutive tickets at once.
+    template <class InputIt>
+    void push_bulk(InputIt first, size_type n) {
+        size_type pos = enqueue_pos_.fetch_add(n, std::memory_order_relaxed);
+        for (size_type i = 0; i < n; ++i, ++first) {
+            put(pos + i, *first);
+        }
+    }
+
+    // ---- Consumers ----
+
+    bool try_pop(T& out) {
+        size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells_[pos & mask_];
+            size_type seq = c.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(*c.value());
+                    std::destroy_at(c.value());
+                    c.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<T> try_pop() {
+        std::optional<T> out;
+        size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells_[pos & mask_];
+            size_type seq = c.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out.emplace(std::move(*c.value()));
+                    std::destroy_at(c.value());
+                    c.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return out;
+                }
+            } else if (diff < 0) {
+                return out;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Pop up to @p max ready elements into @p out; returns the number popped.
+    template <class OutputIt>
+    size_type try_pop_bulk(OutputIt out, size_type max) {
+        size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            size_type k = 0;
+            while (k < max && k <= mask_ &&
+                   cells_[(pos + k) & mask_].seq.load(std::memory_order_acquire) == pos + k + 1) {
+                ++k;
+            }
+            if (k == 0) {
+                size_type seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0) {
+                    return 0;
+                }
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+                for (size_type i = 0; i < k; ++i, ++out) {
+                    cell& c = cells_[(pos + i) & mask_];
+                    *out = std::move(*c.value());
+                    std::destroy_at(c.value());
+                    c.seq.store(pos + i + mask_ + 1, std::memory_order_release);
+                }
+                return k;
+            }
+        }
+    }
+
+    /// Blocking pop: takes a ticket and waits for its slot to be filled.
+    T pop() {
+        size_type pos = dequeue_pos_.fetch_add(1, std::memory_order_relaxed);
+        return take(pos);
+    }
+
+    /// Blocking bulk pop: claims @p n consecutive tickets at once and
+    /// returns once all n elements have been written to @p out.
+    template <class OutputIt>
+    void pop_bulk(OutputIt out, size_type n) {
+        size_type pos = dequeue_pos_.fetch_add(n, std::memory_order_relaxed);
+        for (size_type i = 0; i < n; ++i, ++out) {
+            *out = take(pos + i);
+        }
+    }
+
+private:
+    struct alignas(detail::cache_line_size) cell {
+        explicit cell(size_type s) : seq(s) {}
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+
+        std::atomic<size_type> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static void wait_for(cell& c, size_type expected) {
+        size_type seq = c.seq.load(std::memory_order_acquire);
+        while (seq != expected) {
+            c.seq.wait(seq, std::memory_order_acquire);
+            seq = c.seq.load(std::memory_order_acquire);
+        }
+    }
+
+    template <class... Args>
+    void put(size_type pos, Args&&... args) {
+        cell& c = cells_[pos & mask_];
+        wait_for(c, pos);
+        std::construct_at(c.value(), std::forward<Args>(args)...);
+        c.seq.store(pos + 1, std::memory_order_release);
+        c.seq.notify_all();
+    }
+
+    T take(size_type pos) {
+        cell& c = cells_[pos & mask_];
+        wait_for(c, pos + 1);
+        T out(std::move(*c.value()));
+        std::destroy_at(c.value());
+        c.seq.store(pos + mask_ + 1, std::memory_order_release);
+        c.seq.notify_all();
+        return out;
+    }
+
+    const size_type mask_;
+    detail::ring_storage<cell> cells_;
+    alignas(detail::cache_line_size) std::atomic<size_type> enqueue_pos_{0};
+    alignas(detail::cache_line_size) std::atomic<size_type> dequeue_pos_{0};
+};
+}  // namespace std_module
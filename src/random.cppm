@@ -6,6 +6,23 @@
 module;
 
 #include <random>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define STD_MODULE_RANDOM_X86 1
+#else
+#define STD_MODULE_RANDOM_X86 0
+#endif
 
 export module std_module.random;
 
@@ -71,4 +88,1676 @@ using std::piecewise_linear_distribution;
 
 // Utility function
 using std::generate_canonical;
+
+// Concepts (C++20)
+using std::uniform_random_bit_generator;
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+namespace std_module::detail
+{
+/// Seed expander recommended for the xoshiro family
+constexpr std::uint64_t random_splitmix64(std::uint64_t& state) noexcept
+{
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/// State words drawn from a seed sequence, like the std engines' seed(Sseq&)
+template <class Word, std::size_t N, class Sseq>
+std::array<Word, N> random_seed_words(Sseq& q)
+{
+    constexpr std::size_t per_word = sizeof(Word) / 4;
+    std::uint32_t raw[N * per_word];
+    q.generate(raw, raw + N * per_word);
+    std::array<Word, N> out{};
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < per_word; ++j) {
+            out[i] |= static_cast<Word>(static_cast<Word>(raw[i * per_word + j]) << (32 * j));
+        }
+    }
+    return out;
+}
+
+template <class Sseq, class Engine>
+concept random_seed_sequence = !std::is_convertible_v<Sseq&, typename Engine::result_type> &&
+                               !std::is_same_v<std::remove_cv_t<Sseq>, Engine>;
+
+/// Unsigned 128-bit integer, enough of it for 128-bit LCG state
+struct random_u128
+{
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+
+    constexpr random_u128() noexcept = default;
+    constexpr random_u128(std::uint64_t low) noexcept : lo(low) {}
+    constexpr random_u128(std::uint64_t high, std::uint64_t low) noexcept : hi(high), lo(low) {}
+
+    friend constexpr random_u128 operator+(random_u128 a, random_u128 b) noexcept
+    {
+        std::uint64_t lo = a.lo + b.lo;
+        return {a.hi + b.hi + (lo < a.lo ? 1 : 0), lo};
+    }
+
+    friend constexpr random_u128 operator*(random_u128 a, random_u128 b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 p = static_cast<unsigned __int128>(a.lo) * b.lo;
+        return {static_cast<std::uint64_t>(p >> 64) + a.lo * b.hi + a.hi * b.lo, static_cast<std::uint64_t>(p)};
+#else
+        std::uint64_t ll = (a.lo & 0xFFFFFFFFull) * (b.lo & 0xFFFFFFFFull);
+        std::uint64_t lh = (a.lo & 0xFFFFFFFFull) * (b.lo >> 32);
+        std::uint64_t hl = (a.lo >> 32) * (b.lo & 0xFFFFFFFFull);
+        std::uint64_t hh = (a.lo >> 32) * (b.lo >> 32);
+        std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+        return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32) + a.lo * b.hi + a.hi * b.lo,
+                (mid << 32) | (ll & 0xFFFFFFFFull)};
+#endif
+    }
+
+    friend constexpr bool operator==(random_u128, random_u128) noexcept = default;
+};
+
+/// High and low halves of the 128-bit product a * b
+constexpr random_u128 random_mul_wide(std::uint64_t a, std::uint64_t b) noexcept
+{
+    return random_u128(a) * random_u128(b);
+}
+
+/**
+ * Advances an LCG state x -> x * mult + plus by delta steps in O(log
+ * delta) (Brown, "Random number generation with arbitrary strides").
+ */
+template <class U>
+constexpr U random_lcg_advance(U state, U mult, U plus, unsigned long long delta) noexcept
+{
+    U acc_mult(1);
+    U acc_plus(0);
+    while (delta > 0) {
+        if (delta & 1) {
+            acc_mult = acc_mult * mult;
+            acc_plus = acc_plus * mult + plus;
+        }
+        plus = (mult + U(1)) * plus;
+        mult = mult * mult;
+        delta >>= 1;
+    }
+    return acc_mult * state + acc_plus;
+}
+
+/// One xoshiro256** step: returns the output and advances @p s
+constexpr std::uint64_t random_xoshiro256_next(std::uint64_t (&s)[4]) noexcept
+{
+    std::uint64_t result = std::rotl(s[1] * 5, 7) * 9;
+    std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = std::rotl(s[3], 45);
+    return result;
+}
+
+/// xoshiro256 jump polynomials: 2^128 and 2^192 steps
+inline constexpr std::uint64_t random_xoshiro256_jump_poly[4] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                                                 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+inline constexpr std::uint64_t random_xoshiro256_long_jump_poly[4] = {0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+                                                                      0x77710069854EE241ull, 0x39109BB02ACBE635ull};
+
+/// Multiplies the xoshiro256 state @p s by a jump polynomial
+constexpr void random_xoshiro256_jump(std::uint64_t (&s)[4], const std::uint64_t (&poly)[4]) noexcept
+{
+    std::uint64_t t[4] = {};
+    for (std::uint64_t word : poly) {
+        for (int b = 0; b < 64; ++b) {
+            if ((word >> b) & 1) {
+                for (int i = 0; i < 4; ++i) {
+                    t[i] ^= s[i];
+                }
+            }
+            random_xoshiro256_next(s);
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        s[i] = t[i];
+    }
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief xoshiro256** (Blackman and Vigna): 256-bit state, 64-bit output,
+ * period 2^256 - 1.
+ *
+ * Models std::uniform_random_bit_generator, so it drops in wherever
+ * std::mt19937_64 is used with the std distributions, with 32 bytes of
+ * state instead of 2.5 KB and no tempering. jump() advances the sequence
+ * by 2^128 draws and long_jump() by 2^192: for parallel streams, seed one
+ * engine and give each worker a copy jumped once more than the previous
+ * worker's. Not cryptographically secure.
+ */
+class xoshiro256starstar
+{
+public:
+    using result_type = std::uint64_t;
+    static constexpr result_type default_seed = 0x853C49E6748FEA9Bull;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr xoshiro256starstar() noexcept : xoshiro256starstar(default_seed) {}
+    constexpr explicit xoshiro256starstar(result_type value) noexcept { seed(value); }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, xoshiro256starstar>
+    explicit xoshiro256starstar(Sseq& q)
+    {
+        seed(q);
+    }
+
+    /// State expanded from @p value with splitmix64
+    constexpr void seed(result_type value = default_seed) noexcept
+    {
+        for (std::uint64_t& w : s_) {
+            w = detail::random_splitmix64(value);
+        }
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, xoshiro256starstar>
+    void seed(Sseq& q)
+    {
+        auto words = detail::random_seed_words<std::uint64_t, 4>(q);
+        for (int i = 0; i < 4; ++i) {
+            s_[i] = words[i];
+        }
+        if ((s_[0] | s_[1] | s_[2] | s_[3]) == 0) {
+            s_[0] = 1;  // the all-zero state is a fixed point
+        }
+    }
+
+    constexpr result_type operator()() noexcept { return detail::random_xoshiro256_next(s_); }
+
+    constexpr void discard(unsigned long long z) noexcept
+    {
+        for (; z > 0; --z) {
+            (*this)();
+        }
+    }
+
+    /// Advances by 2^128 draws
+    constexpr void jump() noexcept { detail::random_xoshiro256_jump(s_, detail::random_xoshiro256_jump_poly); }
+
+    /// Advances by 2^192 draws
+    constexpr void long_jump() noexcept
+    {
+        detail::random_xoshiro256_jump(s_, detail::random_xoshiro256_long_jump_poly);
+    }
+
+    friend constexpr bool operator==(const xoshiro256starstar&, const xoshiro256starstar&) noexcept = default;
+
+private:
+    std::uint64_t s_[4] = {};
+};
+
+/**
+ * @brief xoshiro128+ (Blackman and Vigna): 128-bit state, 32-bit output,
+ * period 2^128 - 1.
+ *
+ * The fastest generator here on 32-bit work, meant for floating point:
+ * its lowest bits are weak (they fail linearity tests), which the top 24
+ * bits used for a float never see. Prefer xoshiro256starstar or pcg32
+ * for integers. jump() advances by 2^64 draws, long_jump() by 2^96.
+ */
+class xoshiro128plus
+{
+public:
+    using result_type = std::uint32_t;
+    static constexpr std::uint64_t default_seed = 0x853C49E6748FEA9Bull;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr xoshiro128plus() noexcept : xoshiro128plus(default_seed) {}
+    constexpr explicit xoshiro128plus(std::uint64_t value) noexcept { seed(value); }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, xoshiro128plus>
+    explicit xoshiro128plus(Sseq& q)
+    {
+        seed(q);
+    }
+
+    /// State expanded from @p value with splitmix64
+    constexpr void seed(std::uint64_t value = default_seed) noexcept
+    {
+        for (int i = 0; i < 4; i += 2) {
+            std::uint64_t w = detail::random_splitmix64(value);
+            s_[i] = static_cast<std::uint32_t>(w);
+            s_[i + 1] = static_cast<std::uint32_t>(w >> 32);
+        }
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, xoshiro128plus>
+    void seed(Sseq& q)
+    {
+        auto words = detail::random_seed_words<std::uint32_t, 4>(q);
+        for (int i = 0; i < 4; ++i) {
+            s_[i] = words[i];
+        }
+        if ((s_[0] | s_[1] | s_[2] | s_[3]) == 0) {
+            s_[0] = 1;  // the all-zero state is a fixed point
+        }
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        result_type result = s_[0] + s_[3];
+        std::uint32_t t = s_[1] << 9;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = std::rotl(s_[3], 11);
+        return result;
+    }
+
+    constexpr void discard(unsigned long long z) noexcept
+    {
+        for (; z > 0; --z) {
+            (*this)();
+        }
+    }
+
+    /// Advances by 2^64 draws
+    constexpr void jump() noexcept
+    {
+        constexpr std::uint32_t poly[] = {0x8764000Bu, 0xF542D2D3u, 0x6FA035C3u, 0x77F2DB5Bu};
+        apply(poly);
+    }
+
+    /// Advances by 2^96 draws
+    constexpr void long_jump() noexcept
+    {
+        constexpr std::uint32_t poly[] = {0xB523952Eu, 0x0B6F099Fu, 0xCCF5A0EFu, 0x1C580662u};
+        apply(poly);
+    }
+
+    friend constexpr bool operator==(const xoshiro128plus&, const xoshiro128plus&) noexcept = default;
+
+private:
+    constexpr void apply(const std::uint32_t (&poly)[4]) noexcept
+    {
+        std::uint32_t t[4] = {};
+        for (std::uint32_t word : poly) {
+            for (int b = 0; b < 32; ++b) {
+                if ((word >> b) & 1) {
+                    for (int i = 0; i < 4; ++i) {
+                        t[i] ^= s_[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            s_[i] = t[i];
+        }
+    }
+
+    std::uint32_t s_[4] = {};
+};
+
+/**
+ * @brief PCG32 (O'Neill, pcg32 / XSH-RR): 64-bit LCG state with a
+ * permuted 32-bit output, period 2^64 per stream.
+ *
+ * The (seed, stream) pair selects one of 2^63 distinct sequences, and
+ * discard(n) jumps in O(log n), so parallel streams can come either from
+ * distinct stream ids or from one sequence cut into blocks. Outputs match
+ * the reference pcg32_srandom_r / pcg32_random_r.
+ */
+class pcg32
+{
+public:
+    using result_type = std::uint32_t;
+    static constexpr std::uint64_t default_seed = 0xCAFEF00DD15EA5E5ull;
+    static constexpr std::uint64_t default_stream = 0x0A02BDBF7BB3C0A7ull;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr pcg32() noexcept : pcg32(default_seed) {}
+    constexpr explicit pcg32(std::uint64_t value, std::uint64_t stream = default_stream) noexcept
+    {
+        seed(value, stream);
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, pcg32>
+    explicit pcg32(Sseq& q)
+    {
+        seed(q);
+    }
+
+    constexpr void seed(std::uint64_t value = default_seed, std::uint64_t stream = default_stream) noexcept
+    {
+        inc_ = (stream << 1) | 1;
+        state_ = 0;
+        step();
+        state_ += value;
+        step();
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, pcg32>
+    void seed(Sseq& q)
+    {
+        auto words = detail::random_seed_words<std::uint64_t, 2>(q);
+        seed(words[0], words[1]);
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        std::uint64_t old = state_;
+        step();
+        auto xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        return std::rotr(xorshifted, static_cast<int>(old >> 59));
+    }
+
+    /// Skips @p z draws in O(log z)
+    constexpr void discard(unsigned long long z) noexcept
+    {
+        state_ = detail::random_lcg_advance(state_, multiplier, inc_, z);
+    }
+
+    friend constexpr bool operator==(const pcg32&, const pcg32&) noexcept = default;
+
+private:
+    static constexpr std::uint64_t multiplier = 6364136223846793005ull;
+
+    constexpr void step() noexcept { state_ = state_ * multiplier + inc_; }
+
+    std::uint64_t state_ = 0;
+    std::uint64_t inc_ = 1;
+};
+
+/**
+ * @brief PCG64 (O'Neill, pcg64 / XSL-RR 128/64): 128-bit LCG state with
+ * a permuted 64-bit output, period 2^128 per stream.
+ *
+ * Same (seed, stream) and O(log n) discard as pcg32, for 64-bit output.
+ * Outputs match the reference pcg64_srandom_r / pcg64_random_r with
+ * 64-bit seed and stream values.
+ */
+class pcg64
+{
+public:
+    using result_type = std::uint64_t;
+    static constexpr std::uint64_t default_seed = 0xCAFEF00DD15EA5E5ull;
+    static constexpr std::uint64_t default_stream = 0x0A02BDBF7BB3C0A7ull;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr pcg64() noexcept : pcg64(default_seed) {}
+    constexpr explicit pcg64(std::uint64_t value, std::uint64_t stream = default_stream) noexcept
+    {
+        seed(value, stream);
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, pcg64>
+    explicit pcg64(Sseq& q)
+    {
+        seed(q);
+    }
+
+    constexpr void seed(std::uint64_t value = default_seed, std::uint64_t stream = default_stream) noexcept
+    {
+        // stream << 1 | 1 over 128 bits
+        inc_ = detail::random_u128(stream >> 63, (stream << 1) | 1);
+        state_ = 0;
+        step();
+        state_ = state_ + detail::random_u128(value);
+        step();
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, pcg64>
+    void seed(Sseq& q)
+    {
+        auto words = detail::random_seed_words<std::uint64_t, 4>(q);
+        inc_ = detail::random_u128((words[2] << 1) | (words[3] >> 63), (words[3] << 1) | 1);
+        state_ = 0;
+        step();
+        state_ = state_ + detail::random_u128(words[0], words[1]);
+        step();
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        step();
+        return std::rotr(state_.hi ^ state_.lo, static_cast<int>(state_.hi >> 58));
+    }
+
+    /// Skips @p z draws in O(log z)
+    constexpr void discard(unsigned long long z) noexcept
+    {
+        state_ = detail::random_lcg_advance(state_, multiplier(), inc_, z);
+    }
+
+    friend constexpr bool operator==(const pcg64&, const pcg64&) noexcept = default;
+
+private:
+    static constexpr detail::random_u128 multiplier() noexcept
+    {
+        return {2549297995355413924ull, 4865540595714422341ull};
+    }
+
+    constexpr void step() noexcept { state_ = state_ * multiplier() + inc_; }
+
+    detail::random_u128 state_;
+    detail::random_u128 inc_ = 1;
+};
+
+/**
+ * @brief wyrand (Wang Yi): 64-bit state, one 64x64->128 multiply per
+ * draw, period 2^64.
+ *
+ * The smallest and usually the fastest 64-bit generator here; it passes
+ * BigCrush and PractRand, but its period is short enough that a single
+ * stream should stay well under 2^64 draws. The state is a Weyl sequence,
+ * so discard(n) is O(1) and streams are simply distant offsets.
+ */
+class wyrand
+{
+public:
+    using result_type = std::uint64_t;
+    static constexpr result_type default_seed = 0x853C49E6748FEA9Bull;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr wyrand() noexcept : wyrand(default_seed) {}
+    constexpr explicit wyrand(result_type value) noexcept : state_(value) {}
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, wyrand>
+    explicit wyrand(Sseq& q)
+    {
+        seed(q);
+    }
+
+    constexpr void seed(result_type value = default_seed) noexcept { state_ = value; }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, wyrand>
+    void seed(Sseq& q)
+    {
+        state_ = detail::random_seed_words<std::uint64_t, 1>(q)[0];
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        state_ += increment;
+        detail::random_u128 p = detail::random_mul_wide(state_, state_ ^ 0xE7037ED1A0B428DBull);
+        return p.hi ^ p.lo;
+    }
+
+    /// Skips @p z draws in O(1)
+    constexpr void discard(unsigned long long z) noexcept { state_ += z * increment; }
+
+    friend constexpr bool operator==(const wyrand&, const wyrand&) noexcept = default;
+
+private:
+    static constexpr std::uint64_t increment = 0xA0761D6478BD642Full;
+
+    std::uint64_t state_;
+};
+}  // namespace std_module
+
+// ------------------------------------------------------------------------------
+// Batch generation
+// ------------------------------------------------------------------------------
+
+namespace std_module::detail
+{
+/// Lanes of xoshiro256starstar_x8, stored one state word per row
+using random_lanes = std::uint64_t[4][8];
+
+inline void random_lanes_scalar(random_lanes& s, std::uint64_t* out, std::size_t blocks) noexcept
+{
+    for (std::size_t b = 0; b < blocks; ++b, out += 8) {
+        for (std::size_t l = 0; l < 8; ++l) {
+            out[l] = std::rotl(s[1][l] * 5, 7) * 9;
+            std::uint64_t t = s[1][l] << 17;
+            s[2][l] ^= s[0][l];
+            s[3][l] ^= s[1][l];
+            s[1][l] ^= s[2][l];
+            s[0][l] ^= s[3][l];
+            s[2][l] ^= t;
+            s[3][l] = std::rotl(s[3][l], 45);
+        }
+    }
+}
+
+#if STD_MODULE_RANDOM_X86
+// x * 5 and x * 9 are a shift and an add; SSE2 and AVX2 have no 64-bit multiply
+template <int K>
+__attribute__((target("sse2"))) inline __m128i random_rotl_sse2(__m128i x) noexcept
+{
+    return _mm_or_si128(_mm_slli_epi64(x, K), _mm_srli_epi64(x, 64 - K));
+}
+
+__attribute__((target("sse2"))) inline void random_lanes_sse2(random_lanes& s, std::uint64_t* out,
+                                                              std::size_t blocks) noexcept
+{
+    __m128i s0[4], s1[4], s2[4], s3[4];
+    for (int h = 0; h < 4; ++h) {
+        s0[h] = _mm_load_si128(reinterpret_cast<const __m128i*>(s[0] + 2 * h));
+        s1[h] = _mm_load_si128(reinterpret_cast<const __m128i*>(s[1] + 2 * h));
+        s2[h] = _mm_load_si128(reinterpret_cast<const __m128i*>(s[2] + 2 * h));
+        s3[h] = _mm_load_si128(reinterpret_cast<const __m128i*>(s[3] + 2 * h));
+    }
+    for (std::size_t b = 0; b < blocks; ++b, out += 8) {
+        for (int h = 0; h < 4; ++h) {
+            __m128i x = _mm_add_epi64(_mm_slli_epi64(s1[h], 2), s1[h]);
+            x = random_rotl_sse2<7>(x);
+            x = _mm_add_epi64(_mm_slli_epi64(x, 3), x);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * h), x);
+            __m128i t = _mm_slli_epi64(s1[h], 17);
+            s2[h] = _mm_xor_si128(s2[h], s0[h]);
+            s3[h] = _mm_xor_si128(s3[h], s1[h]);
+            s1[h] = _mm_xor_si128(s1[h], s2[h]);
+            s0[h] = _mm_xor_si128(s0[h], s3[h]);
+            s2[h] = _mm_xor_si128(s2[h], t);
+            s3[h] = random_rotl_sse2<45>(s3[h]);
+        }
+    }
+    for (int h = 0; h < 4; ++h) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(s[0] + 2 * h), s0[h]);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s[1] + 2 * h), s1[h]);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s[2] + 2 * h), s2[h]);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s[3] + 2 * h), s3[h]);
+    }
+}
+
+template <int K>
+__attribute__((target("avx2"))) inline __m256i random_rotl_avx2(__m256i x) noexcept
+{
+    return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K));
+}
+
+__attribute__((target("avx2"))) inline void random_lanes_avx2(random_lanes& s, std::uint64_t* out,
+                                                              std::size_t blocks) noexcept
+{
+    __m256i s0[2], s1[2], s2[2], s3[2];
+    for (int h = 0; h < 2; ++h) {
+        s0[h] = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[0] + 4 * h));
+        s1[h] = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[1] + 4 * h));
+        s2[h] = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[2] + 4 * h));
+        s3[h] = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[3] + 4 * h));
+    }
+    for (std::size_t b = 0; b < blocks; ++b, out += 8) {
+        for (int h = 0; h < 2; ++h) {
+            __m256i x = _mm256_add_epi64(_mm256_slli_epi64(s1[h], 2), s1[h]);
+            x = random_rotl_avx2<7>(x);
+            x = _mm256_add_epi64(_mm256_slli_epi64(x, 3), x);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4 * h), x);
+            __m256i t = _mm256_slli_epi64(s1[h], 17);
+            s2[h] = _mm256_xor_si256(s2[h], s0[h]);
+            s3[h] = _mm256_xor_si256(s3[h], s1[h]);
+            s1[h] = _mm256_xor_si256(s1[h], s2[h]);
+            s0[h] = _mm256_xor_si256(s0[h], s3[h]);
+            s2[h] = _mm256_xor_si256(s2[h], t);
+            s3[h] = random_rotl_avx2<45>(s3[h]);
+        }
+    }
+    for (int h = 0; h < 2; ++h) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[0] + 4 * h), s0[h]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[1] + 4 * h), s1[h]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[2] + 4 * h), s2[h]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[3] + 4 * h), s3[h]);
+    }
+}
+#endif
+
+using random_lanes_fn = void (*)(random_lanes&, std::uint64_t*, std::size_t) noexcept;
+
+// Resolved once, on first use, from the CPU the program runs on
+inline random_lanes_fn random_select_lanes() noexcept
+{
+#if STD_MODULE_RANDOM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return random_lanes_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return random_lanes_sse2;
+    }
+#endif
+    return random_lanes_scalar;
+}
+
+/// Writes @p blocks blocks of 8 outputs, one from each lane in turn
+inline void random_lanes_fill(random_lanes& s, std::uint64_t* out, std::size_t blocks) noexcept
+{
+    static const random_lanes_fn impl = random_select_lanes();
+    impl(s, out, blocks);
+}
+
+/// Words per batch: transforms run over whole batches so their loops have a fixed trip count and vectorize
+inline constexpr std::size_t random_batch = 256;
+
+/**
+ * Fills @p out with full-range 64-bit words from any uniform random bit
+ * generator: straight from the engine when it has 64-bit output (in bulk
+ * when it has generate()), from two draws when it has 32-bit output, and
+ * through std::uniform_int_distribution otherwise.
+ */
+template <class G>
+void random_fill_words(G& g, std::uint64_t* out, std::size_t n)
+{
+    constexpr bool zero_based = G::min() == 0;
+    constexpr bool bits64 = zero_based && static_cast<std::uint64_t>(G::max()) == ~0ull;
+    constexpr bool bits32 = zero_based && static_cast<std::uint64_t>(G::max()) == 0xFFFFFFFFull;
+    if constexpr (bits64 && requires { g.generate(std::span<std::uint64_t>(out, n)); }) {
+        g.generate(std::span<std::uint64_t>(out, n));
+    } else if constexpr (bits64) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::uint64_t>(g());
+        }
+    } else if constexpr (bits32) {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t hi = static_cast<std::uint64_t>(g());
+            out[i] = hi << 32 | static_cast<std::uint64_t>(g());
+        }
+    } else {
+        std::uniform_int_distribution<std::uint64_t> word;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = word(g);
+        }
+    }
+}
+
+template <class G>
+std::uint64_t random_word(G& g)
+{
+    std::uint64_t w;
+    random_fill_words(g, &w, 1);
+    return w;
+}
+
+/**
+ * Runs @p batch(bits, dst, n) over @p out in batches of random_batch
+ * words, PerWord values per word. dst always has room for a whole batch:
+ * the tail is produced into scratch space and copied, so transforms can
+ * loop over the full batch and fix up the first n values after.
+ */
+template <std::size_t PerWord, class T, class G, class Batch>
+void random_generate(G& g, std::span<T> out, Batch batch)
+{
+    constexpr std::size_t values = random_batch * PerWord;
+    std::uint64_t bits[random_batch] = {};
+    T tail[values];
+    for (std::size_t i = 0; i < out.size(); i += values) {
+        std::size_t n = out.size() - i < values ? out.size() - i : values;
+        random_fill_words(g, bits, (n + PerWord - 1) / PerWord);
+        T* dst = n == values ? out.data() + i : tail;
+        batch(bits, dst, n);
+        if (dst == tail) {
+            for (std::size_t k = 0; k < n; ++k) {
+                out[i + k] = tail[k];
+            }
+        }
+    }
+}
+
+/// Uniform double in [0, 1) from the top 52 bits: mantissa bits under the exponent of 1.0, minus 1.0
+inline double random_unit(std::uint64_t w) noexcept
+{
+    return std::bit_cast<double>(w >> 12 | 0x3FF0000000000000ull) - 1.0;
+}
+
+/// Uniform float in [0, 1) from the top 23 bits of a 32-bit word
+inline float random_unit(std::uint32_t w) noexcept
+{
+    return std::bit_cast<float>(w >> 9 | 0x3F800000u) - 1.0f;
+}
+
+/**
+ * Ziggurat of 256 layers of equal area v under an unnormalized density f
+ * (Marsaglia and Tsang; layout as in Doornik, "An improved ziggurat
+ * method"). x[1] = r is where the tail starts, x[0] = v / f(r) is the
+ * width of the base layer counting the tail, x[256] = 0; layer i spans
+ * [0, x[i]] between heights f[i] and f[i + 1].
+ */
+struct random_ziggurat
+{
+    double x[257];
+    double f[257];
+};
+
+template <class Density, class Inverse>
+random_ziggurat random_make_ziggurat(double r, double v, Density density, Inverse inverse)
+{
+    random_ziggurat z;
+    z.x[0] = v / density(r);
+    z.x[1] = r;
+    for (int i = 1; i < 255; ++i) {
+        z.x[i + 1] = inverse(v / z.x[i] + density(z.x[i]));
+    }
+    z.x[256] = 0;
+    for (int i = 0; i < 257; ++i) {
+        z.f[i] = density(z.x[i]);
+    }
+    return z;
+}
+
+/// For exp(-x^2 / 2), r from Marsaglia and Tsang's 256-layer table
+inline const random_ziggurat& random_normal_ziggurat()
+{
+    static const random_ziggurat z = [] {
+        constexpr double r = 3.6541528853610088;
+        double tail = std::sqrt(std::acos(-1.0) / 2) * std::erfc(r / std::sqrt(2.0));
+        return random_make_ziggurat(
+            r, r * std::exp(-r * r / 2) + tail, [](double x) { return std::exp(-x * x / 2); },
+            [](double y) { return std::sqrt(-2 * std::log(y)); });
+    }();
+    return z;
+}
+
+/// For exp(-x)
+inline const random_ziggurat& random_exponential_ziggurat()
+{
+    static const random_ziggurat z = [] {
+        constexpr double r = 7.69711747013104972;
+        return random_make_ziggurat(
+            r, (r + 1) * std::exp(-r), [](double x) { return std::exp(-x); }, [](double y) { return -std::log(y); });
+    }();
+    return z;
+}
+
+/**
+ * The slow half of a ziggurat draw, for a word whose fast test (x below
+ * the next layer's edge) failed: the tail or the wedge test with a fresh
+ * uniform. Returns false when the draw is rejected and must start over.
+ */
+template <bool Normal, class G>
+bool random_ziggurat_slow(const random_ziggurat& z, std::uint64_t w, double& x, G& g)
+{
+    std::size_t i = w & 0xFF;
+    x = random_unit(w) * z.x[i];
+    if (i == 0) {
+        double r = z.x[1];
+        if constexpr (Normal) {
+            double a, b;
+            do {
+                a = -std::log(1.0 - random_unit(random_word(g))) / r;
+                b = -std::log(1.0 - random_unit(random_word(g)));
+            } while (b + b < a * a);
+            x = r + a;
+        } else {
+            x = r - std::log(1.0 - random_unit(random_word(g)));
+        }
+        return true;
+    }
+    double y = z.f[i] + random_unit(random_word(g)) * (z.f[i + 1] - z.f[i]);
+    return y < (Normal ? std::exp(-x * x / 2) : std::exp(-x));
+}
+
+/// One ziggurat draw; for Normal, bit 8 of the word is the sign
+template <bool Normal, class G>
+double random_ziggurat_draw(const random_ziggurat& z, G& g)
+{
+    for (;;) {
+        std::uint64_t w = random_word(g);
+        std::size_t i = w & 0xFF;
+        double x = random_unit(w) * z.x[i];
+        if (x < z.x[i + 1] || random_ziggurat_slow<Normal>(z, w, x, g)) {
+            return Normal && (w >> 8 & 1) ? -x : x;
+        }
+    }
+}
+
+/**
+ * A batch of ziggurat draws: a branch-free pass takes the fast path for
+ * every word (about 99% succeed), then the rare failures finish their
+ * draw on the slow path.
+ */
+template <bool Normal, class T, class G>
+void random_ziggurat_batch(const random_ziggurat& z, const std::uint64_t* bits, T* dst, std::size_t n, double scale,
+                           double shift, G& g)
+{
+    bool slow[random_batch];
+    for (std::size_t k = 0; k < random_batch; ++k) {
+        std::uint64_t w = bits[k];
+        std::size_t i = w & 0xFF;
+        double x = random_unit(w) * z.x[i];
+        slow[k] = !(x < z.x[i + 1]);
+        if constexpr (Normal) {
+            // Flip the sign bit rather than branch on it: the branch is a coin toss
+            x = std::bit_cast<double>(std::bit_cast<std::uint64_t>(x) ^ (w & 0x100) << 55);
+        }
+        dst[k] = static_cast<T>(shift + scale * x);
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        if (slow[k]) {
+            double x;
+            if (random_ziggurat_slow<Normal>(z, bits[k], x, g)) {
+                x = Normal && (bits[k] >> 8 & 1) ? -x : x;
+            } else {
+                x = random_ziggurat_draw<Normal>(z, g);
+            }
+            dst[k] = static_cast<T>(shift + scale * x);
+        }
+    }
+}
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Eight xoshiro256** streams run side by side, for filling arrays.
+ *
+ * Each call to generate() advances all eight lanes together with SSE2 or
+ * AVX2 (picked at run time), about four times the throughput of a single
+ * xoshiro256starstar. Output interleaves the lanes: lane 0, 1, ..., 7,
+ * then lane 0 again. Lane k starts k jumps (2^128 draws) after lane 0, so
+ * the lanes never overlap; operator() and generate() can be mixed freely
+ * and produce the same sequence. long_jump() advances every lane by 2^192
+ * draws, for independent copies on other threads.
+ */
+class xoshiro256starstar_x8
+{
+public:
+    using result_type = std::uint64_t;
+    static constexpr std::size_t lanes = 8;
+    static constexpr result_type default_seed = xoshiro256starstar::default_seed;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    xoshiro256starstar_x8() noexcept : xoshiro256starstar_x8(default_seed) {}
+    explicit xoshiro256starstar_x8(result_type value) noexcept { seed(value); }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, xoshiro256starstar_x8>
+    explicit xoshiro256starstar_x8(Sseq& q)
+    {
+        seed(q);
+    }
+
+    /// Lane 0 gets the state xoshiro256starstar(value) would have
+    void seed(result_type value = default_seed) noexcept
+    {
+        std::uint64_t s[4];
+        for (std::uint64_t& w : s) {
+            w = detail::random_splitmix64(value);
+        }
+        set_lanes(s);
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, xoshiro256starstar_x8>
+    void seed(Sseq& q)
+    {
+        auto words = detail::random_seed_words<std::uint64_t, 4>(q);
+        std::uint64_t s[4] = {words[0], words[1], words[2], words[3]};
+        if ((s[0] | s[1] | s[2] | s[3]) == 0) {
+            s[0] = 1;  // the all-zero state is a fixed point
+        }
+        set_lanes(s);
+    }
+
+    result_type operator()() noexcept
+    {
+        if (next_ == lanes) {
+            detail::random_lanes_fill(s_, block_, 1);
+            next_ = 0;
+        }
+        return block_[next_++];
+    }
+
+    /// Fills @p out with the next out.size() outputs
+    void generate(std::span<result_type> out) noexcept
+    {
+        std::size_t i = 0;
+        for (; next_ < lanes && i < out.size(); ++i) {
+            out[i] = block_[next_++];
+        }
+        std::size_t blocks = (out.size() - i) / lanes;
+        detail::random_lanes_fill(s_, out.data() + i, blocks);
+        for (i += blocks * lanes; i < out.size(); ++i) {
+            out[i] = (*this)();
+        }
+    }
+
+    void discard(unsigned long long z) noexcept
+    {
+        for (; z > 0; --z) {
+            (*this)();
+        }
+    }
+
+    /// Advances every lane by 2^192 draws
+    void long_jump() noexcept
+    {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            std::uint64_t s[4] = {s_[0][l], s_[1][l], s_[2][l], s_[3][l]};
+            detail::random_xoshiro256_jump(s, detail::random_xoshiro256_long_jump_poly);
+            for (int w = 0; w < 4; ++w) {
+                s_[w][l] = s[w];
+            }
+        }
+    }
+
+    /// Equal when the two produce the same sequence from here on
+    friend bool operator==(const xoshiro256starstar_x8& x, const xoshiro256starstar_x8& y) noexcept
+    {
+        for (int w = 0; w < 4; ++w) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                if (x.s_[w][l] != y.s_[w][l]) {
+                    return false;
+                }
+            }
+        }
+        if (x.next_ != y.next_) {
+            return false;
+        }
+        for (std::size_t i = x.next_; i < lanes; ++i) {
+            if (x.block_[i] != y.block_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void set_lanes(std::uint64_t (&s)[4]) noexcept
+    {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            for (int w = 0; w < 4; ++w) {
+                s_[w][l] = s[w];
+            }
+            detail::random_xoshiro256_jump(s, detail::random_xoshiro256_jump_poly);
+        }
+        next_ = lanes;
+    }
+
+    alignas(32) detail::random_lanes s_ = {};
+    std::uint64_t block_[lanes] = {};
+    std::size_t next_ = lanes;
+};
+
+/**
+ * @brief Uniform float or double in [a, b), one draw at a time or a span
+ * at a time with generate().
+ *
+ * Each value takes the top 52 (double) or 23 (float) bits of a draw as
+ * the mantissa of a number in [1, 2) and subtracts 1: no integer-to-float
+ * conversion and no branch, so the batch loop vectorizes, and a 64-bit
+ * draw makes two floats. Resolution is 2^-52 (2^-23) of b - a, one bit
+ * less than std::uniform_real_distribution, and results never reach b.
+ */
+template <class T = double>
+    requires std::floating_point<T>
+class fast_uniform_real_distribution
+{
+public:
+    using result_type = T;
+
+    explicit fast_uniform_real_distribution(T a = 0, T b = 1) noexcept
+        : a_(a), b_(b), width_(b - a), below_b_(std::nextafter(b, a))
+    {
+    }
+
+    T a() const noexcept { return a_; }
+    T b() const noexcept { return b_; }
+    T min() const noexcept { return a_; }
+    T max() const noexcept { return b_; }
+    void reset() noexcept {}
+
+    template <class G>
+    T operator()(G& g)
+    {
+        return scale(unit(detail::random_word(g)));
+    }
+
+    /// Fills @p out with independent values
+    template <class G>
+    void generate(G& g, std::span<T> out)
+    {
+        constexpr std::size_t per_word = sizeof(T) == 4 ? 2 : 1;
+        // A copy, so stores to dst cannot alias the parameters and the loop vectorizes
+        const fast_uniform_real_distribution d = *this;
+        detail::random_generate<per_word>(g, out, [d](const std::uint64_t* bits, T* dst, std::size_t) {
+            for (std::size_t k = 0; k < detail::random_batch; ++k) {
+                if constexpr (per_word == 2) {
+                    dst[2 * k] = d.scale(detail::random_unit(static_cast<std::uint32_t>(bits[k] >> 32)));
+                    dst[2 * k + 1] = d.scale(detail::random_unit(static_cast<std::uint32_t>(bits[k])));
+                } else {
+                    dst[k] = d.scale(unit(bits[k]));
+                }
+            }
+        });
+    }
+
+    friend bool operator==(const fast_uniform_real_distribution& x, const fast_uniform_real_distribution& y) noexcept
+    {
+        return x.a_ == y.a_ && x.b_ == y.b_;
+    }
+
+private:
+    static T unit(std::uint64_t w) noexcept
+    {
+        if constexpr (sizeof(T) == 4) {
+            return detail::random_unit(static_cast<std::uint32_t>(w >> 32));
+        } else {
+            return static_cast<T>(detail::random_unit(w));
+        }
+    }
+
+    // a + u * (b - a) can round up to b; clamp to the largest value below it
+    T scale(T u) const noexcept
+    {
+        T x = a_ + u * width_;
+        return x < below_b_ ? x : below_b_;
+    }
+
+    T a_;
+    T b_;
+    T width_;
+    T below_b_;
+};
+
+/**
+ * @brief Unbiased uniform integer in [a, b] by Lemire's multiply-shift
+ * ("Fast random integer generation in an interval"), one draw at a time
+ * or a span at a time with generate().
+ *
+ * A draw x maps to the high half of x * (b - a + 1); the rare products
+ * whose low half falls below 2^k mod (b - a + 1) are redrawn, which makes
+ * every value exactly equally likely. That threshold is computed once,
+ * at construction, so no draw divides. Ranges of up to 2^32 values take
+ * 32 bits per result (two per 64-bit draw in generate()), and generate()
+ * checks for rejections in a separate pass so the multiply loop
+ * vectorizes.
+ */
+template <class T = int>
+    requires std::integral<T>
+class fast_uniform_int_distribution
+{
+public:
+    using result_type = T;
+
+    explicit fast_uniform_int_distribution(T a = 0, T b = std::numeric_limits<T>::max()) noexcept
+        : a_(a),
+          b_(b),
+          // Cast back before widening: for types narrower than int the difference is promoted to int
+          range_(static_cast<std::uint64_t>(
+                     static_cast<unsigned_type>(static_cast<unsigned_type>(b) - static_cast<unsigned_type>(a))) +
+                 1),
+          narrow_(range_ != 0 && range_ <= 0x100000000ull)
+    {
+        if (narrow_) {
+            threshold_ = (0x100000000ull - range_) % range_;
+        } else if (range_ != 0) {
+            threshold_ = (0 - range_) % range_;
+        }
+    }
+
+    T a() const noexcept { return a_; }
+    T b() const noexcept { return b_; }
+    T min() const noexcept { return a_; }
+    T max() const noexcept { return b_; }
+    void reset() noexcept {}
+
+    template <class G>
+    T operator()(G& g)
+    {
+        if (range_ == 0) {  // all 2^64 values
+            return offset(detail::random_word(g));
+        }
+        if (narrow_) {
+            for (;;) {
+                std::uint64_t m = (detail::random_word(g) >> 32) * range_;
+                if ((m & 0xFFFFFFFFull) >= threshold_) {
+                    return offset(m >> 32);
+                }
+            }
+        }
+        for (;;) {
+            detail::random_u128 m = detail::random_mul_wide(detail::random_word(g), range_);
+            if (m.lo >= threshold_) {
+                return offset(m.hi);
+            }
+        }
+    }
+
+    /// Fills @p out with independent values
+    template <class G>
+    void generate(G& g, std::span<T> out)
+    {
+        if (range_ == 0) {
+            detail::random_generate<1>(g, out, [this](const std::uint64_t* bits, T* dst, std::size_t) {
+                for (std::size_t k = 0; k < detail::random_batch; ++k) {
+                    dst[k] = offset(bits[k]);
+                }
+            });
+        } else if (narrow_) {
+            detail::random_generate<2>(g, out, [this, &g](const std::uint64_t* bits, T* dst, std::size_t n) {
+                bool rejected = false;
+                for (std::size_t k = 0; k < detail::random_batch; ++k) {
+                    std::uint64_t hi = (bits[k] >> 32) * range_;
+                    std::uint64_t lo = (bits[k] & 0xFFFFFFFFull) * range_;
+                    rejected |= (hi & 0xFFFFFFFFull) < threshold_;
+                    rejected |= (lo & 0xFFFFFFFFull) < threshold_;
+                    dst[2 * k] = offset(hi >> 32);
+                    dst[2 * k + 1] = offset(lo >> 32);
+                }
+                if (rejected) {
+                    redraw(bits, dst, n, g);
+                }
+            });
+        } else {
+            detail::random_generate<1>(g, out, [this, &g](const std::uint64_t* bits, T* dst, std::size_t n) {
+                bool rejected = false;
+                for (std::size_t k = 0; k < detail::random_batch; ++k) {
+                    detail::random_u128 m = detail::random_mul_wide(bits[k], range_);
+                    rejected |= m.lo < threshold_;
+                    dst[k] = offset(m.hi);
+                }
+                if (rejected) {
+                    redraw(bits, dst, n, g);
+                }
+            });
+        }
+    }
+
+    friend bool operator==(const fast_uniform_int_distribution& x, const fast_uniform_int_distribution& y) noexcept
+    {
+        return x.a_ == y.a_ && x.b_ == y.b_;
+    }
+
+private:
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    T offset(std::uint64_t v) const noexcept
+    {
+        return static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(a_) + v));
+    }
+
+    // The rejection pass of generate(): replaces each rejected result among the first n with a fresh draw
+    template <class G>
+    void redraw(const std::uint64_t* bits, T* dst, std::size_t n, G& g)
+    {
+        for (std::size_t k = 0; k < n; ++k) {
+            if (narrow_) {
+                std::uint64_t half = k % 2 == 0 ? bits[k / 2] >> 32 : bits[k / 2] & 0xFFFFFFFFull;
+                if (((half * range_) & 0xFFFFFFFFull) < threshold_) {
+                    dst[k] = (*this)(g);
+                }
+            } else if (detail::random_mul_wide(bits[k], range_).lo < threshold_) {
+                dst[k] = (*this)(g);
+            }
+        }
+    }
+
+    T a_;
+    T b_;
+    std::uint64_t range_;  // b - a + 1, 0 for the full 64-bit range
+    bool narrow_;          // range_ fits in 32 bits
+    std::uint64_t threshold_ = 0;
+};
+
+/**
+ * @brief Normal distribution by the 256-layer ziggurat, one draw at a time
+ * or a span at a time with generate().
+ *
+ * About 99% of draws take one 64-bit word, a table lookup, a multiply and
+ * a compare (no log, sqrt or trigonometry as in the Box-Muller and polar
+ * methods); generate() runs that fast path branch-free over a whole batch
+ * and finishes the rest afterwards. Values are exact samples, not an
+ * approximation, with 52 bits of resolution per draw.
+ */
+template <class T = double>
+    requires std::floating_point<T>
+class ziggurat_normal_distribution
+{
+public:
+    using result_type = T;
+
+    explicit ziggurat_normal_distribution(T mean = 0, T stddev = 1) noexcept : mean_(mean), stddev_(stddev) {}
+
+    T mean() const noexcept { return mean_; }
+    T stddev() const noexcept { return stddev_; }
+    T min() const noexcept { return std::numeric_limits<T>::lowest(); }
+    T max() const noexcept { return std::numeric_limits<T>::max(); }
+    void reset() noexcept {}
+
+    template <class G>
+    T operator()(G& g)
+    {
+        double z = detail::random_ziggurat_draw<true>(detail::random_normal_ziggurat(), g);
+        return static_cast<T>(mean_ + stddev_ * z);
+    }
+
+    /// Fills @p out with independent values
+    template <class G>
+    void generate(G& g, std::span<T> out)
+    {
+        const detail::random_ziggurat& z = detail::random_normal_ziggurat();
+        detail::random_generate<1>(g, out, [&](const std::uint64_t* bits, T* dst, std::size_t n) {
+            detail::random_ziggurat_batch<true>(z, bits, dst, n, stddev_, mean_, g);
+        });
+    }
+
+    friend bool operator==(const ziggurat_normal_distribution& x, const ziggurat_normal_distribution& y) noexcept
+    {
+        return x.mean_ == y.mean_ && x.stddev_ == y.stddev_;
+    }
+
+private:
+    T mean_;
+    T stddev_;
+};
+
+/**
+ * @brief Exponential distribution by the 256-layer ziggurat, one draw at
+ * a time or a span at a time with generate().
+ *
+ * The same scheme as ziggurat_normal_distribution, on exp(-x): about 99%
+ * of draws need no logarithm, against one per draw for
+ * std::exponential_distribution.
+ */
+template <class T = double>
+    requires std::floating_point<T>
+class ziggurat_exponential_distribution
+{
+public:
+    using result_type = T;
+
+    explicit ziggurat_exponential_distribution(T lambda = 1) noexcept : lambda_(lambda) {}
+
+    T lambda() const noexcept { return lambda_; }
+    T min() const noexcept { return 0; }
+    T max() const noexcept { return std::numeric_limits<T>::max(); }
+    void reset() noexcept {}
+
+    template <class G>
+    T operator()(G& g)
+    {
+        return static_cast<T>(detail::random_ziggurat_draw<false>(detail::random_exponential_ziggurat(), g) /
+                              lambda_);
+    }
+
+    /// Fills @p out with independent values
+    template <class G>
+    void generate(G& g, std::span<T> out)
+    {
+        const detail::random_ziggurat& z = detail::random_exponential_ziggurat();
+        double scale = 1.0 / lambda_;
+        detail::random_generate<1>(g, out, [&](const std::uint64_t* bits, T* dst, std::size_t n) {
+            detail::random_ziggurat_batch<false>(z, bits, dst, n, scale, 0.0, g);
+        });
+    }
+
+    friend bool operator==(const ziggurat_exponential_distribution& x,
+                           const ziggurat_exponential_distribution& y) noexcept
+    {
+        return x.lambda_ == y.lambda_;
+    }
+
+private:
+    T lambda_;
+};
+}  // namespace std_module
+
+// ------------------------------------------------------------------------------
+// Counter-based engines
+// ------------------------------------------------------------------------------
+
+namespace std_module::detail
+{
+/// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"), as in Random123
+struct random_philox4x32
+{
+    using word = std::uint32_t;
+    static constexpr std::size_t key_words = 2;
+
+    // Round R uses the key bumped R times by the Weyl constants
+    template <std::size_t R>
+    static constexpr void round(std::array<word, 4>& x, const std::array<word, 2>& key) noexcept
+    {
+        auto k0 = static_cast<word>(key[0] + R * 0x9E3779B9u);
+        auto k1 = static_cast<word>(key[1] + R * 0xBB67AE85u);
+        std::uint64_t p0 = std::uint64_t{0xD2511F53u} * x[0];
+        std::uint64_t p1 = std::uint64_t{0xCD9E8D57u} * x[2];
+        x = {static_cast<word>(p1 >> 32) ^ x[1] ^ k0, static_cast<word>(p1), static_cast<word>(p0 >> 32) ^ x[3] ^ k1,
+             static_cast<word>(p0)};
+    }
+
+    static constexpr std::array<word, 4> block(const std::array<word, 2>& key, std::array<word, 4> x) noexcept
+    {
+        [&]<std::size_t... R>(std::index_sequence<R...>) { (round<R>(x, key), ...); }(std::make_index_sequence<10>{});
+        return x;
+    }
+};
+
+/// Philox4x64-10, as in Random123
+struct random_philox4x64
+{
+    using word = std::uint64_t;
+    static constexpr std::size_t key_words = 2;
+
+    template <std::size_t R>
+    static constexpr void round(std::array<word, 4>& x, const std::array<word, 2>& key) noexcept
+    {
+        word k0 = key[0] + R * 0x9E3779B97F4A7C15ull;
+        word k1 = key[1] + R * 0xBB67AE8584CAA73Bull;
+        random_u128 p0 = random_mul_wide(0xD2E7470EE14C6C93ull, x[0]);
+        random_u128 p1 = random_mul_wide(0xCA5A826395121157ull, x[2]);
+        x = {p1.hi ^ x[1] ^ k0, p1.lo, p0.hi ^ x[3] ^ k1, p0.lo};
+    }
+
+    static constexpr std::array<word, 4> block(const std::array<word, 2>& key, std::array<word, 4> x) noexcept
+    {
+        [&]<std::size_t... R>(std::index_sequence<R...>) { (round<R>(x, key), ...); }(std::make_index_sequence<10>{});
+        return x;
+    }
+};
+
+/// Threefry4x64-20 (the Threefish-256 block cipher without tweak), as in Random123
+struct random_threefry4x64
+{
+    using word = std::uint64_t;
+    static constexpr std::size_t key_words = 4;
+
+    // Round R: two MIX steps, with every fourth round followed by a key injection
+    template <std::size_t R>
+    static constexpr void round(std::array<word, 4>& x, const word (&ks)[5]) noexcept
+    {
+        constexpr int rotations[8][2] = {{14, 16}, {52, 57}, {23, 40}, {5, 37},
+                                         {25, 33}, {46, 12}, {58, 22}, {32, 32}};
+        constexpr int r0 = rotations[R % 8][0];
+        constexpr int r1 = rotations[R % 8][1];
+        if constexpr (R % 2 == 0) {
+            x[0] += x[1];
+            x[1] = std::rotl(x[1], r0) ^ x[0];
+            x[2] += x[3];
+            x[3] = std::rotl(x[3], r1) ^ x[2];
+        } else {
+            x[0] += x[3];
+            x[3] = std::rotl(x[3], r0) ^ x[0];
+            x[2] += x[1];
+            x[1] = std::rotl(x[1], r1) ^ x[2];
+        }
+        if constexpr (R % 4 == 3) {
+            constexpr std::size_t s = (R + 1) / 4;
+            x[0] += ks[s % 5];
+            x[1] += ks[(s + 1) % 5];
+            x[2] += ks[(s + 2) % 5];
+            x[3] += ks[(s + 3) % 5] + s;
+        }
+    }
+
+    static constexpr std::array<word, 4> block(const std::array<word, 4>& key, std::array<word, 4> x) noexcept
+    {
+        const word ks[5] = {key[0], key[1], key[2], key[3],
+                            0x1BD11BDAA9FC1A22ull ^ key[0] ^ key[1] ^ key[2] ^ key[3]};
+        for (int i = 0; i < 4; ++i) {
+            x[i] += ks[i];
+        }
+        [&]<std::size_t... R>(std::index_sequence<R...>) { (round<R>(x, ks), ...); }(std::make_index_sequence<20>{});
+        return x;
+    }
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Counter-based engine: output block c is a keyed bijection of the
+ * counter c, so any position is reachable in O(1) with no shared state.
+ *
+ * The state is a key (the seed; 2^64 or more distinct streams) and a
+ * 4-word counter. Each counter value yields a block of 4 outputs, and
+ * the sequence is block(key, 0), block(key, 1), ... in little-endian
+ * counter order (word 0 lowest). discard(n) and set_counter() jump in
+ * O(1), and block() is the bare function, for code that wants to compute
+ * the value at a position directly. Use through the philox4x32,
+ * philox4x64 and threefry4x64 aliases. Each passes BigCrush with the
+ * rounds used here. Seeding from a single value gives the same sequence
+ * as the C++26 philox engines.
+ */
+template <class Bijection>
+class counter_engine
+{
+public:
+    using result_type = typename Bijection::word;
+    using key_type = std::array<result_type, Bijection::key_words>;
+    using counter_type = std::array<result_type, 4>;
+    static constexpr std::size_t word_count = 4;
+    static constexpr result_type default_seed = 20111115u;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr counter_engine() noexcept : counter_engine(default_seed) {}
+    constexpr explicit counter_engine(result_type value) noexcept { seed(value); }
+    constexpr counter_engine(const key_type& key, const counter_type& counter) noexcept { seed(key, counter); }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, counter_engine>
+    explicit counter_engine(Sseq& q)
+    {
+        seed(q);
+    }
+
+    /// Key {value, 0, ...}, counter 0
+    constexpr void seed(result_type value = default_seed) noexcept
+    {
+        key_type key{};
+        key[0] = value;
+        seed(key, counter_type{});
+    }
+
+    template <class Sseq>
+        requires detail::random_seed_sequence<Sseq, counter_engine>
+    void seed(Sseq& q)
+    {
+        auto words = detail::random_seed_words<result_type, Bijection::key_words>(q);
+        key_type key{};
+        for (std::size_t i = 0; i < key.size(); ++i) {
+            key[i] = words[i];
+        }
+        seed(key, counter_type{});
+    }
+
+    constexpr void seed(const key_type& key, const counter_type& counter) noexcept
+    {
+        key_ = key;
+        set_counter(counter);
+    }
+
+    /// Moves to the first output of block @p counter
+    constexpr void set_counter(const counter_type& counter) noexcept
+    {
+        counter_ = counter;
+        index_ = 0;
+        block_ = Bijection::block(key_, counter_);
+    }
+
+    constexpr const key_type& key() const noexcept { return key_; }
+
+    /// Counter of the block the next output comes from
+    constexpr const counter_type& counter() const noexcept { return counter_; }
+
+    /// Position of the next output within its block
+    constexpr std::size_t index() const noexcept { return index_; }
+
+    /// The outputs at counter @p counter under key @p key
+    static constexpr counter_type block(const key_type& key, const counter_type& counter) noexcept
+    {
+        return Bijection::block(key, counter);
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        result_type result = block_[index_];
+        if (++index_ == word_count) {
+            advance(1);
+        }
+        return result;
+    }
+
+    /// Fills @p out with the next out.size() outputs, whole blocks straight from the bijection
+    constexpr void generate(std::span<result_type> out) noexcept
+    {
+        std::size_t i = 0;
+        for (; index_ != 0 && i < out.size(); ++i) {
+            out[i] = (*this)();
+        }
+        for (; out.size() - i >= word_count; i += word_count) {
+            for (std::size_t j = 0; j < word_count; ++j) {
+                out[i + j] = block_[j];
+            }
+            advance(1);
+        }
+        for (; i < out.size(); ++i) {
+            out[i] = (*this)();
+        }
+    }
+
+    /// Skips @p z outputs in O(1)
+    constexpr void discard(unsigned long long z) noexcept
+    {
+        unsigned long long blocks = z / word_count;
+        index_ += static_cast<std::size_t>(z % word_count);
+        if (index_ >= word_count) {
+            index_ -= word_count;
+            ++blocks;
+        }
+        if (blocks != 0) {
+            std::size_t index = index_;
+            advance(blocks);
+            index_ = index;
+        }
+    }
+
+    friend constexpr bool operator==(const counter_engine& x, const counter_engine& y) noexcept
+    {
+        return x.key_ == y.key_ && x.counter_ == y.counter_ && x.index_ == y.index_;
+    }
+
+private:
+    // Adds @p blocks to the counter, carrying across words, and loads that block
+    constexpr void advance(unsigned long long blocks) noexcept
+    {
+        constexpr int bits = sizeof(result_type) * 8;
+        unsigned long long carry = blocks;
+        for (std::size_t i = 0; i < word_count && carry != 0; ++i) {
+            auto add = static_cast<result_type>(carry);
+            if constexpr (bits < 64) {
+                carry >>= bits;
+            } else {
+                carry = 0;
+            }
+            counter_[i] += add;
+            carry += counter_[i] < add ? 1 : 0;
+        }
+        index_ = 0;
+        block_ = Bijection::block(key_, counter_);
+    }
+
+    key_type key_{};
+    counter_type counter_{};
+    std::size_t index_ = 0;
+    counter_type block_{};
+};
+
+/// Philox4x32-10: 32-bit output, 64-bit key, 128-bit counter; the C++26 std::philox4x32 sequence
+using philox4x32 = counter_engine<detail::random_philox4x32>;
+
+/// Philox4x64-10: 64-bit output, 128-bit key, 256-bit counter; the C++26 std::philox4x64 sequence
+using philox4x64 = counter_engine<detail::random_philox4x64>;
+
+/// Threefry4x64-20: 64-bit output, 256-bit key, 256-bit counter; needs no multiplier, so it is the fast choice on
+/// hardware with slow 64-bit multiplies
+using threefry4x64 = counter_engine<detail::random_threefry4x64>;
+
+/// Work items [begin, end) of one part of a stream_partition
+struct partition_range
+{
+    std::size_t begin = 0;
+    std::size_t end = 0;
+
+    constexpr std::size_t size() const noexcept { return end - begin; }
+    friend constexpr bool operator==(const partition_range&, const partition_range&) noexcept = default;
+};
+
+/**
+ * @brief Splits one random stream across workers so results do not
+ * depend on how many threads there are.
+ *
+ * Item i of @p items owns outputs [i * draws_per_item, (i + 1) *
+ * draws_per_item) of the base engine's sequence. range(p) gives part p
+ * of @p parts a contiguous run of items (sizes differ by at most one),
+ * and engine(p) the base engine advanced to that run's first output, so
+ * a worker that makes draws_per_item draws per item, in item order,
+ * reproduces the single-threaded sequence exactly. item_engine(i) starts
+ * at any single item instead, for work stealing or when an item draws
+ * fewer than its budget. An item that draws more than draws_per_item
+ * overlaps the next one. Positioning is one discard(): O(1) for the
+ * counter engines and wyrand, O(log n) for pcg32 and pcg64.
+ */
+template <class Engine>
+class stream_partition
+{
+public:
+    constexpr stream_partition(const Engine& base, std::size_t items, std::size_t parts,
+                               unsigned long long draws_per_item) noexcept
+        : base_(base), items_(items), parts_(parts == 0 ? 1 : parts), draws_per_item_(draws_per_item)
+    {
+    }
+
+    constexpr std::size_t items() const noexcept { return items_; }
+    constexpr std::size_t parts() const noexcept { return parts_; }
+    constexpr unsigned long long draws_per_item() const noexcept { return draws_per_item_; }
+
+    constexpr partition_range range(std::size_t part) const noexcept
+    {
+        std::size_t share = items_ / parts_;
+        std::size_t extra = items_ % parts_;
+        std::size_t begin = part * share + (part < extra ? part : extra);
+        return {begin, begin + share + (part < extra ? 1 : 0)};
+    }
+
+    /// The engine for part @p part, at the first output of its first item
+    constexpr Engine engine(std::size_t part) const { return item_engine(range(part).begin); }
+
+    /// The engine at the first output of item @p item
+    constexpr Engine item_engine(std::size_t item) const
+    {
+        Engine e = base_;
+        e.discard(static_cast<unsigned long long>(item) * draws_per_item_);
+        return e;
+    }
+
+private:
+    Engine base_;
+    std::size_t items_;
+    std::size_t parts_;
+    unsigned long long draws_per_item_;
+};
+}  // namespace std_module
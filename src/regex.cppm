@@ -4,7 +4,20 @@
  */
 
 module;
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 export module std_module.regex;
 
 export namespace std {
@@ -69,6 +82,7 @@ export namespace std {
         using std::regex_constants::awk;
         using std::regex_constants::grep;
         using std::regex_constants::egrep;
+        using std::regex_constants::multiline;
 
         // match_flag_type constants
         using std::regex_constants::match_default;
@@ -101,3 +115,2670 @@ export namespace std {
         using std::regex_constants::error_stack;
     }
 }
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+// A linear-time engine for an ECMAScript subset. Patterns compile to a
+// Thompson NFA; matching runs a lazily built DFA over it (one cached state
+// per reachable set of NFA states), so every input byte costs one table
+// lookup once the DFA is warm. Searches find the end of the leftmost match
+// with a forward DFA and its start with a DFA of the reversed pattern;
+// captures, when asked for, are filled in by a Pike VM run over just the
+// matched range. No step ever backtracks.
+//
+// Patterns known at compile time can instead go through match, search and
+// captures, which run the same parser in constant evaluation and turn the
+// result into a backtracking matcher specialized for the one pattern.
+
+namespace std_module::detail
+{
+/// 256-bit membership table for one byte class of the pattern
+struct regex_byte_set
+{
+    std::uint64_t bits[4] = {};
+
+    constexpr bool test(unsigned char c) const noexcept { return (bits[c >> 6] >> (c & 63)) & 1; }
+    constexpr void set(unsigned char c) noexcept { bits[c >> 6] |= std::uint64_t{1} << (c & 63); }
+
+    constexpr void set_range(unsigned lo, unsigned hi) noexcept
+    {
+        for (unsigned c = lo; c <= hi; ++c) {
+            set(static_cast<unsigned char>(c));
+        }
+    }
+
+    constexpr void merge(const regex_byte_set& other) noexcept
+    {
+        for (int i = 0; i < 4; ++i) {
+            bits[i] |= other.bits[i];
+        }
+    }
+
+    constexpr void invert() noexcept
+    {
+        for (std::uint64_t& b : bits) {
+            b = ~b;
+        }
+    }
+
+    /// Adds the other case of every ASCII letter in the set
+    constexpr void fold_case() noexcept
+    {
+        for (unsigned c = 'a'; c <= 'z'; ++c) {
+            if (test(static_cast<unsigned char>(c)) || test(static_cast<unsigned char>(c - 32))) {
+                set(static_cast<unsigned char>(c));
+                set(static_cast<unsigned char>(c - 32));
+            }
+        }
+    }
+
+    /// The only member, or -1 if there are none or several
+    constexpr int single() const noexcept
+    {
+        int found = -1;
+        for (unsigned c = 0; c < 256; ++c) {
+            if (test(static_cast<unsigned char>(c))) {
+                if (found >= 0) {
+                    return -1;
+                }
+                found = static_cast<int>(c);
+            }
+        }
+        return found;
+    }
+};
+
+constexpr bool regex_is_word(unsigned char c) noexcept
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+constexpr bool regex_is_line_terminator(unsigned char c) noexcept
+{
+    return c == '\n' || c == '\r';
+}
+
+enum class regex_assertion : std::uint8_t { line_begin, line_end, word_boundary, not_word_boundary };
+
+/// What an assertion can see at one position
+struct regex_look
+{
+    bool line_begin;
+    bool word_before;
+    bool line_end;
+    bool word_after;
+
+    constexpr bool holds(regex_assertion a) const noexcept
+    {
+        switch (a) {
+        case regex_assertion::line_begin:
+            return line_begin;
+        case regex_assertion::line_end:
+            return line_end;
+        case regex_assertion::word_boundary:
+            return word_before != word_after;
+        case regex_assertion::not_word_boundary:
+            return word_before == word_after;
+        }
+        return false;
+    }
+};
+
+// ------------------------------------------------------------------------------
+// Parsing
+// ------------------------------------------------------------------------------
+
+struct regex_node
+{
+    enum kind_type : std::uint8_t { empty, bytes, concat, alternate, repeat, group, assertion };
+
+    kind_type kind = empty;
+    regex_assertion assert_kind = regex_assertion::line_begin;
+    bool greedy = true;
+    int min = 0;
+    int max = 0;       // repeat; negative is unbounded
+    int capture = -1;  // group; -1 is non-capturing
+    std::uint32_t set = 0;
+    std::vector<std::uint32_t> children;
+};
+
+struct regex_ast
+{
+    std::vector<regex_node> nodes;
+    std::vector<regex_byte_set> sets;
+    std::uint32_t root = 0;
+    unsigned captures = 0;
+    bool has_assertions = false;
+};
+
+inline constexpr int regex_max_repeat = 100000;
+
+/**
+ * Recursive-descent parser for the supported ECMAScript subset: literals,
+ * escapes, '.', bracket expressions (ranges, negation, class escapes and
+ * [:name:] classes), capturing and (?:) groups, alternation, greedy and
+ * lazy quantifiers including {n,m}, and the ^ $ \b \B assertions.
+ * Backreferences and lookahead cannot be matched in linear time and are
+ * rejected. Errors are reported as std::regex_error with the code
+ * std::regex would use.
+ */
+class regex_parser
+{
+public:
+    constexpr regex_parser(std::string_view pattern, std::regex_constants::syntax_option_type flags)
+        : p_(pattern.data()),
+          end_(pattern.data() + pattern.size()),
+          icase_((flags & std::regex_constants::icase) == std::regex_constants::icase),
+          nosubs_((flags & std::regex_constants::nosubs) == std::regex_constants::nosubs)
+    {
+    }
+
+    constexpr regex_ast parse()
+    {
+        ast_.root = disjunction();
+        if (p_ != end_) {
+            fail(std::regex_constants::error_paren);  // unmatched ')'
+        }
+        return std::move(ast_);
+    }
+
+private:
+    // Not constexpr, so a malformed compile-time pattern stops compilation here
+    [[noreturn]] static void fail(std::regex_constants::error_type e) { throw std::regex_error(e); }
+
+    constexpr bool at(char c) const noexcept { return p_ != end_ && *p_ == c; }
+
+    constexpr std::uint32_t add(regex_node n)
+    {
+        ast_.nodes.push_back(std::move(n));
+        return static_cast<std::uint32_t>(ast_.nodes.size() - 1);
+    }
+
+    constexpr std::uint32_t add_bytes(regex_byte_set s)
+    {
+        regex_node n;
+        n.kind = regex_node::bytes;
+        n.set = static_cast<std::uint32_t>(ast_.sets.size());
+        ast_.sets.push_back(s);
+        return add(std::move(n));
+    }
+
+    constexpr std::uint32_t add_list(regex_node::kind_type kind, std::vector<std::uint32_t> children)
+    {
+        if (children.size() == 1) {
+            return children[0];
+        }
+        regex_node n;
+        n.kind = children.empty() ? regex_node::empty : kind;
+        n.children = std::move(children);
+        return add(std::move(n));
+    }
+
+    constexpr std::uint32_t add_assertion(regex_assertion a)
+    {
+        ast_.has_assertions = true;
+        regex_node n;
+        n.kind = regex_node::assertion;
+        n.assert_kind = a;
+        return add(std::move(n));
+    }
+
+    constexpr std::uint32_t literal(unsigned char c)
+    {
+        regex_byte_set s;
+        s.set(c);
+        if (icase_) {
+            s.fold_case();
+        }
+        return add_bytes(s);
+    }
+
+    constexpr std::uint32_t disjunction()
+    {
+        std::vector<std::uint32_t> alternatives{alternative()};
+        while (at('|')) {
+            ++p_;
+            alternatives.push_back(alternative());
+        }
+        return add_list(regex_node::alternate, std::move(alternatives));
+    }
+
+    constexpr std::uint32_t alternative()
+    {
+        std::vector<std::uint32_t> terms;
+        while (p_ != end_ && *p_ != '|' && *p_ != ')') {
+            terms.push_back(term());
+        }
+        return add_list(regex_node::concat, std::move(terms));
+    }
+
+    constexpr std::uint32_t term()
+    {
+        if (at('^') || at('$')) {
+            return add_assertion(*p_++ == '^' ? regex_assertion::line_begin : regex_assertion::line_end);
+        }
+        if (at('\\') && end_ - p_ >= 2 && (p_[1] == 'b' || p_[1] == 'B')) {
+            p_ += 2;
+            return add_assertion(p_[-1] == 'b' ? regex_assertion::word_boundary : regex_assertion::not_word_boundary);
+        }
+        std::uint32_t atom_node = atom();
+        return quantifier(atom_node);
+    }
+
+    constexpr std::uint32_t atom()
+    {
+        unsigned char c = static_cast<unsigned char>(*p_++);
+        switch (c) {
+        case '.': {
+            regex_byte_set s;
+            s.invert();
+            s.bits['\n' >> 6] &= ~(std::uint64_t{1} << '\n');
+            s.bits['\r' >> 6] &= ~(std::uint64_t{1} << '\r');
+            return add_bytes(s);
+        }
+        case '(':
+            return group();
+        case '[':
+            return bracket();
+        case '\\':
+            return escape();
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            fail(std::regex_constants::error_badrepeat);
+        default:
+            return literal(c);
+        }
+    }
+
+    constexpr std::uint32_t group()
+    {
+        regex_node n;
+        n.kind = regex_node::group;
+        if (at('?')) {
+            ++p_;
+            if (at('=') || at('!')) {
+                fail(std::regex_constants::error_complexity);  // lookahead
+            }
+            if (!at(':')) {
+                fail(std::regex_constants::error_paren);
+            }
+            ++p_;
+        } else if (!nosubs_) {
+            n.capture = static_cast<int>(++ast_.captures);
+        }
+        n.children.push_back(disjunction());
+        if (!at(')')) {
+            fail(std::regex_constants::error_paren);
+        }
+        ++p_;
+        return add(std::move(n));
+    }
+
+    constexpr std::uint32_t quantifier(std::uint32_t child)
+    {
+        if (p_ == end_) {
+            return child;
+        }
+        int min = 0;
+        int max = -1;
+        switch (*p_) {
+        case '*':
+            break;
+        case '+':
+            min = 1;
+            break;
+        case '?':
+            max = 1;
+            break;
+        case '{':
+            ++p_;
+            min = max = count();
+            if (at(',')) {
+                ++p_;
+                max = at('}') ? -1 : count();
+            }
+            if (!at('}')) {
+                fail(p_ == end_ ? std::regex_constants::error_brace : std::regex_constants::error_badbrace);
+            }
+            if (max >= 0 && max < min) {
+                fail(std::regex_constants::error_badbrace);
+            }
+            break;
+        default:
+            return child;
+        }
+        ++p_;
+        regex_node n;
+        n.kind = regex_node::repeat;
+        n.min = min;
+        n.max = max;
+        if (at('?')) {
+            ++p_;
+            n.greedy = false;
+        }
+        n.children.push_back(child);
+        if (at('*') || at('+') || at('?') || at('{')) {
+            fail(std::regex_constants::error_badrepeat);
+        }
+        return add(std::move(n));
+    }
+
+    constexpr int count()
+    {
+        if (p_ == end_ || *p_ < '0' || *p_ > '9') {
+            fail(p_ == end_ ? std::regex_constants::error_brace : std::regex_constants::error_badbrace);
+        }
+        int n = 0;
+        while (p_ != end_ && *p_ >= '0' && *p_ <= '9') {
+            n = n * 10 + (*p_++ - '0');
+            if (n > regex_max_repeat) {
+                fail(std::regex_constants::error_badbrace);
+            }
+        }
+        return n;
+    }
+
+    static constexpr regex_byte_set class_set(char name)
+    {
+        regex_byte_set s;
+        switch (name | 0x20) {
+        case 'd':
+            s.set_range('0', '9');
+            break;
+        case 'w':
+            s.set_range('a', 'z');
+            s.set_range('A', 'Z');
+            s.set_range('0', '9');
+            s.set('_');
+            break;
+        default:  // 's'
+            s.set_range('\t', '\r');
+            s.set(' ');
+            break;
+        }
+        if (name >= 'A' && name <= 'Z') {
+            s.invert();
+        }
+        return s;
+    }
+
+    static constexpr bool is_class_escape(char c) noexcept
+    {
+        return c == 'd' || c == 'D' || c == 'w' || c == 'W' || c == 's' || c == 'S';
+    }
+
+    constexpr int hex_digits(int n)
+    {
+        int v = 0;
+        for (int i = 0; i < n; ++i) {
+            if (p_ == end_) {
+                fail(std::regex_constants::error_escape);
+            }
+            char c = *p_++;
+            int d = c >= '0' && c <= '9'   ? c - '0'
+                    : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                    : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                           : -1;
+            if (d < 0) {
+                fail(std::regex_constants::error_escape);
+            }
+            v = v * 16 + d;
+        }
+        return v;
+    }
+
+    // Character value of the escape after '\' (not a class escape)
+    constexpr unsigned char escaped_char(bool in_bracket)
+    {
+        if (p_ == end_) {
+            fail(std::regex_constants::error_escape);
+        }
+        char c = *p_++;
+        switch (c) {
+        case 'f':
+            return '\f';
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        case 'v':
+            return '\v';
+        case 'b':
+            return '\b';  // only reached inside brackets
+        case '0':
+            if (at('0') || (p_ != end_ && *p_ >= '1' && *p_ <= '9')) {
+                fail(std::regex_constants::error_escape);
+            }
+            return '\0';
+        case 'c':
+            if (p_ == end_ || !((*p_ >= 'a' && *p_ <= 'z') || (*p_ >= 'A' && *p_ <= 'Z'))) {
+                fail(std::regex_constants::error_escape);
+            }
+            return static_cast<unsigned char>(*p_++ % 32);
+        case 'x':
+            return static_cast<unsigned char>(hex_digits(2));
+        case 'u': {
+            int v = hex_digits(4);
+            if (v > 0xFF) {
+                fail(std::regex_constants::error_escape);  // matching is byte-wise
+            }
+            return static_cast<unsigned char>(v);
+        }
+        default:
+            if (c >= '1' && c <= '9') {
+                fail(in_bracket ? std::regex_constants::error_escape : std::regex_constants::error_backref);
+            }
+            return static_cast<unsigned char>(c);  // identity escape
+        }
+    }
+
+    constexpr std::uint32_t escape()
+    {
+        if (p_ != end_ && is_class_escape(*p_)) {
+            return add_bytes(class_set(*p_++));
+        }
+        return literal(escaped_char(false));
+    }
+
+    static constexpr bool posix_class(std::string_view name, regex_byte_set& s)
+    {
+        if (name == "alpha" || name == "alnum" || name == "upper" || name == "w") {
+            s.set_range('A', 'Z');
+        }
+        if (name == "alpha" || name == "alnum" || name == "lower" || name == "w") {
+            s.set_range('a', 'z');
+        }
+        if (name == "digit" || name == "alnum" || name == "xdigit" || name == "d" || name == "w") {
+            s.set_range('0', '9');
+        }
+        if (name == "w") {
+            s.set('_');
+        } else if (name == "xdigit") {
+            s.set_range('a', 'f');
+            s.set_range('A', 'F');
+        } else if (name == "space" || name == "s") {
+            s.set_range('\t', '\r');
+            s.set(' ');
+        } else if (name == "blank") {
+            s.set('\t');
+            s.set(' ');
+        } else if (name == "cntrl") {
+            s.set_range(0, 31);
+            s.set(127);
+        } else if (name == "print") {
+            s.set_range(32, 126);
+        } else if (name == "graph") {
+            s.set_range(33, 126);
+        } else if (name == "punct") {
+            s.set_range(33, 47);
+            s.set_range(58, 64);
+            s.set_range(91, 96);
+            s.set_range(123, 126);
+        } else if (name != "alpha" && name != "alnum" && name != "upper" && name != "lower" && name != "digit" &&
+                   name != "d") {
+            return false;
+        }
+        return true;
+    }
+
+    constexpr std::uint32_t bracket()
+    {
+        regex_byte_set s;
+        bool negate = at('^');
+        if (negate) {
+            ++p_;
+        }
+        while (!at(']')) {
+            if (p_ == end_) {
+                fail(std::regex_constants::error_brack);
+            }
+            // One element: a class, or a character that may start a range
+            int lo = -1;
+            if (at('[') && end_ - p_ >= 2 && (p_[1] == ':' || p_[1] == '.' || p_[1] == '=')) {
+                if (p_[1] != ':') {
+                    fail(std::regex_constants::error_collate);
+                }
+                const char* name = p_ + 2;
+                const char* close = name;
+                while (close + 1 < end_ && !(close[0] == ':' && close[1] == ']')) {
+                    ++close;
+                }
+                if (close + 1 >= end_) {
+                    fail(std::regex_constants::error_brack);
+                }
+                if (!posix_class(std::string_view(name, static_cast<std::size_t>(close - name)), s)) {
+                    fail(std::regex_constants::error_ctype);
+                }
+                p_ = close + 2;
+            } else if (at('\\') && end_ - p_ >= 2 && is_class_escape(p_[1])) {
+                s.merge(class_set(p_[1]));
+                p_ += 2;
+            } else {
+                lo = bracket_char();
+            }
+            if (lo < 0) {
+                if (at('-') && end_ - p_ >= 2 && p_[1] != ']') {
+                    fail(std::regex_constants::error_range);  // a class cannot start a range
+                }
+                continue;
+            }
+            int hi = lo;
+            if (at('-') && end_ - p_ >= 2 && p_[1] != ']') {
+                ++p_;
+                if (at('[') || (at('\\') && end_ - p_ >= 2 && is_class_escape(p_[1]))) {
+                    fail(std::regex_constants::error_range);
+                }
+                hi = bracket_char();
+                if (hi < lo) {
+                    fail(std::regex_constants::error_range);
+                }
+            }
+            s.set_range(static_cast<unsigned>(lo), static_cast<unsigned>(hi));
+        }
+        ++p_;
+        if (icase_) {
+            s.fold_case();
+        }
+        if (negate) {
+            s.invert();
+        }
+        return add_bytes(s);
+    }
+
+    constexpr int bracket_char()
+    {
+        char c = *p_++;
+        if (c == '\\') {
+            return escaped_char(true);
+        }
+        return static_cast<unsigned char>(c);
+    }
+
+    const char* p_;
+    const char* end_;
+    bool icase_;
+    bool nosubs_;
+    regex_ast ast_;
+};
+
+// ------------------------------------------------------------------------------
+// Compilation
+// ------------------------------------------------------------------------------
+
+enum class regex_op : std::uint8_t { byte_set, split, jump, save, assertion, match };
+
+/**
+ * One NFA instruction. byte_set consumes a byte in sets[x]; split continues
+ * at x, then (lower priority) at y; jump continues at x; save records the
+ * position in capture slot x. Everything else falls through to pc + 1.
+ */
+struct regex_inst
+{
+    regex_op op;
+    regex_assertion assertion;
+    std::uint32_t x;
+    std::uint32_t y;
+};
+
+inline constexpr std::size_t regex_max_program = 100000;
+
+struct regex_program
+{
+    std::vector<regex_inst> code;
+    std::vector<regex_byte_set> sets;
+    std::uint32_t start = 0;             // anchored at the first position
+    std::uint32_t unanchored_start = 0;  // through a lazy .*? loop
+    bool has_assertions = false;
+    bool multiline = false;
+
+    // Bytes that no instruction or assertion tells apart share a class,
+    // which keeps DFA rows short. Two extra columns follow the classes:
+    // the end of the text, and the end of the text under match_not_eol.
+    std::uint8_t byte_class[256] = {};
+    std::vector<unsigned char> class_byte;  // one representative per class
+    unsigned classes = 0;
+
+    unsigned end_column(bool not_eol) const noexcept { return classes + (not_eol ? 1 : 0); }
+};
+
+/**
+ * Lowers the AST to instructions. The reverse program matches the pattern
+ * read right to left: concatenations are emitted backwards, ^ and $ swap,
+ * and there are no captures. Repeats are expanded, so a{2,4} costs four
+ * copies of a; programs over regex_max_program instructions are rejected.
+ */
+class regex_emitter
+{
+public:
+    regex_emitter(const regex_ast& ast, bool reverse) : ast_(ast), reverse_(reverse) {}
+
+    regex_program emit(bool multiline)
+    {
+        prog_.sets = ast_.sets;
+        prog_.has_assertions = ast_.has_assertions;
+        prog_.multiline = multiline;
+        if (!reverse_) {
+            push(regex_op::save, 0);
+        }
+        node(ast_.root);
+        if (!reverse_) {
+            push(regex_op::save, 1);
+        }
+        push(regex_op::match);
+        if (reverse_) {
+            return std::move(prog_);
+        }
+        regex_byte_set any;
+        any.invert();
+        prog_.sets.push_back(any);
+        std::uint32_t loop = push(regex_op::split, prog_.start, 0);
+        prog_.code[loop].y = push(regex_op::byte_set, static_cast<std::uint32_t>(prog_.sets.size() - 1));
+        push(regex_op::jump, loop);
+        prog_.unanchored_start = loop;
+        return std::move(prog_);
+    }
+
+private:
+    std::uint32_t push(regex_op op, std::uint32_t x = 0, std::uint32_t y = 0)
+    {
+        if (prog_.code.size() >= regex_max_program) {
+            throw std::regex_error(std::regex_constants::error_space);
+        }
+        prog_.code.push_back(regex_inst{op, regex_assertion::line_begin, x, y});
+        return static_cast<std::uint32_t>(prog_.code.size() - 1);
+    }
+
+    std::uint32_t here() const noexcept { return static_cast<std::uint32_t>(prog_.code.size()); }
+
+    // split whose preferred branch is the next instruction when greedy
+    std::uint32_t push_split(bool greedy)
+    {
+        std::uint32_t s = push(regex_op::split);
+        (greedy ? prog_.code[s].x : prog_.code[s].y) = s + 1;
+        return s;
+    }
+
+    void patch_exit(std::uint32_t s, bool greedy)
+    {
+        (greedy ? prog_.code[s].y : prog_.code[s].x) = here();
+    }
+
+    void node(std::uint32_t n)
+    {
+        const regex_node& nd = ast_.nodes[n];
+        switch (nd.kind) {
+        case regex_node::empty:
+            break;
+        case regex_node::bytes:
+            push(regex_op::byte_set, nd.set);
+            break;
+        case regex_node::assertion: {
+            regex_assertion a = nd.assert_kind;
+            if (reverse_ && a == regex_assertion::line_begin) {
+                a = regex_assertion::line_end;
+            } else if (reverse_ && a == regex_assertion::line_end) {
+                a = regex_assertion::line_begin;
+            }
+            prog_.code[push(regex_op::assertion)].assertion = a;
+            break;
+        }
+        case regex_node::group:
+            if (nd.capture >= 0 && !reverse_) {
+                push(regex_op::save, 2 * static_cast<std::uint32_t>(nd.capture));
+                node(nd.children[0]);
+                push(regex_op::save, 2 * static_cast<std::uint32_t>(nd.capture) + 1);
+            } else {
+                node(nd.children[0]);
+            }
+            break;
+        case regex_node::concat:
+            if (reverse_) {
+                for (auto it = nd.children.rbegin(); it != nd.children.rend(); ++it) {
+                    node(*it);
+                }
+            } else {
+                for (std::uint32_t c : nd.children) {
+                    node(c);
+                }
+            }
+            break;
+        case regex_node::alternate: {
+            std::vector<std::uint32_t> exits;
+            for (std::size_t i = 0; i + 1 < nd.children.size(); ++i) {
+                std::uint32_t s = push(regex_op::split, here() + 1);
+                node(nd.children[i]);
+                exits.push_back(push(regex_op::jump));
+                prog_.code[s].y = here();
+            }
+            node(nd.children.back());
+            for (std::uint32_t j : exits) {
+                prog_.code[j].x = here();
+            }
+            break;
+        }
+        case regex_node::repeat:
+            repeat(nd);
+            break;
+        }
+    }
+
+    void repeat(const regex_node& nd)
+    {
+        std::uint32_t child = nd.children[0];
+        if (nd.max < 0) {
+            for (int i = 1; i < nd.min; ++i) {
+                node(child);
+            }
+            if (nd.min > 0) {
+                // x+ : body, then loop back while preferred
+                std::uint32_t body = here();
+                node(child);
+                std::uint32_t s = push(regex_op::split);
+                (nd.greedy ? prog_.code[s].x : prog_.code[s].y) = body;
+                patch_exit(s, nd.greedy);
+            } else {
+                // x* : test, body, jump back to the test
+                std::uint32_t s = push_split(nd.greedy);
+                node(child);
+                push(regex_op::jump, s);
+                patch_exit(s, nd.greedy);
+            }
+            return;
+        }
+        for (int i = 0; i < nd.min; ++i) {
+            node(child);
+        }
+        // Optional copies x(x(x)?)? flattened; every test exits to the end
+        std::vector<std::uint32_t> tests;
+        for (int i = nd.min; i < nd.max; ++i) {
+            tests.push_back(push_split(nd.greedy));
+            node(child);
+        }
+        for (std::uint32_t s : tests) {
+            patch_exit(s, nd.greedy);
+        }
+    }
+
+    const regex_ast& ast_;
+    bool reverse_;
+    regex_program prog_;
+};
+
+// Appends the bytes every match of node n starts with; true if all of n
+// is such a literal, so that the next node of a concatenation continues it
+constexpr bool regex_literal_prefix(const regex_ast& ast, std::uint32_t n, std::string& out)
+{
+    const regex_node& nd = ast.nodes[n];
+    switch (nd.kind) {
+    case regex_node::empty:
+        return true;
+    case regex_node::bytes: {
+        int c = ast.sets[nd.set].single();
+        if (c < 0) {
+            return false;
+        }
+        out.push_back(static_cast<char>(c));
+        return true;
+    }
+    case regex_node::group:
+        return regex_literal_prefix(ast, nd.children[0], out);
+    case regex_node::concat:
+        for (std::uint32_t c : nd.children) {
+            if (!regex_literal_prefix(ast, c, out)) {
+                return false;
+            }
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+// True if every match of node n has to start with a ^ assertion
+constexpr bool regex_starts_with_caret(const regex_ast& ast, std::uint32_t n)
+{
+    const regex_node& nd = ast.nodes[n];
+    switch (nd.kind) {
+    case regex_node::assertion:
+        return nd.assert_kind == regex_assertion::line_begin;
+    case regex_node::group:
+    case regex_node::concat:
+        return regex_starts_with_caret(ast, nd.children[0]);
+    case regex_node::alternate:
+        return std::all_of(nd.children.begin(), nd.children.end(),
+                           [&](std::uint32_t c) { return regex_starts_with_caret(ast, c); });
+    default:
+        return false;
+    }
+}
+
+/// Everything compiled from one pattern; shared by copies of a dfa_regex
+struct regex_code
+{
+    regex_program forward;
+    regex_program reverse;
+    std::string prefix;        // literal that starts every match, if any
+    bool anchored = false;     // ^ without multiline: matches start at the text start only
+    unsigned marks = 0;
+    std::regex_constants::syntax_option_type flags{};
+};
+
+inline void regex_assign_classes(const regex_ast& ast, regex_program& forward, regex_program& reverse)
+{
+    auto differs = [&](unsigned c) {
+        auto a = static_cast<unsigned char>(c - 1);
+        auto b = static_cast<unsigned char>(c);
+        for (const regex_byte_set& s : ast.sets) {
+            if (s.test(a) != s.test(b)) {
+                return true;
+            }
+        }
+        return ast.has_assertions &&
+               (regex_is_word(a) != regex_is_word(b) || regex_is_line_terminator(a) || regex_is_line_terminator(b));
+    };
+    unsigned cls = 0;
+    forward.class_byte.push_back(0);
+    for (unsigned c = 1; c < 256; ++c) {
+        if (differs(c)) {
+            ++cls;
+            forward.class_byte.push_back(static_cast<unsigned char>(c));
+        }
+        forward.byte_class[c] = static_cast<std::uint8_t>(cls);
+    }
+    forward.classes = cls + 1;
+    std::copy(std::begin(forward.byte_class), std::end(forward.byte_class), std::begin(reverse.byte_class));
+    reverse.class_byte = forward.class_byte;
+    reverse.classes = forward.classes;
+}
+
+inline std::shared_ptr<const regex_code> regex_compile(std::string_view pattern,
+                                                       std::regex_constants::syntax_option_type flags)
+{
+    regex_ast ast = regex_parser(pattern, flags).parse();
+    bool multiline = (flags & std::regex_constants::multiline) == std::regex_constants::multiline;
+    auto code = std::make_shared<regex_code>();
+    code->forward = regex_emitter(ast, false).emit(multiline);
+    code->reverse = regex_emitter(ast, true).emit(multiline);
+    regex_assign_classes(ast, code->forward, code->reverse);
+    regex_literal_prefix(ast, ast.root, code->prefix);
+    code->anchored = !multiline && regex_starts_with_caret(ast, ast.root);
+    code->marks = ast.captures;
+    code->flags = flags;
+    return code;
+}
+
+// ------------------------------------------------------------------------------
+// Lazy DFA
+// ------------------------------------------------------------------------------
+
+struct regex_state_hash
+{
+    std::size_t operator()(const std::vector<std::uint32_t>& key) const noexcept
+    {
+        std::uint64_t h = 0x9E3779B97F4A7C15ull;
+        for (std::uint32_t v : key) {
+            h = (h ^ v) * 0xFF51AFD7ED558CCDull;
+            h ^= h >> 32;
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
+/**
+ * DFA built on demand from a program. A state is the ordered list of NFA
+ * instructions that are waiting on the next byte (byte tests, matches and
+ * not yet decided assertions), plus what the previous byte was as far as
+ * assertions care. Assertions are decided when the next byte is known, so
+ * the "a match ends here" bit belongs to the transition, not the state.
+ *
+ * In leftmost-first mode the list keeps ECMAScript priority order and a
+ * match drops every lower-priority thread, which is what makes the end of
+ * the match agree with a backtracking engine. Otherwise the list is a set
+ * and the DFA answers "does any path match" (used for regex_match and the
+ * reverse scan).
+ *
+ * Transitions are stored as (row << 2) | special | matched, where row is
+ * the state index times the row stride. special marks transitions into
+ * the dead state and into the prefilter start state, so the scan loop
+ * tests a single mask. When the table reaches its budget it is flushed
+ * and rebuilt from the current state, so memory stays bounded and each
+ * byte still costs at most one state construction.
+ */
+class regex_dfa
+{
+public:
+    static constexpr std::int32_t unknown = -1;
+    static constexpr std::int32_t matched_bit = 1;
+    static constexpr std::int32_t special_bit = 2;
+
+    // State flags
+    static constexpr std::uint32_t prev_word = 1;
+    static constexpr std::uint32_t prev_line = 2;  // ^ holds here
+    static constexpr std::uint32_t no_empty = 4;   // start state ignoring empty matches
+
+    static constexpr std::size_t table_budget = std::size_t{1} << 20;  // entries
+
+    regex_dfa(const regex_program& prog, bool leftmost_first)
+        : prog_(&prog),
+          leftmost_first_(leftmost_first),
+          stride_(prog.classes + 2),
+          max_states_(std::max<std::size_t>(64, table_budget / (prog.classes + 2))),
+          mark_(prog.code.size(), 0)
+    {
+        reset();
+    }
+
+    unsigned column(char c) const noexcept { return prog_->byte_class[static_cast<unsigned char>(c)]; }
+    const std::uint8_t* byte_classes() const noexcept { return prog_->byte_class; }
+    const std::int32_t* table() const noexcept { return table_.data(); }
+
+    /// Start state at a position whose context gives @p flags
+    std::int32_t start(bool anchored, std::uint32_t flags)
+    {
+        std::int32_t& row = starts_[anchored ? 1 : 0][flags];
+        if (row < 0) {
+            next_generation();
+            pending_.clear();
+            follow(anchored ? prog_->start : prog_->unanchored_start, nullptr, pending_);
+            std::vector<std::uint32_t> list = pending_;
+            std::int32_t r = intern(flags, list);
+            starts_[anchored ? 1 : 0][flags] = r;  // intern may have flushed the table
+            return r;
+        }
+        return row;
+    }
+
+    /**
+     * Marks transitions into the unanchored start state (no assertions, so
+     * a single one) as special: a scan there can skip ahead to the next
+     * occurrence of the pattern's literal prefix.
+     */
+    void enable_prefilter()
+    {
+        prefilter_ = true;
+        reset();
+    }
+
+    std::int32_t prefilter_row() const noexcept { return prefilter_row_; }
+
+    std::int32_t next(std::int32_t row, unsigned column)
+    {
+        std::int32_t t = table_[static_cast<std::size_t>(row) + column];
+        return t != unknown ? t : compute(row, column);
+    }
+
+    std::int32_t compute(std::int32_t row, unsigned column)
+    {
+        // Copied: interning the successor may flush the table
+        std::vector<std::uint32_t> key = states_[static_cast<std::size_t>(row) / stride_];
+        std::uint32_t flags = key[0];
+        bool at_end = column >= prog_->classes;
+        unsigned char byte = at_end ? 0 : prog_->class_byte[column];
+        regex_look look{(flags & prev_line) != 0, (flags & prev_word) != 0,
+                        at_end ? column == prog_->end_column(false)
+                               : prog_->multiline && regex_is_line_terminator(byte),
+                        !at_end && regex_is_word(byte)};
+
+        std::uint64_t flushes = flushes_;
+        next_generation();
+        expanded_.clear();
+        for (std::size_t i = 1; i < key.size(); ++i) {
+            follow(key[i], &look, expanded_);
+        }
+        bool matched = false;
+        seeds_.clear();
+        for (std::uint32_t pc : expanded_) {
+            const regex_inst& in = prog_->code[pc];
+            if (in.op == regex_op::match) {
+                if ((flags & no_empty) != 0) {
+                    continue;
+                }
+                matched = true;
+                if (leftmost_first_) {
+                    break;  // lower-priority threads can no longer win
+                }
+            } else if (!at_end && prog_->sets[in.x].test(byte)) {
+                seeds_.push_back(pc + 1);
+            }
+        }
+
+        std::int32_t next_row = 0;
+        if (!seeds_.empty()) {
+            next_generation();
+            pending_.clear();
+            for (std::uint32_t pc : seeds_) {
+                follow(pc, nullptr, pending_);
+            }
+            std::uint32_t next_flags = 0;
+            if (prog_->has_assertions) {
+                next_flags = (regex_is_word(byte) ? prev_word : 0) |
+                             (prog_->multiline && regex_is_line_terminator(byte) ? prev_line : 0);
+            }
+            next_row = intern(next_flags, pending_);
+        }
+        std::int32_t t = next_row << 2;
+        if (matched) {
+            t |= matched_bit;
+        }
+        if (next_row == 0 || next_row == prefilter_row_) {
+            t |= special_bit;
+        }
+        if (flushes == flushes_) {
+            table_[static_cast<std::size_t>(row) + column] = t;
+        }
+        return t;
+    }
+
+private:
+    void next_generation()
+    {
+        if (++generation_ == 0) {
+            std::fill(mark_.begin(), mark_.end(), 0);
+            generation_ = 1;
+        }
+    }
+
+    // Appends to out, in priority order, the instructions reachable from pc
+    // through jumps, splits and saves. Assertions end the walk unless look
+    // is given, in which case the ones that hold are passed through.
+    void follow(std::uint32_t pc, const regex_look* look, std::vector<std::uint32_t>& out)
+    {
+        stack_.clear();
+        stack_.push_back(pc);
+        while (!stack_.empty()) {
+            std::uint32_t p = stack_.back();
+            stack_.pop_back();
+            for (;;) {
+                if (mark_[p] == generation_) {
+                    break;
+                }
+                mark_[p] = generation_;
+                const regex_inst& in = prog_->code[p];
+                if (in.op == regex_op::jump) {
+                    p = in.x;
+                } else if (in.op == regex_op::split) {
+                    stack_.push_back(in.y);
+                    p = in.x;
+                } else if (in.op == regex_op::save) {
+                    ++p;
+                } else if (in.op == regex_op::assertion && look) {
+                    if (!look->holds(in.assertion)) {
+                        break;
+                    }
+                    ++p;
+                } else {
+                    out.push_back(p);
+                    break;
+                }
+            }
+        }
+    }
+
+    std::int32_t intern(std::uint32_t flags, std::vector<std::uint32_t>& list)
+    {
+        if (list.empty()) {
+            return 0;
+        }
+        if (!leftmost_first_) {
+            std::sort(list.begin(), list.end());
+        }
+        std::vector<std::uint32_t> key;
+        key.reserve(list.size() + 1);
+        key.push_back(flags);
+        key.insert(key.end(), list.begin(), list.end());
+        if (auto it = states_by_key_.find(key); it != states_by_key_.end()) {
+            return it->second;
+        }
+        if (states_.size() >= max_states_) {
+            reset();
+            if (auto it = states_by_key_.find(key); it != states_by_key_.end()) {
+                return it->second;
+            }
+        }
+        auto row = static_cast<std::int32_t>(states_.size() * stride_);
+        states_.push_back(key);
+        table_.resize(table_.size() + stride_, unknown);
+        states_by_key_.emplace(std::move(key), row);
+        return row;
+    }
+
+    void reset()
+    {
+        ++flushes_;
+        states_by_key_.clear();
+        states_.assign(1, std::vector<std::uint32_t>{0});  // dead state
+        table_.assign(stride_, special_bit);
+        for (auto& side : starts_) {
+            for (std::int32_t& r : side) {
+                r = -1;
+            }
+        }
+        prefilter_row_ = -1;
+        if (prefilter_) {
+            prefilter_row_ = start(false, 0);
+        }
+    }
+
+    const regex_program* prog_;
+    bool leftmost_first_;
+    bool prefilter_ = false;
+    std::size_t stride_;
+    std::size_t max_states_;
+    std::vector<std::int32_t> table_;
+    std::vector<std::vector<std::uint32_t>> states_;
+    std::unordered_map<std::vector<std::uint32_t>, std::int32_t, regex_state_hash> states_by_key_;
+    std::int32_t starts_[2][8];
+    std::int32_t prefilter_row_ = -1;
+    std::uint64_t flushes_ = 0;
+
+    std::vector<std::uint32_t> mark_;
+    std::uint32_t generation_ = 0;
+    std::vector<std::uint32_t> stack_;
+    std::vector<std::uint32_t> expanded_;
+    std::vector<std::uint32_t> seeds_;
+    std::vector<std::uint32_t> pending_;
+};
+
+/// Text being matched: assertions may look at [begin, end)
+struct regex_bounds
+{
+    const char* begin;
+    const char* end;
+    bool not_bol;
+    bool not_eol;
+};
+
+inline std::uint32_t regex_forward_flags(const regex_program& prog, const regex_bounds& b, const char* p) noexcept
+{
+    if (!prog.has_assertions) {
+        return 0;
+    }
+    if (p == b.begin) {
+        return b.not_bol ? 0 : regex_dfa::prev_line;
+    }
+    auto c = static_cast<unsigned char>(p[-1]);
+    return (regex_is_word(c) ? regex_dfa::prev_word : 0) |
+           (prog.multiline && regex_is_line_terminator(c) ? regex_dfa::prev_line : 0);
+}
+
+// Same for the reverse program, which reads leftwards from p
+inline std::uint32_t regex_reverse_flags(const regex_program& prog, const regex_bounds& b, const char* p) noexcept
+{
+    if (!prog.has_assertions) {
+        return 0;
+    }
+    if (p == b.end) {
+        return b.not_eol ? 0 : regex_dfa::prev_line;
+    }
+    auto c = static_cast<unsigned char>(*p);
+    return (regex_is_word(c) ? regex_dfa::prev_word : 0) |
+           (prog.multiline && regex_is_line_terminator(c) ? regex_dfa::prev_line : 0);
+}
+
+/**
+ * Runs the DFA from @p row over [p, end). Returns the end of the last match
+ * seen (nullptr if none), or of the first one if @p stop_at_first; stops
+ * early once the DFA dies. With a @p prefix, time spent in the prefilter
+ * start state is skipped with a substring search.
+ */
+inline const char* regex_scan_forward(regex_dfa& dfa, std::int32_t row, const char* p, const char* end,
+                                      unsigned end_column, bool stop_at_first, std::string_view prefix)
+{
+    const char* found = nullptr;
+    const std::int32_t* table = dfa.table();
+    const std::uint8_t* classes = dfa.byte_classes();
+    if (!prefix.empty() && row == dfa.prefilter_row()) {
+        std::size_t at = std::string_view(p, static_cast<std::size_t>(end - p)).find(prefix);
+        if (at == std::string_view::npos) {
+            return nullptr;
+        }
+        p += at;
+    }
+    for (; p != end; ++p) {
+        std::int32_t t = table[row + classes[static_cast<unsigned char>(*p)]];
+        if ((t & (regex_dfa::matched_bit | regex_dfa::special_bit)) != 0) [[unlikely]] {
+            if (t == regex_dfa::unknown) {
+                t = dfa.compute(row, classes[static_cast<unsigned char>(*p)]);
+                table = dfa.table();
+            }
+            if ((t & regex_dfa::matched_bit) != 0) {
+                found = p;
+                if (stop_at_first) {
+                    return found;
+                }
+            }
+            row = t >> 2;
+            if (row == 0) {
+                return found;
+            }
+            if (!prefix.empty() && row == dfa.prefilter_row()) {
+                std::size_t at = std::string_view(p + 1, static_cast<std::size_t>(end - p - 1)).find(prefix);
+                if (at == std::string_view::npos) {
+                    return found;
+                }
+                p += at;
+            }
+            continue;
+        }
+        row = t >> 2;
+    }
+    if ((dfa.next(row, end_column) & regex_dfa::matched_bit) != 0) {
+        found = end;
+    }
+    return found;
+}
+
+/**
+ * Runs the reverse DFA leftwards from @p p down to @p first. Returns the
+ * leftmost position where a match of the reversed pattern ends (the start
+ * of the forward match), or nullptr. @p boundary_column is the column of
+ * the byte before @p first, or an end column.
+ */
+inline const char* regex_scan_reverse(regex_dfa& dfa, std::int32_t row, const char* p, const char* first,
+                                      unsigned boundary_column)
+{
+    const char* found = nullptr;
+    const std::int32_t* table = dfa.table();
+    const std::uint8_t* classes = dfa.byte_classes();
+    for (; p != first; --p) {
+        unsigned col = classes[static_cast<unsigned char>(p[-1])];
+        std::int32_t t = table[row + col];
+        if (t == regex_dfa::unknown) {
+            t = dfa.compute(row, col);
+            table = dfa.table();
+        }
+        if ((t & regex_dfa::matched_bit) != 0) {
+            found = p;
+        }
+        row = t >> 2;
+        if (row == 0) {
+            return found;
+        }
+    }
+    if ((dfa.next(row, boundary_column) & regex_dfa::matched_bit) != 0) {
+        found = first;
+    }
+    return found;
+}
+
+// ------------------------------------------------------------------------------
+// Pike VM (captures)
+// ------------------------------------------------------------------------------
+
+/**
+ * NFA simulation that carries capture positions with each thread, in
+ * priority order, so group contents follow ECMAScript preference (greedy,
+ * lazy, leftmost alternative). O(length * program size); only run over
+ * ranges the DFA has already located.
+ */
+class regex_pike
+{
+public:
+    regex_pike(const regex_program& prog, std::size_t slots) : prog_(&prog), slots_(slots), mark_(prog.code.size(), 0)
+    {
+    }
+
+    /**
+     * Leftmost-first match starting at @p first (or anywhere after it
+     * unless @p anchored). With @p full the match must end at b.end; with
+     * @p not_null it must not be empty. Fills @p out with slots() positions.
+     */
+    bool run(const regex_bounds& b, const char* first, bool anchored, bool full, bool not_null,
+             std::vector<const char*>& out)
+    {
+        thread_list* cur = &lists_[0];
+        thread_list* nxt = &lists_[1];
+        cur->clear();
+        std::uint32_t cur_gen = next_generation();
+        bool matched = false;
+        work_.assign(slots_, nullptr);
+        for (const char* p = first;; ++p) {
+            if (!matched && (!anchored || p == first)) {
+                std::fill(work_.begin(), work_.end(), nullptr);
+                add(*cur, cur_gen, prog_->start, p, look_at(b, p));
+            }
+            if (cur->pcs.empty() && (matched || anchored)) {
+                break;
+            }
+            nxt->clear();
+            std::uint32_t next_gen = next_generation();
+            regex_look next_look{};
+            if (p != b.end) {
+                next_look = look_at(b, p + 1);
+            }
+            for (std::size_t i = 0; i < cur->pcs.size(); ++i) {
+                const regex_inst& in = prog_->code[cur->pcs[i]];
+                const char* const* caps = cur->caps.data() + i * slots_;
+                if (in.op == regex_op::match) {
+                    if ((full && p != b.end) || (not_null && caps[0] == p)) {
+                        continue;
+                    }
+                    matched = true;
+                    out.assign(caps, caps + slots_);
+                    break;
+                }
+                if (p != b.end && prog_->sets[in.x].test(static_cast<unsigned char>(*p))) {
+                    std::copy(caps, caps + slots_, work_.begin());
+                    add(*nxt, next_gen, cur->pcs[i] + 1, p + 1, next_look);
+                }
+            }
+            std::swap(cur, nxt);
+            cur_gen = next_gen;
+            if (p == b.end) {
+                break;
+            }
+        }
+        return matched;
+    }
+
+private:
+    struct thread_list
+    {
+        std::vector<std::uint32_t> pcs;
+        std::vector<const char*> caps;  // slots per thread
+
+        void clear() noexcept
+        {
+            pcs.clear();
+            caps.clear();
+        }
+    };
+
+    struct frame
+    {
+        std::uint32_t pc;
+        std::uint32_t slot;  // restore_slot: explore pc
+        const char* old;
+    };
+    static constexpr std::uint32_t explore = 0xFFFFFFFFu;
+
+    std::uint32_t next_generation()
+    {
+        if (++generation_ == 0) {
+            std::fill(mark_.begin(), mark_.end(), 0);
+            generation_ = 1;
+        }
+        return generation_;
+    }
+
+    regex_look look_at(const regex_bounds& b, const char* p) const noexcept
+    {
+        bool has_prev = p != b.begin;
+        bool has_next = p != b.end;
+        auto prev = has_prev ? static_cast<unsigned char>(p[-1]) : 0;
+        auto next = has_next ? static_cast<unsigned char>(*p) : 0;
+        return regex_look{has_prev ? prog_->multiline && regex_is_line_terminator(prev) : !b.not_bol,
+                          has_prev && regex_is_word(prev),
+                          has_next ? prog_->multiline && regex_is_line_terminator(next) : !b.not_eol,
+                          has_next && regex_is_word(next)};
+    }
+
+    // Follows epsilons from pc at position pos with captures work_, adding
+    // byte tests and matches to the list in priority order.
+    void add(thread_list& list, std::uint32_t generation, std::uint32_t pc, const char* pos, const regex_look& look)
+    {
+        stack_.clear();
+        stack_.push_back(frame{pc, explore, nullptr});
+        while (!stack_.empty()) {
+            frame f = stack_.back();
+            stack_.pop_back();
+            if (f.slot != explore) {
+                work_[f.slot] = f.old;
+                continue;
+            }
+            std::uint32_t p = f.pc;
+            for (;;) {
+                if (mark_[p] == generation) {
+                    break;
+                }
+                mark_[p] = generation;
+                const regex_inst& in = prog_->code[p];
+                if (in.op == regex_op::jump) {
+                    p = in.x;
+                } else if (in.op == regex_op::split) {
+                    stack_.push_back(frame{in.y, explore, nullptr});
+                    p = in.x;
+                } else if (in.op == regex_op::save) {
+                    if (in.x < slots_) {
+                        stack_.push_back(frame{0, in.x, work_[in.x]});
+                        work_[in.x] = pos;
+                    }
+                    ++p;
+                } else if (in.op == regex_op::assertion) {
+                    if (!look.holds(in.assertion)) {
+                        break;
+                    }
+                    ++p;
+                } else {
+                    list.pcs.push_back(p);
+                    list.caps.insert(list.caps.end(), work_.begin(), work_.end());
+                    break;
+                }
+            }
+        }
+    }
+
+    const regex_program* prog_;
+    std::size_t slots_;
+    std::vector<std::uint32_t> mark_;
+    std::uint32_t generation_ = 0;
+    std::vector<const char*> work_;
+    std::vector<frame> stack_;
+    thread_list lists_[2];
+};
+
+/**
+ * Per-regex matching state: the three lazy DFAs and the Pike VM, each
+ * built on first use, behind one mutex.
+ */
+class regex_matcher
+{
+public:
+    explicit regex_matcher(std::shared_ptr<const regex_code> code) : code_(std::move(code)) {}
+
+    std::mutex mutex;
+
+    std::size_t slots() const noexcept { return 2 * (code_->marks + 1); }
+
+    /// Leftmost-first search from @p first; fills @p out (slots()) if given
+    bool search(const regex_bounds& b, const char* first, bool continuous, bool not_null,
+                std::vector<const char*>* out)
+    {
+        const regex_program& fwd = code_->forward;
+        if (not_null && !continuous) {
+            std::vector<const char*> scratch;
+            return pike().run(b, first, false, false, true, out ? *out : scratch);
+        }
+        // Only the first position can start a match of ^... here, and
+        // trying it alone avoids scanning the rest of the text
+        continuous = continuous || code_->anchored;
+        regex_dfa& dfa = leftmost();
+        std::int32_t row = dfa.start(continuous, regex_forward_flags(fwd, b, first) | (not_null ? regex_dfa::no_empty : 0));
+        std::string_view prefix = continuous || fwd.has_assertions ? std::string_view() : code_->prefix;
+        const char* e = regex_scan_forward(dfa, row, first, b.end, fwd.end_column(b.not_eol), out == nullptr, prefix);
+        if (!e) {
+            return false;
+        }
+        if (!out) {
+            return true;
+        }
+        const char* s = first;
+        if (!continuous) {
+            const regex_program& rev = code_->reverse;
+            regex_dfa& back = reverse();
+            unsigned boundary = first != b.begin ? back.column(first[-1]) : rev.end_column(b.not_bol);
+            s = regex_scan_reverse(back, back.start(true, regex_reverse_flags(rev, b, e)), e, first, boundary);
+        }
+        if (code_->marks == 0) {
+            out->assign({s, e});
+            return true;
+        }
+        return pike().run(b, s, true, false, not_null, *out);
+    }
+
+    /// Whole-range match of [first, b.end)
+    bool match(const regex_bounds& b, const char* first, bool not_null, std::vector<const char*>* out)
+    {
+        if (not_null && first == b.end) {
+            return false;
+        }
+        const regex_program& fwd = code_->forward;
+        regex_dfa& dfa = any_path();
+        const char* e = regex_scan_forward(dfa, dfa.start(true, regex_forward_flags(fwd, b, first)), first, b.end,
+                                           fwd.end_column(b.not_eol), false, std::string_view());
+        if (e != b.end) {
+            return false;
+        }
+        if (!out) {
+            return true;
+        }
+        if (code_->marks == 0) {
+            out->assign({first, b.end});
+            return true;
+        }
+        return pike().run(b, first, true, true, false, *out);
+    }
+
+private:
+    regex_dfa& leftmost()
+    {
+        if (!leftmost_) {
+            leftmost_ = std::make_unique<regex_dfa>(code_->forward, true);
+            if (!code_->prefix.empty() && !code_->forward.has_assertions) {
+                leftmost_->enable_prefilter();
+            }
+        }
+        return *leftmost_;
+    }
+
+    regex_dfa& any_path()
+    {
+        if (!any_path_) {
+            any_path_ = std::make_unique<regex_dfa>(code_->forward, false);
+        }
+        return *any_path_;
+    }
+
+    regex_dfa& reverse()
+    {
+        if (!reverse_) {
+            reverse_ = std::make_unique<regex_dfa>(code_->reverse, false);
+        }
+        return *reverse_;
+    }
+
+    regex_pike& pike()
+    {
+        if (!pike_) {
+            pike_ = std::make_unique<regex_pike>(code_->forward, slots());
+        }
+        return *pike_;
+    }
+
+    std::shared_ptr<const regex_code> code_;
+    std::unique_ptr<regex_dfa> leftmost_;
+    std::unique_ptr<regex_dfa> any_path_;
+    std::unique_ptr<regex_dfa> reverse_;
+    std::unique_ptr<regex_pike> pike_;
+};
+
+inline bool regex_has(std::regex_constants::match_flag_type flags, std::regex_constants::match_flag_type f) noexcept
+{
+    return (flags & f) == f;
+}
+
+// ------------------------------------------------------------------------------
+// Compile-time patterns
+// ------------------------------------------------------------------------------
+
+/// Parse tree node as a constant: children are a range of the child table
+struct regex_static_node
+{
+    regex_node::kind_type kind = regex_node::empty;
+    regex_assertion assert_kind = regex_assertion::line_begin;
+    bool greedy = true;
+    int min = 0;
+    int max = 0;
+    int capture = -1;
+    std::uint32_t set = 0;
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
+template <auto Pattern, std::regex_constants::syntax_option_type Flags>
+constexpr regex_ast regex_static_parse()
+{
+    return regex_parser(Pattern.view(), Flags).parse();
+}
+
+// Adds the bytes a match of node n can start with; true if n can match
+// the empty string
+constexpr bool regex_first_bytes(const regex_ast& ast, std::uint32_t n, regex_byte_set& out)
+{
+    const regex_node& nd = ast.nodes[n];
+    switch (nd.kind) {
+    case regex_node::bytes:
+        out.merge(ast.sets[nd.set]);
+        return false;
+    case regex_node::group:
+        return regex_first_bytes(ast, nd.children[0], out);
+    case regex_node::concat:
+        for (std::uint32_t c : nd.children) {
+            if (!regex_first_bytes(ast, c, out)) {
+                return false;
+            }
+        }
+        return true;
+    case regex_node::alternate: {
+        bool nullable = false;
+        for (std::uint32_t c : nd.children) {
+            nullable = regex_first_bytes(ast, c, out) || nullable;
+        }
+        return nullable;
+    }
+    case regex_node::repeat:
+        return regex_first_bytes(ast, nd.children[0], out) || nd.min == 0;
+    default:  // empty, assertion
+        return true;
+    }
+}
+
+/**
+ * The parse of one pattern literal, kept as constants: the pattern is
+ * parsed while the program compiles (an invalid pattern is a compile
+ * error), and nothing of it remains at run time but these tables.
+ */
+template <auto Pattern, std::regex_constants::syntax_option_type Flags>
+struct regex_static_code
+{
+    static constexpr std::size_t node_count = regex_static_parse<Pattern, Flags>().nodes.size();
+    static constexpr std::size_t set_count = regex_static_parse<Pattern, Flags>().sets.size();
+
+    static constexpr std::size_t child_count = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        std::size_t n = 0;
+        for (const regex_node& nd : ast.nodes) {
+            n += nd.children.size();
+        }
+        return n;
+    }();
+
+    static constexpr std::size_t prefix_size = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        std::string prefix;
+        regex_literal_prefix(ast, ast.root, prefix);
+        return prefix.size();
+    }();
+
+    static constexpr std::array<regex_static_node, node_count> nodes = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        std::array<regex_static_node, node_count> out{};
+        std::uint32_t child = 0;
+        for (std::size_t i = 0; i < node_count; ++i) {
+            const regex_node& nd = ast.nodes[i];
+            out[i] = {nd.kind, nd.assert_kind, nd.greedy, nd.min, nd.max, nd.capture, nd.set, child,
+                      static_cast<std::uint32_t>(nd.children.size())};
+            child += static_cast<std::uint32_t>(nd.children.size());
+        }
+        return out;
+    }();
+
+    static constexpr std::array<std::uint32_t, child_count> children = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        std::array<std::uint32_t, child_count> out{};
+        std::size_t n = 0;
+        for (const regex_node& nd : ast.nodes) {
+            for (std::uint32_t c : nd.children) {
+                out[n++] = c;
+            }
+        }
+        return out;
+    }();
+
+    static constexpr std::array<regex_byte_set, set_count> sets = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        std::array<regex_byte_set, set_count> out{};
+        std::copy(ast.sets.begin(), ast.sets.end(), out.begin());
+        return out;
+    }();
+
+    /// Literal that starts every match, if any
+    static constexpr std::array<char, prefix_size> prefix = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        std::string s;
+        regex_literal_prefix(ast, ast.root, s);
+        std::array<char, prefix_size> out{};
+        std::copy(s.begin(), s.end(), out.begin());
+        return out;
+    }();
+
+    /// Bytes a match can start with; meaningless when nullable
+    static constexpr regex_byte_set first = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        regex_byte_set out;
+        regex_first_bytes(ast, ast.root, out);
+        return out;
+    }();
+
+    static constexpr bool nullable = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        regex_byte_set unused;
+        return regex_first_bytes(ast, ast.root, unused);
+    }();
+
+    static constexpr std::uint32_t root = regex_static_parse<Pattern, Flags>().root;
+    static constexpr unsigned marks = regex_static_parse<Pattern, Flags>().captures;
+    static constexpr bool multiline = (Flags & std::regex_constants::multiline) == std::regex_constants::multiline;
+
+    /// ^ without multiline: matches start at the text start only
+    static constexpr bool anchored = [] {
+        regex_ast ast = regex_static_parse<Pattern, Flags>();
+        return !multiline && regex_starts_with_caret(ast, ast.root);
+    }();
+};
+
+/**
+ * Backtracking matcher generated from a regex_static_code: every node of
+ * the pattern becomes its own function template, and what follows a node
+ * is passed to it as a continuation, so the compiler sees (and inlines)
+ * the whole pattern as straight-line code. Alternatives and repeats are
+ * tried in ECMAScript order, leftmost-first like std::regex.
+ *
+ * Repeats of a single byte class scan their run in a loop; other repeats
+ * recurse once per iteration.
+ */
+template <class Code, bool Captures>
+class regex_static_matcher
+{
+public:
+    static constexpr std::size_t slot_count = Captures ? 2 * (Code::marks + 1) : 0;
+
+    constexpr regex_static_matcher(const char* begin, const char* end) noexcept : begin_(begin), end_(end) {}
+
+    constexpr bool match()
+    {
+        if (!eval<Code::root>(begin_, [&](const char* q) { return q == end_; })) {
+            return false;
+        }
+        record(begin_, end_);
+        return true;
+    }
+
+    constexpr bool search()
+    {
+        const char* last = nullptr;
+        auto accept = [&](const char* q) {
+            last = q;
+            return true;
+        };
+        if constexpr (Code::anchored) {
+            if (!eval<Code::root>(begin_, accept)) {
+                return false;
+            }
+            record(begin_, last);
+            return true;
+        } else {
+            for (const char* p = begin_;; ++p) {
+                p = next_start(p);
+                if (p == end_ && !Code::nullable) {
+                    return false;
+                }
+                if (eval<Code::root>(p, accept)) {
+                    record(p, last);
+                    return true;
+                }
+                if (p == end_) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    /// (first, last) per group after a successful call; nullptr for groups that did not take part
+    constexpr const std::array<const char*, slot_count>& slots() const noexcept { return slots_; }
+
+private:
+    static constexpr unsigned char byte(char c) noexcept { return static_cast<unsigned char>(c); }
+
+    template <std::uint32_t S>
+    static constexpr bool test(char c) noexcept
+    {
+        constexpr int single = Code::sets[S].single();
+        if constexpr (single >= 0) {
+            return byte(c) == single;
+        } else {
+            return Code::sets[S].test(byte(c));
+        }
+    }
+
+    // First position from p where a match can start, or end_ if there is
+    // none and the pattern cannot match the empty string
+    constexpr const char* next_start(const char* p) const noexcept
+    {
+        if constexpr (Code::prefix.size() > 1) {
+            std::string_view rest(p, static_cast<std::size_t>(end_ - p));
+            std::size_t at = rest.find(std::string_view(Code::prefix.data(), Code::prefix.size()));
+            return at == std::string_view::npos ? end_ : p + at;
+        } else if constexpr (!Code::nullable) {
+            constexpr int single = Code::first.single();
+            if constexpr (single >= 0) {
+                std::string_view rest(p, static_cast<std::size_t>(end_ - p));
+                std::size_t at = rest.find(static_cast<char>(single));
+                return at == std::string_view::npos ? end_ : p + at;
+            } else {
+                while (p != end_ && !Code::first.test(byte(*p))) {
+                    ++p;
+                }
+            }
+        }
+        return p;
+    }
+
+    constexpr void record(const char* first, const char* last) noexcept
+    {
+        if constexpr (Captures) {
+            slots_[0] = first;
+            slots_[1] = last;
+        }
+    }
+
+    template <regex_assertion A>
+    constexpr bool holds(const char* p) const noexcept
+    {
+        if constexpr (A == regex_assertion::line_begin) {
+            return p == begin_ || (Code::multiline && regex_is_line_terminator(byte(p[-1])));
+        } else if constexpr (A == regex_assertion::line_end) {
+            return p == end_ || (Code::multiline && regex_is_line_terminator(byte(*p)));
+        } else {
+            bool before = p != begin_ && regex_is_word(byte(p[-1]));
+            bool after = p != end_ && regex_is_word(byte(*p));
+            return (before != after) == (A == regex_assertion::word_boundary);
+        }
+    }
+
+    // Matches node N at p, then asks k whether the rest matches from there
+    template <std::uint32_t N, class K>
+    constexpr bool eval(const char* p, const K& k)
+    {
+        constexpr regex_static_node n = Code::nodes[N];
+        if constexpr (n.kind == regex_node::empty) {
+            return k(p);
+        } else if constexpr (n.kind == regex_node::bytes) {
+            return p != end_ && test<n.set>(*p) && k(p + 1);
+        } else if constexpr (n.kind == regex_node::assertion) {
+            return holds<n.assert_kind>(p) && k(p);
+        } else if constexpr (n.kind == regex_node::concat) {
+            return sequence<N, 0>(p, k);
+        } else if constexpr (n.kind == regex_node::alternate) {
+            return alternatives<N, 0>(p, k);
+        } else if constexpr (n.kind == regex_node::group) {
+            return group<N>(p, k);
+        } else {
+            constexpr regex_static_node body = Code::nodes[Code::children[n.first]];
+            if constexpr (body.kind == regex_node::bytes) {
+                return repeat_bytes<N, body.set>(p, k);
+            } else {
+                return repeat<N>(p, 0, k);
+            }
+        }
+    }
+
+    // Number of single-byte literals from child I of concatenation N on
+    template <std::uint32_t N, std::uint32_t I>
+    static constexpr std::uint32_t literal_run() noexcept
+    {
+        std::uint32_t run = 0;
+        while (I + run < Code::nodes[N].count) {
+            const regex_static_node& c = Code::nodes[Code::children[Code::nodes[N].first + I + run]];
+            if (c.kind != regex_node::bytes || Code::sets[c.set].single() < 0) {
+                break;
+            }
+            ++run;
+        }
+        return run;
+    }
+
+    template <std::uint32_t N, std::uint32_t I>
+    static constexpr char literal_at() noexcept
+    {
+        return static_cast<char>(Code::sets[Code::nodes[Code::children[Code::nodes[N].first + I]].set].single());
+    }
+
+    template <std::uint32_t N, std::uint32_t I, class K>
+    constexpr bool sequence(const char* p, const K& k)
+    {
+        constexpr regex_static_node n = Code::nodes[N];
+        constexpr std::uint32_t run = literal_run<N, I>();
+        if constexpr (I == n.count) {
+            return k(p);
+        } else if constexpr (run >= 2) {
+            // Literal text compares as one block
+            if (end_ - p < static_cast<std::ptrdiff_t>(run)) {
+                return false;
+            }
+            bool same = [&]<std::uint32_t... J>(std::integer_sequence<std::uint32_t, J...>) {
+                return ((p[J] == literal_at<N, I + J>()) && ...);
+            }(std::make_integer_sequence<std::uint32_t, run>{});
+            return same && sequence<N, I + run>(p + run, k);
+        } else {
+            return eval<Code::children[n.first + I]>(p, [&](const char* q) { return sequence<N, I + 1>(q, k); });
+        }
+    }
+
+    template <std::uint32_t N, std::uint32_t I, class K>
+    constexpr bool alternatives(const char* p, const K& k)
+    {
+        constexpr regex_static_node n = Code::nodes[N];
+        if constexpr (I + 1 >= n.count) {
+            return eval<Code::children[n.first + I]>(p, k);
+        } else {
+            return eval<Code::children[n.first + I]>(p, k) || alternatives<N, I + 1>(p, k);
+        }
+    }
+
+    template <std::uint32_t N, class K>
+    constexpr bool group(const char* p, const K& k)
+    {
+        constexpr regex_static_node n = Code::nodes[N];
+        if constexpr (!Captures || n.capture < 0) {
+            return eval<Code::children[n.first]>(p, k);
+        } else {
+            constexpr auto slot = 2 * static_cast<std::size_t>(n.capture);
+            return eval<Code::children[n.first]>(p, [&](const char* q) {
+                const char* saved_first = slots_[slot];
+                const char* saved_last = slots_[slot + 1];
+                slots_[slot] = p;
+                slots_[slot + 1] = q;
+                if (k(q)) {
+                    return true;
+                }
+                slots_[slot] = saved_first;
+                slots_[slot + 1] = saved_last;
+                return false;
+            });
+        }
+    }
+
+    // One more iteration of repeat N (count done so far), or what follows it
+    template <std::uint32_t N, class K>
+    constexpr bool repeat(const char* p, int count, const K& k)
+    {
+        constexpr regex_static_node n = Code::nodes[N];
+        auto again = [&] {
+            return (n.max < 0 || count < n.max) && eval<Code::children[n.first]>(p, [&](const char* q) {
+                       // Past the minimum, an iteration has to consume input (ECMAScript)
+                       return (q != p || count < n.min) && repeat<N>(q, count + 1, k);
+                   });
+        };
+        if constexpr (n.greedy) {
+            return again() || (count >= n.min && k(p));
+        } else {
+            return (count >= n.min && k(p)) || again();
+        }
+    }
+
+    // Repeat of one byte class: scan the run, then offer its lengths to k
+    // from the preferred end
+    template <std::uint32_t N, std::uint32_t S, class K>
+    constexpr bool repeat_bytes(const char* p, const K& k)
+    {
+        constexpr regex_static_node n = Code::nodes[N];
+        auto avail = static_cast<std::size_t>(end_ - p);
+        std::size_t most = n.max < 0 || avail < static_cast<std::size_t>(n.max) ? avail : static_cast<std::size_t>(n.max);
+        constexpr auto least = static_cast<std::size_t>(n.min);
+        if constexpr (n.greedy) {
+            std::size_t run = 0;
+            while (run < most && test<S>(p[run])) {
+                ++run;
+            }
+            if (run < least) {
+                return false;
+            }
+            for (std::size_t i = run;; --i) {
+                if (k(p + i)) {
+                    return true;
+                }
+                if (i == least) {
+                    return false;
+                }
+            }
+        } else {
+            std::size_t i = 0;
+            for (; i < least; ++i) {
+                if (i >= most || !test<S>(p[i])) {
+                    return false;
+                }
+            }
+            for (;; ++i) {
+                if (k(p + i)) {
+                    return true;
+                }
+                if (i >= most || !test<S>(p[i])) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    const char* begin_;
+    const char* end_;
+    std::array<const char*, slot_count> slots_{};
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+class dfa_regex;
+class dfa_regex_iterator;
+
+/**
+ * @brief Results of a dfa_regex match, shaped like std::cmatch: element 0
+ * is the whole match, element n the n-th capture group, each a
+ * std::csub_match into the searched text.
+ */
+class dfa_match
+{
+public:
+    using value_type = std::csub_match;
+    using const_reference = const value_type&;
+    using reference = const_reference;
+    using const_iterator = std::vector<value_type>::const_iterator;
+    using iterator = const_iterator;
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+    using string_type = std::string;
+
+    bool ready() const noexcept { return ready_; }
+    bool empty() const noexcept { return subs_.empty(); }
+    size_type size() const noexcept { return subs_.size(); }
+
+    difference_type length(size_type n = 0) const { return (*this)[n].length(); }
+    /// Offset of sub-match @p n from the start of the searched text
+    difference_type position(size_type n = 0) const { return (*this)[n].first - base_; }
+    string_type str(size_type n = 0) const { return (*this)[n].str(); }
+
+    /// Unmatched sub-match for n >= size(), as with std::match_results
+    const_reference operator[](size_type n) const noexcept { return n < subs_.size() ? subs_[n] : unmatched_; }
+    const_reference prefix() const noexcept { return prefix_; }
+    const_reference suffix() const noexcept { return suffix_; }
+
+    const_iterator begin() const noexcept { return subs_.begin(); }
+    const_iterator end() const noexcept { return subs_.end(); }
+    const_iterator cbegin() const noexcept { return subs_.begin(); }
+    const_iterator cend() const noexcept { return subs_.end(); }
+
+private:
+    friend class dfa_regex;
+    friend class dfa_regex_iterator;
+
+    // Slots hold (first, second) per group; nullptr for groups that did not take part
+    void assign(const char* base, const char* first, const char* last, const std::vector<const char*>& slots)
+    {
+        base_ = base;
+        subs_.resize(slots.size() / 2);
+        for (std::size_t i = 0; i < subs_.size(); ++i) {
+            value_type& s = subs_[i];
+            s.matched = slots[2 * i] != nullptr && slots[2 * i + 1] != nullptr;
+            s.first = s.matched ? slots[2 * i] : last;
+            s.second = s.matched ? slots[2 * i + 1] : last;
+        }
+        set_affixes(first, subs_[0].first, subs_[0].second, last);
+        ready_ = true;
+    }
+
+    void set_affixes(const char* first, const char* match_first, const char* match_last, const char* last)
+    {
+        prefix_.first = first;
+        prefix_.second = match_first;
+        prefix_.matched = first != match_first;
+        suffix_.first = match_last;
+        suffix_.second = last;
+        suffix_.matched = match_last != last;
+    }
+
+    void clear() noexcept
+    {
+        subs_.clear();
+        ready_ = true;
+    }
+
+    std::vector<value_type> subs_;
+    value_type prefix_;
+    value_type suffix_;
+    value_type unmatched_;
+    const char* base_ = nullptr;
+    bool ready_ = false;
+};
+
+/**
+ * @brief Regular expression compiled for linear-time matching.
+ *
+ * Accepts the ECMAScript grammar minus backreferences and lookahead (both
+ * rejected with std::regex_error); of the syntax options, icase, nosubs
+ * and multiline apply. Matches and captures agree with std::regex, except
+ * around repeated groups whose body can match the empty string (such as
+ * (a|)+ or (b??)*), where backtracking engines disagree among themselves.
+ * The work is O(text length) for every pattern: no backtracking, no
+ * recursion, no stack growth with the input. Bytes are matched as bytes
+ * (icase folds ASCII only).
+ *
+ * Of the match flags, match_not_bol, match_not_eol, match_prev_avail,
+ * match_continuous and match_not_null are honoured.
+ *
+ * Matching lazily builds a DFA inside the object, so the first searches
+ * over new kinds of input are slower than later ones. Concurrent calls on
+ * one object are safe but serialized on that cache; threads that match
+ * heavily should use their own copy (copies share the compiled program
+ * and start with an empty cache).
+ *
+ * A moved-from dfa_regex stays usable, as libstdc++'s std::regex does: it
+ * matches nothing, mark_count() is 0 and flags() is empty, until a
+ * pattern is assigned to it.
+ */
+class dfa_regex
+{
+public:
+    using value_type = char;
+    using flag_type = std::regex_constants::syntax_option_type;
+
+    /// @throws std::regex_error for invalid or unsupported patterns
+    explicit dfa_regex(std::string_view pattern, flag_type f = std::regex_constants::ECMAScript)
+        : code_(detail::regex_compile(pattern, f)),
+          matcher_(std::make_unique<detail::regex_matcher>(code_))
+    {
+    }
+
+    dfa_regex(const dfa_regex& other)
+        : code_(other.code_),
+          matcher_(code_ ? std::make_unique<detail::regex_matcher>(code_) : nullptr)
+    {
+    }
+
+    dfa_regex& operator=(const dfa_regex& other)
+    {
+        if (this != &other) {
+            code_ = other.code_;
+            matcher_ = code_ ? std::make_unique<detail::regex_matcher>(code_) : nullptr;
+        }
+        return *this;
+    }
+
+    dfa_regex(dfa_regex&&) noexcept = default;
+    dfa_regex& operator=(dfa_regex&&) noexcept = default;
+
+    /// Number of capture groups
+    unsigned mark_count() const noexcept { return code_ ? code_->marks : 0; }
+    flag_type flags() const noexcept { return code_ ? code_->flags : flag_type{}; }
+
+    /// True if the whole of @p s matches
+    bool match(std::string_view s,
+               std::regex_constants::match_flag_type f = std::regex_constants::match_default) const
+    {
+        return match_at(s, f, nullptr);
+    }
+
+    bool match(std::string_view s, dfa_match& m,
+               std::regex_constants::match_flag_type f = std::regex_constants::match_default) const
+    {
+        return match_at(s, f, &m);
+    }
+
+    /// True if some substring of @p s matches; @p m gets the leftmost one
+    bool search(std::string_view s,
+                std::regex_constants::match_flag_type f = std::regex_constants::match_default) const
+    {
+        return search_at(s.data(), begin_of(s, f), s.data(), s.data() + s.size(), f, nullptr);
+    }
+
+    bool search(std::string_view s, dfa_match& m,
+                std::regex_constants::match_flag_type f = std::regex_constants::match_default) const
+    {
+        return search_at(s.data(), begin_of(s, f), s.data(), s.data() + s.size(), f, &m);
+    }
+
+private:
+    friend class dfa_regex_iterator;
+
+    static const char* begin_of(std::string_view s, std::regex_constants::match_flag_type f) noexcept
+    {
+        // match_prev_avail: the byte before s is part of the text
+        return detail::regex_has(f, std::regex_constants::match_prev_avail) ? s.data() - 1 : s.data();
+    }
+
+    static detail::regex_bounds bounds(const char* begin, const char* last, std::regex_constants::match_flag_type f)
+    {
+        return detail::regex_bounds{begin, last, detail::regex_has(f, std::regex_constants::match_not_bol),
+                                    detail::regex_has(f, std::regex_constants::match_not_eol)};
+    }
+
+    // A moved-from regex matches nothing
+    static bool moved_from(dfa_match* m) noexcept
+    {
+        if (m) {
+            m->clear();
+        }
+        return false;
+    }
+
+    bool match_at(std::string_view s, std::regex_constants::match_flag_type f, dfa_match* m) const
+    {
+        const char* first = s.data();
+        const char* last = first + s.size();
+        detail::regex_bounds b = bounds(begin_of(s, f), last, f);
+        bool not_null = detail::regex_has(f, std::regex_constants::match_not_null);
+        if (!matcher_) {
+            return moved_from(m);
+        }
+        std::lock_guard lock(matcher_->mutex);
+        if (!m) {
+            return matcher_->match(b, first, not_null, nullptr);
+        }
+        slots_.assign(matcher_->slots(), nullptr);
+        if (!matcher_->match(b, first, not_null, &slots_)) {
+            m->clear();
+            return false;
+        }
+        m->assign(first, first, last, slots_);
+        return true;
+    }
+
+    // Search [first, last), where [begin, first) is earlier text and
+    // positions count from base
+    bool search_at(const char* base, const char* begin, const char* first, const char* last,
+                   std::regex_constants::match_flag_type f, dfa_match* m) const
+    {
+        detail::regex_bounds b = bounds(begin, last, f);
+        bool continuous = detail::regex_has(f, std::regex_constants::match_continuous);
+        bool not_null = detail::regex_has(f, std::regex_constants::match_not_null);
+        if (!matcher_) {
+            return moved_from(m);
+        }
+        std::lock_guard lock(matcher_->mutex);
+        if (!m) {
+            return matcher_->search(b, first, continuous, not_null, nullptr);
+        }
+        slots_.assign(matcher_->slots(), nullptr);
+        if (!matcher_->search(b, first, continuous, not_null, &slots_)) {
+            m->clear();
+            return false;
+        }
+        m->assign(base, first, last, slots_);
+        return true;
+    }
+
+    std::shared_ptr<const detail::regex_code> code_;
+    std::unique_ptr<detail::regex_matcher> matcher_;
+    mutable std::vector<const char*> slots_;  // guarded by matcher_->mutex
+};
+
+/// True if the whole of @p s matches @p re
+inline bool regex_match(std::string_view s, const dfa_regex& re,
+                        std::regex_constants::match_flag_type f = std::regex_constants::match_default)
+{
+    return re.match(s, f);
+}
+
+inline bool regex_match(std::string_view s, dfa_match& m, const dfa_regex& re,
+                        std::regex_constants::match_flag_type f = std::regex_constants::match_default)
+{
+    return re.match(s, m, f);
+}
+
+/// True if some substring of @p s matches @p re; @p m gets the leftmost match
+inline bool regex_search(std::string_view s, const dfa_regex& re,
+                         std::regex_constants::match_flag_type f = std::regex_constants::match_default)
+{
+    return re.search(s, f);
+}
+
+inline bool regex_search(std::string_view s, dfa_match& m, const dfa_regex& re,
+                         std::regex_constants::match_flag_type f = std::regex_constants::match_default)
+{
+    return re.search(s, m, f);
+}
+
+/**
+ * @brief Iterates over the successive non-overlapping matches of a
+ * dfa_regex in a text, with std::regex_iterator's rules for empty matches.
+ * Default-constructed, it is the end iterator.
+ */
+class dfa_regex_iterator
+{
+public:
+    using value_type = dfa_match;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const dfa_match*;
+    using reference = const dfa_match&;
+    using iterator_category = std::forward_iterator_tag;
+
+    dfa_regex_iterator() = default;
+
+    dfa_regex_iterator(std::string_view text, const dfa_regex& re,
+                       std::regex_constants::match_flag_type f = std::regex_constants::match_default)
+        : begin_(text.data()), end_(text.data() + text.size()), re_(&re), flags_(f)
+    {
+        if (!re_->search_at(begin_, context(), begin_, end_, flags_, &match_)) {
+            re_ = nullptr;
+        }
+    }
+
+    dfa_regex_iterator(std::string_view, const dfa_regex&&,
+                       std::regex_constants::match_flag_type = std::regex_constants::match_default) = delete;
+
+    bool operator==(const dfa_regex_iterator& other) const noexcept
+    {
+        if (!re_ || !other.re_) {
+            return re_ == other.re_;
+        }
+        return begin_ == other.begin_ && end_ == other.end_ && re_ == other.re_ && flags_ == other.flags_ &&
+               match_[0].first == other.match_[0].first && match_[0].second == other.match_[0].second;
+    }
+
+    reference operator*() const noexcept { return match_; }
+    pointer operator->() const noexcept { return &match_; }
+
+    dfa_regex_iterator& operator++()
+    {
+        const char* previous = match_[0].second;
+        const char* start = previous;
+        if (match_[0].first == match_[0].second) {
+            if (start == end_) {
+                re_ = nullptr;
+                return *this;
+            }
+            // A non-empty match at the same place comes first
+            if (re_->search_at(begin_, context(), start, end_,
+                               flags_ | std::regex_constants::match_not_null | std::regex_constants::match_continuous,
+                               &match_)) {
+                return *this;
+            }
+            ++start;
+        }
+        if (!re_->search_at(begin_, context(), start, end_, flags_, &match_)) {
+            re_ = nullptr;
+            return *this;
+        }
+        match_.set_affixes(previous, match_[0].first, match_[0].second, end_);
+        return *this;
+    }
+
+    dfa_regex_iterator operator++(int)
+    {
+        dfa_regex_iterator old = *this;
+        ++*this;
+        return old;
+    }
+
+private:
+    const char* context() const noexcept
+    {
+        return dfa_regex::begin_of(std::string_view(begin_, static_cast<std::size_t>(end_ - begin_)), flags_);
+    }
+
+    const char* begin_ = nullptr;
+    const char* end_ = nullptr;
+    const dfa_regex* re_ = nullptr;
+    std::regex_constants::match_flag_type flags_ = std::regex_constants::match_default;
+    dfa_match match_;
+};
+
+/**
+ * @brief Pattern literal usable as a template argument, e.g. in
+ * std_module::search<"[a-z]+">(s).
+ */
+template <std::size_t N>
+struct regex_string
+{
+    char data[N] = {};
+
+    constexpr regex_string(const char (&s)[N]) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            data[i] = s[i];
+        }
+    }
+
+    constexpr std::string_view view() const noexcept { return {data, N - 1}; }
+};
+
+/**
+ * @brief Result of std_module::captures: element 0 is the whole match,
+ * element n the n-th capture group, as views into the searched text.
+ * Converts to false when nothing matched.
+ */
+template <std::size_t N>
+class static_match
+{
+public:
+    constexpr static_match() noexcept = default;
+
+    /// From (first, last) pairs into text; nullptr for groups that did not take part
+    constexpr static_match(const char* base, const std::array<const char*, 2 * N>& slots) noexcept
+        : base_(base), slots_(slots)
+    {
+    }
+
+    constexpr explicit operator bool() const noexcept { return slots_[0] != nullptr; }
+    constexpr std::size_t size() const noexcept { return N; }
+
+    /// False for groups that did not take part in the match, and for n >= size()
+    constexpr bool matched(std::size_t n = 0) const noexcept { return n < N && slots_[2 * n] != nullptr; }
+
+    /// Empty view for groups that did not take part in the match
+    constexpr std::string_view operator[](std::size_t n) const noexcept
+    {
+        if (!matched(n)) {
+            return {};
+        }
+        return {slots_[2 * n], static_cast<std::size_t>(slots_[2 * n + 1] - slots_[2 * n])};
+    }
+
+    constexpr std::string_view str(std::size_t n = 0) const noexcept { return (*this)[n]; }
+    constexpr std::size_t length(std::size_t n = 0) const noexcept { return (*this)[n].size(); }
+
+    /// Offset of sub-match @p n from the start of the searched text
+    constexpr std::size_t position(std::size_t n = 0) const noexcept
+    {
+        return static_cast<std::size_t>(slots_[2 * n] - base_);
+    }
+
+    template <std::size_t I>
+    constexpr std::string_view get() const noexcept
+    {
+        static_assert(I < N, "no such capture group");
+        return (*this)[I];
+    }
+
+private:
+    const char* base_ = nullptr;
+    std::array<const char*, 2 * N> slots_{};
+};
+
+/**
+ * @brief True if the literal pattern matches all of @p s.
+ *
+ * The pattern is parsed at compile time (a malformed one fails to
+ * compile) and turned into matching code specialized for it, so there is
+ * nothing to construct at startup. Same grammar and syntax options as
+ * dfa_regex; unlike it, matching backtracks in the ECMAScript order, so
+ * nested quantifiers can take exponential time on hostile input, and a
+ * repeated group uses stack per iteration. Usable in constant expressions:
+ *
+ *     static_assert(std_module::match<"[a-z]+-\\d+">("build-42"));
+ */
+template <regex_string Pattern, std::regex_constants::syntax_option_type Flags = std::regex_constants::ECMAScript>
+constexpr bool match(std::string_view s) noexcept
+{
+    detail::regex_static_matcher<detail::regex_static_code<Pattern, Flags>, false> m(s.data(), s.data() + s.size());
+    return m.match();
+}
+
+/// True if the literal pattern matches somewhere in @p s (see match)
+template <regex_string Pattern, std::regex_constants::syntax_option_type Flags = std::regex_constants::ECMAScript>
+constexpr bool search(std::string_view s) noexcept
+{
+    detail::regex_static_matcher<detail::regex_static_code<Pattern, Flags>, false> m(s.data(), s.data() + s.size());
+    return m.search();
+}
+
+/**
+ * @brief Leftmost match of the literal pattern in @p s with its capture
+ * groups (see match); anchor the pattern with ^...$ to match all of s.
+ *
+ *     if (auto m = std_module::captures<"(\\w+)=(\\d+)">(line)) {
+ *         set(m[1], m[2]);
+ *     }
+ */
+template <regex_string Pattern, std::regex_constants::syntax_option_type Flags = std::regex_constants::ECMAScript>
+constexpr auto captures(std::string_view s) noexcept
+{
+    using code = detail::regex_static_code<Pattern, Flags>;
+    // Empty views may have no data; matches still need a non-null position
+    const char* first = s.data() != nullptr ? s.data() : "";
+    detail::regex_static_matcher<code, true> m(first, first + s.size());
+    if (!m.search()) {
+        return static_match<code::marks + 1>();
+    }
+    return static_match<code::marks + 1>(first, m.slots());
+}
+
+/// Counters of a basic_regex_cache; a snapshot under concurrent use
+struct regex_cache_stats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t size = 0;
+};
+
+/**
+ * @brief Bounded, thread-safe LRU cache of compiled regular expressions,
+ * keyed by pattern and syntax options.
+ *
+ * get() returns a shared immutable regex, compiling it on a miss; once the
+ * cache is full, each insert drops the least recently used entry (callers
+ * still holding it keep it alive). The table is split into shards by hash,
+ * each with its own lock and LRU list, so threads contend only within a
+ * shard and recency is tracked per shard. Compilation runs outside the
+ * lock, so a slow pattern does not stall lookups of others; two threads
+ * missing on the same pattern at once may both compile it, and the first
+ * to finish is kept.
+ *
+ * Regex is std::regex by default; dfa_regex works as well (a shared
+ * dfa_regex serializes matching, see there).
+ */
+template <class Regex = std::regex>
+class basic_regex_cache
+{
+public:
+    using regex_type = Regex;
+    using flag_type = std::regex_constants::syntax_option_type;
+
+    /// Holds at most @p capacity regexes (at least one per shard)
+    explicit basic_regex_cache(std::size_t capacity)
+    {
+        while (shard_count_ < max_shards && shard_count_ * 2 <= capacity / 4) {
+            shard_count_ *= 2;
+        }
+        shards_ = std::make_unique<shard[]>(shard_count_);
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            // Spread the remainder so the shard capacities add up to capacity
+            shards_[i].capacity = std::max<std::size_t>(1, capacity / shard_count_ + (i < capacity % shard_count_ ? 1 : 0));
+        }
+    }
+
+    basic_regex_cache(const basic_regex_cache&) = delete;
+    basic_regex_cache& operator=(const basic_regex_cache&) = delete;
+
+    /**
+     * @brief The compiled form of @p pattern with @p flags, from the cache
+     * or compiled now.
+     * @throws std::regex_error for invalid patterns (nothing is cached)
+     */
+    std::shared_ptr<const Regex> get(std::string_view pattern, flag_type flags = std::regex_constants::ECMAScript)
+    {
+        key k{pattern, flags};
+        std::size_t h = key_hash{}(k);
+        shard& sh = shards_[h & (shard_count_ - 1)];
+        {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            if (auto found = sh.find(k)) {
+                ++sh.hits;
+                return found;
+            }
+            ++sh.misses;
+        }
+        auto compiled = std::make_shared<const Regex>(std::string(pattern), flags);
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        if (auto found = sh.find(k)) {
+            return found;  // compiled concurrently by another thread
+        }
+        sh.lru.push_front({std::string(pattern), flags, std::move(compiled)});
+        const entry& e = sh.lru.front();
+        sh.index.emplace(key{e.pattern, e.flags}, sh.lru.begin());
+        if (sh.lru.size() > sh.capacity) {
+            const entry& last = sh.lru.back();
+            sh.index.erase(key{last.pattern, last.flags});
+            sh.lru.pop_back();
+            ++sh.evictions;
+        }
+        return e.regex;
+    }
+
+    regex_cache_stats stats() const
+    {
+        regex_cache_stats s;
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            const shard& sh = shards_[i];
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            s.hits += sh.hits;
+            s.misses += sh.misses;
+            s.evictions += sh.evictions;
+            s.size += sh.lru.size();
+        }
+        return s;
+    }
+
+    std::size_t size() const { return stats().size; }
+
+    std::size_t capacity() const noexcept
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            total += shards_[i].capacity;
+        }
+        return total;
+    }
+
+    /// Drops every entry; the counters keep counting
+    void clear()
+    {
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            shard& sh = shards_[i];
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            sh.index.clear();
+            sh.lru.clear();
+        }
+    }
+
+private:
+    static constexpr std::size_t max_shards = 16;
+
+    struct key
+    {
+        std::string_view pattern;
+        flag_type flags;
+
+        bool operator==(const key&) const = default;
+    };
+
+    struct key_hash
+    {
+        std::size_t operator()(const key& k) const noexcept
+        {
+            std::size_t h = std::hash<std::string_view>{}(k.pattern);
+            return h ^ (static_cast<std::size_t>(k.flags) + 0x9E3779B9u + (h << 6) + (h >> 2));
+        }
+    };
+
+    struct entry
+    {
+        std::string pattern;
+        flag_type flags;
+        std::shared_ptr<const Regex> regex;
+    };
+
+    // Index keys view the pattern strings of the list entries
+    struct alignas(64) shard
+    {
+        mutable std::mutex mutex;
+        std::list<entry> lru;  // most recently used first
+        std::unordered_map<key, typename std::list<entry>::iterator, key_hash> index;
+        std::size_t capacity = 1;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+
+        std::shared_ptr<const Regex> find(const key& k)
+        {
+            auto it = index.find(k);
+            if (it == index.end()) {
+                return nullptr;
+            }
+            lru.splice(lru.begin(), lru, it->second);
+            return it->second->regex;
+        }
+    };
+
+    std::size_t shard_count_ = 1;
+    std::unique_ptr<shard[]> shards_;
+};
+
+using regex_cache = basic_regex_cache<std::regex>;
+}  // namespace std_module
@@ -6,6 +6,15 @@
 module;
 
 #include <stack>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 export module std_module.stack;
 
@@ -26,3 +35,356 @@ using std::operator<=>;  // C++20 three-way comparison
 // Swap specialization
 using std::swap;
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+namespace std_module::detail
+{
+template <class T, std::size_t N>
+struct small_stack_buffer {
+    T* data() noexcept { return std::launder(reinterpret_cast<T*>(bytes)); }
+    const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(bytes)); }
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+};
+
+template <class T>
+struct small_stack_buffer<T, 0> {
+    T* data() noexcept { return nullptr; }
+    const T* data() const noexcept { return nullptr; }
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief LIFO stack over contiguous storage with optional inline capacity.
+ *
+ * Same interface as std::stack. The first @p N elements live inside the
+ * object itself, so shallow stacks (parser states, DFS frontiers on small
+ * graphs) never touch the heap; deeper stacks spill to a heap buffer that
+ * grows geometrically and is kept until destruction. With N = 0 this is a
+ * vector-backed stack without std::stack's deque default.
+ */
+template <class T, std::size_t N = 0>
+class small_stack {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_type inline_capacity = N;
+
+    small_stack() noexcept { reset(); }
+
+    small_stack(const small_stack& other) : small_stack() {
+        reserve(other.size());
+        end_ = std::uninitialized_copy(other.begin_, other.end_, begin_);
+    }
+
+    small_stack(small_stack&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : small_stack() {
+        take(other);
+    }
+
+    small_stack& operator=(const small_stack& other) {
+        if (this != &other) {
+            small_stack tmp(other);
+            clear();
+            take(tmp);
+        }
+        return *this;
+    }
+
+    small_stack& operator=(small_stack&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~small_stack() {
+        clear();
+        release();
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return end_ == begin_; }
+    size_type size() const noexcept { return static_cast<size_type>(end_ - begin_); }
+    size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+
+    reference top() noexcept { return end_[-1]; }
+    const_reference top() const noexcept { return end_[-1]; }
+
+    void push(const value_type& v) { emplace(v); }
+    void push(value_type&& v) { emplace(std::move(v)); }
+
+    template <class... Args>
+    reference emplace(Args&&... args) {
+        if (end_ == cap_) {
+            return grow_and_emplace(std::forward<Args>(args)...);
+        }
+        T* p = std::construct_at(end_, std::forward<Args>(args)...);
+        ++end_;
+        return *p;
+    }
+
+    void pop() noexcept { std::destroy_at(--end_); }
+
+    void reserve(size_type n) {
+        if (n > capacity()) {
+            T* fresh = std::allocator<T>().allocate(n);
+            try {
+                relocate_to(fresh, n);
+            } catch (...) {
+                std::allocator<T>().deallocate(fresh, n);
+                throw;
+            }
+        }
+    }
+
+    void clear() noexcept {
+        std::destroy(begin_, end_);
+        end_ = begin_;
+    }
+
+    void swap(small_stack& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        small_stack tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    bool is_inline() const noexcept { return begin_ == buffer_.data(); }
+
+    void reset() noexcept {
+        begin_ = end_ = buffer_.data();
+        cap_ = begin_ + N;
+    }
+
+    // Emplace first, then move the old elements, so that arguments
+    // referring into the stack stay valid. Kept out of line so emplace()
+    // inlines to a compare, a store and an increment.
+    template <class... Args>
+    [[gnu::noinline]] reference grow_and_emplace(Args&&... args) {
+        size_type old_size = size();
+        size_type new_cap = old_size ? old_size * 2 : 8;
+        T* fresh = std::allocator<T>().allocate(new_cap);
+        T* p;
+        try {
+            p = std::construct_at(fresh + old_size, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<T>().deallocate(fresh, new_cap);
+            throw;
+        }
+        try {
+            relocate_to(fresh, new_cap);
+        } catch (...) {
+            std::destroy_at(p);
+            std::allocator<T>().deallocate(fresh, new_cap);
+            throw;
+        }
+        ++end_;
+        return *p;
+    }
+
+    // Moves the elements into fresh, or copies them when moving could
+    // throw. If a copy throws, the stack is unchanged and the caller still
+    // owns fresh.
+    void relocate_to(T* fresh, size_type new_cap) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        T* out = fresh;
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            for (T* in = begin_; in != end_; ++in, ++out) {
+                std::construct_at(out, std::move(*in));
+                std::destroy_at(in);
+            }
+        } else {
+            try {
+                for (T* in = begin_; in != end_; ++in, ++out) {
+                    std::construct_at(out, std::move_if_noexcept(*in));
+                }
+            } catch (...) {
+                std::destroy(fresh, out);
+                throw;
+            }
+            std::destroy(begin_, end_);
+        }
+        release();
+        begin_ = fresh;
+        end_ = out;
+        cap_ = fresh + new_cap;
+    }
+
+    void release() noexcept {
+        if (!is_inline()) {
+            std::allocator<T>().deallocate(begin_, capacity());
+        }
+    }
+
+    // Precondition: this stack is empty.
+    void take(small_stack& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.is_inline()) {
+            reserve(other.size());
+            for (T* in = other.begin_; in != other.end_; ++in) {
+                std::construct_at(end_++, std::move(*in));
+            }
+            other.clear();
+        } else {
+            release();
+            begin_ = other.begin_;
+            end_ = other.end_;
+            cap_ = other.cap_;
+            other.reset();
+        }
+    }
+
+    [[no_unique_address]] detail::small_stack_buffer<T, N> buffer_;
+    T* begin_;
+    T* end_;
+    T* cap_;
+};
+
+template <class T, std::size_t N>
+void swap(small_stack<T, N>& a, small_stack<T, N>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+/**
+ * @brief Bounded lock-free LIFO stack (Treiber) with ABA protection.
+ *
+ * Elements live in a fixed array of slots allocated up front; the stack
+ * and the list of free slots are both Treiber stacks of slot indices. Each
+ * head packs a 32-bit index with a 32-bit modification tag into a single
+ * 64-bit atomic, so a pop that raced with a pop/push/pop of the same slot
+ * fails its CAS instead of corrupting the list, and the structure is
+ * lock-free on every target with 64-bit atomics (no double-width CAS).
+ *
+ * Typical use is a concurrent freelist of object pointers or indices.
+ * try_push() fails when all slots are in use; try_pop() when empty.
+ */
+template <class T>
+class treiber_stack {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Throws std::length_error unless capacity fits a 32-bit slot index (below 2^32 - 1).
+    explicit treiber_stack(size_type capacity)
+        : capacity_(checked_capacity(capacity)),
+          next_(std::make_unique<std::atomic<std::uint32_t>[]>(capacity)),
+          slots_(std::allocator<T>().allocate(capacity)) {
+        for (std::uint32_t i = 0; i < capacity_; ++i) {
+            next_[i].store(i + 1 < capacity_ ? i + 1 : nil, std::memory_order_relaxed);
+        }
+        free_.store(pack(capacity_ ? 0 : nil, 0), std::memory_order_relaxed);
+    }
+
+    treiber_stack(const treiber_stack&) = delete;
+    treiber_stack& operator=(const treiber_stack&) = delete;
+
+    ~treiber_stack() {
+        for (std::uint32_t i = index(head_.load(std::memory_order_relaxed)); i != nil;
+             i = next_[i].load(std::memory_order_relaxed)) {
+            std::destroy_at(slots_ + i);
+        }
+        std::allocator<T>().deallocate(slots_, capacity_);
+    }
+
+    size_type capacity() const noexcept { return capacity_; }
+
+    /// Snapshot only; may be stale by the time it is used.
+    [[nodiscard]] bool empty() const noexcept {
+        return index(head_.load(std::memory_order_acquire)) == nil;
+    }
+
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        std::uint32_t i = pop_index(free_);
+        if (i == nil) {
+            return false;
+        }
+        std::construct_at(slots_ + i, std::forward<Args>(args)...);
+        push_index(head_, i);
+        return true;
+    }
+
+    bool try_push(const T& v) { return try_emplace(v); }
+    bool try_push(T&& v) { return try_emplace(std::move(v)); }
+
+    std::optional<T> try_pop() {
+        std::optional<T> out;
+        std::uint32_t i = pop_index(head_);
+        if (i != nil) {
+            out.emplace(std::move(slots_[i]));
+            std::destroy_at(slots_ + i);
+            push_index(free_, i);
+        }
+        return out;
+    }
+
+    bool try_pop(T& out) {
+        std::uint32_t i = pop_index(head_);
+        if (i == nil) {
+            return false;
+        }
+        out = std::move(slots_[i]);
+        std::destroy_at(slots_ + i);
+        push_index(free_, i);
+        return true;
+    }
+
+private:
+    static constexpr std::uint32_t nil = 0xFFFFFFFFu;
+
+    // Slot indices are 32 bits and nil is the largest of them.
+    static std::uint32_t checked_capacity(size_type capacity) {
+        if (capacity >= nil) {
+            throw std::length_error("std_module::treiber_stack: capacity must be below 2^32 - 1");
+        }
+        return static_cast<std::uint32_t>(capacity);
+    }
+
+    static constexpr std::uint64_t pack(std::uint32_t idx, std::uint32_t tag) noexcept {
+        return (static_cast<std::uint64_t>(tag) << 32) | idx;
+    }
+    static constexpr std::uint32_t index(std::uint64_t head) noexcept {
+        return static_cast<std::uint32_t>(head);
+    }
+    static constexpr std::uint32_t tag(std::uint64_t head) noexcept {
+        return static_cast<std::uint32_t>(head >> 32);
+    }
+
+    void push_index(std::atomic<std::uint64_t>& head, std::uint32_t i) noexcept {
+        std::uint64_t old = head.load(std::memory_order_relaxed);
+        do {
+            next_[i].store(index(old), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old, pack(i, tag(old) + 1), std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    std::uint32_t pop_index(std::atomic<std::uint64_t>& head) noexcept {
+        std::uint64_t old = head.load(std::memory_order_acquire);
+        for (;;) {
+            std::uint32_t i = index(old);
+            if (i == nil) {
+                return nil;
+            }
+            // next_[i] may be rewritten concurrently once another thread
+            // pops i; the tag makes the CAS below fail in that case.
+            std::uint32_t next = next_[i].load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(next, tag(old) + 1), std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+                return i;
+            }
+        }
+    }
+
+    std::uint32_t capacity_;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> next_;
+    T* slots_;
+    alignas(64) std::atomic<std::uint64_t> head_{pack(nil, 0)};
+    alignas(64) std::atomic<std::uint64_t> free_{pack(nil, 0)};
+};
+}  // namespace std_module
@@ -6,6 +6,22 @@
 module;
 
 #include <string>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 export module std_module.string;
 
@@ -56,3 +72,796 @@ using namespace std::literals::string_literals;
 }  // namespace literals
 
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+namespace std_module::detail
+{
+/**
+ * Append-only byte arena. Each stored string is a record of a 4-byte
+ * length followed by the bytes, so a record is identified by one pointer.
+ * Records never move; blocks are released together on destruction.
+ */
+class string_arena
+{
+public:
+    string_arena() = default;
+
+    // The bump cursor points into blocks_, so it moves with them; the
+    // moved-from arena starts over with no block.
+    string_arena(string_arena&& other) noexcept
+        : blocks_(std::move(other.blocks_)),
+          cur_(std::exchange(other.cur_, nullptr)),
+          left_(std::exchange(other.left_, 0)),
+          reserved_(std::exchange(other.reserved_, 0)),
+          next_block_(std::exchange(other.next_block_, min_block))
+    {
+    }
+
+    string_arena& operator=(string_arena&& other) noexcept
+    {
+        blocks_ = std::move(other.blocks_);
+        cur_ = std::exchange(other.cur_, nullptr);
+        left_ = std::exchange(other.left_, 0);
+        reserved_ = std::exchange(other.reserved_, 0);
+        next_block_ = std::exchange(other.next_block_, min_block);
+        return *this;
+    }
+
+    const char* store(std::string_view s)
+    {
+        if (s.size() > 0xFFFFFFFFu) {
+            throw std::length_error("std_module: interned string longer than 4 GiB");
+        }
+        std::size_t need = sizeof(std::uint32_t) + s.size();
+        if (need > left_) {
+            // Blocks double from min_block to max_block so that many small
+            // arenas (one per interner shard) stay small.
+            std::size_t next = next_block_;
+            if (need > next / 4) {
+                // Oversized strings get a block of their own and leave the
+                // current block in place.
+                blocks_.push_back(std::make_unique<char[]>(need));
+                reserved_ += need;
+                return write(blocks_.back().get(), s);
+            }
+            blocks_.push_back(std::make_unique<char[]>(next));
+            reserved_ += next;
+            cur_ = blocks_.back().get();
+            left_ = next;
+            next_block_ = next < max_block ? next * 2 : max_block;
+        }
+        const char* rec = write(cur_, s);
+        cur_ += need;
+        left_ -= need;
+        return rec;
+    }
+
+    static std::string_view view(const char* rec) noexcept
+    {
+        std::uint32_t n;
+        std::memcpy(&n, rec, sizeof n);
+        return {rec + sizeof n, n};
+    }
+
+    std::size_t bytes_reserved() const noexcept
+    {
+        return reserved_ + blocks_.capacity() * sizeof(blocks_[0]);
+    }
+
+private:
+    static constexpr std::size_t min_block = 1024;
+    static constexpr std::size_t max_block = 64 * 1024;
+
+    static const char* write(char* out, std::string_view s) noexcept
+    {
+        auto n = static_cast<std::uint32_t>(s.size());
+        std::memcpy(out, &n, sizeof n);
+        if (!s.empty()) {
+            std::memcpy(out + sizeof n, s.data(), s.size());
+        }
+        return out;
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cur_ = nullptr;
+    std::size_t left_ = 0;
+    std::size_t reserved_ = 0;
+    std::size_t next_block_ = min_block;
+};
+
+inline std::uint64_t intern_hash(std::string_view s) noexcept
+{
+    return std::hash<std::string_view>{}(s);
+}
+
+/**
+ * Open-addressing hash index from string hash to 32-bit id. Slots keep
+ * the low 32 hash bits as a tag, which also serves as the probe start, so
+ * rehashing never needs the strings; the caller resolves tag matches to
+ * strings through @p eq.
+ */
+class intern_index
+{
+public:
+    intern_index() = default;
+
+    intern_index(intern_index&& other) noexcept
+        : slots_(std::move(other.slots_)), count_(std::exchange(other.count_, 0))
+    {
+    }
+
+    intern_index& operator=(intern_index&& other) noexcept
+    {
+        slots_ = std::move(other.slots_);
+        count_ = std::exchange(other.count_, 0);
+        return *this;
+    }
+
+    template <class Eq>
+    std::optional<std::uint32_t> find(std::uint64_t hash, Eq&& eq) const
+    {
+        if (slots_.empty()) {
+            return std::nullopt;
+        }
+        auto tag = static_cast<std::uint32_t>(hash);
+        std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = tag & mask;; i = (i + 1) & mask) {
+            const slot& s = slots_[i];
+            if (s.id_plus_one == 0) {
+                return std::nullopt;
+            }
+            if (s.tag == tag && eq(s.id_plus_one - 1)) {
+                return s.id_plus_one - 1;
+            }
+        }
+    }
+
+    // Precondition: no entry for this string exists.
+    void insert(std::uint64_t hash, std::uint32_t id)
+    {
+        if ((count_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        }
+        place(slot{static_cast<std::uint32_t>(hash), id + 1});
+        ++count_;
+    }
+
+    std::size_t size() const noexcept { return count_; }
+
+    std::size_t bytes_reserved() const noexcept { return slots_.capacity() * sizeof(slot); }
+
+private:
+    struct slot
+    {
+        std::uint32_t tag = 0;
+        std::uint32_t id_plus_one = 0;  // 0 marks an empty slot
+    };
+
+    void place(slot s) noexcept
+    {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t i = s.tag & mask;
+        while (slots_[i].id_plus_one != 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = s;
+    }
+
+    void rehash(std::size_t n)
+    {
+        std::vector<slot> old(n);
+        old.swap(slots_);
+        for (const slot& s : old) {
+            if (s.id_plus_one != 0) {
+                place(s);
+            }
+        }
+    }
+
+    std::vector<slot> slots_;
+    std::size_t count_ = 0;
+};
+
+/**
+ * Id -> record table that never moves its entries, so it can be read
+ * without locks while other threads append. Segment k holds
+ * first_segment << k entries and is installed on first use.
+ */
+class intern_records
+{
+public:
+    intern_records() = default;
+    intern_records(const intern_records&) = delete;
+    intern_records& operator=(const intern_records&) = delete;
+
+    ~intern_records()
+    {
+        for (std::size_t k = 0; k < segment_count; ++k) {
+            delete[] segments_[k].load(std::memory_order_relaxed);
+        }
+    }
+
+    const char* get(std::uint32_t id) const noexcept
+    {
+        auto [k, offset] = locate(id);
+        return segments_[k].load(std::memory_order_acquire)[offset];
+    }
+
+    void set(std::uint32_t id, const char* rec)
+    {
+        auto [k, offset] = locate(id);
+        const char** seg = segments_[k].load(std::memory_order_acquire);
+        if (!seg) {
+            auto fresh = std::make_unique<const char*[]>(first_segment << k);
+            if (segments_[k].compare_exchange_strong(seg, fresh.get(), std::memory_order_acq_rel)) {
+                seg = fresh.release();
+            }
+        }
+        seg[offset] = rec;
+    }
+
+    std::size_t bytes_reserved() const noexcept
+    {
+        std::size_t total = 0;
+        for (std::size_t k = 0; k < segment_count; ++k) {
+            if (segments_[k].load(std::memory_order_relaxed)) {
+                total += (first_segment << k) * sizeof(const char*);
+            }
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::size_t first_segment = 1024;
+    static constexpr std::size_t segment_count = 23;  // covers all 2^32 ids
+
+    struct position
+    {
+        std::size_t segment;
+        std::size_t offset;
+    };
+
+    static position locate(std::uint32_t id) noexcept
+    {
+        std::uint64_t j = std::uint64_t{id} + first_segment;
+        std::size_t k = static_cast<std::size_t>(std::bit_width(j)) - std::bit_width(first_segment);
+        return {k, static_cast<std::size_t>(j - (std::uint64_t{first_segment} << k))};
+    }
+
+    std::atomic<const char**> segments_[segment_count] = {};
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Deduplicating, arena-backed string pool (single-threaded).
+ *
+ * intern() returns a view of the pool's copy of the string, storing each
+ * distinct string once. Views stay valid for the lifetime of the pool
+ * (they are not invalidated by later interning), and equal strings yield
+ * views with the same data(), so interned views can be compared and
+ * hashed by pointer. Each distinct string costs its length plus about 16
+ * bytes, against sizeof(std::string) plus a heap block per copy.
+ */
+class string_pool
+{
+    // Defined first: its deduced return type is needed by the members below
+    auto equal_to(std::string_view s) const
+    {
+        return [this, s](std::uint32_t id) { return detail::string_arena::view(records_[id]) == s; };
+    }
+
+public:
+    string_pool() = default;
+    string_pool(string_pool&&) noexcept = default;
+    string_pool& operator=(string_pool&&) noexcept = default;
+
+    std::string_view intern(std::string_view s)
+    {
+        std::uint64_t h = detail::intern_hash(s);
+        if (auto id = index_.find(h, equal_to(s))) {
+            return detail::string_arena::view(records_[*id]);
+        }
+        const char* rec = arena_.store(s);
+        index_.insert(h, static_cast<std::uint32_t>(records_.size()));
+        records_.push_back(rec);
+        return detail::string_arena::view(rec);
+    }
+
+    [[nodiscard]] bool contains(std::string_view s) const
+    {
+        return index_.find(detail::intern_hash(s), equal_to(s)).has_value();
+    }
+
+    /// Number of distinct strings
+    std::size_t size() const noexcept { return records_.size(); }
+
+    /// Bytes allocated by the pool, including index overhead
+    std::size_t memory_usage() const noexcept
+    {
+        return arena_.bytes_reserved() + index_.bytes_reserved() +
+               records_.capacity() * sizeof(const char*);
+    }
+
+private:
+    detail::string_arena arena_;
+    detail::intern_index index_;
+    std::vector<const char*> records_;
+};
+
+/**
+ * @brief Thread-safe string interning table with stable 32-bit ids.
+ *
+ * intern() maps each distinct string to a dense id (0, 1, 2, ... in
+ * insertion order across all threads) that never changes; view() maps it
+ * back. The table is split into shards by hash, each guarded by a
+ * reader-writer lock, so concurrent lookups of already interned strings
+ * only take shared locks and inserts contend only within a shard. view()
+ * takes no lock at all. Strings are stored once in per-shard arenas and
+ * stay valid for the lifetime of the table.
+ */
+class string_interner
+{
+    auto equal_to(std::string_view s) const
+    {
+        return [this, s](std::uint32_t id) { return detail::string_arena::view(records_.get(id)) == s; };
+    }
+
+public:
+    using id_type = std::uint32_t;
+
+    string_interner() = default;
+    string_interner(const string_interner&) = delete;
+    string_interner& operator=(const string_interner&) = delete;
+
+    id_type intern(std::string_view s)
+    {
+        std::uint64_t h = detail::intern_hash(s);
+        shard& sh = shard_for(h);
+        {
+            std::shared_lock lock(sh.mutex);
+            if (auto id = sh.index.find(h, equal_to(s))) {
+                return *id;
+            }
+        }
+        std::unique_lock lock(sh.mutex);
+        if (auto id = sh.index.find(h, equal_to(s))) {
+            return *id;
+        }
+        // Never advance past the last id, so exhaustion stays permanent and
+        // ids are never handed out twice
+        std::uint32_t id = next_id_.load(std::memory_order_relaxed);
+        do {
+            if (id == 0xFFFFFFFFu) {
+                throw std::length_error("std_module::string_interner: id space exhausted");
+            }
+        } while (!next_id_.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+        records_.set(id, sh.arena.store(s));
+        sh.index.insert(h, id);
+        return id;
+    }
+
+    /// Id of @p s if it has been interned
+    std::optional<id_type> find(std::string_view s) const
+    {
+        std::uint64_t h = detail::intern_hash(s);
+        const shard& sh = shard_for(h);
+        std::shared_lock lock(sh.mutex);
+        return sh.index.find(h, equal_to(s));
+    }
+
+    /// String for an id returned by intern(); lock-free
+    std::string_view view(id_type id) const noexcept
+    {
+        return detail::string_arena::view(records_.get(id));
+    }
+
+    /// Number of distinct strings (a snapshot under concurrent interning)
+    std::size_t size() const noexcept { return next_id_.load(std::memory_order_relaxed); }
+
+    /// Bytes allocated by the table, including index overhead
+    std::size_t memory_usage() const
+    {
+        std::size_t total = records_.bytes_reserved();
+        for (const shard& sh : shards_) {
+            std::shared_lock lock(sh.mutex);
+            total += sh.arena.bytes_reserved() + sh.index.bytes_reserved();
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::size_t shard_bits = 6;
+
+    struct alignas(64) shard
+    {
+        mutable std::shared_mutex mutex;
+        detail::intern_index index;
+        detail::string_arena arena;
+    };
+
+    // The index uses the low hash bits, so pick the shard from the high ones
+    shard& shard_for(std::uint64_t h) noexcept { return shards_[h >> (64 - shard_bits)]; }
+    const shard& shard_for(std::uint64_t h) const noexcept { return shards_[h >> (64 - shard_bits)]; }
+
+    shard shards_[std::size_t{1} << shard_bits];
+    detail::intern_records records_;
+    std::atomic<std::uint32_t> next_id_{0};
+};
+}  // namespace std_module
+
+namespace std_module::detail
+{
+/**
+ * Immutable rope node: a leaf holding a chunk of text, or a concatenation
+ * of two non-empty subtrees. Nodes are shared between ropes, so copying a
+ * rope and taking substrings are cheap and edits copy only O(log n) nodes.
+ */
+struct rope_node
+{
+    using ptr = std::shared_ptr<const rope_node>;
+
+    ptr left;
+    ptr right;
+    std::string text;  // leaves only
+    std::size_t size = 0;
+    int height = 1;  // leaves are 1; the empty tree is 0
+
+    bool is_leaf() const noexcept { return !left; }
+};
+
+class rope_tree
+{
+public:
+    using ptr = rope_node::ptr;
+
+    // Leaves are cut at max_leaf bytes when built from flat text, and
+    // adjacent leaves are merged on join while they fit.
+    static constexpr std::size_t max_leaf = 4096;
+
+    static int height(const ptr& n) noexcept { return n ? n->height : 0; }
+    static std::size_t size(const ptr& n) noexcept { return n ? n->size : 0; }
+
+    static ptr leaf(std::string_view s) { return s.empty() ? nullptr : leaf(std::string(s)); }
+
+    static ptr leaf(std::string&& s)
+    {
+        if (s.empty()) {
+            return nullptr;
+        }
+        auto n = std::make_shared<rope_node>();
+        n->size = s.size();
+        n->text = std::move(s);
+        return n;
+    }
+
+    // Balanced tree over chunks of s of at most max_leaf bytes
+    static ptr build(std::string_view s)
+    {
+        if (s.size() <= max_leaf) {
+            return leaf(s);
+        }
+        // Equal-sized leaves, so that an edit that overflows a leaf leaves
+        // two half-full ones rather than a full one and a sliver
+        std::size_t chunks = (s.size() + max_leaf - 1) / max_leaf;
+        std::size_t half = s.size() / chunks * (chunks / 2);
+        return make(build(s.substr(0, half)), build(s.substr(half)));
+    }
+
+    // Concatenation preserving the AVL height invariant (join-based
+    // balancing), O(|height(l) - height(r)|).
+    static ptr join(const ptr& l, const ptr& r)
+    {
+        if (!l) {
+            return r;
+        }
+        if (!r) {
+            return l;
+        }
+        if (l->is_leaf() && r->is_leaf() && l->size + r->size <= max_leaf) {
+            auto n = std::make_shared<rope_node>();
+            n->text.reserve(l->size + r->size);
+            n->text.append(l->text).append(r->text);
+            n->size = n->text.size();
+            return n;
+        }
+        if (l->height > r->height + 1) {
+            return join_right(l, r);
+        }
+        if (r->height > l->height + 1) {
+            return join_left(l, r);
+        }
+        return make(l, r);
+    }
+
+    // First pos bytes and the rest
+    static std::pair<ptr, ptr> split(const ptr& n, std::size_t pos)
+    {
+        if (!n || pos == 0) {
+            return {nullptr, n};
+        }
+        if (pos >= n->size) {
+            return {n, nullptr};
+        }
+        if (n->is_leaf()) {
+            std::string_view text = n->text;
+            return {leaf(text.substr(0, pos)), leaf(text.substr(pos))};
+        }
+        std::size_t left_size = n->left->size;
+        if (pos < left_size) {
+            auto [a, b] = split(n->left, pos);
+            return {std::move(a), join(b, n->right)};
+        }
+        if (pos > left_size) {
+            auto [a, b] = split(n->right, pos - left_size);
+            return {join(n->left, a), std::move(b)};
+        }
+        return {n->left, n->right};
+    }
+
+    // Replaces count bytes at pos with s. Edits inside one leaf rewrite
+    // just that leaf and rejoin the path above it; anything else falls
+    // back to split and join.
+    static ptr replace(const ptr& n, std::size_t pos, std::size_t count, std::string_view s)
+    {
+        if (!n) {
+            return build(s);
+        }
+        if (n->is_leaf() && s.size() <= max_leaf) {
+            std::string_view text = n->text;
+            std::string out;
+            out.reserve(text.size() - count + s.size());
+            out.append(text.substr(0, pos)).append(s).append(text.substr(pos + count));
+            if (out.size() <= max_leaf) {
+                return leaf(std::move(out));
+            }
+            return build(out);
+        }
+        if (!n->is_leaf() && s.size() <= max_leaf) {
+            std::size_t left_size = n->left->size;
+            if (pos + count <= left_size) {
+                return join(replace(n->left, pos, count, s), n->right);
+            }
+            if (pos >= left_size) {
+                return join(n->left, replace(n->right, pos - left_size, count, s));
+            }
+        }
+        auto [a, rest] = split(n, pos);
+        ptr b = split(rest, count).second;
+        return join(join(a, build(s)), b);
+    }
+
+    static char at(const rope_node* n, std::size_t pos) noexcept
+    {
+        while (!n->is_leaf()) {
+            if (pos < n->left->size) {
+                n = n->left.get();
+            } else {
+                pos -= n->left->size;
+                n = n->right.get();
+            }
+        }
+        return n->text[pos];
+    }
+
+    template <class F>
+    static void for_each_leaf(const rope_node* n, F& f)
+    {
+        while (n && !n->is_leaf()) {
+            for_each_leaf(n->left.get(), f);
+            n = n->right.get();
+        }
+        if (n) {
+            f(std::string_view(n->text));
+        }
+    }
+
+private:
+    static ptr make(ptr l, ptr r)
+    {
+        auto n = std::make_shared<rope_node>();
+        n->size = l->size + r->size;
+        n->height = 1 + (l->height > r->height ? l->height : r->height);
+        n->left = std::move(l);
+        n->right = std::move(r);
+        return n;
+    }
+
+    static ptr rotate_left(const ptr& n) { return make(make(n->left, n->right->left), n->right->right); }
+    static ptr rotate_right(const ptr& n) { return make(n->left->left, make(n->left->right, n->right)); }
+
+    // Precondition: height(l) > height(r) + 1
+    static ptr join_right(const ptr& l, const ptr& r)
+    {
+        const ptr& keep = l->left;
+        const ptr& c = l->right;
+        if (c->height <= r->height + 1) {
+            ptr t = join(c, r);
+            if (t->height <= keep->height + 1) {
+                return make(keep, std::move(t));
+            }
+            return rotate_left(make(keep, rotate_right(t)));
+        }
+        ptr t = join_right(c, r);
+        if (t->height <= keep->height + 1) {
+            return make(keep, std::move(t));
+        }
+        return rotate_left(make(keep, std::move(t)));
+    }
+
+    // Mirror image of join_right
+    static ptr join_left(const ptr& l, const ptr& r)
+    {
+        const ptr& keep = r->right;
+        const ptr& c = r->left;
+        if (c->height <= l->height + 1) {
+            ptr t = join(l, c);
+            if (t->height <= keep->height + 1) {
+                return make(std::move(t), keep);
+            }
+            return rotate_right(make(rotate_left(t), keep));
+        }
+        ptr t = join_left(l, c);
+        if (t->height <= keep->height + 1) {
+            return make(std::move(t), keep);
+        }
+        return rotate_right(make(std::move(t), keep));
+    }
+};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Balanced-tree string (rope/cord) for editing large documents.
+ *
+ * Text is stored in chunks of up to 4 KiB at the leaves of an immutable,
+ * height-balanced tree of shared nodes. Concatenation, insertion, erasure
+ * and substr() take O(log n) time and copy no more than a chunk of text;
+ * copying a rope is O(1) and copies share structure, so a rope may be
+ * snapshotted and read from other threads while the original is edited.
+ * Character access is O(log n); prefer for_each_chunk()/write_to() to
+ * consume the text.
+ */
+class rope
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    rope() = default;
+    explicit rope(std::string_view s) : root_(detail::rope_tree::build(s)) {}
+
+    size_type size() const noexcept { return detail::rope_tree::size(root_); }
+    [[nodiscard]] bool empty() const noexcept { return !root_; }
+
+    /// Unchecked; O(log n)
+    char operator[](size_type pos) const noexcept { return detail::rope_tree::at(root_.get(), pos); }
+
+    char at(size_type pos) const
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("std_module::rope::at");
+        }
+        return (*this)[pos];
+    }
+
+    rope& append(std::string_view s) { return append(rope(s)); }
+
+    rope& append(const rope& r)
+    {
+        root_ = detail::rope_tree::join(root_, r.root_);
+        return *this;
+    }
+
+    rope& insert(size_type pos, std::string_view s) { return replace(pos, 0, s); }
+
+    rope& insert(size_type pos, const rope& r)
+    {
+        check(pos, "std_module::rope::insert");
+        auto [a, b] = detail::rope_tree::split(root_, pos);
+        root_ = detail::rope_tree::join(detail::rope_tree::join(a, r.root_), b);
+        return *this;
+    }
+
+    rope& erase(size_type pos = 0, size_type n = npos) { return replace(pos, n, {}); }
+
+    /// Replaces up to n bytes at pos with s
+    rope& replace(size_type pos, size_type n, std::string_view s)
+    {
+        check(pos, "std_module::rope::replace");
+        root_ = detail::rope_tree::replace(root_, pos, clamp(pos, n), s);
+        return *this;
+    }
+
+    rope substr(size_type pos = 0, size_type n = npos) const
+    {
+        check(pos, "std_module::rope::substr");
+        n = clamp(pos, n);
+        rope out;
+        out.root_ = detail::rope_tree::split(detail::rope_tree::split(root_, pos).second, n).first;
+        return out;
+    }
+
+    void clear() noexcept { root_.reset(); }
+
+    /// Calls f(std::string_view) for each chunk, in order
+    template <class F>
+    void for_each_chunk(F&& f) const
+    {
+        detail::rope_tree::for_each_leaf(root_.get(), f);
+    }
+
+    /// Writes the text chunk by chunk, without flattening; returns bytes written
+    size_type write_to(std::streambuf& buf) const
+    {
+        size_type written = 0;
+        bool ok = true;
+        for_each_chunk([&](std::string_view chunk) {
+            if (ok) {
+                auto n = buf.sputn(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                written += static_cast<size_type>(n);
+                ok = static_cast<size_type>(n) == chunk.size();
+            }
+        });
+        return written;
+    }
+
+    std::string str() const
+    {
+        std::string out;
+        out.reserve(size());
+        for_each_chunk([&](std::string_view chunk) { out.append(chunk); });
+        return out;
+    }
+
+    friend rope operator+(const rope& a, const rope& b)
+    {
+        rope out(a);
+        out.append(b);
+        return out;
+    }
+
+    friend bool operator==(const rope& a, std::string_view s)
+    {
+        if (a.size() != s.size()) {
+            return false;
+        }
+        bool equal = true;
+        a.for_each_chunk([&](std::string_view chunk) {
+            equal = equal && s.substr(0, chunk.size()) == chunk;
+            s.remove_prefix(chunk.size());
+        });
+        return equal;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const rope& r)
+    {
+        std::ostream::sentry guard(os);
+        if (guard && r.write_to(*os.rdbuf()) != r.size()) {
+            os.setstate(std::ios_base::badbit);
+        }
+        return os;
+    }
+
+private:
+    void check(size_type pos, const char* what) const
+    {
+        if (pos > size()) {
+            throw std::out_of_range(what);
+        }
+    }
+
+    size_type clamp(size_type pos, size_type n) const noexcept
+    {
+        return n < size() - pos ? n : size() - pos;
+    }
+
+    detail::rope_tree::ptr root_;
+};
+}  // namespace std_module
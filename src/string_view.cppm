@@ -6,6 +6,20 @@
 module;
 
 #include <string_view>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define STD_MODULE_SV_X86 1
+#else
+#define STD_MODULE_SV_X86 0
+#endif
 
 export module std_module.string_view;
 
@@ -32,3 +46,471 @@ inline namespace literals {
     }
 }
 }  // namespace std
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module
+{
+/**
+ * @brief Set of byte values for find_any_of(), split() and tokenize().
+ *
+ * Besides a 256-bit membership bitmap, construction precomputes the two
+ * 16-entry nibble tables used by the vectorized search: byte c is a
+ * member iff lo[c & 15] & hi[c >> 4] is non-zero. That is exact whenever
+ * the set has at most 8 distinct low-nibble patterns across high nibbles,
+ * which covers every ASCII set; other sets use the scalar bitmap path.
+ * Build sets once (they are constexpr-constructible) and reuse them.
+ */
+class byte_set
+{
+public:
+    constexpr byte_set() noexcept = default;
+
+    constexpr explicit byte_set(std::string_view chars) noexcept
+    {
+        for (char c : chars) {
+            set_bit(static_cast<unsigned char>(c));
+        }
+        build_tables();
+    }
+
+    constexpr void insert(char c) noexcept
+    {
+        set_bit(static_cast<unsigned char>(c));
+        build_tables();
+    }
+
+    constexpr bool contains(char c) const noexcept
+    {
+        auto u = static_cast<unsigned char>(c);
+        return (bits_[u >> 6] >> (u & 63)) & 1;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>(std::popcount(bits_[0]) + std::popcount(bits_[1]) +
+                                        std::popcount(bits_[2]) + std::popcount(bits_[3]));
+    }
+
+    // Nibble tables for the SIMD kernels
+    constexpr bool vectorizable() const noexcept { return vectorizable_; }
+    constexpr const std::uint8_t* lo_table() const noexcept { return lo_; }
+    constexpr const std::uint8_t* hi_table() const noexcept { return hi_; }
+
+private:
+    constexpr void set_bit(unsigned char u) noexcept { bits_[u >> 6] |= std::uint64_t{1} << (u & 63); }
+
+    constexpr void build_tables() noexcept
+    {
+        // Group high nibbles by the set of low nibbles they contain; each
+        // distinct non-empty group gets one of the 8 bits.
+        std::uint16_t rows[16] = {};
+        for (unsigned c = 0; c < 256; ++c) {
+            if (contains(static_cast<char>(c))) {
+                rows[c >> 4] |= static_cast<std::uint16_t>(1u << (c & 15));
+            }
+        }
+        std::uint16_t groups[8] = {};
+        unsigned group_count = 0;
+        vectorizable_ = true;
+        for (auto& v : lo_) {
+            v = 0;
+        }
+        for (unsigned h = 0; h < 16; ++h) {
+            hi_[h] = 0;
+            if (rows[h] == 0) {
+                continue;
+            }
+            unsigned g = 0;
+            while (g < group_count && groups[g] != rows[h]) {
+                ++g;
+            }
+            if (g == group_count) {
+                if (group_count == 8) {
+                    vectorizable_ = false;
+                    return;
+                }
+                groups[group_count++] = rows[h];
+                for (unsigned l = 0; l < 16; ++l) {
+                    if (rows[h] >> l & 1) {
+                        lo_[l] |= static_cast<std::uint8_t>(1u << g);
+                    }
+                }
+            }
+            hi_[h] = static_cast<std::uint8_t>(1u << g);
+        }
+    }
+
+    std::uint64_t bits_[4] = {};
+    alignas(16) std::uint8_t lo_[16] = {};
+    alignas(16) std::uint8_t hi_[16] = {};
+    bool vectorizable_ = true;
+};
+}  // namespace std_module
+
+namespace std_module::detail
+{
+inline std::size_t find_any_scalar(const char* p, std::size_t n, const byte_set& set) noexcept
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        if (set.contains(p[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#if STD_MODULE_SV_X86
+__attribute__((target("ssse3"))) inline std::size_t find_any_ssse3(const char* p, std::size_t n,
+                                                                   const byte_set& set) noexcept
+{
+    const __m128i lo_tbl = _mm_load_si128(reinterpret_cast<const __m128i*>(set.lo_table()));
+    const __m128i hi_tbl = _mm_load_si128(reinterpret_cast<const __m128i*>(set.hi_table()));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i lo = _mm_shuffle_epi8(lo_tbl, _mm_and_si128(v, nibble));
+        __m128i hi = _mm_shuffle_epi8(hi_tbl, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        auto miss = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero)));
+        if (miss != 0xFFFF) {
+            return i + static_cast<std::size_t>(std::countr_one(miss));
+        }
+    }
+    return i + find_any_scalar(p + i, n - i, set);
+}
+
+__attribute__((target("avx2"))) inline std::size_t find_any_avx2(const char* p, std::size_t n,
+                                                                 const byte_set& set) noexcept
+{
+    const __m256i lo_tbl =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.lo_table())));
+    const __m256i hi_tbl =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.hi_table())));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i lo = _mm256_shuffle_epi8(lo_tbl, _mm256_and_si256(v, nibble));
+        __m256i hi = _mm256_shuffle_epi8(hi_tbl, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        auto miss = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero)));
+        if (miss != 0xFFFFFFFFu) {
+            return i + static_cast<std::size_t>(std::countr_one(miss));
+        }
+    }
+    return i + find_any_ssse3(p + i, n - i, set);
+}
+#endif
+
+using find_any_fn = std::size_t (*)(const char*, std::size_t, const byte_set&) noexcept;
+
+// Resolved once, on first use, from the CPU the program runs on
+inline find_any_fn select_find_any() noexcept
+{
+#if STD_MODULE_SV_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return find_any_avx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return find_any_ssse3;
+    }
+#endif
+    return find_any_scalar;
+}
+
+inline std::size_t find_any(const char* p, std::size_t n, const byte_set& set) noexcept
+{
+    static const find_any_fn impl = select_find_any();
+    // Short inputs are not worth the indirect call
+    if (n < 16 || !set.vectorizable()) {
+        return find_any_scalar(p, n, set);
+    }
+    return impl(p, n, set);
+}
+
+inline std::size_t find_delimiter(const char* p, std::size_t n, char c) noexcept
+{
+    const void* hit = n ? std::memchr(p, static_cast<unsigned char>(c), n) : nullptr;
+    return hit ? static_cast<std::size_t>(static_cast<const char*>(hit) - p) : n;
+}
+
+inline std::size_t find_delimiter(const char* p, std::size_t n, const byte_set& set) noexcept
+{
+    return find_any(p, n, set);
+}
+
+constexpr std::uint64_t broadcast(std::uint8_t b) noexcept
+{
+    return 0x0101010101010101ull * b;
+}
+
+// Lowercases the ASCII letters in 8 packed bytes, leaving other bytes
+// (including non-ASCII) untouched.
+constexpr std::uint64_t ascii_lower8(std::uint64_t x) noexcept
+{
+    std::uint64_t low7 = x & broadcast(0x7F);
+    std::uint64_t ge_a = low7 + broadcast(0x80 - 'A');
+    std::uint64_t gt_z = low7 + broadcast(0x80 - 'Z' - 1);
+    std::uint64_t upper = (ge_a ^ gt_z) & ~x & broadcast(0x80);
+    return x | (upper >> 2);
+}
+
+inline std::uint64_t load8(const char* p) noexcept
+{
+    std::uint64_t x;
+    std::memcpy(&x, p, 8);
+    return x;
+}
+
+inline std::uint64_t load4(const char* p) noexcept
+{
+    std::uint32_t x;
+    std::memcpy(&x, p, 4);
+    return x;
+}
+
+// Packs the n < 8 bytes at p into a word with fixed-size, possibly
+// overlapping loads (a variable-size memcpy would be a library call).
+// The packing is a deterministic function of the bytes for a given n,
+// which is all equality and hashing need.
+inline std::uint64_t load_tail(const char* p, std::size_t n) noexcept
+{
+    if (n >= 4) {
+        return load4(p) | load4(p + n - 4) << 32;
+    }
+    if (n > 0) {
+        return std::uint64_t{static_cast<unsigned char>(p[0])} |
+               std::uint64_t{static_cast<unsigned char>(p[n / 2])} << 8 |
+               std::uint64_t{static_cast<unsigned char>(p[n - 1])} << 16;
+    }
+    return 0;
+}
+
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Position of the first byte of @p s at or after @p pos that is in
+ * @p set, or std::string_view::npos.
+ *
+ * Vectorized with 16/32-byte nibble-table lookups (SSSE3/AVX2, picked at
+ * run time) where the set allows it.
+ */
+inline std::size_t find_any_of(std::string_view s, const byte_set& set, std::size_t pos = 0) noexcept
+{
+    if (pos >= s.size()) {
+        return std::string_view::npos;
+    }
+    std::size_t i = pos + detail::find_any(s.data() + pos, s.size() - pos, set);
+    return i < s.size() ? i : std::string_view::npos;
+}
+
+/**
+ * @brief Forward range over the fields of a string separated by a
+ * delimiter (a char or a byte_set).
+ *
+ * Fields are views into the input; nothing is allocated. With
+ * skip_empty == false (split) every delimiter ends a field, so "a,,b"
+ * yields "a", "", "b" and "" yields one empty field; with skip_empty ==
+ * true (tokenize) empty fields are dropped.
+ */
+template <class Delim>
+class split_range
+{
+public:
+    class iterator
+    {
+    public:
+        // Fields are returned by value, not as references into the
+        // iterator, so references taken from *it outlive ++it. That makes
+        // it a forward iterator for ranges but only an input iterator to
+        // the C++17 requirements, like the standard views' iterators.
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        reference operator*() const noexcept { return field_; }
+
+        iterator& operator++() noexcept
+        {
+            do {
+                advance();
+            } while (range_->skip_empty_ && !done_ && field_.empty());
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept
+        {
+            return a.done_ == b.done_ && (a.done_ || a.field_.data() == b.field_.data());
+        }
+
+    private:
+        friend class split_range;
+
+        explicit iterator(const split_range* range) noexcept : range_(range), done_(false)
+        {
+            find_field(range->input_.data());
+            if (range_->skip_empty_ && field_.empty()) {
+                ++*this;
+            }
+        }
+
+        void find_field(const char* start) noexcept
+        {
+            const char* last = range_->input_.data() + range_->input_.size();
+            std::size_t n = detail::find_delimiter(start, static_cast<std::size_t>(last - start),
+                                                   range_->delim_);
+            field_ = std::string_view(start, n);
+        }
+
+        void advance() noexcept
+        {
+            const char* field_end = field_.data() + field_.size();
+            if (field_end == range_->input_.data() + range_->input_.size()) {
+                done_ = true;
+                field_ = {};
+                return;
+            }
+            find_field(field_end + 1);
+        }
+
+        const split_range* range_ = nullptr;
+        std::string_view field_;
+        bool done_ = true;
+    };
+
+    split_range(std::string_view input, Delim delim, bool skip_empty) noexcept
+        : input_(input), delim_(delim), skip_empty_(skip_empty)
+    {
+    }
+
+    iterator begin() const noexcept { return iterator(this); }
+
+    iterator end() const noexcept { return iterator(); }
+
+private:
+    std::string_view input_;
+    Delim delim_;
+    bool skip_empty_;
+};
+
+/// Fields of @p s separated by @p delim, keeping empty fields
+inline split_range<char> split(std::string_view s, char delim) noexcept
+{
+    return {s, delim, false};
+}
+
+/// Fields of @p s separated by any byte of @p delims, keeping empty fields
+inline split_range<byte_set> split(std::string_view s, const byte_set& delims) noexcept
+{
+    return {s, delims, false};
+}
+
+/// Non-empty tokens of @p s separated by @p delim
+inline split_range<char> tokenize(std::string_view s, char delim) noexcept
+{
+    return {s, delim, true};
+}
+
+/// Non-empty tokens of @p s separated by runs of bytes in @p delims
+inline split_range<byte_set> tokenize(std::string_view s, const byte_set& delims) noexcept
+{
+    return {s, delims, true};
+}
+
+/**
+ * @brief ASCII case-insensitive equality (bytes >= 0x80 compare exactly),
+ * 8 bytes at a time.
+ */
+inline bool iequals(std::string_view a, std::string_view b) noexcept
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    std::size_t n = a.size();
+    if (n < 8) {
+        return detail::ascii_lower8(detail::load_tail(a.data(), n)) ==
+               detail::ascii_lower8(detail::load_tail(b.data(), n));
+    }
+    for (std::size_t i = 0; i + 8 < n; i += 8) {
+        std::uint64_t x = detail::load8(a.data() + i);
+        std::uint64_t y = detail::load8(b.data() + i);
+        if (x != y && detail::ascii_lower8(x) != detail::ascii_lower8(y)) {
+            return false;
+        }
+    }
+    // Last 8 bytes, overlapping the loop's final word
+    return detail::ascii_lower8(detail::load8(a.data() + n - 8)) ==
+           detail::ascii_lower8(detail::load8(b.data() + n - 8));
+}
+
+/**
+ * @brief Hash consistent with iequals(): strings differing only in ASCII
+ * letter case hash equal.
+ */
+inline std::size_t ihash(std::string_view s) noexcept
+{
+    constexpr std::uint64_t k = 0x9E3779B97F4A7C15ull;
+    std::size_t n = s.size();
+    std::uint64_t h = n * k;
+    if (n < 8) {
+        h ^= detail::ascii_lower8(detail::load_tail(s.data(), n));
+    } else {
+        for (std::size_t i = 0; i + 8 < n; i += 8) {
+            h = std::rotl((h ^ detail::ascii_lower8(detail::load8(s.data() + i))) * k, 29);
+        }
+        h ^= detail::ascii_lower8(detail::load8(s.data() + n - 8));
+    }
+    h *= k;
+    return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+/// Transparent hasher/comparator pair for case-insensitive unordered containers
+struct ihash_fn
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const noexcept { return ihash(s); }
+};
+
+struct iequal_to
+{
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const noexcept { return iequals(a, b); }
+};
+
+/// True if @p s starts with any of @p prefixes
+inline bool starts_with_any(std::string_view s, std::span<const std::string_view> prefixes) noexcept
+{
+    for (std::string_view p : prefixes) {
+        if (p.size() <= s.size() &&
+            (p.empty() || (p[0] == s[0] && std::memcmp(p.data(), s.data(), p.size()) == 0))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool starts_with_any(std::string_view s, std::initializer_list<std::string_view> prefixes) noexcept
+{
+    return starts_with_any(s, std::span<const std::string_view>(prefixes.begin(), prefixes.size()));
+}
+}  // namespace std_module
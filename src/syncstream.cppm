@@ -6,6 +6,27 @@
 module;
 
 #include <syncstream>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <source_location>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 export module std_module.syncstream;
 
@@ -21,3 +42,487 @@ using std::basic_osyncstream;
 using std::osyncstream;
 using std::wosyncstream;
 }  // namespace std
+
+
+// ==============================================================================
+// Extensions
+// ==============================================================================
+
+export namespace std_module
+{
+enum class log_level : std::uint8_t
+{
+    trace,
+    debug,
+    info,
+    warn,
+    error,
+};
+
+/**
+ * @brief Format string of a log call plus the call site.
+ *
+ * Implicitly built from a string literal in the log call, which validates
+ * it against the argument types at compile time (as std::format does) and
+ * captures std::source_location::current() of the caller.
+ */
+template <class... Args>
+struct basic_log_format
+{
+    template <class S>
+        requires std::convertible_to<const S&, std::string_view>
+    consteval basic_log_format(const S& s, std::source_location where = std::source_location::current())
+        : fmt(s), where(where)
+    {
+    }
+
+    std::format_string<Args...> fmt;
+    std::source_location where;
+};
+
+template <class... Args>
+using log_format = basic_log_format<std::type_identity_t<Args>...>;
+}  // namespace std_module
+
+namespace std_module::detail
+{
+// Ring storage unit; every record starts on a slot boundary
+struct alignas(16) log_slot
+{
+    std::byte bytes[16];
+};
+
+struct log_record;
+using log_emit_fn = void (*)(log_record*, std::string&);
+
+/**
+ * Fixed part of a record in a log_ring. emit == nullptr marks padding
+ * that skips to the end of the ring. The captured arguments follow.
+ */
+struct log_record
+{
+    log_emit_fn emit;
+    std::uint32_t slots;
+    log_level level;
+    std::int64_t timestamp_ns;
+    std::string_view fmt;
+    std::source_location where;
+};
+
+// Arguments are captured by value. Strings are copied into the record
+// itself and stored as a string_view into it, so capturing never
+// allocates and the caller's string may change right after the call.
+template <class T>
+struct log_capture
+{
+    using type = T;
+
+    static std::size_t extra(const T&) noexcept { return 0; }
+    static const T& store(const T& v, char*&) noexcept { return v; }
+};
+
+template <class T>
+concept log_string_arg = std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+                         std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <class T>
+    requires log_string_arg<T>
+struct log_capture<T>
+{
+    using type = std::string_view;
+
+    static std::size_t extra(const T& v) noexcept { return std::string_view(v).size(); }
+
+    static std::string_view store(const T& v, char*& tail) noexcept
+    {
+        std::string_view s(v);
+        if (!s.empty()) {
+            std::memcpy(tail, s.data(), s.size());
+        }
+        std::string_view out(tail, s.size());
+        tail += s.size();
+        return out;
+    }
+};
+
+template <class T>
+using log_capture_for = log_capture<std::decay_t<T>>;
+
+template <class... Args>
+struct log_payload
+{
+    using tuple = std::tuple<typename log_capture_for<Args>::type...>;
+
+    static_assert(alignof(tuple) <= alignof(log_slot), "over-aligned log argument");
+
+    static constexpr std::size_t args_offset = (sizeof(log_record) + alignof(tuple) - 1) / alignof(tuple) * alignof(tuple);
+    static constexpr std::size_t tail_offset = args_offset + sizeof(tuple);
+
+    static tuple* args(log_record* r) noexcept
+    {
+        return std::launder(reinterpret_cast<tuple*>(reinterpret_cast<std::byte*>(r) + args_offset));
+    }
+
+    // Appends the message and destroys the captured arguments
+    static void emit(log_record* r, std::string& out)
+    {
+        tuple* t = args(r);
+        std::apply([&](auto&... a) { std::vformat_to(std::back_inserter(out), r->fmt, std::make_format_args(a...)); },
+                   *t);
+        t->~tuple();
+    }
+};
+
+/**
+ * Single-producer/single-consumer ring of variable-sized records, one per
+ * logging thread. Positions count slots and only ever increase; a record
+ * that would straddle the end is preceded by a padding record.
+ */
+struct alignas(64) log_ring
+{
+    // Zero-filled so the pages are faulted in at registration rather than
+    // on the first pass of the logging thread
+    explicit log_ring(std::size_t slots, std::thread::id owner)
+        : slots(new log_slot[slots]()), capacity(slots), mask(slots - 1), owner(owner)
+    {
+    }
+
+    // Returns nullptr when the ring lacks room right now; the consumer
+    // side lives in async_logger, which also writes the line prefix.
+    log_record* try_reserve(std::size_t n) noexcept
+    {
+        std::uint64_t pos = tail.load(std::memory_order_relaxed);
+        std::size_t index = static_cast<std::size_t>(pos & mask);
+        std::size_t pad = index + n > capacity ? capacity - index : 0;
+        if (pad + n > capacity) {
+            // The record fits the ring but never behind this padding: publish the
+            // padding alone and place the record at offset 0, once the ring drains.
+            if (pos + pad - head_cache > capacity) {
+                head_cache = head.load(std::memory_order_acquire);
+                if (pos + pad - head_cache > capacity) {
+                    return nullptr;
+                }
+            }
+            auto* p = reinterpret_cast<log_record*>(&slots[index]);
+            p->emit = nullptr;
+            p->slots = static_cast<std::uint32_t>(pad);
+            pos += pad;
+            tail.store(pos, std::memory_order_release);
+            pad = 0;
+        }
+        std::uint64_t need = pad + n;
+        if (pos + need - head_cache > capacity) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (pos + need - head_cache > capacity) {
+                return nullptr;
+            }
+        }
+        if (pad != 0) {
+            auto* p = reinterpret_cast<log_record*>(&slots[index]);
+            p->emit = nullptr;
+            p->slots = static_cast<std::uint32_t>(pad);
+        }
+        reserved = need;
+        return reinterpret_cast<log_record*>(&slots[(pos + pad) & mask]);
+    }
+
+    void commit() noexcept { tail.store(tail.load(std::memory_order_relaxed) + reserved, std::memory_order_release); }
+
+    std::unique_ptr<log_slot[]> slots;
+    std::size_t capacity;
+    std::uint64_t mask;
+    std::thread::id owner;
+
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+    std::uint64_t head_cache = 0;
+    std::uint64_t reserved = 0;
+
+    alignas(64) std::atomic<std::uint64_t> head{0};
+};
+
+// Per-thread cache of (logger id -> ring); ids are never reused, so a
+// stale entry of a destroyed logger can never match a new one.
+struct log_ring_cache
+{
+    struct entry
+    {
+        std::uint64_t logger = 0;
+        log_ring* ring = nullptr;
+    };
+
+    entry entries[4];
+    unsigned next = 0;
+};
+
+inline thread_local log_ring_cache ring_cache;
+inline std::atomic<std::uint64_t> next_logger_id{1};
+
+inline constexpr std::string_view log_level_names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+}  // namespace std_module::detail
+
+export namespace std_module
+{
+/**
+ * @brief Asynchronous logger: callers capture, a background thread formats.
+ *
+ * A log call checks the level, then copies the format string, call site,
+ * timestamp and arguments (strings included) into a lock-free ring owned
+ * by the calling thread; no formatting, locking or allocation happens on
+ * the caller's side after the thread's first call. A background thread
+ * drains the rings, formats each record with std::vformat_to into one
+ * batch per pass and writes the batch through std::osyncstream, so other
+ * osyncstream users of the same stream never see torn lines.
+ *
+ * Lines look like "1700000000.123456 INFO  main.cpp:42 message". Records
+ * of one thread keep their order; records of different threads are
+ * ordered per pass, not globally. When a thread's ring is full the call
+ * waits for the background thread, or drops the record if
+ * drop_when_full is set. Threads must stop logging before the logger is
+ * destroyed; the destructor writes out whatever is still queued.
+ *
+ *     std_module::async_logger log(std::clog);
+ *     log.info("request {} took {:.2f} ms", id, ms);
+ */
+class async_logger
+{
+public:
+    struct options
+    {
+        std::size_t ring_bytes;                  ///< Per-thread ring size, rounded up to a power of two
+        bool drop_when_full;                     ///< Drop instead of waiting when a ring is full
+        std::chrono::microseconds poll_interval; ///< Background sleep when there was nothing to write
+    };
+
+    static constexpr options default_options{std::size_t(1) << 20, false, std::chrono::microseconds(1000)};
+
+    explicit async_logger(std::ostream& out, options opt = default_options)
+        : out_(out), opt_(opt), id_(detail::next_logger_id.fetch_add(1, std::memory_order_relaxed))
+    {
+        ring_slots_ = 64;
+        while (ring_slots_ * sizeof(detail::log_slot) < opt_.ring_bytes) {
+            ring_slots_ *= 2;
+        }
+        worker_ = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    async_logger(const async_logger&) = delete;
+    async_logger& operator=(const async_logger&) = delete;
+
+    /// Writes out everything logged so far, then stops the background thread
+    ~async_logger()
+    {
+        worker_.request_stop();
+        worker_.join();
+    }
+
+    template <class... Args>
+    void log(log_level level, log_format<Args...> fmt, const Args&... args)
+    {
+        if (level < level_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        using payload = detail::log_payload<Args...>;
+        std::size_t bytes = payload::tail_offset + (detail::log_capture_for<Args>::extra(args) + ... + 0);
+        std::size_t slots = (bytes + sizeof(detail::log_slot) - 1) / sizeof(detail::log_slot);
+        detail::log_ring& ring = local_ring();
+        if (slots > ring.capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        detail::log_record* r = ring.try_reserve(slots);
+        while (r == nullptr) {
+            if (opt_.drop_when_full) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+            r = ring.try_reserve(slots);
+        }
+        r->emit = &payload::emit;
+        r->slots = static_cast<std::uint32_t>(slots);
+        r->level = level;
+        r->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+        r->fmt = fmt.fmt.get();
+        r->where = fmt.where;
+        char* tail = reinterpret_cast<char*>(r) + payload::tail_offset;
+        ::new (static_cast<void*>(payload::args(r)))
+            typename payload::tuple(detail::log_capture_for<Args>::store(args, tail)...);
+        ring.commit();
+    }
+
+    template <class... Args>
+    void trace(log_format<Args...> fmt, const Args&... args) { log(log_level::trace, fmt, args...); }
+    template <class... Args>
+    void debug(log_format<Args...> fmt, const Args&... args) { log(log_level::debug, fmt, args...); }
+    template <class... Args>
+    void info(log_format<Args...> fmt, const Args&... args) { log(log_level::info, fmt, args...); }
+    template <class... Args>
+    void warn(log_format<Args...> fmt, const Args&... args) { log(log_level::warn, fmt, args...); }
+    template <class... Args>
+    void error(log_format<Args...> fmt, const Args&... args) { log(log_level::error, fmt, args...); }
+
+    /// Records below @p level are discarded at the call site
+    void set_level(log_level level) noexcept { level_.store(level, std::memory_order_relaxed); }
+    log_level level() const noexcept { return level_.load(std::memory_order_relaxed); }
+
+    /// Records dropped because a ring was full (or a record was larger than a ring)
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Blocks until everything this thread logged before the call
+     * has been written and the stream flushed.
+     */
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::uint64_t ticket = ++flush_requested_;
+        wake_.notify_one();
+        done_.wait(lock, [&] { return flush_done_ >= ticket; });
+    }
+
+private:
+    detail::log_ring& local_ring()
+    {
+        auto& cache = detail::ring_cache;
+        for (auto& e : cache.entries) {
+            if (e.logger == id_) {
+                return *e.ring;
+            }
+        }
+        return register_thread();
+    }
+
+    [[gnu::noinline]] detail::log_ring& register_thread()
+    {
+        std::thread::id self = std::this_thread::get_id();
+        detail::log_ring* ring = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& r : rings_) {
+                if (r->owner == self) {
+                    ring = r.get();
+                }
+            }
+            if (ring == nullptr) {
+                rings_.push_back(std::make_unique<detail::log_ring>(ring_slots_, self));
+                ring = rings_.back().get();
+            }
+        }
+        auto& cache = detail::ring_cache;
+        cache.entries[cache.next++ % 4] = {id_, ring};
+        return *ring;
+    }
+
+    // Formats all pending records into batch_; returns how many
+    std::size_t drain()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            snapshot_.clear();
+            for (auto& r : rings_) {
+                snapshot_.push_back(r.get());
+            }
+        }
+        std::size_t count = 0;
+        for (detail::log_ring* ring : snapshot_) {
+            count += drain_ring(*ring);
+        }
+        return count;
+    }
+
+    std::size_t drain_ring(detail::log_ring& ring)
+    {
+        std::size_t count = 0;
+        std::uint64_t pos = ring.head.load(std::memory_order_relaxed);
+        std::uint64_t end = ring.tail.load(std::memory_order_acquire);
+        while (pos != end) {
+            auto* r = reinterpret_cast<detail::log_record*>(&ring.slots[pos & ring.mask]);
+            std::uint32_t n = r->slots;
+            if (r->emit != nullptr) {
+                write_prefix(*r);
+                r->emit(r, batch_);
+                batch_.push_back('\n');
+                ++count;
+            }
+            pos += n;
+            // Hand space back record by record so a waiting producer resumes early
+            ring.head.store(pos, std::memory_order_release);
+        }
+        return count;
+    }
+
+    void write_prefix(const detail::log_record& r)
+    {
+        std::string_view file = r.where.file_name();
+        std::size_t slash = file.find_last_of("/\\");
+        if (slash != std::string_view::npos) {
+            file.remove_prefix(slash + 1);
+        }
+        std::int64_t us = r.timestamp_ns / 1000;
+        std::format_to(std::back_inserter(batch_), "{}.{:06} {:<5} {}:{} ", us / 1'000'000, us % 1'000'000,
+                       detail::log_level_names[static_cast<std::size_t>(r.level)], file, r.where.line());
+    }
+
+    void write_batch(bool flush)
+    {
+        if (batch_.empty() && !flush) {
+            return;
+        }
+        std::osyncstream sync(out_);
+        sync.rdbuf()->set_emit_on_sync(flush);
+        sync.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+        if (flush) {
+            sync.flush();
+        }
+        batch_.clear();
+    }
+
+    void run(std::stop_token stop)
+    {
+        while (!stop.stop_requested()) {
+            std::uint64_t requested;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                requested = flush_requested_;
+            }
+            std::size_t written = drain();
+            write_batch(requested != flush_done_);
+            if (requested != flush_done_) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                flush_done_ = requested;
+                done_.notify_all();
+            }
+            if (written == 0) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait_for(lock, stop, opt_.poll_interval, [&] { return flush_requested_ != flush_done_; });
+            }
+        }
+        // Final pass after the owner stopped logging
+        drain();
+        write_batch(true);
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush_done_ = flush_requested_;
+        done_.notify_all();
+    }
+
+    std::ostream& out_;
+    options opt_;
+    std::uint64_t id_;
+    std::size_t ring_slots_;
+    std::atomic<log_level> level_{log_level::trace};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::condition_variable_any done_;
+    std::vector<std::unique_ptr<detail::log_ring>> rings_;
+    std::vector<detail::log_ring*> snapshot_;
+    std::uint64_t flush_requested_ = 0;
+    std::uint64_t flush_done_ = 0;
+
+    std::string batch_;
+    std::jthread worker_;
+};
+}  // namespace std_module
@@ -7,6 +7,13 @@
  */
 
 import std_module.charconv;
+import std_module.bit;
+import std_module.limits;
+import std_module.span;
+import std_module.string;
+import std_module.string_view;
+import std_module.system_error;
+import std_module.vector;
 import std_module.test_framework;
 
 int main() {
@@ -55,6 +62,110 @@ int main() {
     [[maybe_unused]] auto ec = result.ec;
     test::success("to_chars_result structure");
 
+    test::section("Testing std_module extensions");
+
+    // Batch parsing: delimiter and line breaks separate fields
+    std::string_view ints = "12,-7,123456789012,0\r\n-9223372036854775808,42\n";
+    std::vector<long long> iv(8);
+    auto ir = std_module::from_chars_batch(ints.data(), ints.data() + ints.size(), std::span(iv));
+    test::assert_true(ir.ec == std::errc{} && ir.count == 6 && ir.ptr == ints.data() + ints.size(),
+                      "from_chars_batch integers");
+    test::assert_true(iv[2] == 123456789012 && iv[4] == -9223372036854775807LL - 1 && iv[5] == 42,
+                      "from_chars_batch integer values");
+
+    // Stops when the output is full and can resume at ptr
+    int two[2];
+    auto partial = std_module::from_chars_batch(ints.data(), ints.data() + ints.size(), std::span<int>(two));
+    test::assert_true(partial.count == 2 && partial.ptr == ints.data() + 6, "from_chars_batch resumable");
+
+    // Errors report the position of the offending field
+    std::string_view bad = "1,2,300,4";
+    unsigned char small[4];
+    auto range = std_module::from_chars_batch(bad.data(), bad.data() + bad.size(), std::span<unsigned char>(small));
+    test::assert_true(range.ec == std::errc::result_out_of_range && range.count == 2 && range.ptr == bad.data() + 4,
+                      "from_chars_batch out of range position");
+    int small_ints[2];
+    std::string_view garbage = "1\t2";
+    auto invalid = std_module::from_chars_batch(garbage.data(), garbage.data() + garbage.size(), std::span<int>(small_ints));
+    test::assert_true(invalid.ec == std::errc::invalid_argument && invalid.ptr == garbage.data() + 1,
+                      "from_chars_batch bad separator position");
+    auto tabs = std_module::from_chars_batch(garbage.data(), garbage.data() + garbage.size(), std::span<int>(small_ints), '\t');
+    test::assert_true(tabs.count == 2 && small_ints[1] == 2, "from_chars_batch custom delimiter");
+
+    // Doubles match std::from_chars bit for bit, fast path or not
+    std::string_view reals = "0.1,-2.5e-3,3.141592653589793,1e300,123456789.123456789,.5,7.,inf,-0";
+    std::vector<double> dv(16);
+    auto dr = std_module::from_chars_batch(reals.data(), reals.data() + reals.size(), std::span(dv));
+    test::assert_equal(dr.count, static_cast<size_t>(9), "from_chars_batch doubles");
+    bool same = true;
+    const char* field = reals.data();
+    for (size_t i = 0; i < dr.count; ++i) {
+        double expected = 0.0;
+        auto r = std::from_chars(field, reals.data() + reals.size(), expected);
+        same = same && expected == dv[i] && (expected != 0 || 1 / expected == 1 / dv[i]);  // sign of zero too
+        field = r.ptr + 1;
+    }
+    test::assert_true(same, "from_chars_batch doubles match std::from_chars");
+
+    // Batch printing with a separator
+    std::vector<int> out_values = {1, -23, 456};
+    char line[16];
+    auto wr = std_module::to_chars_batch(line, line + sizeof(line), std::span(out_values), ';');
+    test::assert_true(wr.ec == std::errc{} && std::string_view(line, wr.ptr) == "1;-23;456", "to_chars_batch");
+    auto full = std_module::to_chars_batch(line, line + 5, std::span(out_values));
+    test::assert_true(full.ec == std::errc::value_too_large && full.count == 2 &&
+                          std::string_view(line, full.ptr) == "1,-23",
+                      "to_chars_batch reports where it stopped");
+    double reals_out[] = {0.1, 2.5, -1e-7};
+    auto fr = std_module::to_chars_batch(line, line + sizeof(line), std::span<const double>(reals_out), ' ');
+    test::assert_true(std::string_view(line, fr.ptr) == "0.1 2.5 -1e-07", "to_chars_batch doubles");
+
+    // Shortest round-trip output, laid out exactly as std::to_chars does
+    auto shortest = [](auto value, auto... fmt) {
+        static char buf[400];
+        auto r = std_module::to_chars(buf, buf + sizeof(buf), value, fmt...);
+        return std::string(buf, r.ptr);
+    };
+    test::assert_true(shortest(0.1) == "0.1" && shortest(-2.5e-7) == "-2.5e-07" && shortest(1e4) == "10000" &&
+                          shortest(1e5) == "1e+05" && shortest(0.0) == "0" && shortest(-0.0f) == "-0",
+                      "to_chars shortest plain");
+    test::assert_true(shortest(1e23, std::chars_format::fixed) == "99999999999999991611392" &&
+                          shortest(123456789012345680000.0) == "123456789012345683968",
+                      "to_chars fixed prints whole numbers exactly");
+    test::assert_true(shortest(5e-324, std::chars_format::scientific) == "5e-324" &&
+                          shortest(1.7976931348623157e308, std::chars_format::general) == "1.7976931348623157e+308" &&
+                          shortest(0.0001234f, std::chars_format::general) == "0.0001234",
+                      "to_chars scientific and general");
+    test::assert_true(shortest(1.5, std::chars_format::hex) == "1.8p+0" &&
+                          shortest(1e-45f, std::chars_format::hex) == "0.000002p-126" &&
+                          shortest(-std::numeric_limits<double>::infinity()) == "-inf",
+                      "to_chars hex and special values");
+    char tiny[4];
+    auto too_small = std_module::to_chars(tiny, tiny + sizeof(tiny), 3.125);
+    test::assert_true(too_small.ec == std::errc::value_too_large && too_small.ptr == tiny + sizeof(tiny),
+                      "to_chars value_too_large");
+
+    const std::chars_format formats[] = {std::chars_format::fixed, std::chars_format::scientific,
+                                         std::chars_format::general, std::chars_format::hex};
+    bool identical = true;
+    unsigned long long bits = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 20000; ++i) {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double d = std::bit_cast<double>(bits);
+        float f = std::bit_cast<float>(static_cast<unsigned>(bits));
+        char expected[400];
+        identical = identical && shortest(d) == std::string(expected, std::to_chars(expected, expected + 400, d).ptr) &&
+                    shortest(f) == std::string(expected, std::to_chars(expected, expected + 400, f).ptr);
+        for (auto fmt : formats) {
+            identical = identical &&
+                        shortest(d, fmt) == std::string(expected, std::to_chars(expected, expected + 400, d, fmt).ptr) &&
+                        shortest(f, fmt) == std::string(expected, std::to_chars(expected, expected + 400, f, fmt).ptr);
+        }
+    }
+    test::assert_true(identical, "to_chars matches std::to_chars on random bit patterns");
+
     test::test_footer();
     return 0;
 }
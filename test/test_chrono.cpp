@@ -7,6 +7,9 @@
  */
 
 import std_module.chrono;
+import std_module.stdexcept;
+import std_module.string_view;
+import std_module.system_error;
 import std_module.test_framework;
 
 int main() {
@@ -140,6 +143,202 @@ int main() {
     [[maybe_unused]] constexpr bool trait = treat_as_floating_point_v<seconds>;
     test::success("duration traits accessible");
 
+    test::section("Testing std_module extensions");
+
+    using std_module::tsc_clock;
+    static_assert(tsc_clock::is_steady && tsc_clock::duration(1s).count() == 1'000'000'000);
+    auto previous = tsc_clock::now();
+    bool monotonic = true;
+    for (int i = 0; i < 100'000; ++i) {
+        auto t = tsc_clock::now();
+        monotonic = monotonic && t >= previous;
+        previous = t;
+    }
+    test::assert_true(monotonic, "tsc_clock::now is monotonic");
+
+    // Same epoch as steady_clock, and the same rate over 20 ms
+    auto tsc_start = tsc_clock::now();
+    auto steady_start = steady_clock::now();
+    test::assert_true(abs(tsc_clock::to_steady(tsc_start) - steady_start) < 1ms,
+                      "tsc_clock shares steady_clock's epoch");
+    while (steady_clock::now() - steady_start < 20ms) {
+    }
+    auto tsc_elapsed = tsc_clock::now() - tsc_start;
+    auto steady_elapsed = steady_clock::now() - steady_start;
+    test::assert_true(abs(tsc_elapsed - duration_cast<nanoseconds>(steady_elapsed)) < 200us,
+                      "tsc_clock keeps pace with steady_clock");
+
+    auto start_ticks = tsc_clock::ticks();
+    auto end_ticks = tsc_clock::ticks_ordered();
+    auto converted = tsc_clock::from_ticks(end_ticks) - tsc_clock::from_ticks(start_ticks);
+    auto direct = tsc_clock::to_duration(end_ticks - start_ticks);
+    // Each conversion rounds down, so the two paths can differ by 1 ns
+    test::assert_true(end_ticks >= start_ticks && abs(converted - direct) <= 1ns && converted >= 0ns,
+                      "tsc_clock ticks and conversions");
+    auto one_second = tsc_clock::to_duration(static_cast<unsigned long long>(tsc_clock::ticks_per_second()));
+    test::assert_true(abs(one_second - 1s) < 1ms, "tsc_clock::ticks_per_second");
+    test::assert_true(!tsc_clock::uses_counter() || tsc_clock::invariant_tsc(), "tsc_clock uses an invariant counter");
+
+    auto before = tsc_clock::now();
+    tsc_clock::recalibrate();
+    auto after = tsc_clock::now();
+    test::assert_true(after >= before && after - before < 10ms, "tsc_clock::recalibrate stays monotonic");
+    // Readings taken before a recalibration convert as they did before it
+    bool stable = true;
+    monotonic = true;
+    previous = tsc_clock::now();
+    for (int i = 0; i < 20; ++i) {
+        auto ticks = tsc_clock::ticks();
+        auto converted_before = tsc_clock::from_ticks(ticks);
+        tsc_clock::recalibrate();
+        stable = stable && tsc_clock::from_ticks(ticks) == converted_before;
+        auto t = tsc_clock::now();
+        monotonic = monotonic && converted_before >= previous && t >= converted_before;
+        previous = t;
+    }
+    test::assert_true(stable && monotonic, "tsc_clock conversions survive recalibrate");
+
+    using std_module::coarse_clock;
+    static_assert(coarse_clock::is_steady);
+    test::assert_true(!coarse_clock::running(), "coarse_clock starts on first use");
+    auto coarse_start = coarse_clock::now();
+    test::assert_true(coarse_clock::running() && coarse_clock::resolution() == 1ms, "coarse_clock ticker running");
+    // Trails steady_clock by at most a tick plus the ticker's wake-up latency (generous on a loaded machine)
+    auto lag = steady_clock::now() - coarse_clock::to_steady(coarse_start);
+    test::assert_true(lag >= 0ns && lag < 50ms, "coarse_clock shares steady_clock's epoch");
+    steady_start = steady_clock::now();
+    auto coarse_previous = coarse_start;
+    monotonic = true;
+    while (steady_clock::now() - steady_start < 20ms) {
+        auto t = coarse_clock::now();
+        monotonic = monotonic && t >= coarse_previous && coarse_clock::to_steady(t) <= steady_clock::now();
+        coarse_previous = t;
+    }
+    test::assert_true(monotonic, "coarse_clock::now is monotonic and never ahead");
+    test::assert_true(coarse_previous - coarse_start >= 5ms, "coarse_clock advances");
+
+    coarse_clock::set_resolution(100us);
+    test::assert_true(coarse_clock::resolution() == 100us, "coarse_clock::set_resolution");
+    coarse_clock::set_resolution(1ns);
+    test::assert_true(coarse_clock::resolution() == 10us, "coarse_clock resolution floor");
+    coarse_clock::set_resolution(1ms);
+    coarse_clock::stop();
+    test::assert_true(!coarse_clock::running(), "coarse_clock::stop");
+    test::assert_true(coarse_clock::now() >= coarse_previous && coarse_clock::running(), "coarse_clock restarts");
+    coarse_clock::stop();
+
+    using std_module::monotonic_coarse_clock;
+    auto kernel_coarse = monotonic_coarse_clock::now();
+    lag = steady_clock::now() - monotonic_coarse_clock::to_steady(kernel_coarse);
+    test::assert_true(monotonic_coarse_clock::resolution() > 0ns && lag >= 0ns &&
+                          lag <= monotonic_coarse_clock::resolution() + 50ms,
+                      "monotonic_coarse_clock");
+
+    using std_module::to_sys_days;
+    using std_module::to_year_month_day;
+    static_assert(to_year_month_day(sys_days{}) == 1970y / January / 1);
+    static_assert(to_sys_days(2000y / February / 29) == sys_days(days(11016)));
+    bool calendar_agrees = true;
+    for (int d = -800'000; d <= 800'000; d += 13) {
+        sys_days sd_d{days(d)};
+        calendar_agrees = calendar_agrees && to_year_month_day(sd_d) == year_month_day(sd_d) &&
+                          to_sys_days(year_month_day(sd_d)) == sd_d;
+    }
+    test::assert_true(calendar_agrees, "to_year_month_day / to_sys_days agree with year_month_day");
+    test::assert_true(to_sys_days(2023y / February / 30) == sys_days(2023y / March / 2), "to_sys_days day overflow");
+
+    using std_module::format_iso8601;
+    char buf[std_module::iso8601_buffer_size];
+    char* buf_end = buf + sizeof buf;
+    auto iso = [&](auto r) { return std::string_view(buf, r.ptr); };
+    auto stamp = sys_days{2024y / February / 29} + 13h + 5min + 7s + 123ms;
+    test::assert_true(iso(format_iso8601(buf, buf_end, stamp)) == "2024-02-29T13:05:07.123Z", "format_iso8601");
+    test::assert_true(iso(format_iso8601(buf, buf_end, stamp + 456789ns)) == "2024-02-29T13:05:07.123456789Z",
+                      "format_iso8601 nanoseconds");
+    test::assert_true(iso(format_iso8601(buf, buf_end, floor<seconds>(stamp))) == "2024-02-29T13:05:07Z",
+                      "format_iso8601 seconds");
+    test::assert_true(iso(format_iso8601(buf, buf_end, sys_seconds(-1s))) == "1969-12-31T23:59:59Z",
+                      "format_iso8601 before the epoch");
+    test::assert_true(iso(format_iso8601(buf, buf_end, stamp, -5h)) == "2024-02-29T08:05:07.123-05:00" &&
+                          iso(format_iso8601(buf, buf_end, stamp, 5h + 30min)) == "2024-02-29T18:35:07.123+05:30",
+                      "format_iso8601 with offset");
+    test::assert_true(iso(format_iso8601(buf, buf_end, sys_days{year(-1) / 1 / 1})) == "-0001-01-01T00:00:00Z" &&
+                          iso(format_iso8601(buf, buf_end, sys_days{year(12345) / 1 / 1})) == "12345-01-01T00:00:00Z",
+                      "format_iso8601 wide years");
+    auto too_small = format_iso8601(buf, buf + 10, stamp);
+    test::assert_true(too_small.ec == std::errc::value_too_large && too_small.ptr == buf + 10,
+                      "format_iso8601 buffer too small");
+
+    using std_module::parse_iso8601;
+    auto parse = [](std::string_view text, auto& out) {
+        return parse_iso8601(text.data(), text.data() + text.size(), out);
+    };
+    sys_time<milliseconds> parsed_ms;
+    std::string_view with_rest = "2024-02-29T08:05:07.123456-05:00 rest";
+    auto pr = parse(with_rest, parsed_ms);
+    test::assert_true(pr.ec == std::errc{} && parsed_ms == stamp && std::string_view(pr.ptr) == " rest",
+                      "parse_iso8601");
+    bool forms = parse("2024-02-29 13:05:07.123Z", parsed_ms).ec == std::errc{} && parsed_ms == stamp &&
+                 parse("2024-02-29t13:05:07,1239", parsed_ms).ec == std::errc{} && parsed_ms == stamp &&
+                 parse("2024-02-29T18:35:07.123+0530", parsed_ms).ec == std::errc{} && parsed_ms == stamp &&
+                 parse("2024-02-29T15:05:07.123+02", parsed_ms).ec == std::errc{} && parsed_ms == stamp;
+    test::assert_true(forms, "parse_iso8601 separators, fractions and offsets");
+    sys_time<nanoseconds> parsed_ns;
+    bool round_trip = true;
+    auto t_ns = sys_days{1900y / January / 1} + 1ns;
+    for (; t_ns < sys_days{2200y / January / 1}; t_ns += 7919h + 7s + 123456789ns) {
+        round_trip = round_trip && parse(iso(format_iso8601(buf, buf_end, t_ns)), parsed_ns).ec == std::errc{} &&
+                     parsed_ns == t_ns;
+    }
+    test::assert_true(round_trip, "parse_iso8601 round-trips format_iso8601");
+    std::string_view bad_inputs[] = {"2023-02-29T00:00:00Z", "2024-13-01T00:00:00Z", "2024-02-29T24:00:00Z",
+                                     "2024-02-29T13:05:07.Z", "2024-02-29T13:05:07+5", "2024-02-29X13:05:07Z",
+                                     "2024-02-29T13:05"};
+    bool rejects = true;
+    for (std::string_view bad : bad_inputs) {
+        auto r = parse(bad, parsed_ms);
+        rejects = rejects && r.ec == std::errc::invalid_argument && r.ptr == bad.data();
+    }
+    test::assert_true(rejects, "parse_iso8601 rejects malformed and invalid timestamps");
+    test::assert_true(parse("2300-01-01T00:00:00Z", parsed_ns).ec == std::errc::result_out_of_range &&
+                          parse("2300-01-01T00:00:00Z", parsed_ms).ec == std::errc{},
+                      "parse_iso8601 range of the duration");
+
+    // Needs the tzdb; skipped where it is unavailable. Only the lookup is
+    // guarded, so exceptions from zone_cache itself still fail the test.
+    const time_zone* new_york = nullptr;
+    try {
+        new_york = locate_zone("America/New_York");
+    } catch (const std::runtime_error&) {
+        test::success("zone_cache (tzdb unavailable)");
+    }
+    if (new_york) {
+        std_module::zone_cache cache("America/New_York");
+        bool agrees = true;
+        auto begin = sys_days{2020y / January / 1};
+        auto end = sys_days{2023y / January / 1};
+        for (sys_time<minutes> t = begin; t < end; t += 37min) {
+            const sys_info& cached = cache.info(t);
+            sys_info direct = new_york->get_info(t);
+            agrees = agrees && cached.offset == direct.offset && cached.abbrev == direct.abbrev &&
+                     cache.offset(t) == direct.offset;
+        }
+        for (sys_time<minutes> t = end; t > begin; t -= 53min) {
+            agrees = agrees && cache.offset(t) == new_york->get_info(t).offset;
+        }
+        test::assert_true(agrees, "zone_cache agrees with time_zone::get_info");
+        bool summer = cache.to_local(sys_days{2024y / July / 1} + 12h) == local_days{2024y / July / 1} + 8h;
+        bool winter = cache.to_local(sys_days{2024y / January / 1} + 12h) == local_days{2024y / January / 1} + 7h;
+        test::assert_true(summer && winter, "zone_cache::to_local");
+        std_module::zone_cache preloaded(new_york);
+        preloaded.preload(begin, end);
+        auto periods = preloaded.size();
+        for (sys_seconds t = begin; t < end; t += 1h) {
+            preloaded.offset(t);
+        }
+        test::assert_true(periods >= 6 && preloaded.size() == periods, "zone_cache::preload");
+    }
+
     test::test_footer();
     return 0;
 }
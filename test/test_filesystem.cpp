@@ -7,7 +7,14 @@
  */
 
 import std_module.filesystem;
+import std_module.algorithm;
+import std_module.fstream;
+import std_module.mutex;
+import std_module.string;
+import std_module.system_error;
+import std_module.vector;
 import std_module.test_framework;
+#include <cstddef>  // For size_t
 
 int main() {
     test::test_header("std_module.filesystem");
@@ -95,6 +102,164 @@ int main() {
     [[maybe_unused]] auto perm_opts = std::filesystem::perm_options::add;
     test::success("perms and perm_options accessible");
 
+    test::section("Testing std_module extensions");
+
+    namespace fs = std::filesystem;
+    auto tree = fs::temp_directory_path() / "std_module_walk_test";
+    fs::remove_all(tree);
+    fs::create_directories(tree / "a" / "b" / "c");
+    fs::create_directories(tree / "skip");
+    fs::create_directories(tree / "empty");
+    const char* files[] = {"top.txt", "a/x.txt", "a/b/y.txt", "a/b/c/z.txt", "skip/inner.txt"};
+    for (const char* file : files) {
+        std::ofstream(tree / file) << "data";
+    }
+    for (int i = 0; i < 300; ++i) {
+        std::ofstream(tree / "a" / ("file_with_a_longish_name_" + std::to_string(i)));
+    }
+    std::error_code link_error;
+    fs::create_directory_symlink(tree / "a", tree / "link", link_error);
+
+    std::vector<std::string> expected;
+    std::size_t expected_dirs = 1;
+    for (const auto& e : fs::recursive_directory_iterator(tree)) {
+        expected.push_back(fs::relative(e.path(), tree).generic_string());
+        expected_dirs += e.is_directory() && !e.is_symlink();
+    }
+    std::sort(expected.begin(), expected.end());
+
+    auto walk = [&](std_module::walk_options options, auto filter, auto prune,
+                    std_module::walk_stats* stats = nullptr) {
+        std::mutex mutex;
+        std::vector<std::string> seen;
+        auto s = std_module::parallel_walk(
+            tree,
+            [&](const std_module::walk_batch& batch) {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& e : batch.entries) {
+                    seen.push_back(fs::relative(batch.directory / e.name, tree).generic_string());
+                }
+            },
+            options, filter, prune);
+        if (stats) {
+            *stats = s;
+        }
+        std::sort(seen.begin(), seen.end());
+        return seen;
+    };
+    auto all = [](const fs::path&, const std_module::walk_entry&) { return true; };
+    auto none = [](const fs::path&, const std_module::walk_entry&) { return false; };
+
+    unsigned thread_counts[] = {1, 4};
+    for (unsigned threads : thread_counts) {
+        std_module::walk_stats stats;
+        auto seen = walk({threads}, all, none, &stats);
+        test::assert_true(seen == expected && stats.entries == expected.size() && stats.directories == expected_dirs &&
+                              stats.errors == 0,
+                          "parallel_walk visits what recursive_directory_iterator does");
+    }
+
+    bool types_right = true;
+    std_module::parallel_walk(tree, [&](const std_module::walk_batch& batch) {
+        for (const auto& e : batch.entries) {
+            types_right = types_right && e.type == fs::symlink_status(batch.directory / e.name).type() && e.inode != 0;
+        }
+    }, {1});
+    test::assert_true(types_right, "parallel_walk entry types, symlinks not followed");
+
+    auto pruned = walk({4}, all, [](const fs::path&, const std_module::walk_entry& e) { return e.name == "skip"; });
+    test::assert_true(std::count(pruned.begin(), pruned.end(), "skip") == 1 &&
+                          std::count(pruned.begin(), pruned.end(), "skip/inner.txt") == 0 &&
+                          pruned.size() == expected.size() - 1,
+                      "parallel_walk prune");
+    auto only_txt = walk({4}, [](const fs::path&, const std_module::walk_entry& e) { return e.name.ends_with(".txt"); },
+                         none);
+    test::assert_true(only_txt == std::vector<std::string>{"a/b/c/z.txt", "a/b/y.txt", "a/x.txt", "skip/inner.txt",
+                                                           "top.txt"},
+                      "parallel_walk filter");
+    std_module::walk_options shallow;
+    shallow.max_depth = 0;
+    test::assert_true(walk(shallow, all, none).size() == (link_error ? 4u : 5u), "parallel_walk max_depth");
+
+    std_module::walk_options small_reads;
+    small_reads.threads = 2;
+    small_reads.read_buffer = 4096;
+    std::mutex batches_mutex;
+    std::size_t batches_of_a = 0;
+    std_module::parallel_walk(tree, [&](const std_module::walk_batch& batch) {
+        std::lock_guard<std::mutex> lock(batches_mutex);
+        batches_of_a += batch.directory == tree / "a";
+    }, small_reads);
+    test::assert_true(batches_of_a >= 2, "parallel_walk batches large directories");
+
+    bool threw = false;
+    try {
+        std_module::parallel_walk(tree / "missing", [](const std_module::walk_batch&) {});
+    } catch (const fs::filesystem_error&) {
+        threw = true;
+    }
+    test::assert_true(threw, "parallel_walk throws for a missing root");
+    threw = false;
+    try {
+        std_module::parallel_walk(tree, [](const std_module::walk_batch&) { throw 42; }, {4});
+    } catch (int) {
+        threw = true;
+    }
+    test::assert_true(threw, "parallel_walk rethrows callback exceptions");
+
+    auto file = tree / "a" / "x.txt";
+    auto info = std_module::query_file_info(file);
+    auto file_status = fs::status(file);
+    test::assert_true(info.has(std_module::file_info_fields::type | std_module::file_info_fields::size |
+                               std_module::file_info_fields::last_write_time |
+                               std_module::file_info_fields::hard_link_count) &&
+                          info.type == fs::file_type::regular && info.permissions == file_status.permissions() &&
+                          info.size == fs::file_size(file) && info.last_write_time == fs::last_write_time(file) &&
+                          info.hard_link_count == fs::hard_link_count(file),
+                      "query_file_info matches std::filesystem");
+    auto partial = std_module::query_file_info(file, std_module::file_info_fields::size);
+    test::assert_true(partial.fields == std_module::file_info_fields::size && partial.size == 4,
+                      "query_file_info fetches only the fields asked for");
+    auto missing = std_module::query_file_info(tree / "missing");
+    test::assert_true(missing.type == fs::file_type::not_found && missing.fields == std_module::file_info_fields::type,
+                      "query_file_info of a missing path");
+    if (!link_error) {
+        test::assert_true(std_module::query_file_info(tree / "link").type == fs::file_type::directory &&
+                              std_module::query_symlink_info(tree / "link").type == fs::file_type::symlink,
+                          "query_symlink_info does not follow symlinks");
+    }
+    threw = false;
+    try {
+        std_module::query_file_info(tree / "top.txt" / "under_a_file" / "deeper");
+        std::error_code ec;
+        std_module::query_file_info(fs::path(std::string(5000, 'x')), std_module::file_info_fields::all, ec);
+        threw = !!ec;
+    } catch (const fs::filesystem_error&) {
+    }
+    test::assert_true(threw, "query_file_info reports failures");
+
+    std::vector<fs::path> paths;
+    for (const auto& e : fs::recursive_directory_iterator(tree)) {
+        paths.push_back(e.path());
+    }
+    paths.push_back(tree / "missing");
+    paths.push_back(fs::path(std::string(5000, 'x')));
+    std_module::file_info_options batch_options;
+    batch_options.threads = 4;
+    batch_options.follow_symlinks = false;
+    auto infos = std_module::query_file_info(paths, batch_options);
+    bool batch_right = infos.size() == paths.size();
+    for (std::size_t i = 0; batch_right && i + 2 < paths.size(); ++i) {
+        auto single = std_module::query_symlink_info(paths[i]);
+        batch_right = !infos[i].error && infos[i].fields == single.fields && infos[i].type == single.type &&
+                      infos[i].size == single.size && infos[i].inode == single.inode;
+    }
+    test::assert_true(batch_right && infos[paths.size() - 2].type == fs::file_type::not_found &&
+                          infos.back().error && infos.back().fields == std_module::file_info_fields::none,
+                      "batch query_file_info");
+
+    fs::remove_all(tree);
+
     test::test_footer();
     return 0;
 }
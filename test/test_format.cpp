@@ -7,7 +7,25 @@
  */
 
 import std_module.format;
+import std_module.iterator;
+import std_module.memory_resource;
+import std_module.span;
+import std_module.string;
+import std_module.string_view;
 import std_module.test_framework;
+#include <cstddef>  // For std::ptrdiff_t
+#include <utility>  // For std::move
+
+// Minimal user-defined sink (stands in for a socket or mmap'd buffer)
+struct chunk_counter {
+    std::string out;
+    int chunks = 0;
+
+    void append(std::string_view chunk) {
+        out += chunk;
+        ++chunks;
+    }
+};
 
 // Custom type for testing custom formatter
 struct Point {
@@ -89,6 +107,86 @@ int main() {
     [[maybe_unused]] std::format_context* fmt_ctx_ptr = nullptr;
     test::success("format context types accessible");
 
+    test::section("Testing std_module extensions");
+
+    // Compiled format strings produce exactly what std::format does
+    std::string host = "db-01";
+    int status = 200;
+    double ms = 12.345;
+    test::assert_true(std_module::format<"{}: {} ({:.2f} ms)">(host, status, ms) ==
+                          std::format("{}: {} ({:.2f} ms)", host, status, ms),
+                      "compiled format matches std::format");
+    test::assert_true(std_module::format<"{} {} {} {}">(true, 'x', 1.5, "str") ==
+                          std::format("{} {} {} {}", true, 'x', 1.5, "str"),
+                      "compiled format fast paths");
+    test::assert_true(std_module::format<"{{{}}}">(7) == "{7}", "compiled format escapes");
+    test::assert_true(std_module::format<"{1}-{0}">(1, 2) == "2-1", "compiled format manual indexing");
+    std::string long_arg(1000, 'a');
+    test::assert_equal(std_module::format<"[{}]">(long_arg).size(), static_cast<size_t>(1002),
+                       "compiled format beyond the stack buffer");
+
+    // Output into a caller-provided buffer, truncating like format_to_n
+    char buf[8];
+    auto truncated = std_module::format_to<"{}-{}">(std::span<char>(buf), 12345, 67890);
+    test::assert_equal(truncated.size, static_cast<std::ptrdiff_t>(11), "format_to span reports full size");
+    test::assert_true(truncated.out == buf + 8 && buf[7] == '7', "format_to span truncates");
+
+    std::string appended;
+    std_module::format_to<"{} {:>4}">(std::back_inserter(appended), -7, 2.5f);
+    test::assert_true(appended == "-7  2.5", "format_to output iterator");
+    test::assert_equal(std_module::formatted_size<"{:>10}{}">(1, long_arg), static_cast<size_t>(1010),
+                       "compiled formatted_size");
+
+    // Runtime format strings fall back to std::vformat
+    std::string_view runtime_fmt = "{}/{}";
+    test::assert_true(std_module::format(runtime_fmt, 1, "x") == "1/x", "runtime format fallback");
+    // Nested width fields are rejected in compiled formats; the runtime form takes them
+    test::assert_true(std_module::format(std::string_view("[{:>{}}]"), 7, 3) == "[  7]", "runtime nested width");
+    auto runtime_n = std_module::format_to(std::span<char>(buf), runtime_fmt, 123456, 7);
+    test::assert_equal(runtime_n.size, static_cast<std::ptrdiff_t>(8), "runtime format_to span");
+
+    // memory_buffer: inline storage first, then growth through the resource
+    std_module::memory_buffer mb;
+    test::assert_equal(mb.capacity(), static_cast<size_t>(500), "memory_buffer inline capacity");
+    std_module::format_to<"{} [{}] {}">(mb, 1700000000, "INFO", host);
+    test::assert_true(mb.view() == "1700000000 [INFO] db-01", "format_to memory_buffer");
+    std_module::format_to<" {:>5}">(mb, status);
+    test::assert_true(mb.str() == "1700000000 [INFO] db-01   200", "format_to memory_buffer appends");
+
+    char arena[4096];
+    std::pmr::monotonic_buffer_resource pool(arena, sizeof arena, std::pmr::null_memory_resource());
+    std_module::basic_memory_buffer<char, 16> small(&pool);
+    std_module::format_to<"{}{}">(small, long_arg, long_arg.size());
+    test::assert_equal(small.size(), static_cast<size_t>(1004), "memory_buffer grows past inline storage");
+    test::assert_true(small.data() >= arena && small.data() < arena + sizeof arena,
+                      "memory_buffer grows through its memory_resource");
+
+    std_module::basic_memory_buffer<char, 16> moved(std::move(small));
+    test::assert_true(moved.size() == 1004 && small.empty(), "memory_buffer move");
+    small.append(std::string_view("inline"));
+    moved = std::move(small);
+    test::assert_true(moved.view() == "inline", "memory_buffer move assignment");
+    moved.clear();
+    std::format_to(std::back_inserter(moved), "{}", 42);
+    test::assert_true(moved.view() == "42", "memory_buffer with back_inserter");
+
+    // Any type with append(string_view) is a sink
+    static_assert(std_module::format_sink<std::string>);
+    static_assert(!std_module::format_sink<std::span<char>>);
+    chunk_counter sink;
+    std_module::format_to<"{} took {:.1f} ms">(sink, "query", ms);
+    test::assert_true(sink.out == "query took 12.3 ms" && sink.chunks == 4, "format_to custom sink");
+    chunk_counter wide;
+    std_module::format_to<"[{:>300}]">(wide, 7);
+    test::assert_true(wide.out.size() == 302 && wide.out[300] == '7' && wide.chunks == 4,
+                      "format_to custom sink, field longer than the scratch buffer");
+    moved.clear();
+    std_module::format_to<"{:>600}">(moved, 7);
+    test::assert_true(moved.size() == 600 && moved.view().back() == '7', "format_to memory_buffer, long field");
+    std::string to_string_sink = "> ";
+    std_module::format_to(to_string_sink, runtime_fmt, long_arg, 1);
+    test::assert_equal(to_string_sink.size(), static_cast<size_t>(1004), "runtime format_to sink");
+
     test::test_footer();
     return 0;
 }
@@ -9,6 +9,11 @@
 import std_module.forward_list;
 import std_module.test_framework;
 
+struct node : std_module::slist_hook<> {
+    int value = 0;
+    explicit node(int v) : value(v) {}
+};
+
 int main() {
     test::test_header("std_module.forward_list");
 
@@ -133,6 +138,29 @@ int main() {
     removed = std::erase_if(list17, [](int n) { return n % 2 == 0; });
     test::assert_true(removed > 0, "std::erase_if");
 
+    test::section("Testing std_module extensions");
+
+    node n1(1), n2(2), n3(3);
+    std_module::intrusive_slist<node> sl;
+    sl.push_front(n1);
+    sl.push_front(n2);
+    sl.insert_after(sl.begin(), n3);
+    test::assert_equal(sl.size(), static_cast<size_t>(3), "intrusive_slist push_front/insert_after");
+    test::assert_equal(sl.front().value, 2, "intrusive_slist front");
+    test::assert_true(n1.is_linked(), "slist_hook is_linked (last element)");
+
+    test::assert_true(sl.remove(n3), "intrusive_slist remove");
+    int node_sum = 0;
+    for (const node& n : sl) {
+        node_sum += n.value;
+    }
+    test::assert_equal(node_sum, 3, "intrusive_slist iteration");
+
+    std_module::intrusive_slist<node> moved(static_cast<std_module::intrusive_slist<node>&&>(sl));
+    test::assert_true(sl.empty() && moved.size() == 2, "intrusive_slist move");
+    moved.pop_front();
+    test::assert_false(n2.is_linked(), "intrusive_slist pop_front unlinks");
+
     test::test_footer();
     return 0;
 }
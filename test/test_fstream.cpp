@@ -7,7 +7,15 @@
  */
 
 import std_module.fstream;
+import std_module.filesystem;
+import std_module.istream;
+import std_module.string;
+import std_module.string_view;
+import std_module.system_error;
 import std_module.test_framework;
+#include <cstddef>  // For std::byte
+#include <ios>      // For std::streamsize
+#include <utility>  // For std::move
 
 int main() {
     test::test_header("std_module.fstream");
@@ -145,6 +153,126 @@ int main() {
     }
     test::success("default constructor and open method accessible");
 
+    test::section("Testing std_module extensions");
+
+    {
+        const char* map_file = "test_mapped.txt";
+        {
+            std::ofstream out(map_file);
+            out << "line one\nline two\n";
+        }
+        std_module::mapped_file file(map_file);
+        test::assert_true(file.is_open() && file.size() == 18 && file.chars() == "line one\nline two\n" &&
+                              file.bytes().size() == 18 && file.writable_bytes().empty(),
+                          "mapped_file read_only view");
+        std_module::mapped_file moved = std::move(file);
+        test::assert_true(!file.is_open() && moved.chars().starts_with("line"), "mapped_file move");
+
+        std_module::mapped_streambuf buf(map_file);
+        std::istream in(&buf);
+        std::string line;
+        std::getline(in, line);
+        test::assert_true(line == "line one" && in.tellg() == 9, "mapped_streambuf getline and tellg");
+        in.seekg(14);
+        in >> line;
+        test::assert_true(line == "two" && !(in >> line) && in.eof(), "mapped_streambuf seekg and end of file");
+        in.clear();
+        in.seekg(-4, std::ios_base::end);
+        char tail[4];
+        in.read(tail, 4);
+        test::assert_true(in.gcount() == 4 && std::string_view(tail, 4) == "two\n", "mapped_streambuf read");
+
+        std_module::mapped_streambuf view(moved.bytes());
+        std::istream view_in(&view);
+        view_in >> line;
+        test::assert_true(line == "line" && !view.file().is_open(), "mapped_streambuf over viewed bytes");
+
+        const char* rw_file = "test_mapped_rw.bin";
+        std::filesystem::remove(rw_file);
+        {
+            std_module::mapped_file rw(rw_file, {.mode = std_module::map_mode::read_write, .size = 8192});
+            auto bytes = rw.writable_bytes();
+            test::assert_true(bytes.size() == 8192, "mapped_file read_write creates and sizes the file");
+            bytes[0] = std::byte{'A'};
+            bytes[8191] = std::byte{'Z'};
+            rw.advise(std_module::map_advice::sequential, 100, 5000);
+            rw.flush();
+        }
+        std::ifstream rw_in(rw_file);
+        char first = 0;
+        rw_in.get(first);
+        rw_in.seekg(8191);
+        char last = 0;
+        rw_in.get(last);
+        test::assert_true(first == 'A' && last == 'Z', "mapped_file read_write writes reach the file");
+
+        std::ofstream(std::string("test_mapped_empty.bin"));
+        std_module::mapped_file empty("test_mapped_empty.bin");
+        test::assert_true(empty.is_open() && empty.empty(), "mapped_file of an empty file");
+
+        bool threw = false;
+        try {
+            std_module::mapped_file missing("nonexistent_file_xyz.txt");
+        } catch (const std::filesystem::filesystem_error&) {
+            threw = true;
+        }
+        std::error_code ec;
+        std_module::mapped_file missing("nonexistent_file_xyz.txt", {}, ec);
+        test::assert_true(threw && ec && !missing.is_open(), "mapped_file reports missing files");
+
+        const char* fast_file = "test_fast.bin";
+        {
+            std_module::fast_ofstream out(fast_file, std::ios_base::out, {.buffer_size = 4096});
+            test::assert_true(out.is_open() && !out.rdbuf()->direct(), "fast_ofstream open");
+            std::string record(1000, 'r');
+            for (int i = 0; i < 10; ++i) {
+                out.write(record.data(), static_cast<std::streamsize>(record.size()));
+            }
+            out.put('!');
+            std::string big(20000, 'b');
+            out.write(big.data(), static_cast<std::streamsize>(big.size()));
+            test::assert_true(out.tellp() == 30001, "fast_ofstream tellp");
+            out.seekp(5);
+            out.write("XY", 2);
+            out << 42;
+            test::assert_true(!out.write_at(0, "HDR", 3), "fast_ofstream write_at");
+            out.close();
+            test::assert_true(!out.fail(), "fast_ofstream close");
+        }
+        {
+            std_module::fast_ofstream out(fast_file, std::ios_base::app);
+            out.write("END", 3);
+        }
+        std::string written(30004, '\0');
+        std::ifstream fast_in(fast_file);
+        fast_in.read(written.data(), 30004);
+        test::assert_true(fast_in.gcount() == 30004 && fast_in.get() == std::ifstream::traits_type::eof() &&
+                              written.starts_with("HDRrrXY42rr") && written[9999] == 'r' && written[10000] == '!' &&
+                              written[10001] == 'b' && written.ends_with("bbEND"),
+                          "fast_ofstream writes, seeks and appends");
+
+        const char* direct_file = "test_fast_direct.bin";
+        {
+            std_module::fast_ofstream out(direct_file, std::ios_base::out, {.buffer_size = 8192, .direct = true});
+            std::string chunk(5000, 'd');
+            out.write(chunk.data(), 5000);
+            out.flush();
+            chunk.assign(7000, 'e');
+            out.write(chunk.data(), 7000);
+            out.flush();
+            out.put('!');
+        }
+        std::string direct_written(12002, '\0');
+        std::ifstream direct_in(direct_file);
+        direct_in.read(direct_written.data(), 12002);
+        test::assert_true(direct_in.gcount() == 12001 && direct_written[4999] == 'd' && direct_written[5000] == 'e' &&
+                              direct_written[11999] == 'e' && direct_written[12000] == '!',
+                          "fast_ofstream with direct writes");
+
+        std_module::fast_ofstream bad("nonexistent_dir_xyz/file.bin");
+        test::assert_true(bad.fail() && !bad.is_open() && bad.rdbuf()->error(), "fast_ofstream open failure");
+    }
+
     test::test_footer();
     return 0;
 }
@@ -9,6 +9,13 @@
 import std_module.list;
 import std_module.test_framework;
 
+// Element that can sit in two intrusive lists at once
+struct lru_tag;
+struct entry : std_module::list_hook<>, std_module::list_hook<lru_tag> {
+    int key = 0;
+    explicit entry(int k) : key(k) {}
+};
+
 int main() {
     test::test_header("std_module.list");
 
@@ -87,6 +94,36 @@ int main() {
     count = std::erase_if(lst8, [](int n) { return n % 2 == 0; });
     test::assert_true(count > 0, "std::erase_if");
 
+    test::section("Testing std_module extensions");
+
+    entry e1(1), e2(2), e3(3);
+    std_module::intrusive_list<entry> il;
+    il.push_back(e1);
+    il.push_back(e2);
+    il.push_front(e3);
+    test::assert_equal(il.size(), static_cast<size_t>(3), "intrusive_list push");
+    test::assert_equal(il.front().key, 3, "intrusive_list front");
+    test::assert_equal(il.back().key, 2, "intrusive_list back");
+
+    il.erase(e1);
+    test::assert_false(e1.std_module::list_hook<>::is_linked(), "intrusive_list erase by element");
+    int keys = 0;
+    for (const entry& e : il) {
+        keys = keys * 10 + e.key;
+    }
+    test::assert_equal(keys, 32, "intrusive_list iteration");
+
+    // Same elements in a second list through a different hook
+    std_module::intrusive_list<entry, lru_tag> lru;
+    lru.push_back(e1);
+    lru.push_back(e2);
+    lru.splice(lru.begin(), lru, lru.iterator_to(e2));
+    test::assert_equal(lru.front().key, 2, "intrusive_list splice (move to front)");
+    test::assert_equal(il.size(), static_cast<size_t>(2), "independent hooks");
+
+    il.clear();
+    test::assert_false(e2.std_module::list_hook<>::is_linked(), "intrusive_list clear unlinks");
+
     test::test_footer();
     return 0;
 }
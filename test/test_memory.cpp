@@ -7,7 +7,9 @@
  */
 
 import std_module.memory;
+import std_module.list;
 import std_module.test_framework;
+#include <utility>  // For std::move
 
 int main() {
     test::test_header("std_module.memory");
@@ -131,6 +133,56 @@ int main() {
     bool same_owner = !cmp(sp5, sp6) && !cmp(sp6, sp5);
     test::assert_true(same_owner, "owner_less");
 
+    test::section("Testing std_module extensions");
+
+    // node_pool_allocator: single objects come from shared slabs
+    std_module::node_pool_allocator<int, 64> pool_alloc;
+    int* a = pool_alloc.allocate(1);
+    int* b = pool_alloc.allocate(1);
+    *a = 1;
+    *b = 2;
+    test::assert_true(b != a && *a + *b == 3, "node_pool_allocator allocate");
+    pool_alloc.deallocate(a, 1);
+    int* c = pool_alloc.allocate(1);
+    test::assert_true(c == a, "node_pool_allocator reuses freed blocks");
+
+    // Rebound copies share the pools and compare equal; fresh allocators do not
+    std_module::node_pool_allocator<double, 64> rebound(pool_alloc);
+    test::assert_true(rebound == pool_alloc, "node_pool_allocator rebind shares pools");
+    test::assert_false(pool_alloc == std_module::node_pool_allocator<int, 64>(), "distinct pools");
+
+    // Multi-object requests fall through to std::allocator
+    int* array = pool_alloc.allocate(16);
+    array[15] = 7;
+    pool_alloc.deallocate(array, 16);
+    pool_alloc.deallocate(b, 1);
+    pool_alloc.deallocate(c, 1);
+    test::success("node_pool_allocator array fallback");
+
+    // Works as a container allocator through allocator_traits
+    using pool_traits = std::allocator_traits<std_module::node_pool_allocator<int>>;
+    std_module::node_pool_allocator<int> node_alloc;
+    int* node = pool_traits::allocate(node_alloc, 1);
+    pool_traits::construct(node_alloc, node, 42);
+    test::assert_equal(*node, 42, "node_pool_allocator via allocator_traits");
+    pool_traits::destroy(node_alloc, node);
+    pool_traits::deallocate(node_alloc, node, 1);
+
+    // Moved-from allocators and containers stay usable
+    std_module::node_pool_allocator<int> moved_alloc = std::move(node_alloc);
+    test::assert_true(moved_alloc == node_alloc, "moved-from node_pool_allocator compares equal");
+    int* after_move = node_alloc.allocate(1);
+    node_alloc.deallocate(after_move, 1);
+    std::list<int, std_module::node_pool_allocator<int>> moved_from;
+    for (int i = 1; i <= 3; ++i) {
+        moved_from.push_back(i);
+    }
+    std::list<int, std_module::node_pool_allocator<int>> moved_to = std::move(moved_from);
+    moved_from.push_back(4);
+    moved_from.push_back(5);
+    test::assert_true(moved_to.size() == 3 && moved_to.back() == 3 && moved_from.size() == 2 &&
+                          moved_from.front() == 4,
+                      "container using node_pool_allocator reused after move");
     test::test_footer();
     return 0;
 }
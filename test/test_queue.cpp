@@ -7,9 +7,15 @@
  */
 
 import std_module.queue;
+import std_module.thread;
 import std_module.test_framework;
 #include <cstddef>  // For size_t
 
+// Min-ordering comparator (avoids importing std_module.functional)
+struct greater_than {
+    bool operator()(unsigned a, unsigned b) const { return a > b; }
+};
+
 int main() {
     test::test_header("std_module.queue");
 
@@ -50,6 +56,126 @@ int main() {
     pq.emplace(40);
     test::success("priority_queue emplace");
 
+    test::section("Testing std_module extensions");
+
+    // d-ary heap: same interface and ordering as priority_queue
+    std_module::dary_heap<int> dh;
+    dh.push(30);
+    dh.push(10);
+    dh.emplace(50);
+    test::assert_equal(dh.top(), 50, "dary_heap top");
+    dh.pop();
+    test::assert_equal(dh.top(), 30, "dary_heap pop");
+    test::assert_equal(dh.size(), static_cast<size_t>(2), "dary_heap size");
+
+    std_module::dary_heap<int, 8> wide;
+    for (int i = 0; i < 100; ++i) {
+        wide.push((i * 37) % 100);
+    }
+    test::assert_equal(wide.top(), 99, "dary_heap custom arity");
+
+    // Mutable d-ary heap: decrease-key through handles
+    std_module::mutable_dary_heap<unsigned, 4, greater_than> mh;
+    mh.push(30u);
+    auto h = mh.push(40u);
+    mh.emplace(20u);
+    test::assert_equal(mh.top(), 20u, "mutable_dary_heap top");
+    mh.update(h, 10u);
+    test::assert_equal(mh.top_handle(), h, "mutable_dary_heap update");
+    mh.pop();
+    test::assert_false(mh.contains(h), "mutable_dary_heap handle released on pop");
+    test::assert_equal(mh.top(), 20u, "mutable_dary_heap pop");
+
+    // Indexed priority queue with decrease-key by caller index
+    std_module::indexed_priority_queue<unsigned, 4, greater_than> ipq;
+    ipq.push(0, 40u);
+    ipq.push(3, 20u);
+    ipq.push_or_update(7, 30u);
+    ipq.update(0, 5u);
+    test::assert_equal(ipq.top_index(), static_cast<size_t>(0), "indexed_priority_queue update");
+    ipq.erase(0);
+    test::assert_false(ipq.contains(0), "indexed_priority_queue erase");
+    test::assert_equal(ipq.top(), 20u, "indexed_priority_queue top");
+
+    // Monotone radix heap
+    std_module::radix_heap<unsigned> rh;
+    rh.push(8u);
+    rh.push(3u);
+    rh.push(5u);
+    test::assert_equal(rh.top(), 3u, "radix_heap top");
+    rh.pop();
+    rh.push(4u);
+    test::assert_equal(rh.top(), 4u, "radix_heap monotone push");
+
+    std_module::radix_heap<unsigned long long, int> timers;
+    timers.emplace(100ull, 1);
+    timers.emplace(50ull, 2);
+    test::assert_equal(timers.top().second, 2, "radix_heap payload");
+    test::assert_equal(timers.top_key(), 50ull, "radix_heap top_key");
+
+    test::section("Testing concurrent queues");
+
+    // SPSC ring: try/bulk operations, capacity rounded to a power of two
+    std_module::spsc_queue<int> spsc(3);
+    test::assert_equal(spsc.capacity(), static_cast<size_t>(4), "spsc_queue capacity");
+    test::assert_true(spsc.try_push(1), "spsc_queue try_push");
+    int batch[] = {2, 3, 4, 5};
+    test::assert_equal(spsc.try_push_bulk(batch, 4), static_cast<size_t>(3), "spsc_queue try_push_bulk");
+    test::assert_false(spsc.try_push(6), "spsc_queue full");
+    int first = 0;
+    test::assert_true(spsc.try_pop(first) && first == 1, "spsc_queue try_pop");
+    int out[4] = {};
+    test::assert_equal(spsc.try_pop_bulk(out, 4), static_cast<size_t>(3), "spsc_queue try_pop_bulk");
+    test::assert_equal(out[2], 4, "spsc_queue FIFO order");
+    test::assert_false(spsc.try_pop().has_value(), "spsc_queue empty");
+
+    // MPMC ring: try/bulk operations
+    std_module::mpmc_queue<int> mpmc(4);
+    test::assert_true(mpmc.try_push(7), "mpmc_queue try_push");
+    test::assert_equal(mpmc.try_push_bulk(batch, 4), static_cast<size_t>(3), "mpmc_queue try_push_bulk");
+    test::assert_false(mpmc.try_push(8), "mpmc_queue full");
+    test::assert_equal(*mpmc.try_pop(), 7, "mpmc_queue try_pop");
+    test::assert_equal(mpmc.try_pop_bulk(out, 4), static_cast<size_t>(3), "mpmc_queue try_pop_bulk");
+    test::assert_true(mpmc.empty(), "mpmc_queue empty");
+
+    // Blocking operations across threads
+    const int items = 10000;
+    long long spsc_sum = 0;
+    std::thread spsc_consumer([&] {
+        for (int i = 0; i < items; ++i) {
+            spsc_sum += spsc.pop();
+        }
+    });
+    for (int i = 1; i <= items; ++i) {
+        spsc.push(i);
+    }
+    spsc_consumer.join();
+    test::assert_equal(spsc_sum, 1LL * items * (items + 1) / 2, "spsc_queue blocking push/pop");
+
+    long long mpmc_sum[2] = {0, 0};
+    std::thread consumers[2];
+    for (int c = 0; c < 2; ++c) {
+        consumers[c] = std::thread([&, c] {
+            for (int i = 0; i < items / 2; ++i) {
+                mpmc_sum[c] += mpmc.pop();
+            }
+        });
+    }
+    std::thread producer([&] {
+        for (int i = 1; i <= items / 2; ++i) {
+            mpmc.push(i);
+        }
+    });
+    for (int i = items / 2 + 1; i <= items; i += 2) {
+        int pair[] = {i, i + 1};
+        mpmc.push_bulk(pair, 2);
+    }
+    producer.join();
+    consumers[0].join();
+    consumers[1].join();
+    test::assert_equal(mpmc_sum[0] + mpmc_sum[1], 1LL * items * (items + 1) / 2,
+                       "mpmc_queue blocking push/pop across threads");
+
     test::test_footer();
     return 0;
 }
@@ -7,9 +7,113 @@
  */
 
 import std_module.random;
+import std_module.algorithm;
+import std_module.iterator;
+import std_module.limits;
+import std_module.span;
+import std_module.thread;
+import std_module.vector;
 import std_module.test_framework;
+#include <cstdint>
+#include <cmath>    // For erfc, exp, sqrt
 #include <cstddef>  // For size_t
 
+// Statistical smoke test in the spirit of TestU01's SmallCrush: every
+// output bit is set about half the time, bytes are uniform (chi-square
+// over 256 cells), and the top nibbles of consecutive draws are
+// independent (chi-square over 16 x 16 cells). Bounds are about six
+// standard deviations, so a passing engine never trips them.
+template <class Engine>
+bool passes_smoke_test(Engine engine) {
+    constexpr int bits = sizeof(typename Engine::result_type) * 8;
+    const unsigned long long draws = 1ull << 20;
+    unsigned long long ones[bits] = {};
+    unsigned long long bytes[256] = {};
+    unsigned long long pairs[256] = {};
+    unsigned previous = 0;
+    for (unsigned long long i = 0; i < draws; ++i) {
+        unsigned long long v = engine();
+        for (int b = 0; b < bits; ++b) {
+            ones[b] += (v >> b) & 1;
+        }
+        for (int b = 0; b < bits; b += 8) {
+            ++bytes[(v >> b) & 0xFF];
+        }
+        unsigned top = static_cast<unsigned>(v >> (bits - 4));
+        ++pairs[previous * 16 + top];
+        previous = top;
+    }
+    for (unsigned long long count : ones) {
+        if (count < draws / 2 - 3072 || count > draws / 2 + 3072) {
+            return false;
+        }
+    }
+    auto chi_square = [](const unsigned long long (&cells)[256]) {
+        unsigned long long total = 0;
+        for (unsigned long long c : cells) {
+            total += c;
+        }
+        double expected = static_cast<double>(total) / 256;
+        double sum = 0;
+        for (unsigned long long c : cells) {
+            sum += (static_cast<double>(c) - expected) * (static_cast<double>(c) - expected) / expected;
+        }
+        return sum;
+    };
+    // 255 degrees of freedom: mean 255, standard deviation 22.6
+    return chi_square(bytes) < 400 && chi_square(pairs) < 400;
+}
+
+// Kolmogorov-Smirnov statistic of the sample against a continuous CDF,
+// scaled by sqrt(n): above 1.95 has probability under 0.1%
+template <class Cdf>
+double kolmogorov_smirnov(std::vector<double> sample, Cdf cdf) {
+    std::sort(sample.begin(), sample.end());
+    double n = static_cast<double>(sample.size());
+    double d = 0;
+    for (std::size_t i = 0; i < sample.size(); ++i) {
+        double f = cdf(sample[i]);
+        d = std::max({d, static_cast<double>(i + 1) / n - f, f - static_cast<double>(i) / n});
+    }
+    return d * std::sqrt(n);
+}
+
+// Replays fixed 64-bit words, to steer rejection sampling
+struct scripted_engine {
+    using result_type = unsigned long long;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ull; }
+    const unsigned long long* words;
+    result_type operator()() { return *words++; }
+};
+
+// Runs a simulation of items work items, each summing draws_per_item
+// draws, on threads threads through a stream_partition
+template <class Engine>
+std::vector<unsigned long long> simulate(const Engine& base, std::size_t items, std::size_t threads) {
+    const unsigned long long draws_per_item = 37;
+    std_module::stream_partition<Engine> partition(base, items, threads, draws_per_item);
+    std::vector<unsigned long long> results(items);
+    std::vector<std::thread> workers;
+    for (std::size_t part = 0; part < threads; ++part) {
+        workers.emplace_back([&, part] {
+            Engine engine = partition.engine(part);
+            std_module::partition_range range = partition.range(part);
+            for (std::size_t item = range.begin; item < range.end; ++item) {
+                unsigned long long sum = 0;
+                for (unsigned long long d = 0; d < draws_per_item; ++d) {
+                    sum += engine();
+                }
+                results[item] = sum;
+            }
+        });
+    }
+    for (std::thread& w : workers) {
+        w.join();
+    }
+    return results;
+}
+
 int main() {
     test::test_header("std_module.random");
 
@@ -103,6 +207,347 @@ int main() {
     auto canonical = std::generate_canonical<double, 10>(mt);
     test::assert_true(canonical >= 0.0 && canonical < 1.0, "generate_canonical");
 
+    test::section("Testing std_module extensions");
+
+    static_assert(std::uniform_random_bit_generator<std_module::xoshiro256starstar> &&
+                  std::uniform_random_bit_generator<std_module::xoshiro128plus> &&
+                  std::uniform_random_bit_generator<std_module::pcg32> &&
+                  std::uniform_random_bit_generator<std_module::pcg64> &&
+                  std::uniform_random_bit_generator<std_module::wyrand>);
+    test::success("engines model uniform_random_bit_generator");
+
+    // Reference outputs (pcg32-demo and pcg64-demo use seed 42, stream 54)
+    std_module::pcg32 pcg(42, 54);
+    test::assert_true(pcg() == 0xA15C02B7u && pcg() == 0x7B47F409u && pcg() == 0xBA1D3330u, "pcg32 reference output");
+    std_module::pcg64 pcg_wide(42, 54);
+    test::assert_true(pcg_wide() == 0x86B1DA1D72062B68ull && pcg_wide() == 0x1304AA46C9853D39ull,
+                      "pcg64 reference output");
+    std_module::xoshiro256starstar xoshiro(7);
+    std_module::xoshiro128plus xoshiro32(7);
+    std_module::wyrand wy(0);
+    test::assert_true(xoshiro() == 0xB358FAF74EF9765Aull && xoshiro32() == 0x5D7E4AAEu && wy() == 0x111CB3A78F59A58Eull,
+                      "xoshiro and wyrand reference output");
+
+    // Jumps: expected values computed independently from the 2^128 / 2^192
+    // (2^64 / 2^96) powers of the state transition matrix
+    xoshiro.seed(7);
+    std_module::xoshiro256starstar jumped = xoshiro;
+    std_module::xoshiro256starstar long_jumped = xoshiro;
+    jumped.jump();
+    long_jumped.long_jump();
+    test::assert_true(jumped() == 0x156617FD83DF2A74ull && long_jumped() == 0x15A4DDFB90A82407ull,
+                      "xoshiro256starstar jump and long_jump");
+    xoshiro32.seed(7);
+    std_module::xoshiro128plus jumped32 = xoshiro32;
+    std_module::xoshiro128plus long_jumped32 = xoshiro32;
+    jumped32.jump();
+    long_jumped32.long_jump();
+    test::assert_true(jumped32() == 0xD869D761u && long_jumped32() == 0xD55187D5u, "xoshiro128plus jump and long_jump");
+
+    // discard(n) lands where n draws would
+    std_module::pcg32 stepped(3, 9);
+    std_module::pcg32 skipped = stepped;
+    std_module::pcg64 stepped_wide(3, 9);
+    std_module::pcg64 skipped_wide = stepped_wide;
+    std_module::wyrand stepped_wy(5);
+    std_module::wyrand skipped_wy = stepped_wy;
+    for (int i = 0; i < 12345; ++i) {
+        stepped();
+        stepped_wide();
+        stepped_wy();
+    }
+    skipped.discard(12345);
+    skipped_wide.discard(12345);
+    skipped_wy.discard(12345);
+    test::assert_true(stepped == skipped && stepped_wide == skipped_wide && stepped_wy == skipped_wy,
+                      "pcg32, pcg64 and wyrand discard");
+    test::assert_true(std_module::pcg32(1, 2)() != std_module::pcg32(1, 3)(), "pcg32 streams");
+
+    // Seed sequences and the std distributions
+    std::seed_seq seeds{1, 2, 3};
+    std_module::xoshiro256starstar from_seq(seeds);
+    std_module::xoshiro256starstar from_seq_again(seeds);
+    test::assert_true(from_seq == from_seq_again && from_seq != std_module::xoshiro256starstar(),
+                      "engines seeded from seed_seq");
+    std::uniform_int_distribution<int> die(1, 6);
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    int in_range = 0;
+    for (int i = 0; i < 100; ++i) {
+        int d = die(xoshiro) + die(xoshiro32) + die(pcg) + die(pcg_wide) + die(wy);
+        in_range += d >= 5 && d <= 30 ? 1 : 0;
+        gauss(pcg_wide);
+    }
+    test::assert_equal(in_range, 100, "engines drive the std distributions");
+
+    test::assert_true(passes_smoke_test(std_module::xoshiro256starstar(1)) &&
+                          passes_smoke_test(std_module::xoshiro128plus(2)) && passes_smoke_test(std_module::pcg32(3)) &&
+                          passes_smoke_test(std_module::pcg64(4)) && passes_smoke_test(std_module::wyrand(5)),
+                      "engines pass the statistical smoke test");
+    std::linear_congruential_engine<unsigned, 65539, 0, 2147483648u> randu(1);
+    test::assert_true(!passes_smoke_test(randu), "statistical smoke test rejects RANDU");
+
+    // xoshiro256starstar_x8: lane k is xoshiro256starstar jumped k times
+    using word = std_module::xoshiro256starstar_x8::result_type;
+    std_module::xoshiro256starstar_x8 lanes(11);
+    std::vector<word> lane_out(8 * 40);
+    lanes.generate(std::span(lane_out));
+    bool lanes_match = true;
+    std_module::xoshiro256starstar lane(11);
+    for (std::size_t l = 0; l < 8; ++l) {
+        std_module::xoshiro256starstar copy = lane;
+        for (std::size_t i = 0; i < 40; ++i) {
+            lanes_match = lanes_match && lane_out[i * 8 + l] == copy();
+        }
+        lane.jump();
+    }
+    test::assert_true(lanes_match, "xoshiro256starstar_x8 lanes are jumped xoshiro256starstar");
+    std_module::xoshiro256starstar_x8 one_by_one(11);
+    std_module::xoshiro256starstar_x8 in_pieces(11);
+    std::vector<word> pieces(8 * 40);
+    in_pieces.generate(std::span(pieces).subspan(0, 3));
+    pieces[3] = in_pieces();
+    in_pieces.generate(std::span(pieces).subspan(4, 21));
+    in_pieces.generate(std::span(pieces).subspan(25));
+    bool same_sequence = pieces == lane_out;
+    for (word v : lane_out) {
+        same_sequence = same_sequence && one_by_one() == v;
+    }
+    test::assert_true(same_sequence && one_by_one == in_pieces, "xoshiro256starstar_x8 generate matches operator()");
+    std_module::xoshiro256starstar_x8 far(11);
+    far.long_jump();
+    std_module::xoshiro256starstar far_lane(11);
+    far_lane.long_jump();
+    test::assert_true(far() == far_lane(), "xoshiro256starstar_x8 long_jump");
+    test::assert_true(passes_smoke_test(std_module::xoshiro256starstar_x8(6)),
+                      "xoshiro256starstar_x8 passes the statistical smoke test");
+
+    // Batch distributions, from 64-bit, 32-bit and narrower engines
+    const std::size_t draws = 1'000'000;
+    std::vector<double> sample(draws);
+    std_module::xoshiro256starstar_x8 wide(21);
+    std::mt19937 narrow(22);
+    std::minstd_rand odd(23);
+
+    std_module::fast_uniform_real_distribution<double> unit;
+    unit.generate(wide, std::span(sample));
+    auto uniform_cdf = [](double x) { return x; };
+    bool in_unit = std::all_of(sample.begin(), sample.end(), [](double x) { return x >= 0 && x < 1; });
+    test::assert_true(in_unit && kolmogorov_smirnov(sample, uniform_cdf) < 1.95, "fast_uniform_real_distribution");
+    std_module::fast_uniform_real_distribution<float> unit_float(-2.0f, 2.0f);
+    std::vector<float> floats(1001);
+    unit_float.generate(narrow, std::span(floats));
+    std::vector<double> widened(floats.begin(), floats.end());
+    for (int i = 0; i < 1000; ++i) {
+        widened.push_back(unit_float(odd));
+    }
+    bool in_range_float = std::all_of(widened.begin(), widened.end(), [](double x) { return x >= -2 && x < 2; });
+    test::assert_true(in_range_float && kolmogorov_smirnov(widened, [](double x) { return (x + 2) / 4; }) < 1.95,
+                      "fast_uniform_real_distribution<float>");
+    std_module::fast_uniform_real_distribution<double> tiny(1.0, std::nextafter(1.0, 2.0));
+    test::assert_true(tiny(wide) == 1.0, "fast_uniform_real_distribution never reaches b");
+
+    std_module::fast_uniform_int_distribution<int> fair_die(1, 6);
+    std::vector<int> rolls(600'001);
+    fair_die.generate(wide, std::span(rolls));
+    unsigned long long faces[7] = {};
+    for (int r : rolls) {
+        ++faces[r >= 1 && r <= 6 ? r : 0];
+    }
+    double die_chi_square = 0;
+    for (int f = 1; f <= 6; ++f) {
+        double d = static_cast<double>(faces[f]) - 100'000;
+        die_chi_square += d * d / 100'000;
+    }
+    // 5 degrees of freedom: 25 has probability about 0.01%
+    test::assert_true(faces[0] == 0 && die_chi_square < 25, "fast_uniform_int_distribution");
+    std_module::fast_uniform_int_distribution<signed char> bytes(-128, 127);
+    std::vector<signed char> byte_values(4096);
+    bytes.generate(odd, std::span(byte_values));
+    bool seen[256] = {};
+    for (signed char v : byte_values) {
+        seen[v + 128] = true;
+    }
+    test::assert_true(std::all_of(std::begin(seen), std::end(seen), [](bool s) { return s; }),
+                      "fast_uniform_int_distribution full 8-bit range");
+    // Types narrower than int: the range must not be computed in promoted int
+    std_module::fast_uniform_int_distribution<short> shorts(-100, 100);
+    std::vector<short> short_values(20'000);
+    shorts.generate(odd, std::span(short_values));
+    bool short_seen[201] = {};
+    bool short_in_range = shorts(wide) >= -100;
+    for (short v : short_values) {
+        short_in_range = short_in_range && v >= -100 && v <= 100;
+        short_seen[short_in_range ? v + 100 : 0] = true;
+    }
+    test::assert_true(short_in_range &&
+                          std::all_of(std::begin(short_seen), std::end(short_seen), [](bool s) { return s; }),
+                      "fast_uniform_int_distribution<short> bounds");
+    std_module::fast_uniform_int_distribution<std::int8_t> small_bytes(-3, 3);
+    std::vector<std::int8_t> small_values(1000);
+    small_bytes.generate(wide, std::span(small_values));
+    bool small_seen[7] = {};
+    bool small_in_range = true;
+    for (std::int8_t v : small_values) {
+        small_in_range = small_in_range && v >= -3 && v <= 3;
+        small_seen[small_in_range ? v + 3 : 0] = true;
+    }
+    std::int8_t one = small_bytes(narrow);
+    test::assert_true(small_in_range && one >= -3 && one <= 3 &&
+                          std::all_of(std::begin(small_seen), std::end(small_seen), [](bool s) { return s; }),
+                      "fast_uniform_int_distribution<int8_t> bounds");
+    const unsigned long long big = (1ull << 63) + (1ull << 62);
+    std_module::fast_uniform_int_distribution<unsigned long long> huge(0, big);
+    std::vector<unsigned long long> huge_values(100'000);
+    huge.generate(narrow, std::span(huge_values));
+    double huge_mean = 0;
+    for (unsigned long long v : huge_values) {
+        huge_mean += static_cast<double>(v) / static_cast<double>(big) / 100'000;
+    }
+    test::assert_true(std::all_of(huge_values.begin(), huge_values.end(), [&](auto v) { return v <= big; }) &&
+                          std::abs(huge_mean - 0.5) < 0.005 && huge(wide) <= big,
+                      "fast_uniform_int_distribution 64-bit range");
+    std_module::fast_uniform_int_distribution<long long> all_values(std::numeric_limits<long long>::min(),
+                                                                     std::numeric_limits<long long>::max());
+    std_module::fast_uniform_int_distribution<int> single(7, 7);
+    test::assert_true(all_values(wide) != all_values(wide) && single(wide) == 7, "fast_uniform_int_distribution edges");
+    // Range 2^32 - 1 rejects exactly the 32-bit half 0; each rejection is
+    // replaced by a fresh draw from the top half of the next word
+    const unsigned long long script[] = {0, 5ull << 32 | 7, 9ull << 32};
+    scripted_engine scripted{script};
+    std_module::fast_uniform_int_distribution<unsigned> rejecting(0, 0xFFFFFFFEu);
+    std::vector<unsigned> redrawn(2);
+    rejecting.generate(scripted, std::span(redrawn));
+    test::assert_true(redrawn[0] == 4 && redrawn[1] == 8 && scripted.words == script + 3,
+                      "fast_uniform_int_distribution rejection");
+
+    // The ziggurat tail starts at 3.654 (normal) and 7.697 (exponential);
+    // expected tail counts are 258 and 454 with standard deviations of
+    // about 16 and 21
+    std_module::ziggurat_normal_distribution<double> gaussian(0.0, 1.0);
+    gaussian.generate(wide, std::span(sample));
+    auto normal_cdf = [](double x) { return std::erfc(-x / std::sqrt(2.0)) / 2; };
+    auto beyond = [&](double r) {
+        return std::count_if(sample.begin(), sample.end(), [&](double x) { return x > r || -x > r; });
+    };
+    auto normal_tail = beyond(3.6541528853610088);
+    test::assert_true(kolmogorov_smirnov(sample, normal_cdf) < 1.95 && normal_tail > 158 && normal_tail < 358,
+                      "ziggurat_normal_distribution");
+    std_module::ziggurat_normal_distribution<float> shifted(10.0f, 2.0f);
+    std::vector<float> shifted_floats(2000);
+    shifted.generate(odd, std::span(shifted_floats).subspan(0, 1000));
+    for (std::size_t i = 1000; i < 2000; ++i) {
+        shifted_floats[i] = shifted(narrow);
+    }
+    std::vector<double> shifted_sample(shifted_floats.begin(), shifted_floats.end());
+    test::assert_true(kolmogorov_smirnov(shifted_sample, [&](double x) { return normal_cdf((x - 10) / 2); }) < 1.95,
+                      "ziggurat_normal_distribution mean and stddev");
+
+    std_module::ziggurat_exponential_distribution<double> expo_batch(1.0);
+    expo_batch.generate(wide, std::span(sample));
+    auto exponential_cdf = [](double x) { return x < 0 ? 0 : 1 - std::exp(-x); };
+    auto exponential_tail = beyond(7.69711747013104972);
+    bool non_negative = std::all_of(sample.begin(), sample.end(), [](double x) { return x >= 0; });
+    test::assert_true(non_negative && kolmogorov_smirnov(sample, exponential_cdf) < 1.95 && exponential_tail > 324 &&
+                          exponential_tail < 584,
+                      "ziggurat_exponential_distribution");
+    std_module::ziggurat_exponential_distribution<double> rate(4.0);
+    std::vector<double> rated(1000);
+    for (double& x : rated) {
+        x = rate(odd);
+    }
+    test::assert_true(kolmogorov_smirnov(rated, [&](double x) { return exponential_cdf(4 * x); }) < 1.95,
+                      "ziggurat_exponential_distribution lambda");
+
+    // Counter-based engines: Random123 known-answer vectors
+    static_assert(std_module::philox4x32::block({0, 0}, {0, 0, 0, 0}) ==
+                  std_module::philox4x32::counter_type{0x6627E8D5u, 0xE169C58Du, 0xBC57AC4Cu, 0x9B00DBD8u});
+    test::assert_true(std_module::philox4x32::block({0xA4093822u, 0x299F31D0u},
+                                                    {0x243F6A88u, 0x85A308D3u, 0x13198A2Eu, 0x03707344u}) ==
+                          std_module::philox4x32::counter_type{0xD16CFE09u, 0x94FDCCEBu, 0x5001E420u, 0x24126EA1u},
+                      "philox4x32 known answers");
+    test::assert_true(std_module::philox4x64::block({0, 0}, {0, 0, 0, 0}) ==
+                          std_module::philox4x64::counter_type{0x16554D9ECA36314Cull, 0xDB20FE9D672D0FDCull,
+                                                               0xD7E772CEE186176Bull, 0x7E68B68AEC7BA23Bull},
+                      "philox4x64 known answers");
+    test::assert_true(std_module::threefry4x64::block({0, 0, 0, 0}, {0, 0, 0, 0}) ==
+                          std_module::threefry4x64::counter_type{0x09218EBDE6C85537ull, 0x55941F5266D86105ull,
+                                                                 0x4BD25E16282434DCull, 0xEE29EC846BD2E40Bull},
+                      "threefry4x64 known answers");
+    // The C++26 required behavior: the 10000th output of a default-constructed engine
+    std_module::philox4x32 philox;
+    std_module::philox4x64 philox_wide;
+    philox.discard(9999);
+    philox_wide.discard(9999);
+    test::assert_true(philox() == 1955073260u && philox_wide() == 3409172418970261260ull,
+                      "philox4x32 and philox4x64 match C++26");
+
+    // O(1) jumps: discard, set_counter and generate against stepping
+    std_module::threefry4x64 stepped_fry(99);
+    std_module::threefry4x64 skipped_fry = stepped_fry;
+    for (int i = 0; i < 1003; ++i) {
+        stepped_fry();
+    }
+    skipped_fry.discard(1);
+    skipped_fry.discard(1002);
+    std::vector<std_module::threefry4x64::result_type> fry_block(23);
+    std_module::threefry4x64 generated_fry = skipped_fry;
+    generated_fry.generate(std::span(fry_block));
+    bool fry_matches = true;
+    for (auto v : fry_block) {
+        fry_matches = fry_matches && stepped_fry() == v;
+    }
+    skipped_fry.discard(23);
+    test::assert_true(fry_matches && skipped_fry == stepped_fry && generated_fry == stepped_fry,
+                      "threefry4x64 discard and generate");
+    // 2^32 blocks and 5 outputs carry into the second counter word
+    std_module::philox4x32 far_philox(5);
+    far_philox.discard((1ull << 34) + 5);
+    std_module::philox4x32 set_philox(5);
+    set_philox.set_counter({0, 1, 0, 0});
+    set_philox.discard(5);
+    auto expected = std_module::philox4x32::block(set_philox.key(), {1, 1, 0, 0});
+    test::assert_true(far_philox == set_philox && far_philox.index() == 1 && far_philox() == expected[1],
+                      "philox4x32 counter carry");
+    std_module::philox4x64 keyed({1, 2}, {3, 4, 5, 6});
+    test::assert_true(keyed() == std_module::philox4x64::block({1, 2}, {3, 4, 5, 6})[0] &&
+                          std_module::philox4x32(seeds) != std_module::philox4x32(),
+                      "counter engines from key and counter or seed_seq");
+    test::assert_true(passes_smoke_test(std_module::philox4x32(7)) && passes_smoke_test(std_module::philox4x64(8)) &&
+                          passes_smoke_test(std_module::threefry4x64(9)),
+                      "counter engines pass the statistical smoke test");
+
+    // stream_partition: contiguous balanced ranges, and the same results
+    // on any number of threads as the single-threaded stream
+    bool ranges_ok = true;
+    for (std::size_t parts = 1; parts <= 64; ++parts) {
+        std_module::stream_partition<std_module::philox4x32> partition({}, 1000, parts, 1);
+        std::size_t next = 0;
+        for (std::size_t p = 0; p < parts; ++p) {
+            std_module::partition_range r = partition.range(p);
+            ranges_ok = ranges_ok && r.begin == next && (r.size() == 1000 / parts || r.size() == 1000 / parts + 1);
+            next = r.end;
+        }
+        ranges_ok = ranges_ok && next == 1000;
+    }
+    test::assert_true(ranges_ok, "stream_partition ranges");
+    const std::size_t items = 1000;
+    std_module::philox4x64 base(2024);
+    std::vector<unsigned long long> serial = simulate(base, items, 1);
+    bool reproducible = true;
+    for (std::size_t threads : {2, 3, 4, 7, 8, 16, 31, 64}) {
+        reproducible = reproducible && simulate(base, items, threads) == serial;
+    }
+    std_module::threefry4x64 fry_base(2025);
+    std::vector<unsigned long long> fry_serial = simulate(fry_base, items, 1);
+    reproducible = reproducible && simulate(fry_base, items, 64) == fry_serial;
+    std_module::stream_partition<std_module::philox4x64> partition(base, items, 5, 37);
+    std_module::philox4x64 item_500 = partition.item_engine(500);
+    unsigned long long sum_500 = 0;
+    for (int d = 0; d < 37; ++d) {
+        sum_500 += item_500();
+    }
+    test::assert_true(reproducible && sum_500 == serial[500], "stream_partition reproducible on 1 to 64 threads");
+
     test::test_footer();
     return 0;
 }
@@ -7,7 +7,34 @@
  */
 
 import std_module.regex;
+import std_module.string;
+import std_module.string_view;
+import std_module.thread;
+import std_module.vector;
 import std_module.test_framework;
+#include <cstddef>  // For size_t
+#include <utility>  // For std::move
+
+// Inputs on which the compile-time pattern disagrees with std::regex
+template <std_module::regex_string P>
+int static_mismatches(const std::vector<std::string>& inputs) {
+    std::regex re(P.data);
+    int mismatches = 0;
+    for (const std::string& s : inputs) {
+        std::smatch m;
+        bool found = std::regex_search(s, m, re);
+        auto sm = std_module::captures<P>(s);
+        bool same = found == static_cast<bool>(sm) && found == std_module::search<P>(s) &&
+                    std::regex_match(s, re) == std_module::match<P>(s);
+        for (std::size_t g = 0; same && found && g < m.size(); ++g) {
+            same = m[g].matched == sm.matched(g) &&
+                   (!m[g].matched || (static_cast<std::size_t>(m.position(g)) == sm.position(g) &&
+                                      static_cast<std::size_t>(m.length(g)) == sm.length(g)));
+        }
+        mismatches += same ? 0 : 1;
+    }
+    return mismatches;
+}
 
 int main() {
     test::test_header("std_module.regex");
@@ -75,6 +102,216 @@ int main() {
     std::regex icase("HELLO", std::regex_constants::icase);
     test::assert_true(std::regex_match("hello", icase), "icase flag");
 
+    test::section("Testing std_module extensions");
+
+    // Leftmost match and captures, like std::regex_search
+    std_module::dfa_regex request(R"((GET|POST) (/\S*) (\d{3}))");
+    std::string access = "10.0.0.1 - POST /api/v1/users 201 12ms";
+    std_module::dfa_match dm;
+    test::assert_true(std_module::regex_search(access, dm, request), "dfa_regex regex_search");
+    test::assert_true(dm.size() == 4 && dm.str(1) == "POST" && dm.str(2) == "/api/v1/users" && dm.str(3) == "201",
+                      "dfa_match groups");
+    test::assert_true(dm.position(0) == 11 && dm.prefix().str() == "10.0.0.1 - " && dm.suffix().str() == " 12ms",
+                      "dfa_match position, prefix and suffix");
+    test::assert_true(!std_module::regex_search("GET /x 20", request) && dm.ready(), "dfa_regex no match");
+
+    // ECMAScript preference: first alternative, lazy quantifiers
+    std_module::dfa_regex alternatives("a|ab");
+    test::assert_true(std_module::regex_search("ab", dm, alternatives) && dm.str() == "a",
+                      "dfa_regex leftmost-first alternation");
+    test::assert_true(std_module::regex_match("ab", alternatives), "dfa_regex regex_match tries every alternative");
+    std_module::dfa_regex lazy("<(.+?)>");
+    test::assert_true(std_module::regex_search("<a><b>", dm, lazy) && dm.str(1) == "a", "dfa_regex lazy quantifier");
+
+    // A moved-from regex matches nothing until it is assigned again
+    std_module::dfa_regex taken(std::move(lazy));
+    test::assert_true(std_module::regex_search("<a>", dm, taken) && lazy.mark_count() == 0 &&
+                          !std_module::regex_search("<a>", dm, lazy) && dm.ready() && dm.empty() &&
+                          std_module::dfa_regex_iterator("<a>", lazy) == std_module::dfa_regex_iterator(),
+                      "dfa_regex moved-from state");
+    std_module::dfa_regex copy_of_empty(lazy);
+    lazy = taken;
+    test::assert_true(!copy_of_empty.match("") && std_module::regex_match("<b>", lazy), "dfa_regex reuse after move");
+
+    // Options and assertions
+    std_module::dfa_regex level(R"(^error\b)", std::regex_constants::icase | std::regex_constants::multiline);
+    test::assert_true(std_module::regex_search("ok\nERROR: disk full", level), "dfa_regex icase and multiline");
+    test::assert_true(!std_module::regex_search("ok\nerrors: none", level), "dfa_regex word boundary");
+    test::assert_true(!std_module::regex_search("x", level, std::regex_constants::match_not_bol) &&
+                          !std_module::regex_search("error", level, std::regex_constants::match_not_bol),
+                      "dfa_regex match_not_bol");
+
+    // Every match in order, with std::regex_iterator's empty-match rules
+    auto same_matches = [](const char* pattern, std::string_view text) {
+        std::regex re(pattern);
+        std_module::dfa_regex dre(pattern);
+        std::cregex_iterator it(text.data(), text.data() + text.size(), re);
+        std_module::dfa_regex_iterator dit(text, dre);
+        for (; it != std::cregex_iterator() && dit != std_module::dfa_regex_iterator(); ++it, ++dit) {
+            if (it->position() != dit->position() || it->length() != dit->length() ||
+                it->prefix().length() != dit->prefix().length()) {
+                return false;
+            }
+        }
+        return it == std::cregex_iterator() && dit == std_module::dfa_regex_iterator();
+    };
+    test::assert_true(same_matches(R"(\d+)", "a1b22c333"), "dfa_regex_iterator");
+    test::assert_true(same_matches("a*", "baaac") && same_matches(R"(\b)", "one two") && same_matches("a*?", "aa"),
+                      "dfa_regex_iterator empty matches");
+
+    // Same answers as std::regex over generated inputs
+    const char* patterns[] = {"a|ab",
+                              "(a|ab)(c|bcd)(d*)",
+                              R"(\d+(\.\d+)?)",
+                              R"((\w+)@(\w+)\.com)",
+                              "x*",
+                              "a{2,3}",
+                              "(a+?)(b*)",
+                              "[^ab ]+",
+                              R"(\bfo+\b)",
+                              R"(^\s*(\w+)\s*=\s*(.*?)\s*$)",
+                              "(?:ab|a)(bc|c)?",
+                              "[a-c]{2,}?d",
+                              "(a|b)*c",
+                              R"((\d)\.(\d)|(x))",
+                              "o.$",
+                              R"(\B.\B)"};
+    unsigned long long seed = 12345;
+    auto next_char = [&seed] {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return "abcd fo.=@x19\n"[(seed >> 33) % 14];
+    };
+    int mismatches = 0;
+    for (const char* pattern : patterns) {
+        std::regex re(pattern);
+        std_module::dfa_regex dre(pattern);
+        for (int n = 0; n < 300; ++n) {
+            std::string s;
+            for (unsigned long long len = (seed >> 40) % 16; len > 0; --len) {
+                s.push_back(next_char());
+            }
+            next_char();
+            std::smatch m;
+            bool found = std::regex_search(s, m, re);
+            bool dfound = std_module::regex_search(s, dm, dre);
+            bool same = found == dfound && std::regex_match(s, re) == std_module::regex_match(s, dre);
+            for (std::size_t g = 0; same && found && g < m.size(); ++g) {
+                same = m[g].matched == dm[g].matched &&
+                       (!m[g].matched || (m.position(g) == dm.position(g) && m.length(g) == dm.length(g)));
+            }
+            mismatches += same ? 0 : 1;
+        }
+    }
+    test::assert_equal(mismatches, 0, "dfa_regex agrees with std::regex");
+
+    // Linear time: (a|aa)*b backtracks exponentially on a run of a's
+    std_module::dfa_regex nested("(a|aa)*b");
+    std::string run(100000, 'a');
+    test::assert_true(!std_module::regex_search(run, nested) && !std_module::regex_match(run, nested) &&
+                          !std_module::regex_search(run, dm, nested),
+                      "dfa_regex linear time on pathological patterns");
+    run.push_back('b');
+    test::assert_true(std_module::regex_match(run, dm, nested) && dm.length(1) == 1, "dfa_regex long captures");
+
+    // Copies share the program and keep their own cache
+    std_module::dfa_regex copy = request;
+    test::assert_true(copy.mark_count() == 3 && std_module::regex_search(access, copy), "dfa_regex copy");
+
+    // Unsupported or malformed patterns
+    auto error_of = [](const char* pattern) {
+        try {
+            std_module::dfa_regex re(pattern);
+        } catch (const std::regex_error& e) {
+            return e.code();
+        }
+        return std::regex_constants::error_type{};
+    };
+    test::assert_true(error_of(R"((a)\1)") == std::regex_constants::error_backref, "dfa_regex rejects backreferences");
+    test::assert_true(error_of("a(?=b)") == std::regex_constants::error_complexity, "dfa_regex rejects lookahead");
+    test::assert_true(error_of("(a") == std::regex_constants::error_paren && error_of("[a") == std::regex_constants::error_brack &&
+                          error_of("*a") == std::regex_constants::error_badrepeat,
+                      "dfa_regex syntax errors");
+
+    // Compile-time patterns: parsed and checked by the compiler
+    static_assert(std_module::match<R"([a-z]+-\d+)">("build-42") && !std_module::match<R"([a-z]+-\d+)">("build-"));
+    static_assert(std_module::captures<R"((\w+)=(\d+))">("x key=12 y")[1] == "key");
+    test::success("match, search and captures in constant expressions");
+
+    auto kv = std_module::captures<R"((\w+)=(\d+)(ms)?)">(access);
+    test::assert_true(!kv, "captures no match");
+    kv = std_module::captures<R"((\w+)=(\d+)(ms)?)">("took latency=12 total");
+    test::assert_true(kv && kv.size() == 4 && kv[1] == "latency" && kv.get<2>() == "12" && kv.position(0) == 5,
+                      "captures groups and position");
+    test::assert_true(!kv.matched(3) && kv[3].empty() && !kv.matched(9), "captures unmatched group");
+    test::assert_true(std_module::match<"a|ab">("ab") && std_module::captures<"a|ab">("ab").str() == "a" &&
+                          std_module::captures<"<(.+?)>">("<a><b>")[1] == "a",
+                      "captures ECMAScript preference");
+    test::assert_true(std_module::search<R"(^error\b)", std::regex_constants::icase | std::regex_constants::multiline>(
+                          "ok\nERROR: disk full") &&
+                          !std_module::search<R"(^error\b)">("ok\nerror: disk full"),
+                      "search syntax options");
+    test::assert_true(std_module::captures<"x*">(std::string_view()) && std_module::search<"$">(""),
+                      "captures empty match on empty text");
+
+    std::vector<std::string> inputs;
+    for (int n = 0; n < 300; ++n) {
+        std::string s;
+        for (unsigned long long len = (seed >> 40) % 16; len > 0; --len) {
+            s.push_back(next_char());
+        }
+        next_char();
+        inputs.push_back(s);
+    }
+    mismatches = static_mismatches<"(a|ab)(c|bcd)(d*)">(inputs) + static_mismatches<R"(\d+(\.\d+)?)">(inputs) +
+                 static_mismatches<R"((\w+)@(\w+)\.com)">(inputs) + static_mismatches<"(a+?)(b*)">(inputs) +
+                 static_mismatches<R"(\bfo+\b)">(inputs) + static_mismatches<R"(^\s*(\w+)\s*=\s*(.*?)\s*$)">(inputs) +
+                 static_mismatches<"(?:ab|a)(bc|c)?">(inputs) + static_mismatches<"[a-c]{2,}?d">(inputs) +
+                 static_mismatches<"(a|b)*c">(inputs) + static_mismatches<R"((\d)\.(\d)|(x))">(inputs) +
+                 static_mismatches<R"(\B.\B)">(inputs) + static_mismatches<"fo.=">(inputs);
+    test::assert_equal(mismatches, 0, "compile-time patterns agree with std::regex");
+
+    // Compiled-regex cache
+    std_module::regex_cache cache(2);
+    auto digits = cache.get(R"(\d+)");
+    test::assert_true(cache.get(R"(\d+)") == digits && std::regex_search("a1", *digits), "regex_cache hit");
+    test::assert_true(cache.get(R"(\d+)", std::regex_constants::icase) != digits, "regex_cache keys on flags");
+    cache.get("x");
+    auto counters = cache.stats();
+    test::assert_true(counters.hits == 1 && counters.misses == 3 && counters.evictions == 1 && counters.size == 2 &&
+                          cache.capacity() == 2,
+                      "regex_cache stats and eviction");
+    test::assert_true(cache.get(R"(\d+)") != digits && std::regex_match("42", *digits),
+                      "regex_cache evicted regex stays usable");
+    bool rejected = false;
+    try {
+        cache.get("(");
+    } catch (const std::regex_error&) {
+        rejected = cache.size() == 2;
+    }
+    test::assert_true(rejected, "regex_cache invalid pattern");
+
+    std_module::basic_regex_cache<std_module::dfa_regex> shared(8);
+    std::vector<std::thread> workers;
+    std::vector<int> wrong(4);
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&shared, &wrong, t] {
+            for (int i = 0; i < 1000; ++i) {
+                std::string pattern = "id" + std::to_string((i * 7 + t) % 12) + R"(=\d+)";
+                auto re = shared.get(pattern);
+                if (!std_module::regex_search("x " + pattern.substr(0, pattern.size() - 4) + "=5", *re)) {
+                    ++wrong[t];
+                }
+            }
+        });
+    }
+    for (std::thread& w : workers) {
+        w.join();
+    }
+    counters = shared.stats();
+    test::assert_true(wrong == std::vector<int>(4) && counters.hits + counters.misses == 4000 && counters.size <= 8 &&
+                          counters.misses - counters.evictions >= counters.size,
+                      "regex_cache concurrent use");
+
     test::test_footer();
     return 0;
 }
@@ -7,8 +7,31 @@
  */
 
 import std_module.stack;
+import std_module.stdexcept;
+import std_module.thread;
 import std_module.test_framework;
 #include <cstddef>  // For size_t
+#include <utility>  // For std::move
+
+namespace {
+
+// Copyable, with a move that may throw, so small_stack copies on growth;
+// the copy throws once copies_left runs out
+struct throwing_copy {
+    static inline int copies_left = 1000;
+    int value;
+
+    explicit throwing_copy(int v) : value(v) {}
+    throwing_copy(const throwing_copy& other) : value(other.value) {
+        if (copies_left-- == 0) {
+            throw 1;
+        }
+    }
+    throwing_copy(throwing_copy&& other) noexcept(false) : value(other.value) {}
+    throwing_copy& operator=(const throwing_copy&) = default;
+};
+
+}  // namespace
 
 int main() {
     test::test_header("std_module.stack");
@@ -50,6 +73,118 @@ int main() {
     lifo.pop();
     test::assert_equal(lifo.top(), 1, "LIFO order");
 
+    test::section("Testing std_module extensions");
+
+    // small_stack: inline storage, then spill to the heap
+    std_module::small_stack<int, 4> small;
+    test::assert_true(small.empty(), "small_stack empty");
+    test::assert_equal(small.capacity(), static_cast<size_t>(4), "small_stack inline capacity");
+    for (int i = 0; i < 4; ++i) {
+        small.push(i);
+    }
+    test::assert_equal(small.capacity(), static_cast<size_t>(4), "small_stack stays inline");
+    for (int i = 4; i < 100; ++i) {
+        small.emplace(i);
+    }
+    test::assert_true(small.capacity() >= 100, "small_stack spills to heap");
+    test::assert_equal(small.top(), 99, "small_stack top");
+
+    std_module::small_stack<int, 4> small_copy(small);
+    bool lifo_ok = true;
+    for (int i = 99; i >= 0; --i) {
+        lifo_ok = lifo_ok && small.top() == i;
+        small.pop();
+    }
+    test::assert_true(lifo_ok && small.empty(), "small_stack LIFO order");
+    test::assert_equal(small_copy.size(), static_cast<size_t>(100), "small_stack copy");
+
+    std_module::small_stack<int, 4> small_moved(std::move(small_copy));
+    test::assert_equal(small_moved.top(), 99, "small_stack move (heap)");
+    std_module::small_stack<int, 4> small_inline;
+    small_inline.push(7);
+    swap(small_inline, small_moved);
+    test::assert_equal(small_inline.size(), static_cast<size_t>(100), "small_stack swap");
+    test::assert_equal(small_moved.top(), 7, "small_stack swap (inline)");
+
+    std_module::small_stack<int> heap_only;
+    heap_only.reserve(16);
+    heap_only.push(1);
+    heap_only.push(heap_only.top());
+    test::assert_equal(heap_only.size(), static_cast<size_t>(2), "small_stack<T, 0>");
+
+    // Growth copies when moving may throw, and a throwing copy leaves the stack as it was
+    std_module::small_stack<throwing_copy, 2> guarded;
+    guarded.emplace(1);
+    guarded.emplace(2);
+    throwing_copy::copies_left = 1;
+    bool threw = false;
+    try {
+        guarded.emplace(3);
+    } catch (int) {
+        threw = true;
+    }
+    test::assert_true(threw && guarded.size() == 2 && guarded.capacity() == 2 && guarded.top().value == 2,
+                      "small_stack growth keeps elements when a copy throws");
+    throwing_copy::copies_left = 1000;
+    guarded.emplace(3);
+    test::assert_true(guarded.size() == 3 && guarded.top().value == 3, "small_stack growth by copy");
+
+    // treiber_stack: bounded, single thread
+    std_module::treiber_stack<int> lock_free(3);
+    test::assert_true(lock_free.empty(), "treiber_stack empty");
+    test::assert_true(lock_free.try_push(1) && lock_free.try_push(2) && lock_free.try_emplace(3),
+                      "treiber_stack try_push");
+    test::assert_false(lock_free.try_push(4), "treiber_stack full");
+    auto popped = lock_free.try_pop();
+    test::assert_true(popped.has_value() && *popped == 3, "treiber_stack try_pop");
+    int out = 0;
+    test::assert_true(lock_free.try_pop(out) && out == 2, "treiber_stack try_pop(T&)");
+    test::assert_true(lock_free.try_push(5), "treiber_stack reuses slots");
+
+    // Slot indices are 32 bits; 0xFFFFFFFF is the empty marker
+    bool rejected = false;
+    try {
+        std_module::treiber_stack<int> too_big(0xFFFFFFFFu);
+    } catch (const std::length_error&) {
+        rejected = true;
+    }
+    test::assert_true(rejected, "treiber_stack rejects capacity 2^32 - 1");
+
+    test::section("Testing concurrent treiber_stack");
+
+    // Used as a freelist: every thread repeatedly takes and returns slots.
+    constexpr int slots = 64;
+    std_module::treiber_stack<int> freelist(slots);
+    for (int i = 0; i < slots; ++i) {
+        freelist.try_push(i);
+    }
+    std::thread workers[4];
+    for (auto& w : workers) {
+        w = std::thread([&] {
+            int taken[8];
+            for (int round = 0; round < 20000; ++round) {
+                int n = 0;
+                while (n < 8 && freelist.try_pop(taken[n])) {
+                    ++n;
+                }
+                while (n > 0) {
+                    freelist.try_push(taken[--n]);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    bool seen[slots] = {};
+    int count = 0;
+    bool unique = true;
+    for (int v = 0; freelist.try_pop(v); ++count) {
+        unique = unique && v >= 0 && v < slots && !seen[v];
+        seen[v] = true;
+    }
+    test::assert_true(unique && count == slots, "treiber_stack no lost or duplicated slots");
+
     test::test_footer();
     return 0;
 }
@@ -7,7 +7,11 @@
  */
 
 import std_module.string;
+import std_module.string_view;
+import std_module.thread;
 import std_module.test_framework;
+#include <sstream>  // For ostringstream (no sstream module)
+#include <utility>  // For std::move
 
 int main() {
     test::test_header("std_module.string");
@@ -72,6 +76,120 @@ int main() {
     std::erase(s5, 'a');
     test::assert_true(s5.find('a') == std::string::npos, "erase");
 
+    test::section("Testing std_module extensions");
+
+    // string_pool: one copy per distinct string, stable views
+    std_module::string_pool pool;
+    std::string key("http.requests");
+    std::string_view first = pool.intern(key);
+    key[0] = 'H';
+    test::assert_true(first == "http.requests", "string_pool copies input");
+    std::string_view again = pool.intern("http.requests");
+    test::assert_true(again.data() == first.data(), "string_pool deduplicates");
+    for (int i = 0; i < 10000; ++i) {
+        pool.intern(std::to_string(i));
+    }
+    test::assert_true(first == "http.requests", "string_pool views stay valid");
+    test::assert_equal(pool.size(), static_cast<size_t>(10001), "string_pool size");
+    test::assert_true(pool.contains("42") && !pool.contains("10000"), "string_pool contains");
+    test::assert_true(pool.intern("").empty(), "string_pool empty string");
+    std::string big(100000, 'x');
+    test::assert_true(pool.intern(big).size() == big.size(), "string_pool oversized string");
+    test::assert_true(pool.memory_usage() > 0, "string_pool memory_usage");
+
+    // A moved-from pool starts over without touching the moved-to pool's strings
+    std_module::string_pool moved_pool = std::move(pool);
+    std::string_view kept = moved_pool.intern("http.requests");
+    std::string_view added = moved_pool.intern("added.after.move");
+    for (int i = 0; i < 100; ++i) {
+        pool.intern("reused_" + std::to_string(i));
+    }
+    test::assert_true(kept == "http.requests" && kept.data() == first.data() && moved_pool.size() == 10004 &&
+                          moved_pool.contains("42") && pool.size() == 100 && !pool.contains("42") &&
+                          pool.intern("reused_7") == "reused_7" && added == "added.after.move",
+                      "string_pool reused after move");
+
+    // string_interner: dense, stable ids
+    std_module::string_interner interner;
+    auto id_a = interner.intern("cpu.user");
+    auto id_b = interner.intern("cpu.system");
+    test::assert_equal(id_a, 0u, "string_interner first id");
+    test::assert_equal(id_b, 1u, "string_interner second id");
+    test::assert_equal(interner.intern("cpu.user"), id_a, "string_interner stable id");
+    test::assert_true(interner.view(id_b) == "cpu.system", "string_interner view");
+    test::assert_true(interner.find("cpu.system").value_or(99) == id_b, "string_interner find");
+    test::assert_false(interner.find("mem.free").has_value(), "string_interner find missing");
+    test::assert_equal(interner.size(), static_cast<size_t>(2), "string_interner size");
+
+    // rope: O(log n) edits over shared chunks
+    std::string flat(20000, '.');
+    for (size_t i = 0; i < flat.size(); ++i) {
+        flat[i] = static_cast<char>('a' + i % 26);
+    }
+    std_module::rope doc(flat);
+    test::assert_equal(doc.size(), flat.size(), "rope from string");
+    test::assert_true(doc == flat, "rope equals source");
+    test::assert_true(doc[12345] == flat[12345] && doc.at(0) == 'a', "rope element access");
+
+    std_module::rope snapshot = doc;
+    unsigned long long state = 1;
+    for (int i = 0; i < 500; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        size_t pos = static_cast<size_t>(state >> 33) % (flat.size() + 1);
+        if (i % 3 == 2 && pos < flat.size()) {
+            doc.erase(pos, 7);
+            flat.erase(pos, 7);
+        } else {
+            doc.insert(pos, "<ins>");
+            flat.insert(pos, "<ins>");
+        }
+    }
+    test::assert_true(doc == flat && doc.str() == flat, "rope random edits");
+    test::assert_true(snapshot.size() == 20000 && snapshot[0] == 'a', "rope copies are unaffected by edits");
+    test::assert_true(doc.substr(100, 50) == std::string_view(flat).substr(100, 50), "rope substr");
+
+    std_module::rope joined = std_module::rope("head ") + doc;
+    joined.append(" tail");
+    test::assert_true(joined == "head " + flat + " tail", "rope concatenation");
+
+    size_t chunk_bytes = 0;
+    doc.for_each_chunk([&](std::string_view chunk) { chunk_bytes += chunk.size(); });
+    test::assert_equal(chunk_bytes, doc.size(), "rope for_each_chunk");
+    std::ostringstream streamed;
+    streamed << doc;
+    test::assert_true(streamed.str() == flat, "rope stream output");
+    doc.erase();
+    test::assert_true(doc.empty(), "rope erase all");
+
+    test::section("Testing concurrent string_interner");
+
+    // Every thread interns the same 5000 names in a different order; all
+    // must agree on the ids and no name may be stored twice.
+    constexpr int names = 5000;
+    std_module::string_interner shared;
+    unsigned ids[4][names];
+    std::thread workers[4];
+    for (int t = 0; t < 4; ++t) {
+        workers[t] = std::thread([&, t] {
+            for (int i = 0; i < names; ++i) {
+                int n = (t % 2 ? names - 1 - i : i + t * 977) % names;
+                ids[t][n] = shared.intern("metric." + std::to_string(n));
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    bool agree = true;
+    for (int n = 0; n < names; ++n) {
+        for (int t = 1; t < 4; ++t) {
+            agree = agree && ids[t][n] == ids[0][n];
+        }
+        agree = agree && shared.view(ids[0][n]) == "metric." + std::to_string(n);
+    }
+    test::assert_true(agree, "string_interner threads agree on ids");
+    test::assert_equal(shared.size(), static_cast<size_t>(names), "string_interner no duplicates");
+
     test::test_footer();
     return 0;
 }
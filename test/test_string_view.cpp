@@ -65,6 +65,61 @@ int main() {
     // npos constant
     test::assert_true(std::string_view::npos == static_cast<size_t>(-1), "npos");
 
+    test::section("Testing std_module extensions");
+
+    // byte_set and find_any_of (long enough input for the SIMD kernels)
+    constexpr std_module::byte_set header_delims(":;, \t");
+    test::assert_true(header_delims.contains(':') && !header_delims.contains('a'), "byte_set contains");
+    test::assert_equal(header_delims.size(), static_cast<size_t>(5), "byte_set size");
+    std::string_view header = "Content-Type-And-Some-Long-Header-Name: text/html; charset=utf-8";
+    test::assert_equal(std_module::find_any_of(header, header_delims), header.find_first_of(":;, \t"),
+                       "find_any_of");
+    test::assert_equal(std_module::find_any_of(header, header_delims, 40), header.find_first_of(":;, \t", 40),
+                       "find_any_of from pos");
+    test::assert_true(std_module::find_any_of(header, std_module::byte_set("#")) == std::string_view::npos,
+                      "find_any_of no match");
+
+    // A set with many distinct nibble patterns falls back to the bitmap
+    std_module::byte_set wide;
+    for (int c = 0; c < 256; c += 17) {
+        wide.insert(static_cast<char>(c));
+    }
+    std::string_view binary = "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\xee\x20";
+    test::assert_equal(std_module::find_any_of(binary, wide), static_cast<size_t>(16), "find_any_of wide set");
+
+    // split keeps empty fields, tokenize drops them
+    size_t fields = 0;
+    bool fields_ok = true;
+    const char* expected[] = {"a", "", "b", ""};
+    for (std::string_view f : std_module::split("a,,b,", ',')) {
+        fields_ok = fields_ok && fields < 4 && f == expected[fields];
+        ++fields;
+    }
+    test::assert_true(fields_ok && fields == 4, "split");
+    size_t tokens = 0;
+    for (std::string_view tok : std_module::tokenize("  GET   /index.html HTTP/1.1 ", std_module::byte_set(" \t"))) {
+        tokens += tok.empty() ? 100 : 1;
+    }
+    test::assert_equal(tokens, static_cast<size_t>(3), "tokenize");
+    auto empty_split = std_module::split("", ',');
+    test::assert_true(empty_split.begin() != empty_split.end(), "split of empty string yields one field");
+    auto pair = std_module::split("key=value", '=');
+    auto field_it = pair.begin();
+    const std::string_view& key = *field_it;
+    ++field_it;
+    test::assert_true(key == "key" && *field_it == "value", "split fields outlive the iterator position");
+
+    // ASCII case-insensitive comparison and hashing
+    test::assert_true(std_module::iequals("Content-Length-Header", "content-length-HEADER"), "iequals");
+    test::assert_false(std_module::iequals("Content-Length", "Content-Lengtx"), "iequals mismatch");
+    test::assert_false(std_module::iequals("[", "{"), "iequals non-letters");
+    test::assert_equal(std_module::ihash("Accept-Encoding"), std_module::ihash("ACCEPT-encoding"), "ihash");
+    test::assert_true(std_module::ihash("abc") != std_module::ihash("abd"), "ihash differs");
+
+    test::assert_true(std_module::starts_with_any("https://example.com", {"ftp:", "http:", "https:"}),
+                      "starts_with_any");
+    test::assert_false(std_module::starts_with_any("file:///", {"ftp:", "http:"}), "starts_with_any no match");
+
     test::test_footer();
     return 0;
 }
@@ -7,6 +7,10 @@
  */
 
 import std_module.syncstream;
+import std_module.string;
+import std_module.string_view;
+import std_module.thread;
+import std_module.vector;
 import std_module.test_framework;
 
 #include <sstream>
@@ -49,6 +53,97 @@ int main() {
     sbuf.emit();
     test::assert_true(oss2.str().size() > 0, "syncbuf");
 
+    test::section("Testing std_module extensions");
+
+    // Records are formatted on the background thread; flush() waits for them
+    std::ostringstream log_out;
+    {
+        std_module::async_logger log(log_out);
+        std::string user = "alice";
+        log.info("user {} logged in ({} attempts)", user, 2);
+        user = "overwritten";  // arguments were captured by value
+        log.warn("{:.1f}% disk used", 93.75);
+        log.flush();
+        std::string text = log_out.str();
+        test::assert_true(text.find("INFO  test_syncstream.cpp:") != std::string::npos,
+                          "async_logger level and call site");
+        test::assert_true(text.find(" user alice logged in (2 attempts)\n") != std::string::npos,
+                          "async_logger captures arguments by value");
+        test::assert_true(text.find("WARN  ") != std::string::npos && text.find(" 93.8% disk used\n") != std::string::npos,
+                          "async_logger format specs");
+
+        log.set_level(std_module::log_level::warn);
+        log.info("filtered {}", 1);
+        log.error("kept {}", 2);
+        log.flush();
+        test::assert_true(log_out.str().find("filtered") == std::string::npos &&
+                              log_out.str().find(" kept 2\n") != std::string::npos,
+                          "async_logger level filter");
+    }
+
+    // Per-thread order is preserved; nothing is lost with blocking rings
+    std::ostringstream mt_out;
+    {
+        std_module::async_logger::options small = std_module::async_logger::default_options;
+        small.ring_bytes = 4096;  // small enough to force waiting on the background thread
+        std_module::async_logger log(mt_out, small);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&log, t] {
+                for (int i = 0; i < 2000; ++i) {
+                    log.debug("t{} #{}", t, i);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }  // destructor writes out the rest
+    std::string mt_text = mt_out.str();
+    int lines = 0;
+    int next[4] = {0, 0, 0, 0};
+    bool ordered = true;
+    for (std::string_view line : std_module::split(std::string_view(mt_text), '\n')) {
+        if (line.empty()) {
+            continue;
+        }
+        ++lines;
+        std::string_view msg = line.substr(line.rfind(' ') - 2);
+        int t = msg[1] - '0';
+        int i = std::stoi(std::string(msg.substr(msg.find('#') + 1)));
+        ordered = ordered && i == next[t]++;
+    }
+    test::assert_equal(lines, 8000, "async_logger multi-threaded line count");
+    test::assert_true(ordered, "async_logger keeps per-thread order");
+
+    // Records larger than a ring are dropped, never truncated
+    std::ostringstream drop_out;
+    {
+        std_module::async_logger::options tiny = std_module::async_logger::default_options;
+        tiny.ring_bytes = 256;
+        std_module::async_logger log(drop_out, tiny);
+        log.info("{}", std::string(1000, 'x'));
+        log.flush();
+        test::assert_true(log.dropped() == 1 && drop_out.str().empty(), "async_logger drops oversized records");
+    }
+
+    // A record just under the ring size, after a partial fill, waits for the ring to drain
+    // instead of needing the padding before the wrap as well
+    std::ostringstream wrap_out;
+    {
+        std_module::async_logger::options tiny = std_module::async_logger::default_options;
+        tiny.ring_bytes = 1024;
+        std_module::async_logger log(wrap_out, tiny);
+        log.info("small {}", 1);
+        log.info("{}", std::string(920, 'w'));
+        log.info("small {}", 2);
+        log.flush();
+        std::string text = wrap_out.str();
+        test::assert_true(log.dropped() == 0 && text.find(std::string(920, 'w')) != std::string::npos &&
+                              text.find("small 2") != std::string::npos,
+                          "async_logger record near ring size after a partial fill");
+    }
+
     test::test_footer();
     return 0;
 }